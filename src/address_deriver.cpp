@@ -0,0 +1,76 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "address_deriver.h"
+#include "crypto/ripemd160.h"
+#include "crypto/sha256.h"
+#include <algorithm>
+#include <array>
+
+namespace conclave
+{
+    //
+    // Constructors
+    //
+    
+    AddressDeriver::AddressDeriver(const Address::AddressFormat& addressFormat,
+                                   const Address::NetworkType& networkType)
+        : addressFormat(addressFormat), networkType(networkType)
+    {
+    }
+    
+    //
+    // Public Functions
+    //
+    
+    /***
+     * @return - The hash160 of each key, in the same order. Valid until the next call on this deriver.
+     */
+    const std::vector<Hash160>& AddressDeriver::deriveHash160s(const std::vector<PublicKey>& publicKeys)
+    {
+        const size_t count = publicKeys.size();
+        keyData.resize(count * SECP256K1_PUBKEY_COMPRESSED_SIZE_BYTES);
+        keyPointers.resize(count);
+        keySizes.assign(count, SECP256K1_PUBKEY_COMPRESSED_SIZE_BYTES);
+        sha256Digests.resize(count * LARGE_HASH_SIZE_BYTES);
+        hash160s.resize(count);
+        for (size_t i = 0; i < count; i++) {
+            const auto compressed =
+                static_cast<std::array<BYTE, SECP256K1_PUBKEY_COMPRESSED_SIZE_BYTES>>(publicKeys[i]);
+            keyPointers[i] = keyData.data() + i * SECP256K1_PUBKEY_COMPRESSED_SIZE_BYTES;
+            std::copy(compressed.begin(), compressed.end(), keyData.begin() + i * SECP256K1_PUBKEY_COMPRESSED_SIZE_BYTES);
+        }
+        crypto::sha256Many(keyPointers.data(), keySizes.data(), count, sha256Digests.data(), false);
+        std::array<BYTE, SMALL_HASH_SIZE_BYTES> hash;
+        for (size_t i = 0; i < count; i++) {
+            crypto::ripemd160(sha256Digests.data() + i * LARGE_HASH_SIZE_BYTES, LARGE_HASH_SIZE_BYTES, hash.data());
+            hash160s[i] = Hash160(hash);
+        }
+        return hash160s;
+    }
+    
+    const std::vector<Address> AddressDeriver::deriveAddresses(const std::vector<PublicKey>& publicKeys)
+    {
+        std::vector<Address> addresses;
+        addresses.reserve(publicKeys.size());
+        for (const Hash160& hash160 : deriveHash160s(publicKeys)) {
+            addresses.emplace_back(hash160, addressFormat, networkType, Address::PayeeType::PUBKEY);
+        }
+        return addresses;
+    }
+}
@@ -0,0 +1,53 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "address.h"
+#include "conclave.h"
+#include "hash160.h"
+#include "public_key.h"
+#include <vector>
+
+namespace conclave
+{
+    /***
+     * Derives the pubkey hashes and addresses of many public keys at once, e.g. when pre-generating deposit
+     * addresses. The SHA256 half of each HASH160 is spread across SIMD lanes and RIPEMD160 follows on the digests.
+     * Buffers are kept between calls, so a deriver fed one batch after another stops allocating once it has seen its
+     * largest batch. Keys are hashed in compressed form, as with Address(PublicKey, ...).
+     */
+    class AddressDeriver final
+    {
+        public:
+        // Constructors
+        AddressDeriver(const Address::AddressFormat&, const Address::NetworkType&);
+        // Public Functions
+        const std::vector<Hash160>& deriveHash160s(const std::vector<PublicKey>&);
+        const std::vector<Address> deriveAddresses(const std::vector<PublicKey>&);
+        private:
+        // Properties
+        const Address::AddressFormat addressFormat;
+        const Address::NetworkType networkType;
+        std::vector<BYTE> keyData;
+        std::vector<const BYTE*> keyPointers;
+        std::vector<size_t> keySizes;
+        std::vector<BYTE> sha256Digests;
+        std::vector<Hash160> hash160s;
+    };
+}
@@ -81,7 +81,23 @@ namespace conclave
         
         const Hash256 BitcoinChain::getLatestBlockHash()
         {
-            return Hash256(); // TODO
+            return getLatestBlock().first.getHash256();
+        }
+        
+        const uint64_t BitcoinChain::getLatestBlockHeight()
+        {
+            return getLatestBlock().second;
+        }
+        
+        /***
+         * Get the header and height of the current chain tip in a single round trip, so the two
+         * always describe the same block.
+         */
+        const std::pair<BitcoinBlockHeader, uint64_t> BitcoinChain::getLatestBlock()
+        {
+            pt::ptree tree = electrumxClient.blockchainHeadersSubscribe();
+            BitcoinBlockHeader header(HEX_TO_BYTE_VECTOR(getPrimitiveFromJson<std::string>(tree, "result.hex")));
+            return std::make_pair(std::move(header), getPrimitiveFromJson<uint64_t>(tree, "result.height"));
         }
     }
 }
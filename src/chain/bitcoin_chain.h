@@ -23,9 +23,11 @@
 #include "../structs/bitcoin_tx.h"
 #include "../structs/bitcoin_rich_output.h"
 #include "../structs/outpoint.h"
+#include "structs/bitcoin_block_header.h"
 #include "../address.h"
 #include "../hash256.h"
 #include <cstdint>
+#include <utility>
 /***
  * Abstraction layer over the Bitcoin blockchain. All interaction with the bitcoin base chain
  * such as getting blocks, transactions, wallet balances, as well as submitting new transactions,
@@ -55,6 +57,7 @@ namespace conclave
             const bool outputIsConclaveOwned(const Outpoint& outpoint);
             const Hash256 getLatestBlockHash();
             const uint64_t getLatestBlockHeight();
+            const std::pair<BitcoinBlockHeader, uint64_t> getLatestBlock();
             private:
             // Properties
             ElectrumxClient electrumxClient;
@@ -18,6 +18,9 @@
 
 #include "conclave_chain.h"
 #include "../private_key.h"
+#include "../util/byte_reader.h"
+#include "../util/byte_sink.h"
+#include "../util/serialization.h"
 
 namespace conclave
 {
@@ -27,15 +30,22 @@ namespace conclave
         // Genesis
         //
         
+        constexpr static Hash256 GENESIS_HASH_PREV_BLOCK(
+            "0000000000000000000000000000000000000000000000000000000000000000");
+        constexpr static Hash256 GENESIS_LOWEST_PARENT_BITCOIN_BLOCK_HASH(
+            "0000000000000000000ec9fb4c1ddcfd51b366278a1bdddb7dbee1e9a1aba654");
+        constexpr static Hash256 GENESIS_TX_HASH(
+            "0000000000000000000000000000000000000000000000000000000000000000");
+        
         const ConclaveBlock ConclaveChain::GENESIS_BLOCK(
             0,
             0,
             0,
-            Hash256("0000000000000000000000000000000000000000000000000000000000000000"),
-            Hash256("0000000000000000000ec9fb4c1ddcfd51b366278a1bdddb7dbee1e9a1aba654"),
+            GENESIS_HASH_PREV_BLOCK,
+            GENESIS_LOWEST_PARENT_BITCOIN_BLOCK_HASH,
             0,
             0,
-            Hash256("0000000000000000000000000000000000000000000000000000000000000000")
+            GENESIS_TX_HASH
         );
         
         //
@@ -47,15 +57,60 @@ namespace conclave
         const std::string ConclaveChain::COLLECTION_SPENDS = "Spends";
         const std::string ConclaveChain::COLLECTION_SPEND_TIPS = "SpendTips";
         const std::string ConclaveChain::COLLECTION_FUND_TIPS = "FundTips";
+        const std::string ConclaveChain::COLLECTION_STATE_TREE = "StateTree";
+        const std::string ConclaveChain::COLLECTION_STATE_ROOTS = "StateRoots";
+        const std::string ConclaveChain::COLLECTION_STORAGE_FORMAT = "StorageFormat";
+        
+        //
+        // Storage Format
+        //
+        
+        // 1: transactions are stored in their compact encoding under their txId. Before that they were
+        // content-addressed in their consensus serialization, and the database had no version.
+        const uint32_t ConclaveChain::STORAGE_FORMAT_VERSION = 1;
+        
+        /***
+         * Refuses to open a database whose stored transactions are in an encoding this node can't read. A new,
+         * empty database is marked with the current version.
+         */
+        void ConclaveChain::checkStorageFormat(DatabaseClient& databaseClient)
+        {
+            const std::optional<std::vector<BYTE>> storageFormat =
+                databaseClient.getSingletonItem(COLLECTION_STORAGE_FORMAT);
+            if (!storageFormat.has_value()) {
+                CONCLAVE_ASSERT(databaseClient.isEmpty(),
+                                "database was written by an older node, restart with --reindex to upgrade it");
+                putStorageFormat(databaseClient);
+                return;
+            }
+            ByteReader reader(*storageFormat);
+            const uint32_t version = reader.readIntegral<uint32_t>();
+            CONCLAVE_ASSERT(version <= STORAGE_FORMAT_VERSION,
+                            "database was written by a newer node, storage format " + std::to_string(version));
+            CONCLAVE_ASSERT(version == STORAGE_FORMAT_VERSION,
+                            "database is in storage format " + std::to_string(version) +
+                            ", restart with --reindex to upgrade it");
+        }
         
+        void ConclaveChain::putStorageFormat(DatabaseClient& databaseClient)
+        {
+            std::vector<BYTE> storageFormat;
+            ByteVectorSink sink(storageFormat);
+            writeIntegral(sink, STORAGE_FORMAT_VERSION);
+            databaseClient.putSingletonItem(COLLECTION_STORAGE_FORMAT, storageFormat);
+        }
         
         //
         // Constructors
         //
         
         ConclaveChain::ConclaveChain(const ConclaveChainConfig& conclaveChainConfig, BitcoinChain& bitcoinChain)
-            : bitcoinChain(bitcoinChain), databaseClient(DatabaseClient(conclaveChainConfig.getDatabaseClientConfig()))
+            : bitcoinChain(bitcoinChain), databaseClient(DatabaseClient(conclaveChainConfig.getDatabaseClientConfig())),
+              stateTree(databaseClient, COLLECTION_STATE_TREE),
+              signatureVerifier(conclaveChainConfig.getNumVerifierThreads(),
+                                conclaveChainConfig.getSignatureCacheSize())
         {
+            checkStorageFormat(databaseClient);
         }
         
         const uint64_t ConclaveChain::getAddressBalance(const Address& address)
@@ -70,12 +125,12 @@ namespace conclave
             std::vector<ConclaveRichOutput> utxos;
             std::optional<Outpoint> fundTip = databaseClient.getMutableItem(COLLECTION_FUND_TIPS, walletHash);
             while (fundTip.has_value()) {
-                std::optional<ConclaveTx> conclaveTx = databaseClient.getItem(fundTip->txId);
+                std::optional<ConclaveTxView> conclaveTx = databaseClient.getEncodedItem(fundTip->txId);
                 CONCLAVE_ASSERT(conclaveTx.has_value(),
                                 "can not find transaction: " + std::string(fundTip->txId));
-                CONCLAVE_ASSERT(fundTip->index <= conclaveTx->conclaveOutputs.size(),
+                CONCLAVE_ASSERT(fundTip->index < conclaveTx->getNumConclaveOutputs(),
                                 "index out of range: " + std::to_string(fundTip->index));
-                ConclaveOutput& conclaveOutput = conclaveTx->conclaveOutputs[fundTip->index];
+                const ConclaveOutput conclaveOutput = conclaveTx->getConclaveOutput(fundTip->index);
                 CONCLAVE_ASSERT(conclaveOutput.scriptPubKey.getHash256() == walletHash,
                                 "wallet hash does not match hash of scriptPubKey");
                 utxos.emplace_back(ConclaveRichOutput(
@@ -116,6 +171,24 @@ namespace conclave
             }
         }
         
+        const Hash256 ConclaveChain::getStateRoot()
+        {
+            std::lock_guard<std::mutex> lock(stateTreeMutex);
+            return stateTree.getRoot();
+        }
+        
+        const std::optional<Hash256> ConclaveChain::getStateRoot(const Hash256& txId)
+        {
+            // State root as it was right after the given transaction was applied
+            return databaseClient.getMutableItem(COLLECTION_STATE_ROOTS, txId);
+        }
+        
+        const std::optional<StateTree::Node> ConclaveChain::getStateTreeNode(const uint16_t depth, const Hash256& path)
+        {
+            std::lock_guard<std::mutex> lock(stateTreeMutex);
+            return stateTree.getNode(depth, path);
+        }
+        
         const uint64_t ConclaveChain::countFundTotal(const Hash256& walletHash)
         {
             uint64_t fundTotal = 0;
@@ -123,16 +196,16 @@ namespace conclave
             while (fundTip.has_value()) {
                 // Potential for an infinite loop here if there is a graph cycle.
                 // TODO: Do something about it
-                std::optional<ConclaveTx> conclaveTx = databaseClient.getItem(fundTip->txId);
+                // Only the one output's value and predecessor are decoded
+                std::optional<ConclaveTxView> conclaveTx = databaseClient.getEncodedItem(fundTip->txId);
                 if (!conclaveTx.has_value()) {
                     throw std::runtime_error("can not find transaction: " + static_cast<std::string>(fundTip->txId));
                 }
-                if (conclaveTx->conclaveOutputs.size() <= fundTip->index) {
+                if (conclaveTx->getNumConclaveOutputs() <= fundTip->index) {
                     throw std::runtime_error("output index out of bounds" + static_cast<std::string>(*fundTip));
                 }
-                ConclaveOutput& conclaveOutput = conclaveTx->conclaveOutputs[fundTip->index];
-                fundTotal += conclaveOutput.value;
-                fundTip = conclaveOutput.predecessor;
+                fundTotal += conclaveTx->getConclaveOutputValue(fundTip->index);
+                fundTip = conclaveTx->getConclaveOutputPredecessor(fundTip->index);
             }
             return fundTotal;
         }
@@ -144,32 +217,30 @@ namespace conclave
             while (spendTip.has_value()) {
                 // Potential for an infinite loop here if there is a graph cycle.
                 // TODO: Do something about it
-                std::optional<ConclaveTx> conclaveTx = databaseClient.getItem(spendTip->txId);
+                std::optional<ConclaveTxView> conclaveTx = databaseClient.getEncodedItem(spendTip->txId);
                 if (!conclaveTx.has_value()) {
                     throw std::runtime_error("can not find transaction: " + static_cast<std::string>(spendTip->txId));
                 }
-                if (conclaveTx->conclaveInputs.size() <= spendTip->index) {
+                if (conclaveTx->getNumConclaveInputs() <= spendTip->index) {
                     throw std::runtime_error("input index out of bounds" + static_cast<std::string>(*spendTip));
                 }
-                ConclaveInput& conclaveInput = conclaveTx->conclaveInputs[spendTip->index];
-                Outpoint& outpoint = conclaveInput.outpoint;
-                std::optional<ConclaveTx> prevConclaveTx = databaseClient.getItem(outpoint.txId);
+                const Outpoint outpoint = conclaveTx->getConclaveInputOutpoint(spendTip->index);
+                std::optional<ConclaveTxView> prevConclaveTx = databaseClient.getEncodedItem(outpoint.txId);
                 if (!prevConclaveTx.has_value()) {
                     throw std::runtime_error("can not find transaction: " + static_cast<std::string>(outpoint.txId));
                 }
-                if (prevConclaveTx->conclaveOutputs.size() <= outpoint.index) {
+                if (prevConclaveTx->getNumConclaveOutputs() <= outpoint.index) {
                     throw std::runtime_error("output index out of bounds" + static_cast<std::string>(outpoint));
                 }
-                ConclaveOutput& conclaveOutput = prevConclaveTx->conclaveOutputs[outpoint.index];
-                spendTotal += conclaveOutput.value;
-                spendTip = conclaveInput.predecessor;
+                spendTotal += prevConclaveTx->getConclaveOutputValue(outpoint.index);
+                spendTip = conclaveTx->getConclaveInputPredecessor(spendTip->index);
             }
             return spendTotal;
         }
         
         const bool ConclaveChain::txIsOnBlockchain(const Hash256& txId)
         {
-            return databaseClient.getItem(txId).has_value();
+            return databaseClient.getEncodedItem(txId).has_value();
         }
         
         const Hash256 ConclaveChain::processClaimTx(ConclaveTx claimTx)
@@ -235,8 +306,11 @@ namespace conclave
             // Claim the fundPoint
             databaseClient.putMutableItem(COLLECTION_CLAIMS, fundPointHash, finalTxId);
             
+            // Commit the new outputs to the state tree
+            updateStateTree(finalTxId, claimTx);
+            
             // Store the transaction
-            databaseClient.putItem(claimTx);
+            databaseClient.putEncodedItem(finalTxId, compact::serializeConclaveTx(claimTx));
             return finalTxId;
         }
         
@@ -261,16 +335,15 @@ namespace conclave
             prevOutputs.reserve(conclaveTx.conclaveInputs.size());
             for (uint64_t i = 0; i < conclaveTx.conclaveInputs.size(); i++) {
                 const Outpoint& outpoint = conclaveTx.conclaveInputs[i].outpoint;
-                const std::optional<ConclaveTx> prevTx = databaseClient.getItem(outpoint.txId);
+                const std::optional<ConclaveTxView> prevTx = databaseClient.getEncodedItem(outpoint.txId);
                 if (!prevTx.has_value()) {
-                    throw new std::runtime_error("can not find previous tx");
+                    throw std::runtime_error("can not find previous tx");
                 }
-                if (prevTx->conclaveOutputs.size() <= outpoint.index) {
-                    throw new std::runtime_error("index out of range");
+                if (prevTx->getNumConclaveOutputs() <= outpoint.index) {
+                    throw std::runtime_error("index out of range");
                 }
-                const ConclaveOutput& prevOutput = prevTx->conclaveOutputs[outpoint.index];
-                spendableValue += prevOutput.value;
-                prevOutputs.emplace_back(prevOutput);
+                prevOutputs.emplace_back(prevTx->getConclaveOutput(outpoint.index));
+                spendableValue += prevOutputs.back().value;
             }
             
             // Ensure tx spends no more than the spendable value
@@ -279,7 +352,8 @@ namespace conclave
                 throw std::runtime_error("tx spends too much value");
             }
             
-            // TODO: Check signatures
+            // Ensure every input is signed by the owner of the output it spends
+            signatureVerifier.verifyTx(conclaveTx, prevOutputs);
             
             // Update inpoint predecessors
             // TODO: Currently this does not work properly if there are 2 or more inputs in the
@@ -338,6 +412,9 @@ namespace conclave
                 databaseClient.putMutableItem(COLLECTION_FUND_TIPS, walletHash, newFundTip);
             }
             
+            // Commit the spends and new outputs to the state tree
+            updateStateTree(finalTxId, conclaveTx);
+            
             // Process Bitcoin outputs
             // TEMPORARY !!!
             if (conclaveTx.bitcoinOutputs.size() > 0) {
@@ -345,10 +422,23 @@ namespace conclave
             }
             
             // Store the transaction in database
-            databaseClient.putItem(conclaveTx);
+            databaseClient.putEncodedItem(finalTxId, compact::serializeConclaveTx(conclaveTx));
             return finalTxId;
         }
         
+        void ConclaveChain::updateStateTree(const Hash256& txId, const ConclaveTx& conclaveTx)
+        {
+            std::lock_guard<std::mutex> lock(stateTreeMutex);
+            for (const ConclaveInput& conclaveInput : conclaveTx.conclaveInputs) {
+                stateTree.removeUtxo(conclaveInput.outpoint);
+            }
+            for (uint32_t i = 0; i < conclaveTx.conclaveOutputs.size(); i++) {
+                stateTree.addUtxo(Outpoint(txId, i), conclaveTx.conclaveOutputs[i]);
+            }
+            stateTree.commit();
+            databaseClient.putMutableItem(COLLECTION_STATE_ROOTS, txId, stateTree.getRoot());
+        }
+        
         const void ConclaveChain::withdrawOutputs(const std::vector<BitcoinOutput>& withdrawalOutputs)
         {
             //TODO
@@ -19,14 +19,20 @@
 #pragma once
 
 #include "database/database_client.h"
+#include "signature_verifier.h"
+#include "state_tree.h"
 #include "structs/conclave_block.h"
 #include "bitcoin_chain.h"
 #include "../config/conclave_chain_config.h"
 #include "../structs/conclave_tx.h"
+#include "../structs/compact_encoding.h"
+#include "../structs/conclave_tx_view.h"
 #include "../structs/conclave_rich_output.h"
 #include "../address.h"
 #include "../hash256.h"
 #include <cstdint>
+#include <mutex>
+#include <optional>
 /***
  * Abstraction layer over the Conclave blockchain. All interaction with the Conclave chain
  * such as getting blocks, transactions, wallet balances, as well as submitting new transactions,
@@ -50,6 +56,13 @@ namespace conclave
             const static std::string COLLECTION_SPENDS;
             const static std::string COLLECTION_SPEND_TIPS;
             const static std::string COLLECTION_FUND_TIPS;
+            const static std::string COLLECTION_STATE_TREE;
+            const static std::string COLLECTION_STATE_ROOTS;
+            const static std::string COLLECTION_STORAGE_FORMAT;
+            // Storage Format
+            const static uint32_t STORAGE_FORMAT_VERSION;
+            static void checkStorageFormat(DatabaseClient&);
+            static void putStorageFormat(DatabaseClient&);
             // Constructors
             explicit ConclaveChain(const ConclaveChainConfig&, BitcoinChain& bitcoinChain);
             // Public Functions
@@ -58,6 +71,9 @@ namespace conclave
             const Hash256 submitTx(const ConclaveTx&);
             const Hash256 getChainTipHash();
             const ConclaveBlock getChainTip();
+            const Hash256 getStateRoot();
+            const std::optional<Hash256> getStateRoot(const Hash256&);
+            const std::optional<StateTree::Node> getStateTreeNode(const uint16_t, const Hash256&);
             private:
             // Private Functions
             const uint64_t countFundTotal(const Hash256& walletHash);
@@ -65,10 +81,14 @@ namespace conclave
             const bool txIsOnBlockchain(const Hash256&);
             const Hash256 processClaimTx(ConclaveTx);
             const Hash256 processTx(ConclaveTx);
+            void updateStateTree(const Hash256&, const ConclaveTx&);
             const void withdrawOutputs(const std::vector<BitcoinOutput>&);
             // Properties
             BitcoinChain& bitcoinChain;
             DatabaseClient databaseClient;
+            StateTree stateTree;
+            std::mutex stateTreeMutex;
+            SignatureVerifier signatureVerifier;
         };
     }
 }
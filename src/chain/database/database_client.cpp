@@ -25,11 +25,6 @@ namespace conclave
     {
         namespace database
         {
-            static inline const Hash256 makeCollectionKey(const std::string& collectionName, const Hash256& key)
-            {
-                return Hash256::digest(collectionName) ^ key;
-            }
-            
             static inline const lmdb::val makeValue(const std::vector<BYTE>& value)
             {
                 return lmdb::val(value.data(), value.size());
@@ -44,8 +39,10 @@ namespace conclave
                 return env;
             }
             
-            const Hash256
-                DatabaseClient::SINGLETON_KEY("74223097b6a5346bf30adebc6e2f5f83392788c4eb56eb04a6f96aed1665580b");
+            const Hash256 DatabaseClient::makeCollectionKey(const std::string& collectionName, const Hash256& key)
+            {
+                return Hash256::digest(collectionName) ^ key;
+            }
             
             DatabaseClient::DatabaseClient(const std::string& rootDirectory)
                 : env(std::move(initLmdb(rootDirectory)))
@@ -96,6 +93,41 @@ namespace conclave
                 return value;
             }
             
+            /***
+             * Stores an immutable item in an encoding other than the one its key is the hash of, e.g. a transaction
+             * in its compact storage encoding under its txId. The caller is responsible for the key matching.
+             */
+            void DatabaseClient::putEncodedItem(const Hash256& key, const std::vector<BYTE>& value)
+            {
+                std::vector<BYTE> keyBV = static_cast<std::vector<BYTE>>(key);
+                lmdb::val k(keyBV.data(), keyBV.size());
+                lmdb::val v(value.data(), value.size());
+                lmdb::txn wtxn = lmdb::txn::begin(env);
+                lmdb::dbi dbi = lmdb::dbi::open(wtxn);
+                if (!dbi.put(wtxn, k, v)) {
+                    throw std::runtime_error("putEncodedItem failed");
+                }
+                wtxn.commit();
+            }
+            
+            /***
+             * Reads back an item stored by putEncodedItem(). Its hash can not be checked against the key without
+             * decoding it, so that is left to the caller.
+             */
+            std::optional<std::vector<BYTE>> DatabaseClient::getEncodedItem(const Hash256& key)
+            {
+                std::vector<BYTE> keyBV = static_cast<std::vector<BYTE>>(key);
+                lmdb::val k(keyBV.data(), keyBV.size());
+                lmdb::val v;
+                lmdb::txn rtxn = lmdb::txn::begin(env);
+                lmdb::dbi dbi = lmdb::dbi::open(rtxn);
+                if (dbi.get(rtxn, k, v)) {
+                    return std::vector<BYTE>(v.data(), v.data() + v.size());
+                } else {
+                    return std::nullopt;
+                }
+            }
+            
             void DatabaseClient::putMutableItem(const std::string& collectionName,
                                                 const Hash256& key, const std::vector<BYTE>& value)
             {
@@ -136,6 +168,69 @@ namespace conclave
             {
                 return getMutableItem(collectionName, SINGLETON_KEY);
             }
+            
+            void DatabaseClient::writeBatch(const WriteBatch& writeBatch)
+            {
+                // Erasures are applied before puts so that a batch can clear and rewrite the same key
+                lmdb::txn wtxn = lmdb::txn::begin(env);
+                lmdb::dbi dbi = lmdb::dbi::open(wtxn);
+                for (const Hash256& key : writeBatch.erasures) {
+                    std::vector<BYTE> keyBV = static_cast<std::vector<BYTE>>(key);
+                    lmdb::val k(keyBV.data(), keyBV.size());
+                    dbi.del(wtxn, k);
+                }
+                for (const std::pair<Hash256, std::vector<BYTE>>& put : writeBatch.puts) {
+                    std::vector<BYTE> keyBV = static_cast<std::vector<BYTE>>(put.first);
+                    lmdb::val k(keyBV.data(), keyBV.size());
+                    lmdb::val v(put.second.data(), put.second.size());
+                    if (!dbi.put(wtxn, k, v)) {
+                        throw std::runtime_error("writeBatch failed");
+                    }
+                }
+                wtxn.commit();
+            }
+            
+            void DatabaseClient::scan(const Hash256& from, const std::optional<Hash256>& to,
+                                      const std::function<void(const Hash256&, const std::vector<BYTE>&)>& visitor)
+            {
+                // Visits every raw entry with from <= key < to, in key order, inside a single
+                // read-only transaction. Read-only transactions do not block each other, so
+                // disjoint key ranges can be scanned from several threads at once.
+                std::vector<BYTE> fromBV = static_cast<std::vector<BYTE>>(from);
+                std::optional<std::vector<BYTE>> toBV;
+                if (to.has_value()) {
+                    toBV = static_cast<std::vector<BYTE>>(*to);
+                }
+                lmdb::txn rtxn = lmdb::txn::begin(env, nullptr, MDB_RDONLY);
+                lmdb::dbi dbi = lmdb::dbi::open(rtxn);
+                lmdb::cursor cursor = lmdb::cursor::open(rtxn, dbi.handle());
+                lmdb::val k(fromBV.data(), fromBV.size());
+                lmdb::val v;
+                bool found = cursor.get(k, v, MDB_SET_RANGE);
+                while (found) {
+                    std::vector<BYTE> keyBV(k.data(), k.data() + k.size());
+                    if (toBV.has_value() && keyBV >= *toBV) {
+                        break;
+                    }
+                    visitor(Hash256(keyBV), std::vector<BYTE>(v.data(), v.data() + v.size()));
+                    found = cursor.get(k, v, MDB_NEXT);
+                }
+                cursor.close();
+                rtxn.abort();
+            }
+            
+            bool DatabaseClient::isEmpty()
+            {
+                lmdb::txn rtxn = lmdb::txn::begin(env, nullptr, MDB_RDONLY);
+                lmdb::dbi dbi = lmdb::dbi::open(rtxn);
+                lmdb::cursor cursor = lmdb::cursor::open(rtxn, dbi.handle());
+                lmdb::val k;
+                lmdb::val v;
+                const bool empty = !cursor.get(k, v, MDB_FIRST);
+                cursor.close();
+                rtxn.abort();
+                return empty;
+            }
         }
     }
 }
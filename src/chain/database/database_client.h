@@ -18,10 +18,12 @@
 
 #pragma once
 
+#include "write_batch.h"
 #include "../../config/database_client_config.h"
 #include "../../hash256.h"
 #include "../../conclave.h"
 #include <lmdb++.h>
+#include <functional>
 #include <vector>
 #include <optional>
 #include <string>
@@ -35,17 +37,28 @@ namespace conclave
             class DatabaseClient
             {
                 public:
+                // Factories
+                static const Hash256 makeCollectionKey(const std::string&, const Hash256&);
+                // Constructors
                 DatabaseClient(const std::string&);
                 DatabaseClient(const DatabaseClientConfig&);
                 ~DatabaseClient();
                 Hash256 putItem(const std::vector<BYTE>&);
                 std::optional<std::vector<BYTE>> getItem(const Hash256&);
+                void putEncodedItem(const Hash256&, const std::vector<BYTE>&);
+                std::optional<std::vector<BYTE>> getEncodedItem(const Hash256&);
                 void putMutableItem(const std::string&, const Hash256&, const std::vector<BYTE>&);
                 std::optional<std::vector<BYTE>> getMutableItem(const std::string&, const Hash256&);
                 void putSingletonItem(const std::string&, const std::vector<BYTE>&);
                 std::optional<std::vector<BYTE>> getSingletonItem(const std::string&);
+                void writeBatch(const WriteBatch&);
+                void scan(const Hash256&, const std::optional<Hash256>&,
+                          const std::function<void(const Hash256&, const std::vector<BYTE>&)>&);
+                bool isEmpty();
                 private:
-                const static Hash256 SINGLETON_KEY;
+                constexpr static Hash256 SINGLETON_KEY{
+                    "74223097b6a5346bf30adebc6e2f5f83392788c4eb56eb04a6f96aed1665580b"
+                };
                 lmdb::env env;
             };
         }
@@ -0,0 +1,72 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "write_batch.h"
+#include "database_client.h"
+
+namespace conclave
+{
+    namespace chain
+    {
+        namespace database
+        {
+            //
+            // Public Functions
+            //
+            
+            const Hash256 WriteBatch::putItem(const std::vector<BYTE>& value)
+            {
+                const Hash256 key = Hash256::digest(value);
+                puts.emplace_back(key, value);
+                return key;
+            }
+            
+            void WriteBatch::putEncodedItem(const Hash256& key, const std::vector<BYTE>& value)
+            {
+                puts.emplace_back(key, value);
+            }
+            
+            void WriteBatch::putMutableItem(const std::string& collectionName,
+                                            const Hash256& key, const std::vector<BYTE>& value)
+            {
+                puts.emplace_back(DatabaseClient::makeCollectionKey(collectionName, key), value);
+            }
+            
+            void WriteBatch::erase(const Hash256& rawKey)
+            {
+                erasures.emplace_back(rawKey);
+            }
+            
+            const size_t WriteBatch::size() const
+            {
+                return puts.size() + erasures.size();
+            }
+            
+            const bool WriteBatch::empty() const
+            {
+                return puts.empty() && erasures.empty();
+            }
+            
+            void WriteBatch::clear()
+            {
+                puts.clear();
+                erasures.clear();
+            }
+        }
+    }
+}
@@ -0,0 +1,60 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "../../hash256.h"
+#include "../../conclave.h"
+#include <vector>
+#include <string>
+#include <utility>
+
+/***
+ * A group of writes which DatabaseClient::writeBatch() applies in a single LMDB write
+ * transaction. Committing many small puts individually costs one transaction (and one
+ * fsync) each, so bulk jobs such as reindexing collect their writes here instead.
+ */
+
+namespace conclave
+{
+    namespace chain
+    {
+        namespace database
+        {
+            class DatabaseClient;
+            
+            class WriteBatch final
+            {
+                public:
+                // Public Functions
+                const Hash256 putItem(const std::vector<BYTE>&);
+                void putEncodedItem(const Hash256&, const std::vector<BYTE>&);
+                void putMutableItem(const std::string&, const Hash256&, const std::vector<BYTE>&);
+                void erase(const Hash256&);
+                const size_t size() const;
+                const bool empty() const;
+                void clear();
+                private:
+                // Properties
+                std::vector<std::pair<Hash256, std::vector<BYTE>>> puts;
+                std::vector<Hash256> erasures;
+                friend class DatabaseClient;
+            };
+        }
+    }
+}
@@ -0,0 +1,125 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "multisig_verifier.h"
+#include "../util/serialization.h"
+
+namespace conclave
+{
+    namespace chain
+    {
+        //
+        // Constants
+        //
+        
+        // Recovery ids 2 and 3 only occur when r overflows the curve order, which is
+        // vanishingly rare, so they are only tried when 0 and 1 yield no match.
+        const static uint8_t COMMON_RECOVERY_IDS = 2;
+        const static uint8_t MAX_RECOVERY_IDS = 4;
+        
+        //
+        // Factories
+        //
+        
+        Hash256 MultisigVerifier::makeTrusteeSetId(const std::vector<PublicKey>& trustees)
+        {
+            Hash256Writer writer;
+            writeVectorOfObjects<PublicKey>(writer, trustees);
+            return writer.getHash256();
+        }
+        
+        //
+        // Constructors
+        //
+        
+        MultisigVerifier::MultisigVerifier(const std::vector<PublicKey>& trustees)
+            : trustees(trustees)
+        {
+            trusteeIndexes.reserve(trustees.size());
+            for (size_t i = 0; i < trustees.size(); i++) {
+                trusteeIndexes[trustees[i].getHash256Compressed()].push_back(i);
+            }
+        }
+        
+        //
+        // Public Functions
+        //
+        
+        /***
+         * Finds the first trustee, at or after the given index, who produced the signature.
+         * @param sigHash - The signed message
+         * @param signature - The signature to match
+         * @param firstIndex - Lowest trustee index to consider
+         * @return - Index of the matching trustee, or std::nullopt if there is none
+         */
+        const std::optional<size_t> MultisigVerifier::matchSignature(const Hash256& sigHash,
+                                                                     const EcdsaSignature& signature,
+                                                                     const size_t firstIndex) const
+        {
+            std::optional<size_t> match;
+            for (uint8_t recoveryId = 0; recoveryId < MAX_RECOVERY_IDS; recoveryId++) {
+                if (recoveryId == COMMON_RECOVERY_IDS && match.has_value()) {
+                    break;
+                }
+                const std::optional<PublicKey> publicKey = PublicKey::recover(sigHash, signature, recoveryId);
+                if (!publicKey.has_value()) {
+                    continue;
+                }
+                const auto it = trusteeIndexes.find(publicKey->getHash256Compressed());
+                if (it == trusteeIndexes.end()) {
+                    continue;
+                }
+                for (const size_t index: it->second) {
+                    if (index >= firstIndex && trustees[index] == *publicKey) {
+                        if (!match.has_value() || index < *match) {
+                            match = index;
+                        }
+                        break;
+                    }
+                }
+            }
+            return match;
+        }
+        
+        /***
+         * Checks that exactly minSigs signatures are given and that they match distinct
+         * trustees in increasing trustee order.
+         */
+        const bool MultisigVerifier::verify(const Hash256& sigHash, const std::vector<EcdsaSignature>& signatures,
+                                            const uint32_t minSigs) const
+        {
+            if (signatures.size() != minSigs || minSigs > trustees.size()) {
+                return false;
+            }
+            size_t nextIndex = 0;
+            for (const EcdsaSignature& signature: signatures) {
+                const std::optional<size_t> index = matchSignature(sigHash, signature, nextIndex);
+                if (!index.has_value()) {
+                    return false;
+                }
+                nextIndex = *index + 1;
+            }
+            return true;
+        }
+        
+        const std::vector<PublicKey>& MultisigVerifier::getTrustees() const
+        {
+            return trustees;
+        }
+    }
+}
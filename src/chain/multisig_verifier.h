@@ -0,0 +1,60 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "../ecdsa_signature.h"
+#include "../hash256.h"
+#include "../public_key.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+/***
+ * Verifies m-of-n CHECKMULTISIG signatures against a fixed trustee set. Instead of trying
+ * each signature against each trustee key, the key is recovered from the signature and
+ * looked up in an index of the trustees, built once per trustee set. That costs at most a
+ * couple of recoveries per signature however many trustees there are.
+ *
+ * As with CHECKMULTISIG, signatures must be in the same order as the keys they belong to.
+ */
+
+namespace conclave
+{
+    namespace chain
+    {
+        class MultisigVerifier final
+        {
+            public:
+            // Factories
+            static Hash256 makeTrusteeSetId(const std::vector<PublicKey>&);
+            // Constructors
+            explicit MultisigVerifier(const std::vector<PublicKey>&);
+            // Public Functions
+            const std::optional<size_t> matchSignature(const Hash256&, const EcdsaSignature&, const size_t) const;
+            const bool verify(const Hash256&, const std::vector<EcdsaSignature>&, const uint32_t) const;
+            const std::vector<PublicKey>& getTrustees() const;
+            private:
+            // Properties
+            const std::vector<PublicKey> trustees;
+            std::unordered_map<Hash256, std::vector<size_t>> trusteeIndexes;
+        };
+    }
+}
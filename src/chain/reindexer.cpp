@@ -0,0 +1,399 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "reindexer.h"
+#include "conclave_chain.h"
+#include "../structs/inpoint.h"
+#include "../structs/outpoint.h"
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <thread>
+#include <unordered_set>
+
+namespace conclave
+{
+    namespace chain
+    {
+        // Keys are uniformly distributed hashes, so splitting on the first byte balances the partitions
+        const static unsigned int MAX_THREADS = 256;
+        const static size_t WRITE_BATCH_SIZE = 100000;
+        // Entries are content-checked this many at a time so the hashing can use SIMD lanes
+        const static size_t SCAN_HASH_BATCH_SIZE = 64;
+        const static size_t STATE_TREE_COMMIT_INTERVAL = 10000;
+        const static std::chrono::milliseconds PROGRESS_POLL_INTERVAL(100);
+        const static std::chrono::seconds PROGRESS_REPORT_INTERVAL(1);
+        
+        static const unsigned int defaultThreadCount()
+        {
+            const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+            return hardwareThreads == 0 ? 1 : hardwareThreads;
+        }
+        
+        static const Hash256 partitionBoundary(const unsigned int partition, const unsigned int nPartitions)
+        {
+            std::array<BYTE, LARGE_HASH_SIZE_BYTES> boundary{};
+            boundary[0] = static_cast<BYTE>((partition * 256) / nPartitions);
+            return Hash256(boundary);
+        }
+        
+        //
+        // Constructors
+        //
+        
+        Reindexer::Reindexer(DatabaseClient& databaseClient)
+            : Reindexer(databaseClient, defaultThreadCount())
+        {
+        }
+        
+        Reindexer::Reindexer(DatabaseClient& databaseClient, const unsigned int nThreads)
+            : databaseClient(databaseClient), nThreads(std::clamp(nThreads, 1U, MAX_THREADS)),
+              nEntriesScanned(0), nBytesScanned(0)
+        {
+        }
+        
+        //
+        // Public Functions
+        //
+        
+        void Reindexer::run()
+        {
+            // Derived entries are erased before they are rebuilt. If the process dies in between,
+            // the indexes are incomplete until the next reindex, which starts from scratch. Entries of
+            // any other collection, such as the chain tip, are left as they are.
+            std::cout << "Reindex: scanning database with " << nThreads << " thread(s)" << std::endl;
+            scanAll();
+            std::cout << "Reindex: found " << txs.size() << " transactions, "
+                      << legacyTxIds.size() << " in the legacy encoding" << std::endl;
+            const std::vector<size_t> order = sortByDependency();
+            eraseDerivedEntries();
+            reencodeLegacyTxs();
+            applyAll(order);
+            // Only now is every stored transaction in the current encoding
+            ConclaveChain::putStorageFormat(databaseClient);
+            std::cout << "Reindex: complete" << std::endl;
+        }
+        
+        //
+        // Private Functions
+        //
+        
+        void Reindexer::scanPartition(const unsigned int partition, ScanResult& scanResult)
+        {
+            const Hash256 from = partitionBoundary(partition, nThreads);
+            std::optional<Hash256> to;
+            if (partition + 1 < nThreads) {
+                to = partitionBoundary(partition + 1, nThreads);
+            }
+            std::vector<Hash256> keys;
+            std::vector<std::vector<BYTE>> values;
+            keys.reserve(SCAN_HASH_BATCH_SIZE);
+            values.reserve(SCAN_HASH_BATCH_SIZE);
+            databaseClient.scan(from, to, [this, &scanResult, &keys, &values](const Hash256& key,
+                                                                             const std::vector<BYTE>& value) {
+                nEntriesScanned++;
+                nBytesScanned += value.size();
+                keys.emplace_back(key);
+                values.emplace_back(value);
+                if (keys.size() == SCAN_HASH_BATCH_SIZE) {
+                    classifyEntries(keys, values, scanResult);
+                }
+            });
+            classifyEntries(keys, values, scanResult);
+        }
+        
+        /***
+         * Picks the transactions out of a batch of scanned entries, then empties it. Transactions are stored
+         * compactly under their txId; ones written before that was the case are content-addressed and in their
+         * consensus serialization. Everything else is left for eraseDerivedEntries() to find by key.
+         */
+        void Reindexer::classifyEntries(std::vector<Hash256>& keys, std::vector<std::vector<BYTE>>& values,
+                                        ScanResult& scanResult)
+        {
+            const std::vector<Hash256> digests = Hash256::digestMany(values);
+            for (size_t i = 0; i < keys.size(); i++) {
+                if (digests[i] == keys[i]) {
+                    try {
+                        ConclaveTx conclaveTx(values[i]);
+                        if (conclaveTx.serialize() == values[i]) {
+                            scanResult.txs.emplace_back(keys[i], std::move(conclaveTx));
+                            scanResult.legacyTxIds.emplace_back(keys[i]);
+                        }
+                    } catch (const std::exception&) {
+                        // Content-addressed but not a transaction - leave it alone
+                    }
+                    continue;
+                }
+                try {
+                    ConclaveTx conclaveTx = compact::deserializeConclaveTx(values[i]);
+                    if (conclaveTx.getHash256() == keys[i]) {
+                        scanResult.txs.emplace_back(keys[i], std::move(conclaveTx));
+                    }
+                } catch (const std::exception&) {
+                    // Not a transaction
+                }
+            }
+            keys.clear();
+            values.clear();
+        }
+        
+        void Reindexer::scanAll()
+        {
+            std::vector<ScanResult> scanResults(nThreads);
+            std::vector<std::exception_ptr> errors(nThreads);
+            std::atomic<unsigned int> nFinished(0);
+            std::vector<std::thread> threads;
+            stageStart = lastReport = std::chrono::steady_clock::now();
+            for (unsigned int partition = 0; partition < nThreads; partition++) {
+                threads.emplace_back([this, partition, &scanResults, &errors, &nFinished]() {
+                    try {
+                        scanPartition(partition, scanResults[partition]);
+                    } catch (...) {
+                        errors[partition] = std::current_exception();
+                    }
+                    nFinished++;
+                });
+            }
+            while (nFinished < nThreads) {
+                std::this_thread::sleep_for(PROGRESS_POLL_INTERVAL);
+                reportProgress("scanned", nEntriesScanned, 0);
+            }
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+            for (const std::exception_ptr& error : errors) {
+                if (error) {
+                    std::rethrow_exception(error);
+                }
+            }
+            reportProgress("scanned", nEntriesScanned, nEntriesScanned);
+            for (ScanResult& scanResult : scanResults) {
+                for (std::pair<Hash256, ConclaveTx>& tx : scanResult.txs) {
+                    txIndexes.emplace(tx.first, txs.size());
+                    txs.emplace_back(std::move(tx));
+                }
+                legacyTxIds.insert(legacyTxIds.end(), scanResult.legacyTxIds.begin(), scanResult.legacyTxIds.end());
+            }
+        }
+        
+        const std::vector<size_t> Reindexer::sortByDependency() const
+        {
+            // A transaction depends on the transactions whose outputs it spends and on those its
+            // input and output predecessors point to. Because every predecessor link points backwards
+            // in time, applying transactions in this order leaves each wallet's latest inpoint and
+            // outpoint as its tip, exactly as submitting them one by one did.
+            const size_t nTxs = txs.size();
+            std::vector<std::vector<size_t>> dependents(nTxs);
+            std::vector<size_t> nDependencies(nTxs, 0);
+            for (size_t i = 0; i < nTxs; i++) {
+                const ConclaveTx& conclaveTx = txs[i].second;
+                std::vector<Hash256> parentTxIds;
+                for (const ConclaveInput& conclaveInput : conclaveTx.conclaveInputs) {
+                    parentTxIds.emplace_back(conclaveInput.outpoint.txId);
+                    if (conclaveInput.predecessor.has_value()) {
+                        parentTxIds.emplace_back(conclaveInput.predecessor->txId);
+                    }
+                }
+                for (const ConclaveOutput& conclaveOutput : conclaveTx.conclaveOutputs) {
+                    if (conclaveOutput.predecessor.has_value()) {
+                        parentTxIds.emplace_back(conclaveOutput.predecessor->txId);
+                    }
+                }
+                std::vector<size_t> parents;
+                for (const Hash256& parentTxId : parentTxIds) {
+                    const auto it = txIndexes.find(parentTxId);
+                    if (it != txIndexes.end() && it->second != i) {
+                        parents.emplace_back(it->second);
+                    }
+                }
+                std::sort(parents.begin(), parents.end());
+                parents.erase(std::unique(parents.begin(), parents.end()), parents.end());
+                for (const size_t parent : parents) {
+                    dependents[parent].emplace_back(i);
+                }
+                nDependencies[i] = parents.size();
+            }
+            std::deque<size_t> ready;
+            for (size_t i = 0; i < nTxs; i++) {
+                if (nDependencies[i] == 0) {
+                    ready.emplace_back(i);
+                }
+            }
+            std::vector<size_t> order;
+            order.reserve(nTxs);
+            while (!ready.empty()) {
+                const size_t i = ready.front();
+                ready.pop_front();
+                order.emplace_back(i);
+                for (const size_t dependent : dependents[i]) {
+                    if (--nDependencies[dependent] == 0) {
+                        ready.emplace_back(dependent);
+                    }
+                }
+            }
+            CONCLAVE_ASSERT(order.size() == nTxs, "stored transactions contain a dependency cycle");
+            return order;
+        }
+        
+        /***
+         * Erases the collections the reindex rebuilds, and nothing else. Their keys are hashes, so entries can't be
+         * told apart by key alone; instead every key each collection could hold is derived from the stored
+         * transactions, which also catches entries the rebuild wouldn't overwrite, such as a spend recorded for an
+         * output that is still unspent. The state tree is erased by walking it from its root.
+         */
+        void Reindexer::eraseDerivedEntries()
+        {
+            StateTree(databaseClient, ConclaveChain::COLLECTION_STATE_TREE).clear();
+            std::vector<Hash256> claimKeys;
+            std::vector<Hash256> spendKeys;
+            std::vector<Hash256> stateRootKeys;
+            std::unordered_set<Hash256> walletHashes;
+            for (const std::pair<Hash256, ConclaveTx>& tx : txs) {
+                const ConclaveTx& conclaveTx = tx.second;
+                if (conclaveTx.isClaimTx()) {
+                    claimKeys.emplace_back(conclaveTx.fundPoint->getHash256());
+                }
+                for (const ConclaveInput& conclaveInput : conclaveTx.conclaveInputs) {
+                    spendKeys.emplace_back(conclaveInput.outpoint.getHash256());
+                }
+                for (uint32_t i = 0; i < conclaveTx.conclaveOutputs.size(); i++) {
+                    spendKeys.emplace_back(Outpoint(tx.first, i).getHash256());
+                    walletHashes.emplace(conclaveTx.conclaveOutputs[i].scriptPubKey.getHash256());
+                }
+                stateRootKeys.emplace_back(tx.first);
+            }
+            const std::vector<Hash256> walletKeys(walletHashes.begin(), walletHashes.end());
+            WriteBatch writeBatch;
+            stageStart = lastReport = std::chrono::steady_clock::now();
+            eraseCollectionKeys(writeBatch, ConclaveChain::COLLECTION_CLAIMS, claimKeys);
+            eraseCollectionKeys(writeBatch, ConclaveChain::COLLECTION_SPENDS, spendKeys);
+            eraseCollectionKeys(writeBatch, ConclaveChain::COLLECTION_SPEND_TIPS, walletKeys);
+            eraseCollectionKeys(writeBatch, ConclaveChain::COLLECTION_FUND_TIPS, walletKeys);
+            eraseCollectionKeys(writeBatch, ConclaveChain::COLLECTION_STATE_ROOTS, stateRootKeys);
+            flush(writeBatch, true);
+        }
+        
+        void Reindexer::eraseCollectionKeys(WriteBatch& writeBatch, const std::string& collectionName,
+                                            const std::vector<Hash256>& keys)
+        {
+            for (size_t i = 0; i < keys.size(); i++) {
+                writeBatch.erase(DatabaseClient::makeCollectionKey(collectionName, keys[i]));
+                flush(writeBatch, false);
+                reportProgress("erased " + collectionName, i + 1, keys.size());
+            }
+        }
+        
+        void Reindexer::reencodeLegacyTxs()
+        {
+            // The txId stays the key, so each put replaces the old encoding in place
+            WriteBatch writeBatch;
+            stageStart = lastReport = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < legacyTxIds.size(); i++) {
+                const ConclaveTx& conclaveTx = txs[txIndexes.at(legacyTxIds[i])].second;
+                writeBatch.putEncodedItem(legacyTxIds[i], compact::serializeConclaveTx(conclaveTx));
+                flush(writeBatch, false);
+                reportProgress("re-encoded", i + 1, legacyTxIds.size());
+            }
+            flush(writeBatch, true);
+        }
+        
+        void Reindexer::applyAll(const std::vector<size_t>& order)
+        {
+            // Per-transaction state roots are recorded for this replay order. Independent transactions
+            // may replay in a different order than they were first submitted in, but the final root only
+            // depends on the resulting UTXO set and so always matches.
+            WriteBatch writeBatch;
+            StateTree stateTree(databaseClient, ConclaveChain::COLLECTION_STATE_TREE);
+            stageStart = lastReport = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < order.size(); i++) {
+                const std::pair<Hash256, ConclaveTx>& tx = txs[order[i]];
+                applyTx(writeBatch, stateTree, tx.first, tx.second);
+                flush(writeBatch, false);
+                if ((i + 1) % STATE_TREE_COMMIT_INTERVAL == 0) {
+                    stateTree.commit();
+                }
+                reportProgress("applied", i + 1, order.size());
+            }
+            flush(writeBatch, true);
+            stateTree.commit();
+            std::cout << "Reindex: state root " << stateTree.getRoot() << std::endl;
+        }
+        
+        void Reindexer::applyTx(WriteBatch& writeBatch, StateTree& stateTree,
+                                const Hash256& txId, const ConclaveTx& conclaveTx)
+        {
+            if (conclaveTx.isClaimTx()) {
+                writeBatch.putMutableItem(ConclaveChain::COLLECTION_CLAIMS, conclaveTx.fundPoint->getHash256(), txId);
+            }
+            for (uint32_t i = 0; i < conclaveTx.conclaveInputs.size(); i++) {
+                const Outpoint& outpoint = conclaveTx.conclaveInputs[i].outpoint;
+                const auto it = txIndexes.find(outpoint.txId);
+                CONCLAVE_ASSERT(it != txIndexes.end(), "can not find previous tx: " + std::string(outpoint.txId));
+                const ConclaveTx& prevTx = txs[it->second].second;
+                CONCLAVE_ASSERT(outpoint.index < prevTx.conclaveOutputs.size(),
+                                "index out of range: " + std::string(outpoint));
+                const Hash256 walletHash = prevTx.conclaveOutputs[outpoint.index].scriptPubKey.getHash256();
+                const Inpoint spendTip(txId, i);
+                writeBatch.putMutableItem(ConclaveChain::COLLECTION_SPENDS, outpoint.getHash256(), spendTip);
+                writeBatch.putMutableItem(ConclaveChain::COLLECTION_SPEND_TIPS, walletHash, spendTip);
+                stateTree.removeUtxo(outpoint);
+            }
+            for (uint32_t i = 0; i < conclaveTx.conclaveOutputs.size(); i++) {
+                const Hash256 walletHash = conclaveTx.conclaveOutputs[i].scriptPubKey.getHash256();
+                writeBatch.putMutableItem(ConclaveChain::COLLECTION_FUND_TIPS, walletHash, Outpoint(txId, i));
+                stateTree.addUtxo(Outpoint(txId, i), conclaveTx.conclaveOutputs[i]);
+            }
+            writeBatch.putMutableItem(ConclaveChain::COLLECTION_STATE_ROOTS, txId, stateTree.getRoot());
+        }
+        
+        void Reindexer::flush(WriteBatch& writeBatch, const bool force)
+        {
+            if (writeBatch.empty() || (!force && writeBatch.size() < WRITE_BATCH_SIZE)) {
+                return;
+            }
+            databaseClient.writeBatch(writeBatch);
+            writeBatch.clear();
+        }
+        
+        void Reindexer::reportProgress(const std::string& stage, const uint64_t done, const uint64_t total)
+        {
+            // total == 0 means the total is not known yet
+            const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            const bool finished = (total != 0 && done == total);
+            if (!finished && now - lastReport < PROGRESS_REPORT_INTERVAL) {
+                return;
+            }
+            lastReport = now;
+            const double seconds = std::max(std::chrono::duration<double>(now - stageStart).count(), 1e-3);
+            std::cout << "Reindex: " << stage << " " << done;
+            if (total != 0) {
+                std::cout << "/" << total;
+            }
+            std::cout << " (" << static_cast<uint64_t>(done / seconds) << "/s";
+            if (stage == "scanned") {
+                std::cout << ", " << std::fixed << std::setprecision(1)
+                          << (nBytesScanned / seconds) / (1024.0 * 1024.0) << " MB/s" << std::defaultfloat;
+            }
+            std::cout << ")" << std::endl;
+        }
+    }
+}
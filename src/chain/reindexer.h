@@ -0,0 +1,86 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "database/database_client.h"
+#include "database/write_batch.h"
+#include "state_tree.h"
+#include "../structs/conclave_tx.h"
+#include "../structs/compact_encoding.h"
+#include "../hash256.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+/***
+ * Rebuilds every derived index of the Conclave chain (claims, spends, spend tips, fund tips and
+ * the state tree) from the transactions stored in the database, and moves any transaction still stored in its
+ * consensus serialization over to the compact storage encoding. The key space is split into one range per thread;
+ * each thread walks its range with its own read-only cursor, hashing and decoding what it finds.
+ * The decoded transactions are then applied in dependency order through large write batches.
+ */
+
+namespace conclave
+{
+    namespace chain
+    {
+        using namespace database;
+        
+        class Reindexer final
+        {
+            public:
+            // Constructors
+            explicit Reindexer(DatabaseClient&);
+            Reindexer(DatabaseClient&, const unsigned int);
+            // Public Functions
+            void run();
+            private:
+            struct ScanResult
+            {
+                std::vector<std::pair<Hash256, ConclaveTx>> txs;
+                std::vector<Hash256> legacyTxIds;
+            };
+            // Private Functions
+            void scanPartition(const unsigned int, ScanResult&);
+            void classifyEntries(std::vector<Hash256>&, std::vector<std::vector<BYTE>>&, ScanResult&);
+            void scanAll();
+            const std::vector<size_t> sortByDependency() const;
+            void eraseDerivedEntries();
+            void eraseCollectionKeys(WriteBatch&, const std::string&, const std::vector<Hash256>&);
+            void reencodeLegacyTxs();
+            void applyAll(const std::vector<size_t>&);
+            void applyTx(WriteBatch&, StateTree&, const Hash256&, const ConclaveTx&);
+            void flush(WriteBatch&, const bool);
+            void reportProgress(const std::string&, const uint64_t, const uint64_t);
+            // Properties
+            DatabaseClient& databaseClient;
+            const unsigned int nThreads;
+            std::vector<std::pair<Hash256, ConclaveTx>> txs;
+            std::unordered_map<Hash256, size_t> txIndexes;
+            std::vector<Hash256> legacyTxIds;
+            std::atomic<uint64_t> nEntriesScanned;
+            std::atomic<uint64_t> nBytesScanned;
+            std::chrono::steady_clock::time_point stageStart;
+            std::chrono::steady_clock::time_point lastReport;
+        };
+    }
+}
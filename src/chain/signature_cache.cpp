@@ -0,0 +1,131 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "signature_cache.h"
+#include "../util/serialization.h"
+#include <mutex>
+
+namespace conclave
+{
+    namespace chain
+    {
+        //
+        // Factories
+        //
+        
+        Hash256 SignatureCache::makeEntry(const Hash256& sigHash, const PublicKey& publicKey,
+                                          const EcdsaSignature& signature)
+        {
+            Hash256Writer writer;
+            writeEntryPreimage(writer, sigHash, publicKey, signature);
+            return writer.getHash256();
+        }
+        
+        /***
+         * The bytes makeEntry() hashes, for callers which hash many entries at once with
+         * Hash256::digestMany().
+         */
+        std::vector<BYTE> SignatureCache::makeEntryPreimage(const Hash256& sigHash, const PublicKey& publicKey,
+                                                            const EcdsaSignature& signature)
+        {
+            std::vector<BYTE> preimage(ENTRY_PREIMAGE_SIZE_BYTES);
+            ByteBufferSink sink(preimage.data(), preimage.size());
+            writeEntryPreimage(sink, sigHash, publicKey, signature);
+            return preimage;
+        }
+        
+        /***
+         * Entry for a multisig input which verified. The preimage is 68 + 64m bytes, which never equals the size
+         * of a single signature entry's preimage, so the two kinds of entry can share the cache.
+         */
+        Hash256 SignatureCache::makeMultisigEntry(const Hash256& sigHash, const Hash256& trusteeSetId,
+                                                  const uint32_t minSigs, const std::vector<EcdsaSignature>& signatures)
+        {
+            Hash256Writer writer;
+            writer.write(sigHash, LARGE_HASH_SIZE_BYTES);
+            writer.write(trusteeSetId, LARGE_HASH_SIZE_BYTES);
+            writeIntegral(writer, minSigs);
+            for (const EcdsaSignature& signature: signatures) {
+                const auto signatureArray = static_cast<std::array<BYTE, ECDSA_SIGNATURE_SIZE_BYTES>>(signature);
+                writer.write(signatureArray.data(), signatureArray.size());
+            }
+            return writer.getHash256();
+        }
+        
+        //
+        // Constructors
+        //
+        
+        SignatureCache::SignatureCache(const size_t maxEntries)
+            : maxEntries(maxEntries)
+        {
+            entries.reserve(maxEntries);
+        }
+        
+        //
+        // Public Functions
+        //
+        
+        const bool SignatureCache::contains(const Hash256& entry) const
+        {
+            std::shared_lock<std::shared_mutex> lock(entriesMutex);
+            return entries.find(entry) != entries.end();
+        }
+        
+        void SignatureCache::insert(const Hash256& entry)
+        {
+            if (maxEntries == 0) {
+                return;
+            }
+            std::unique_lock<std::shared_mutex> lock(entriesMutex);
+            if (!entries.insert(entry).second) {
+                return;
+            }
+            insertionOrder.push_back(entry);
+            while (entries.size() > maxEntries) {
+                entries.erase(insertionOrder.front());
+                insertionOrder.pop_front();
+            }
+        }
+        
+        const size_t SignatureCache::size() const
+        {
+            std::shared_lock<std::shared_mutex> lock(entriesMutex);
+            return entries.size();
+        }
+        
+        const size_t SignatureCache::getMaxEntries() const
+        {
+            return maxEntries;
+        }
+        
+        //
+        // Private Functions
+        //
+        
+        void SignatureCache::writeEntryPreimage(ByteSink& sink, const Hash256& sigHash, const PublicKey& publicKey,
+                                                const EcdsaSignature& signature)
+        {
+            // The sighash goes in as-is rather than in its reversed serialized form
+            sink.write(sigHash, LARGE_HASH_SIZE_BYTES);
+            publicKey.serialize(sink);
+            const auto signatureArray = static_cast<std::array<BYTE, ECDSA_SIGNATURE_SIZE_BYTES>>(signature);
+            sink.write(signatureArray.data(), signatureArray.size());
+        }
+    }
+}
@@ -0,0 +1,72 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "../ecdsa_signature.h"
+#include "../hash256.h"
+#include "../public_key.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <unordered_set>
+#include <vector>
+
+/***
+ * Bounded, thread-safe set of (sighash, pubkey, signature) triples which are already known
+ * to verify. A transaction is usually verified more than once (mempool, resubmission,
+ * block replay) and ECDSA verification dominates the cost, so remembering good triples
+ * skips the repeat work. When full, the oldest entry is evicted.
+ *
+ * Multisig inputs are remembered the same way, as (sighash, trustee set, m, signatures).
+ */
+
+namespace conclave
+{
+    namespace chain
+    {
+        class SignatureCache final
+        {
+            public:
+            // Factories
+            static Hash256 makeEntry(const Hash256&, const PublicKey&, const EcdsaSignature&);
+            static std::vector<BYTE> makeEntryPreimage(const Hash256&, const PublicKey&, const EcdsaSignature&);
+            static Hash256 makeMultisigEntry(const Hash256&, const Hash256&, const uint32_t,
+                                             const std::vector<EcdsaSignature>&);
+            // Constructors
+            explicit SignatureCache(const size_t);
+            // Public Functions
+            const bool contains(const Hash256&) const;
+            void insert(const Hash256&);
+            const size_t size() const;
+            const size_t getMaxEntries() const;
+            private:
+            // Size of an entry preimage: sighash, compressed public key, then signature
+            const static size_t ENTRY_PREIMAGE_SIZE_BYTES =
+                LARGE_HASH_SIZE_BYTES + SECP256K1_PUBKEY_COMPRESSED_SIZE_BYTES + ECDSA_SIGNATURE_SIZE_BYTES;
+            // Private Functions
+            static void writeEntryPreimage(ByteSink&, const Hash256&, const PublicKey&, const EcdsaSignature&);
+            // Properties
+            const size_t maxEntries;
+            std::unordered_set<Hash256> entries;
+            std::deque<Hash256> insertionOrder;
+            mutable std::shared_mutex entriesMutex;
+        };
+    }
+}
@@ -0,0 +1,364 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "signature_verifier.h"
+#include "../hash160.h"
+#include <bitcoin/system.hpp>
+#include <algorithm>
+#include <future>
+
+namespace conclave
+{
+    namespace chain
+    {
+        //
+        // Constants
+        //
+        
+        const size_t SignatureVerifier::MIN_CHECKS_PER_TASK = 4;
+        const size_t SignatureVerifier::MAX_MULTISIG_VERIFIERS = 16;
+        
+        //
+        // Helpers
+        //
+        
+        inline static PublicKey parsePublicKey(const std::vector<BYTE>& data, const bool compressedOnly,
+                                               const size_t inputIndex)
+        {
+            if (data.size() == SECP256K1_PUBKEY_COMPRESSED_SIZE_BYTES && (data[0] == 0x02 || data[0] == 0x03)) {
+                std::array<BYTE, SECP256K1_PUBKEY_COMPRESSED_SIZE_BYTES> array{};
+                std::copy(data.begin(), data.end(), array.begin());
+                return PublicKey(array);
+            }
+            if (!compressedOnly && data.size() == SECP256K1_PUBKEY_UNCOMPRESSED_SIZE_BYTES && data[0] == 0x04) {
+                std::array<BYTE, SECP256K1_PUBKEY_UNCOMPRESSED_SIZE_BYTES> array{};
+                std::copy(data.begin(), data.end(), array.begin());
+                return PublicKey(array);
+            }
+            throw std::runtime_error("malformed public key in input " + std::to_string(inputIndex));
+        }
+        
+        inline static EcdsaSignature parseSignature(const std::vector<BYTE>& data, const size_t inputIndex)
+        {
+            bc::system::ec_signature signature;
+            if (!bc::system::parse_signature(signature, data, true)) {
+                throw std::runtime_error("malformed signature in input " + std::to_string(inputIndex));
+            }
+            return EcdsaSignature(signature);
+        }
+        
+        /***
+         * Pool tasks refer to the submitting frame's locals, so that frame must not unwind before
+         * they have all finished.
+         */
+        template<typename T>
+        inline static void waitForAll(std::vector<std::future<T>>& futures)
+        {
+            for (std::future<T>& future: futures) {
+                future.wait();
+            }
+        }
+        
+        //
+        // Factories
+        //
+        
+        /***
+         * Turns each input of a transaction into the signature check which authorizes it.
+         * Only inputs spending pay-to-pubkey-hash outputs (P2PKH and P2WPKH) reduce to a single
+         * check; multisig inputs are left to verifyTx().
+         * @param conclaveTx - The transaction whose inputs are to be checked
+         * @param prevOutputs - The outputs spent by the transaction's inputs, in input order
+         * @return - One signature check per input
+         */
+        std::vector<SignatureVerifier::SignatureCheck> SignatureVerifier::makeSignatureChecks(
+            const ConclaveTx& conclaveTx, const std::vector<ConclaveOutput>& prevOutputs)
+        {
+            CONCLAVE_ASSERT(conclaveTx.conclaveInputs.size() == prevOutputs.size(),
+                            "number of previous outputs does not match number of inputs");
+            const SigHashContext sigHashContext(conclaveTx);
+            std::vector<SignatureCheck> signatureChecks;
+            signatureChecks.reserve(prevOutputs.size());
+            for (size_t i = 0; i < prevOutputs.size(); i++) {
+                signatureChecks.push_back(makeSignatureCheck(sigHashContext, conclaveTx, i, prevOutputs[i]));
+            }
+            return signatureChecks;
+        }
+        
+        //
+        // Constructors
+        //
+        
+        /***
+         * @param numThreads - Total number of threads doing verification, including the calling
+         * thread. The pool itself is one thread smaller.
+         * @param cacheSize - Maximum number of entries in the signature cache
+         */
+        SignatureVerifier::SignatureVerifier(const unsigned int numThreads, const size_t cacheSize)
+            : numThreads(std::max(numThreads, 1u)), threadPool(std::max(numThreads, 1u) - 1),
+              signatureCache(cacheSize)
+        {
+        }
+        
+        //
+        // Public Functions
+        //
+        
+        /***
+         * Verifies a batch of signature checks. Checks found in the cache are skipped and the
+         * rest are split into contiguous chunks, one per thread, with the calling thread taking
+         * the last chunk. Checks which pass are added to the cache.
+         * @return - true if every check passes
+         */
+        const bool SignatureVerifier::verify(const std::vector<SignatureCheck>& signatureChecks)
+        {
+            std::vector<std::vector<BYTE>> cacheEntryPreimages;
+            cacheEntryPreimages.reserve(signatureChecks.size());
+            for (const SignatureCheck& signatureCheck: signatureChecks) {
+                cacheEntryPreimages.push_back(SignatureCache::makeEntryPreimage(
+                    signatureCheck.sigHash, signatureCheck.publicKey, signatureCheck.signature));
+            }
+            const std::vector<Hash256> cacheEntries = Hash256::digestMany(cacheEntryPreimages);
+            std::vector<size_t> pending;
+            for (size_t i = 0; i < signatureChecks.size(); i++) {
+                if (!signatureCache.contains(cacheEntries[i])) {
+                    pending.push_back(i);
+                }
+            }
+            if (pending.empty()) {
+                return true;
+            }
+            
+            std::vector<BYTE> results(signatureChecks.size(), 0);
+            const size_t maxTasks = (pending.size() + MIN_CHECKS_PER_TASK - 1) / MIN_CHECKS_PER_TASK;
+            const size_t numTasks = std::min<size_t>(numThreads, maxTasks);
+            const size_t checksPerTask = (pending.size() + numTasks - 1) / numTasks;
+            std::vector<std::future<void>> futures;
+            futures.reserve(numTasks - 1);
+            try {
+                for (size_t task = 0; task + 1 < numTasks; task++) {
+                    const size_t begin = task * checksPerTask;
+                    const size_t end = std::min(begin + checksPerTask, pending.size());
+                    futures.emplace_back(threadPool.submit([&signatureChecks, &pending, &results, begin, end] {
+                        verifyRange(signatureChecks, pending, begin, end, results);
+                    }));
+                }
+                verifyRange(signatureChecks, pending, std::min((numTasks - 1) * checksPerTask, pending.size()),
+                            pending.size(), results);
+            } catch (...) {
+                waitForAll(futures);
+                throw;
+            }
+            for (std::future<void>& future: futures) {
+                future.get();
+            }
+            
+            bool allValid = true;
+            for (const size_t i: pending) {
+                if (results[i]) {
+                    signatureCache.insert(cacheEntries[i]);
+                } else {
+                    allValid = false;
+                }
+            }
+            return allValid;
+        }
+        
+        void SignatureVerifier::verifyTx(const ConclaveTx& conclaveTx, const std::vector<ConclaveOutput>& prevOutputs)
+        {
+            CONCLAVE_ASSERT(conclaveTx.conclaveInputs.size() == prevOutputs.size(),
+                            "number of previous outputs does not match number of inputs");
+            const SigHashContext sigHashContext(conclaveTx);
+            std::vector<SignatureCheck> signatureChecks;
+            std::vector<MultisigCheck> multisigChecks;
+            signatureChecks.reserve(prevOutputs.size());
+            for (size_t i = 0; i < prevOutputs.size(); i++) {
+                const Script& scriptPubKey = prevOutputs[i].scriptPubKey;
+                if (scriptPubKey.isP2sh() || scriptPubKey.isP2wsh()) {
+                    multisigChecks.push_back(makeMultisigCheck(sigHashContext, conclaveTx, i, prevOutputs[i]));
+                } else {
+                    signatureChecks.push_back(makeSignatureCheck(sigHashContext, conclaveTx, i, prevOutputs[i]));
+                }
+            }
+            // The pool starts on the multisig inputs while this thread takes its share of the single signatures
+            std::vector<Hash256> cacheEntries;
+            std::vector<size_t> pending;
+            std::vector<std::future<bool>> futures;
+            bool signaturesValid;
+            try {
+                submitMultisigChecks(multisigChecks, cacheEntries, pending, futures);
+                signaturesValid = verify(signatureChecks);
+            } catch (...) {
+                waitForAll(futures);
+                throw;
+            }
+            // Every task refers to multisigChecks, so all of them must finish before anything is thrown
+            waitForAll(futures);
+            std::optional<size_t> invalidInput;
+            for (size_t i = 0; i < futures.size(); i++) {
+                if (futures[i].get()) {
+                    signatureCache.insert(cacheEntries[pending[i]]);
+                } else if (!invalidInput.has_value()) {
+                    invalidInput = multisigChecks[pending[i]].inputIndex;
+                }
+            }
+            CONCLAVE_ASSERT(!invalidInput.has_value(), "invalid multisig in input " + std::to_string(*invalidInput));
+            CONCLAVE_ASSERT(signaturesValid, "invalid input signature");
+        }
+        
+        //
+        // Private Functions
+        //
+        
+        /***
+         * A pay-to-pubkey-hash input's scriptSig must push exactly a DER signature followed by
+         * the public key.
+         */
+        SignatureVerifier::SignatureCheck SignatureVerifier::makeSignatureCheck(const SigHashContext& sigHashContext,
+                                                                                const ConclaveTx& conclaveTx,
+                                                                                const size_t inputIndex,
+                                                                                const ConclaveOutput& prevOutput)
+        {
+            const Script& scriptPubKey = prevOutput.scriptPubKey;
+            const std::optional<Hash160> p2pkhHash = scriptPubKey.getP2pkhHash();
+            const std::optional<Hash160> publicKeyHash = p2pkhHash.has_value()
+                                                         ? p2pkhHash
+                                                         : scriptPubKey.getP2wpkhHash();
+            CONCLAVE_ASSERT(publicKeyHash.has_value(),
+                            "input " + std::to_string(inputIndex) + " spends an unsupported scriptPubKey");
+            const std::optional<std::vector<std::vector<BYTE>>> pushedData =
+                conclaveTx.conclaveInputs[inputIndex].scriptSig.getPushedData();
+            CONCLAVE_ASSERT(pushedData.has_value() && pushedData->size() == 2,
+                            "malformed scriptSig in input " + std::to_string(inputIndex));
+            const std::vector<BYTE>& signatureData = (*pushedData)[0];
+            const std::vector<BYTE>& publicKeyData = (*pushedData)[1];
+            CONCLAVE_ASSERT(Hash160::digest(publicKeyData) == *publicKeyHash,
+                            "public key does not match scriptPubKey in input " + std::to_string(inputIndex));
+            return SignatureCheck{
+                sigHashContext.getSigHash(inputIndex, scriptPubKey, prevOutput.value),
+                parsePublicKey(publicKeyData, !p2pkhHash.has_value(), inputIndex),
+                parseSignature(signatureData, inputIndex)
+            };
+        }
+        
+        /***
+         * A script hash input's scriptSig must push the m signatures, in trustee order, followed
+         * by the redeem script. Unlike in bitcoin there is no dummy element for CHECKMULTISIG to
+         * pop. The redeem script takes the place of the scriptSig in the sighash.
+         */
+        SignatureVerifier::MultisigCheck SignatureVerifier::makeMultisigCheck(const SigHashContext& sigHashContext,
+                                                                              const ConclaveTx& conclaveTx,
+                                                                              const size_t inputIndex,
+                                                                              const ConclaveOutput& prevOutput)
+        {
+            const Script& scriptPubKey = prevOutput.scriptPubKey;
+            const std::optional<std::vector<std::vector<BYTE>>> pushedData =
+                conclaveTx.conclaveInputs[inputIndex].scriptSig.getPushedData();
+            CONCLAVE_ASSERT(pushedData.has_value() && !pushedData->empty(),
+                            "malformed scriptSig in input " + std::to_string(inputIndex));
+            const Script redeemScript(pushedData->back());
+            const bool redeemScriptMatches = scriptPubKey.isP2sh()
+                                             ? (redeemScript.getHash160() == *scriptPubKey.getP2shHash())
+                                             : (redeemScript.getSingleSHA256() == *scriptPubKey.getP2wshHash());
+            CONCLAVE_ASSERT(redeemScriptMatches,
+                            "redeem script does not match scriptPubKey in input " + std::to_string(inputIndex));
+            const std::optional<std::pair<uint32_t, std::vector<PublicKey>>> multisigParams =
+                redeemScript.getMultisigParams();
+            CONCLAVE_ASSERT(multisigParams.has_value(),
+                            "unsupported redeem script in input " + std::to_string(inputIndex));
+            std::vector<EcdsaSignature> signatures;
+            signatures.reserve(pushedData->size() - 1);
+            for (size_t i = 0; i + 1 < pushedData->size(); i++) {
+                signatures.push_back(parseSignature((*pushedData)[i], inputIndex));
+            }
+            const Hash256 trusteeSetId = MultisigVerifier::makeTrusteeSetId(multisigParams->second);
+            return MultisigCheck{
+                inputIndex,
+                sigHashContext.getSigHash(inputIndex, redeemScript, prevOutput.value),
+                trusteeSetId,
+                getMultisigVerifier(trusteeSetId, multisigParams->second),
+                std::move(signatures),
+                multisigParams->first
+            };
+        }
+        
+        /***
+         * Queues every multisig check which isn't in the cache, one task each since a check costs
+         * up to m signature recoveries. Without a pool the checks run on the calling thread when
+         * their results are asked for.
+         * @param cacheEntries - Filled with the cache entry of each check
+         * @param pending - Filled with the index of the check behind each future
+         * @param futures - Filled with one future per queued check. It belongs to the caller so that
+         * the checks already queued can be waited on if a later one fails to queue.
+         */
+        void SignatureVerifier::submitMultisigChecks(const std::vector<MultisigCheck>& multisigChecks,
+                                                     std::vector<Hash256>& cacheEntries, std::vector<size_t>& pending,
+                                                     std::vector<std::future<bool>>& futures)
+        {
+            for (size_t i = 0; i < multisigChecks.size(); i++) {
+                const MultisigCheck& multisigCheck = multisigChecks[i];
+                cacheEntries.push_back(SignatureCache::makeMultisigEntry(multisigCheck.sigHash,
+                                                                         multisigCheck.trusteeSetId,
+                                                                         multisigCheck.minSigs,
+                                                                         multisigCheck.signatures));
+                if (signatureCache.contains(cacheEntries.back())) {
+                    continue;
+                }
+                const auto verifyMultisig = [&multisigCheck] {
+                    return multisigCheck.multisigVerifier->verify(multisigCheck.sigHash, multisigCheck.signatures,
+                                                                  multisigCheck.minSigs);
+                };
+                pending.push_back(i);
+                futures.push_back(threadPool.size() > 0
+                                  ? threadPool.submit(verifyMultisig)
+                                  : std::async(std::launch::deferred, verifyMultisig));
+            }
+        }
+        
+        /***
+         * Returns the verifier for a trustee set, building it on first use. Only a handful of
+         * trustee sets are in use at any time so they are kept in a short FIFO list.
+         */
+        std::shared_ptr<const MultisigVerifier> SignatureVerifier::getMultisigVerifier(
+            const Hash256& trusteeSetId, const std::vector<PublicKey>& trustees)
+        {
+            std::lock_guard<std::mutex> lock(multisigVerifiersMutex);
+            for (const auto& entry: multisigVerifiers) {
+                if (entry.first == trusteeSetId) {
+                    return entry.second;
+                }
+            }
+            std::shared_ptr<const MultisigVerifier> multisigVerifier = std::make_shared<MultisigVerifier>(trustees);
+            multisigVerifiers.emplace_back(trusteeSetId, multisigVerifier);
+            if (multisigVerifiers.size() > MAX_MULTISIG_VERIFIERS) {
+                multisigVerifiers.pop_front();
+            }
+            return multisigVerifier;
+        }
+        
+        void SignatureVerifier::verifyRange(const std::vector<SignatureCheck>& signatureChecks,
+                                            const std::vector<size_t>& pending, const size_t begin, const size_t end,
+                                            std::vector<BYTE>& results)
+        {
+            for (size_t i = begin; i < end; i++) {
+                const SignatureCheck& signatureCheck = signatureChecks[pending[i]];
+                results[pending[i]] = signatureCheck.publicKey.verify(signatureCheck.sigHash, signatureCheck.signature);
+            }
+        }
+    }
+}
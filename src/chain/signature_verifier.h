@@ -0,0 +1,104 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "multisig_verifier.h"
+#include "signature_cache.h"
+#include "../structs/conclave_tx.h"
+#include "../structs/conclave_output.h"
+#include "../structs/sig_hash_context.h"
+#include "../util/thread_pool.h"
+#include "../ecdsa_signature.h"
+#include "../hash256.h"
+#include "../public_key.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/***
+ * Verifies the scriptSigs of Conclave transaction inputs. Each input is reduced to a
+ * signature check - (sighash, public key, signature) - and the checks which aren't
+ * already in the signature cache are spread over a pool of threads.
+ *
+ * Checks from several transactions may be concatenated and passed to verify() in one
+ * go, which keeps all threads busy even when individual transactions have few inputs.
+ *
+ * Inputs spending P2SH or P2WSH outputs must reveal an m-of-n multisig redeem script and
+ * are checked by a MultisigVerifier, kept per trustee set. They go through the same pool
+ * and cache, one task per input.
+ */
+
+namespace conclave
+{
+    namespace chain
+    {
+        class SignatureVerifier final
+        {
+            public:
+            struct SignatureCheck
+            {
+                Hash256 sigHash;
+                PublicKey publicKey;
+                EcdsaSignature signature;
+            };
+            struct MultisigCheck
+            {
+                size_t inputIndex;
+                Hash256 sigHash;
+                Hash256 trusteeSetId;
+                std::shared_ptr<const MultisigVerifier> multisigVerifier;
+                std::vector<EcdsaSignature> signatures;
+                uint32_t minSigs;
+            };
+            // Constants
+            const static size_t MIN_CHECKS_PER_TASK;
+            const static size_t MAX_MULTISIG_VERIFIERS;
+            // Factories
+            static std::vector<SignatureCheck> makeSignatureChecks(const ConclaveTx&,
+                                                                   const std::vector<ConclaveOutput>&);
+            // Constructors
+            SignatureVerifier(const unsigned int, const size_t);
+            // Public Functions
+            const bool verify(const std::vector<SignatureCheck>&);
+            void verifyTx(const ConclaveTx&, const std::vector<ConclaveOutput>&);
+            private:
+            // Private Functions
+            static SignatureCheck makeSignatureCheck(const SigHashContext&, const ConclaveTx&, const size_t,
+                                                     const ConclaveOutput&);
+            MultisigCheck makeMultisigCheck(const SigHashContext&, const ConclaveTx&, const size_t,
+                                            const ConclaveOutput&);
+            void submitMultisigChecks(const std::vector<MultisigCheck>&, std::vector<Hash256>&, std::vector<size_t>&,
+                                      std::vector<std::future<bool>>&);
+            std::shared_ptr<const MultisigVerifier> getMultisigVerifier(const Hash256&, const std::vector<PublicKey>&);
+            static void verifyRange(const std::vector<SignatureCheck>&, const std::vector<size_t>&,
+                                    const size_t, const size_t, std::vector<BYTE>&);
+            // Properties
+            const unsigned int numThreads;
+            ThreadPool threadPool;
+            SignatureCache signatureCache;
+            std::deque<std::pair<Hash256, std::shared_ptr<const MultisigVerifier>>> multisigVerifiers;
+            std::mutex multisigVerifiersMutex;
+        };
+    }
+}
@@ -0,0 +1,299 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "state_tree.h"
+#include "database/write_batch.h"
+#include "../util/serialization.h"
+#include <algorithm>
+#include <array>
+
+namespace conclave
+{
+    namespace chain
+    {
+        // Domain separation between leaf and branch preimages
+        const static BYTE LEAF_PREFIX = 0x00;
+        const static BYTE BRANCH_PREFIX = 0x01;
+        // How many erased nodes clear() holds before writing them out
+        const static size_t CLEAR_COMMIT_INTERVAL = 100000;
+        
+        static inline const bool getBit(const Hash256& key, const uint16_t index)
+        {
+            return (key[index / 8] >> (7 - (index % 8))) & 1;
+        }
+        
+        static inline const Hash256 withBit(const Hash256& key, const uint16_t index, const bool bit)
+        {
+            std::array<BYTE, LARGE_HASH_SIZE_BYTES> data = static_cast<std::array<BYTE, LARGE_HASH_SIZE_BYTES>>(key);
+            const BYTE mask = 1 << (7 - (index % 8));
+            data[index / 8] = bit ? (data[index / 8] | mask) : (data[index / 8] & ~mask);
+            return Hash256(data);
+        }
+        
+        //
+        // Node
+        //
+        
+        StateTree::Node StateTree::Node::deserialize(ByteReader& reader)
+        {
+            const bool isLeaf = reader.readIntegral<uint8_t>() != 0;
+            const Hash256 hash = Hash256::deserialize(reader);
+            if (isLeaf) {
+                return Node{hash, Hash256::deserialize(reader)};
+            }
+            return Node{hash, std::nullopt};
+        }
+        
+        StateTree::Node StateTree::Node::deserialize(const std::vector<BYTE>& data)
+        {
+            ByteReader reader(data);
+            return deserialize(reader);
+        }
+        
+        const bool StateTree::Node::isLeaf() const
+        {
+            return leafKey.has_value();
+        }
+        
+        const std::vector<BYTE> StateTree::Node::serialize() const
+        {
+            return serializeToByteVector(*this);
+        }
+        
+        void StateTree::Node::serialize(ByteSink& sink) const
+        {
+            writeIntegral<uint8_t>(sink, isLeaf() ? 1 : 0);
+            hash.serialize(sink);
+            if (isLeaf()) {
+                leafKey->serialize(sink);
+            }
+        }
+        
+        const size_t StateTree::Node::serializedSize() const
+        {
+            return UINT8_SIZE_BYTES + (isLeaf() ? 2 : 1) * LARGE_HASH_SIZE_BYTES;
+        }
+        
+        //
+        // Factories
+        //
+        
+        const Hash256 StateTree::makeLeafHash(const Hash256& key, const Hash256& valueHash)
+        {
+            Hash256Writer writer;
+            writer.write(&LEAF_PREFIX, 1);
+            writer.write(key, LARGE_HASH_SIZE_BYTES);
+            writer.write(valueHash, LARGE_HASH_SIZE_BYTES);
+            return writer.getHash256();
+        }
+        
+        const Hash256 StateTree::makeBranchHash(const Hash256& left, const Hash256& right)
+        {
+            Hash256Writer writer;
+            writer.write(&BRANCH_PREFIX, 1);
+            writer.write(left, LARGE_HASH_SIZE_BYTES);
+            writer.write(right, LARGE_HASH_SIZE_BYTES);
+            return writer.getHash256();
+        }
+        
+        const Hash256 StateTree::makeUtxoValueHash(const ConclaveOutput& conclaveOutput)
+        {
+            // The predecessor link is bookkeeping of this node's indexes, not ledger state
+            return ConclaveOutput(conclaveOutput.scriptPubKey, conclaveOutput.value).getHash256();
+        }
+        
+        //
+        // Constructors
+        //
+        
+        StateTree::StateTree(DatabaseClient& databaseClient, const std::string& collectionName)
+            : databaseClient(databaseClient), collectionName(collectionName)
+        {
+        }
+        
+        //
+        // Public Functions
+        //
+        
+        void StateTree::insert(const Hash256& key, const Hash256& valueHash)
+        {
+            const Node leaf{makeLeafHash(key, valueHash), key};
+            uint16_t depth = 0;
+            std::optional<Node> node = readNode(depth, key);
+            while (node.has_value() && !node->isLeaf()) {
+                node = readNode(++depth, key);
+            }
+            if (node.has_value() && *node->leafKey != key) {
+                // Push the existing leaf down to just below the first bit where the keys differ
+                const Hash256 otherKey = *node->leafKey;
+                while (getBit(key, depth) == getBit(otherKey, depth)) {
+                    depth++;
+                }
+                depth++;
+                writeNode(depth, otherKey, node);
+            }
+            writeNode(depth, key, leaf);
+            rehashPath(key, depth);
+        }
+        
+        void StateTree::erase(const Hash256& key)
+        {
+            uint16_t depth = 0;
+            std::optional<Node> node = readNode(depth, key);
+            while (node.has_value() && !node->isLeaf()) {
+                node = readNode(++depth, key);
+            }
+            if (!node.has_value() || *node->leafKey != key) {
+                return;
+            }
+            writeNode(depth, key, std::nullopt);
+            // A leaf left without a sibling moves up to take its parent's place
+            while (depth > 0) {
+                const Hash256 siblingKey = withBit(key, depth - 1, !getBit(key, depth - 1));
+                const std::optional<Node> current = readNode(depth, key);
+                const std::optional<Node> sibling = readNode(depth, siblingKey);
+                std::optional<Node> lone;
+                if (!current.has_value() && sibling.has_value() && sibling->isLeaf()) {
+                    lone = sibling;
+                    writeNode(depth, siblingKey, std::nullopt);
+                } else if (current.has_value() && current->isLeaf() && !sibling.has_value()) {
+                    lone = current;
+                    writeNode(depth, key, std::nullopt);
+                } else {
+                    break;
+                }
+                writeNode(--depth, key, lone);
+            }
+            rehashPath(key, depth);
+        }
+        
+        void StateTree::addUtxo(const Outpoint& outpoint, const ConclaveOutput& conclaveOutput)
+        {
+            insert(outpoint.getHash256(), makeUtxoValueHash(conclaveOutput));
+        }
+        
+        void StateTree::removeUtxo(const Outpoint& outpoint)
+        {
+            erase(outpoint.getHash256());
+        }
+        
+        const Hash256 StateTree::getRoot()
+        {
+            const std::optional<Node> root = readNode(0, EMPTY_ROOT);
+            return root.has_value() ? root->hash : EMPTY_ROOT;
+        }
+        
+        const std::optional<StateTree::Node> StateTree::getNode(const uint16_t depth, const Hash256& path)
+        {
+            CONCLAVE_ASSERT(depth <= 8 * LARGE_HASH_SIZE_BYTES, "State tree depth out of range");
+            return readNode(depth, path);
+        }
+        
+        /***
+         * Erases every node reachable from the root, leaving an empty tree, and commits
+         */
+        void StateTree::clear()
+        {
+            std::vector<std::pair<uint16_t, Hash256>> toVisit{{0, EMPTY_ROOT}};
+            while (!toVisit.empty()) {
+                const std::pair<uint16_t, Hash256> position = toVisit.back();
+                toVisit.pop_back();
+                const std::optional<Node> node = readNode(position.first, position.second);
+                if (!node.has_value()) {
+                    continue;
+                }
+                if (!node->isLeaf()) {
+                    toVisit.emplace_back(position.first + 1, withBit(position.second, position.first, false));
+                    toVisit.emplace_back(position.first + 1, withBit(position.second, position.first, true));
+                }
+                writeNode(position.first, position.second, std::nullopt);
+                if (pendingNodes.size() >= CLEAR_COMMIT_INTERVAL) {
+                    commit();
+                }
+            }
+            commit();
+        }
+        
+        void StateTree::commit()
+        {
+            WriteBatch writeBatch;
+            for (const std::pair<const Hash256, std::optional<Node>>& pendingNode : pendingNodes) {
+                if (pendingNode.second.has_value()) {
+                    writeBatch.putMutableItem(collectionName, pendingNode.first, pendingNode.second->serialize());
+                } else {
+                    writeBatch.erase(DatabaseClient::makeCollectionKey(collectionName, pendingNode.first));
+                }
+            }
+            if (!writeBatch.empty()) {
+                databaseClient.writeBatch(writeBatch);
+            }
+            pendingNodes.clear();
+        }
+        
+        //
+        // Private Functions
+        //
+        
+        const Hash256 StateTree::makeNodeId(const uint16_t depth, const Hash256& path) const
+        {
+            // Only the first depth bits of the path identify the node
+            BYTE pathPrefix[LARGE_HASH_SIZE_BYTES];
+            size_t pathPrefixSize = 0;
+            for (uint16_t i = 0; i < depth; i += 8) {
+                const uint16_t nBits = std::min<uint16_t>(8, depth - i);
+                pathPrefix[pathPrefixSize++] = path[i / 8] & static_cast<BYTE>(0xff << (8 - nBits));
+            }
+            Hash256Writer writer;
+            writeIntegral(writer, depth);
+            writer.write(pathPrefix, pathPrefixSize);
+            return writer.getHash256();
+        }
+        
+        const std::optional<StateTree::Node> StateTree::readNode(const uint16_t depth, const Hash256& path)
+        {
+            const Hash256 nodeId = makeNodeId(depth, path);
+            const auto it = pendingNodes.find(nodeId);
+            if (it != pendingNodes.end()) {
+                return it->second;
+            }
+            const std::optional<std::vector<BYTE>> nodeBV = databaseClient.getMutableItem(collectionName, nodeId);
+            if (!nodeBV.has_value()) {
+                return std::nullopt;
+            }
+            return Node::deserialize(*nodeBV);
+        }
+        
+        void StateTree::writeNode(const uint16_t depth, const Hash256& path, const std::optional<Node>& node)
+        {
+            pendingNodes.insert_or_assign(makeNodeId(depth, path), node);
+        }
+        
+        void StateTree::rehashPath(const Hash256& key, uint16_t depth)
+        {
+            // Recompute every branch from just above the given depth up to the root
+            while (depth > 0) {
+                depth--;
+                const std::optional<Node> left = readNode(depth + 1, withBit(key, depth, false));
+                const std::optional<Node> right = readNode(depth + 1, withBit(key, depth, true));
+                const Hash256 branchHash = makeBranchHash(left.has_value() ? left->hash : EMPTY_ROOT,
+                                                          right.has_value() ? right->hash : EMPTY_ROOT);
+                writeNode(depth, key, Node{branchHash, std::nullopt});
+            }
+        }
+    }
+}
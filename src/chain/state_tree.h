@@ -0,0 +1,97 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "database/database_client.h"
+#include "../structs/outpoint.h"
+#include "../structs/conclave_output.h"
+#include "../hash256.h"
+#include "../conclave.h"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+/***
+ * Compact sparse Merkle tree committing to the set of unspent Conclave outputs.
+ *
+ * Keys are outpoint hashes, read as a 256-bit path from the most significant bit down. A node at
+ * depth d covers every key sharing its first d bits: it is a branch if two or more keys share that
+ * prefix, a leaf if exactly one does (and its parent is a branch), and absent otherwise. The shape
+ * therefore depends only on the current key set, never on the order of updates, so two nodes
+ * holding the same UTXO set always agree on the root. With uniformly distributed keys a path is
+ * O(log n) nodes deep, which bounds the reads, writes and hashes of every insert and erase.
+ *
+ * Divergence between two nodes can be bisected with getNode(): compare the two children of any
+ * branch whose hashes differ, and descend into the one that differs until reaching a leaf.
+ */
+
+namespace conclave
+{
+    namespace chain
+    {
+        using namespace database;
+        
+        class StateTree final
+        {
+            public:
+            struct Node
+            {
+                // Factories
+                static Node deserialize(ByteReader&);
+                static Node deserialize(const std::vector<BYTE>&);
+                // Public Functions
+                const bool isLeaf() const;
+                const std::vector<BYTE> serialize() const;
+                void serialize(ByteSink&) const;
+                const size_t serializedSize() const;
+                // Properties
+                Hash256 hash;
+                std::optional<Hash256> leafKey;
+            };
+            // Empty tree root
+            constexpr static Hash256 EMPTY_ROOT{"0000000000000000000000000000000000000000000000000000000000000000"};
+            // Factories
+            static const Hash256 makeLeafHash(const Hash256&, const Hash256&);
+            static const Hash256 makeBranchHash(const Hash256&, const Hash256&);
+            static const Hash256 makeUtxoValueHash(const ConclaveOutput&);
+            // Constructors
+            StateTree(DatabaseClient&, const std::string&);
+            // Public Functions
+            void insert(const Hash256&, const Hash256&);
+            void erase(const Hash256&);
+            void addUtxo(const Outpoint&, const ConclaveOutput&);
+            void removeUtxo(const Outpoint&);
+            const Hash256 getRoot();
+            const std::optional<Node> getNode(const uint16_t, const Hash256&);
+            void clear();
+            void commit();
+            private:
+            // Private Functions
+            const Hash256 makeNodeId(const uint16_t, const Hash256&) const;
+            const std::optional<Node> readNode(const uint16_t, const Hash256&);
+            void writeNode(const uint16_t, const Hash256&, const std::optional<Node>&);
+            void rehashPath(const Hash256&, uint16_t);
+            // Properties
+            DatabaseClient& databaseClient;
+            const std::string collectionName;
+            std::unordered_map<Hash256, std::optional<Node>> pendingNodes;
+        };
+    }
+}
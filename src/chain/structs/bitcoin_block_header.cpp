@@ -39,15 +39,20 @@ namespace conclave
         // Factories
         //
         
+        BitcoinBlockHeader BitcoinBlockHeader::deserialize(ByteReader& reader)
+        {
+            const uint32_t version = reader.readIntegral<uint32_t>();
+            const Hash256 hashPrevBlock = Hash256::deserialize(reader);
+            const Hash256 hashMerkleRoot = Hash256::deserialize(reader);
+            const uint32_t time = reader.readIntegral<uint32_t>();
+            const uint32_t bits = reader.readIntegral<uint32_t>();
+            const uint32_t nonce = reader.readIntegral<uint32_t>();
+            return BitcoinBlockHeader(version, std::move(hashPrevBlock), std::move(hashMerkleRoot), time, bits, nonce);
+        }
+        
         BitcoinBlockHeader BitcoinBlockHeader::deserialize(const std::vector<BYTE>& data, size_t& pos)
         {
-            const uint32_t version = deserializeIntegral<uint32_t>(data, pos);
-            const Hash256 hashPrevBlock = Hash256::deserialize(data, pos);
-            const Hash256 hashMerkleRoot = Hash256::deserialize(data, pos);
-            const uint32_t time = deserializeIntegral<uint32_t>(data, pos);
-            const uint32_t bits = deserializeIntegral<uint32_t>(data, pos);
-            const uint32_t nonce = deserializeIntegral<uint32_t>(data, pos);
-            return BitcoinBlockHeader(version, std::move(hashPrevBlock), std::move(hashMerkleRoot), time, bits, nonce);
+            return deserializeFromByteVector<BitcoinBlockHeader>(data, pos);
         }
         
         BitcoinBlockHeader BitcoinBlockHeader::deserialize(const std::vector<BYTE>& data)
@@ -56,6 +61,19 @@ namespace conclave
             return deserialize(data, pos);
         }
         
+        /***
+         * Hashes a run of headers, such as a batch fetched while syncing, in one go.
+         */
+        std::vector<Hash256> BitcoinBlockHeader::getHash256s(const std::vector<BitcoinBlockHeader>& headers)
+        {
+            std::vector<std::vector<BYTE>> serializedHeaders;
+            serializedHeaders.reserve(headers.size());
+            for (const BitcoinBlockHeader& header : headers) {
+                serializedHeaders.push_back(header.serialize());
+            }
+            return Hash256::digestMany(serializedHeaders);
+        }
+        
         //
         // Constructors
         //
@@ -110,30 +128,29 @@ namespace conclave
         
         const Hash256 BitcoinBlockHeader::getHash256() const
         {
-            return Hash256::digest(serialize());
+            Hash256Writer writer;
+            serialize(writer);
+            return writer.getHash256();
         }
         
         const std::vector<BYTE> BitcoinBlockHeader::serialize() const
         {
-            const std::vector<BYTE> versionSerialized = serializeIntegral(version);
-            const std::vector<BYTE> hashPrevBlockSerialized = hashPrevBlock.serialize();
-            const std::vector<BYTE> hashMerkleRootSerialized = hashMerkleRoot.serialize();
-            const std::vector<BYTE> timeSerialized = serializeIntegral(time);
-            const std::vector<BYTE> bitsSerialized = serializeIntegral(bits);
-            const std::vector<BYTE> nonceSerialized = serializeIntegral(nonce);
-            std::vector<BYTE> serialized(
-                versionSerialized.size() + hashPrevBlockSerialized.size() +
-                hashMerkleRootSerialized.size() + timeSerialized.size() +
-                bitsSerialized.size() + nonceSerialized.size()
-            );
-            size_t pos = 0;
-            writeToByteVector(serialized, versionSerialized, pos);
-            writeToByteVector(serialized, hashPrevBlockSerialized, pos);
-            writeToByteVector(serialized, hashMerkleRootSerialized, pos);
-            writeToByteVector(serialized, timeSerialized, pos);
-            writeToByteVector(serialized, bitsSerialized, pos);
-            writeToByteVector(serialized, nonceSerialized, pos);
-            return serialized;
+            return serializeToByteVector(*this);
+        }
+        
+        void BitcoinBlockHeader::serialize(ByteSink& sink) const
+        {
+            writeIntegral(sink, version);
+            hashPrevBlock.serialize(sink);
+            hashMerkleRoot.serialize(sink);
+            writeIntegral(sink, time);
+            writeIntegral(sink, bits);
+            writeIntegral(sink, nonce);
+        }
+        
+        const size_t BitcoinBlockHeader::serializedSize() const
+        {
+            return sizeof(version) + 2 * LARGE_HASH_SIZE_BYTES + sizeof(time) + sizeof(bits) + sizeof(nonce);
         }
         
         //
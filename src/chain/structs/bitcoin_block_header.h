@@ -38,8 +38,10 @@ namespace conclave
             const static std::string JSONKEY_BITS;
             const static std::string JSONKEY_NONCE;
             // Factories
+            static BitcoinBlockHeader deserialize(ByteReader&);
             static BitcoinBlockHeader deserialize(const std::vector<BYTE>&, size_t&);
             static BitcoinBlockHeader deserialize(const std::vector<BYTE>&);
+            static std::vector<Hash256> getHash256s(const std::vector<BitcoinBlockHeader>&);
             // Constructors
             BitcoinBlockHeader(const uint32_t, const Hash256&, const Hash256&,
                                const uint32_t, const uint32_t, const uint32_t);
@@ -52,6 +54,8 @@ namespace conclave
             // Public Functions
             const Hash256 getHash256() const;
             const std::vector<BYTE> serialize() const;
+            void serialize(ByteSink&) const;
+            const size_t serializedSize() const;
             // Conversions
             explicit operator pt::ptree() const;
             explicit operator std::string() const;
@@ -42,20 +42,25 @@ namespace conclave
         // Factories
         //
         
-        ConclaveBlock ConclaveBlock::deserialize(const std::vector<BYTE>& data, size_t& pos)
-        {
-            uint64_t pot = deserializeIntegral<uint64_t>(data, pos);
-            uint64_t height = deserializeIntegral<uint64_t>(data, pos);
-            uint32_t epoch = deserializeIntegral<uint32_t>(data, pos);
-            Hash256 hashPrevBlock = Hash256::deserialize(data, pos);
-            Hash256 lowestParentBitcoinBlockHash = Hash256::deserialize(data, pos);
-            uint16_t txTypeId = deserializeIntegral<uint16_t>(data, pos);
-            uint16_t txVersion = deserializeIntegral<uint16_t>(data, pos);
-            Hash256 txHash = Hash256::deserialize(data, pos);
+        ConclaveBlock ConclaveBlock::deserialize(ByteReader& reader)
+        {
+            uint64_t pot = reader.readIntegral<uint64_t>();
+            uint64_t height = reader.readIntegral<uint64_t>();
+            uint32_t epoch = reader.readIntegral<uint32_t>();
+            Hash256 hashPrevBlock = Hash256::deserialize(reader);
+            Hash256 lowestParentBitcoinBlockHash = Hash256::deserialize(reader);
+            uint16_t txTypeId = reader.readIntegral<uint16_t>();
+            uint16_t txVersion = reader.readIntegral<uint16_t>();
+            Hash256 txHash = Hash256::deserialize(reader);
             return ConclaveBlock(pot, height, epoch, hashPrevBlock,
                                  lowestParentBitcoinBlockHash, txTypeId, txVersion, txHash);
         }
         
+        ConclaveBlock ConclaveBlock::deserialize(const std::vector<BYTE>& data, size_t& pos)
+        {
+            return deserializeFromByteVector<ConclaveBlock>(data, pos);
+        }
+        
         ConclaveBlock ConclaveBlock::deserialize(const std::vector<BYTE>& data)
         {
             size_t pos = 0;
@@ -112,34 +117,32 @@ namespace conclave
         
         const Hash256 ConclaveBlock::getHash256() const
         {
-            return Hash256::digest(serialize());
+            Hash256Writer writer;
+            serialize(writer);
+            return writer.getHash256();
         }
         
         const std::vector<BYTE> ConclaveBlock::serialize() const
         {
-            const std::vector<BYTE> potSerialized = serializeIntegral(pot);
-            const std::vector<BYTE> heightSerialized = serializeIntegral(height);
-            const std::vector<BYTE> epochSerialized = serializeIntegral(epoch);
-            const std::vector<BYTE> hashPrevBlockSerialized = hashPrevBlock.serialize();
-            const std::vector<BYTE> lowestParentBitcoinBlockHashSerialized = lowestParentBitcoinBlockHash.serialize();
-            const std::vector<BYTE> txTypeIdSerialized = serializeIntegral(txTypeId);
-            const std::vector<BYTE> txVersionSerialized = serializeIntegral(txVersion);
-            const std::vector<BYTE> txHashSerialized = txHash.serialize();
-            std::vector<BYTE> serialized(
-                potSerialized.size() + heightSerialized.size() + epochSerialized.size() +
-                hashPrevBlockSerialized.size() + lowestParentBitcoinBlockHashSerialized.size() +
-                txTypeIdSerialized.size() + txVersionSerialized.size() + txHashSerialized.size()
-            );
-            size_t pos = 0;
-            writeToByteVector(serialized, potSerialized, pos);
-            writeToByteVector(serialized, heightSerialized, pos);
-            writeToByteVector(serialized, epochSerialized, pos);
-            writeToByteVector(serialized, hashPrevBlockSerialized, pos);
-            writeToByteVector(serialized, lowestParentBitcoinBlockHashSerialized, pos);
-            writeToByteVector(serialized, txTypeIdSerialized, pos);
-            writeToByteVector(serialized, txVersionSerialized, pos);
-            writeToByteVector(serialized, txHashSerialized, pos);
-            return serialized;
+            return serializeToByteVector(*this);
+        }
+        
+        void ConclaveBlock::serialize(ByteSink& sink) const
+        {
+            writeIntegral(sink, pot);
+            writeIntegral(sink, height);
+            writeIntegral(sink, epoch);
+            hashPrevBlock.serialize(sink);
+            lowestParentBitcoinBlockHash.serialize(sink);
+            writeIntegral(sink, txTypeId);
+            writeIntegral(sink, txVersion);
+            txHash.serialize(sink);
+        }
+        
+        const size_t ConclaveBlock::serializedSize() const
+        {
+            return sizeof(pot) + sizeof(height) + sizeof(epoch) + sizeof(txTypeId) + sizeof(txVersion) +
+                   3 * LARGE_HASH_SIZE_BYTES;
         }
         
         //
@@ -41,6 +41,7 @@ namespace conclave
             const static std::string JSONKEY_TX_VERSION;
             const static std::string JSONKEY_TX_HASH;
             // Factories
+            static ConclaveBlock deserialize(ByteReader&);
             static ConclaveBlock deserialize(const std::vector<BYTE>&, size_t&);
             static ConclaveBlock deserialize(const std::vector<BYTE>&);
             // Constructors
@@ -53,6 +54,8 @@ namespace conclave
             // Public Functions
             const Hash256 getHash256() const;
             const std::vector<BYTE> serialize() const;
+            void serialize(ByteSink&) const;
+            const size_t serializedSize() const;
             // Conversions
             explicit operator pt::ptree() const;
             explicit operator std::string() const;
@@ -31,6 +31,8 @@ typedef unsigned char BYTE;
 #define STRING_TO_BYTE_VECTOR(str) std::vector<BYTE>(str.begin(), str.end())
 #define BYTE_VECTOR_TO_HEX(byteVector) byteVectorToHexString(byteVector)
 #define HEX_TO_BYTE_VECTOR(hex) hexStringToByteVector(hex)
+// Parses a hex string literal into a std::array at compile time, so a malformed literal fails the build
+#define HEX_LITERAL(hex) ([]() { constexpr auto bytes = hexLiteralToByteArray(hex); return bytes; }())
 // Sizes of things. In bytes.
 const static size_t UINT8_SIZE_BYTES = 1;
 const static size_t UINT16_SIZE_BYTES = 2;
@@ -47,10 +49,12 @@ const static size_t ECDSA_SIGNATURE_SIZE_BYTES = 64; // Not DER
 const static size_t ECDSA_SIGNATURE_DER_MAX_SIZE_BYTES = 72;
 
 template<size_t size>
-inline const std::array<BYTE, size> bytePointerToByteArray(const BYTE* ptr)
+constexpr std::array<BYTE, size> bytePointerToByteArray(const BYTE* ptr)
 {
-    std::array<BYTE, size> arr;
-    std::copy(ptr, ptr + size, arr.begin());
+    std::array<BYTE, size> arr{};
+    for (size_t i = 0; i < size; i++) {
+        arr[i] = ptr[i];
+    }
     return arr;
 }
 
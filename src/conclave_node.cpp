@@ -66,6 +66,11 @@ namespace conclave
         return privateKey.getPublicKey();
     }
     
+    const PrivateKey& ConclaveNode::getPrivateKey() const
+    {
+        return privateKey;
+    }
+    
     BitcoinChain& ConclaveNode::getBitcoinChain()
     {
         return bitcoinChain;
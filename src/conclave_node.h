@@ -41,6 +41,7 @@ namespace conclave
         [[nodiscard]] bool isTestnet() const;
         [[nodiscard]] const std::string getDisplayName() const;
         [[nodiscard]] const PublicKey getPublicKey() const;
+        [[nodiscard]] const PrivateKey& getPrivateKey() const;
         BitcoinChain& getBitcoinChain();
         ConclaveChain& getConclaveChain();
         private:
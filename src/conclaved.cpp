@@ -19,6 +19,8 @@
 #include "util/filesystem.h"
 #include "conclave_node.h"
 #include "config/config.h"
+#include "chain/database/database_client.h"
+#include "chain/reindexer.h"
 #include <boost/asio.hpp>
 #include <boost/program_options.hpp>
 #include <string>
@@ -49,7 +51,8 @@ int main(int argc, char** argv)
         std::cout << "Current path is: " << fs::current_path() << std::endl;
         desc.add_options()
                 ("help,h", "Help Screen")
-                ("config-file,c", value<std::string>(), "Config file");
+                ("config-file,c", value<std::string>(), "Config file")
+                ("reindex", "Rebuild the chain indexes from stored transactions before starting");
         
         // read variables map
         store(parse_command_line(argc, argv, desc), vm);
@@ -72,6 +75,13 @@ int main(int argc, char** argv)
         const Config config(configFilePath);
         std::cout << "Config loaded from " << configFilePath << std::endl;
         
+        // Reindex if requested. The database must be closed again before the node opens it.
+        if (vm.count("reindex")) {
+            conclave::chain::database::DatabaseClient databaseClient(
+                config.getConclaveChainConfig().getDatabaseClientConfig());
+            conclave::chain::Reindexer(databaseClient).run();
+        }
+        
         // Create the node
         ConclaveNode conclaveNode(config);
         
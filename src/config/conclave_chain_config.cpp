@@ -17,16 +17,28 @@
  */
 
 #include "conclave_chain_config.h"
+#include <thread>
 
 namespace pt = boost::property_tree;
 
+static const size_t DEFAULT_SIGNATURE_CACHE_SIZE = 100000;
+
 ConclaveChainConfig::ConclaveChainConfig(const pt::ptree& tree)
-    : databaseClientConfig(tree.get_child("Database"))
+    : databaseClientConfig(tree.get_child("Database")),
+      numVerifierThreads(tree.get<unsigned int>("NumVerifierThreads", std::thread::hardware_concurrency())),
+      signatureCacheSize(tree.get<size_t>("SignatureCacheSize", DEFAULT_SIGNATURE_CACHE_SIZE))
 {
 }
 
 ConclaveChainConfig::ConclaveChainConfig(const DatabaseClientConfig& databaseClientConfig)
-    : databaseClientConfig(databaseClientConfig)
+    : ConclaveChainConfig(databaseClientConfig, std::thread::hardware_concurrency(), DEFAULT_SIGNATURE_CACHE_SIZE)
+{
+}
+
+ConclaveChainConfig::ConclaveChainConfig(const DatabaseClientConfig& databaseClientConfig,
+                                         const unsigned int numVerifierThreads, const size_t signatureCacheSize)
+    : databaseClientConfig(databaseClientConfig), numVerifierThreads(numVerifierThreads),
+      signatureCacheSize(signatureCacheSize)
 {
 }
 
@@ -34,3 +46,13 @@ const DatabaseClientConfig& ConclaveChainConfig::getDatabaseClientConfig() const
 {
     return *databaseClientConfig;
 }
+
+unsigned int ConclaveChainConfig::getNumVerifierThreads() const
+{
+    return numVerifierThreads;
+}
+
+size_t ConclaveChainConfig::getSignatureCacheSize() const
+{
+    return signatureCacheSize;
+}
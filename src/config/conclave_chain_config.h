@@ -20,6 +20,7 @@
 
 #include "database_client_config.h"
 #include <boost/property_tree/ptree.hpp>
+#include <cstddef>
 #include <optional>
 
 namespace pt = boost::property_tree;
@@ -29,7 +30,12 @@ class ConclaveChainConfig
     public:
     ConclaveChainConfig(const pt::ptree&);
     ConclaveChainConfig(const DatabaseClientConfig&);
+    ConclaveChainConfig(const DatabaseClientConfig&, const unsigned int, const size_t);
     const DatabaseClientConfig& getDatabaseClientConfig() const;
+    unsigned int getNumVerifierThreads() const;
+    size_t getSignatureCacheSize() const;
     private:
     std::optional<DatabaseClientConfig> databaseClientConfig;
+    unsigned int numVerifierThreads;
+    size_t signatureCacheSize;
 };
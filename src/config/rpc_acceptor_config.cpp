@@ -22,12 +22,21 @@ namespace pt = boost::property_tree;
 
 RpcAcceptorConfig::RpcAcceptorConfig(const pt::ptree& tree)
     : ipAddress(tree.get<std::string>("IPAddress")),
-      port(tree.get<unsigned short>("Port"))
+      port(tree.get<unsigned short>("Port")),
+      idleTimeout(tree.get<unsigned int>("IdleTimeoutMs", 30000)),
+      maxRequestsPerConnection(tree.get<unsigned int>("MaxRequestsPerConnection", 1000))
 {
+    if (const boost::optional<unsigned short> opt = tree.get_optional<unsigned short>("BinaryPort")) {
+        binaryPort = *opt;
+    }
 }
 
-RpcAcceptorConfig::RpcAcceptorConfig(const std::string& ipAddress, const unsigned short port)
-    : ipAddress(ipAddress), port(port)
+RpcAcceptorConfig::RpcAcceptorConfig(const std::string& ipAddress, const unsigned short port,
+                                     const std::optional<unsigned short> binaryPort,
+                                     const std::chrono::milliseconds idleTimeout,
+                                     const unsigned int maxRequestsPerConnection)
+    : ipAddress(ipAddress), port(port), binaryPort(binaryPort), idleTimeout(idleTimeout),
+      maxRequestsPerConnection(maxRequestsPerConnection)
 {
 }
 
@@ -40,3 +49,18 @@ unsigned short RpcAcceptorConfig::getPort() const
 {
     return port;
 }
+
+const std::optional<unsigned short>& RpcAcceptorConfig::getBinaryPort() const
+{
+    return binaryPort;
+}
+
+std::chrono::milliseconds RpcAcceptorConfig::getIdleTimeout() const
+{
+    return idleTimeout;
+}
+
+unsigned int RpcAcceptorConfig::getMaxRequestsPerConnection() const
+{
+    return maxRequestsPerConnection;
+}
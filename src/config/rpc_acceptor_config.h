@@ -19,6 +19,9 @@
 #pragma once
 
 #include <boost/property_tree/ptree.hpp>
+#include <chrono>
+#include <optional>
+#include <string>
 
 namespace pt = boost::property_tree;
 
@@ -26,10 +29,22 @@ class RpcAcceptorConfig
 {
     public:
     RpcAcceptorConfig(const pt::ptree&);
-    RpcAcceptorConfig(const std::string&, const unsigned short);
+    RpcAcceptorConfig(const std::string&, const unsigned short,
+                      const std::optional<unsigned short> = std::nullopt,
+                      const std::chrono::milliseconds = std::chrono::milliseconds(30000),
+                      const unsigned int = 1000);
     const std::string& getIPAddress() const;
     unsigned short getPort() const;
+    const std::optional<unsigned short>& getBinaryPort() const;
+    std::chrono::milliseconds getIdleTimeout() const;
+    unsigned int getMaxRequestsPerConnection() const;
     private:
     std::string ipAddress;
     unsigned short port;
+    // The binary transport is only served when a port is given for it
+    std::optional<unsigned short> binaryPort;
+    // How long a kept-alive HTTP connection may sit with nothing in flight before it is closed
+    std::chrono::milliseconds idleTimeout;
+    // How many requests an HTTP connection may carry before it is closed
+    unsigned int maxRequestsPerConnection;
 };
@@ -22,12 +22,17 @@ namespace pt = boost::property_tree;
 
 RpcConfig::RpcConfig(const pt::ptree& tree)
     : numProcessors(tree.get<unsigned int>("NumProcessors")),
+      numSigners(tree.get<unsigned int>("NumSigners", 1)),
+      latestBlockRefreshInterval(tree.get<unsigned int>("LatestBlockRefreshMs", 5000)),
       rpcAcceptorConfig(tree.get_child("Acceptor"))
 {
 }
 
-RpcConfig::RpcConfig(const unsigned int numProcessors, const RpcAcceptorConfig& rpcAcceptorConfig)
-    : numProcessors(numProcessors), rpcAcceptorConfig(rpcAcceptorConfig)
+RpcConfig::RpcConfig(const unsigned int numProcessors, const unsigned int numSigners,
+                     const std::chrono::milliseconds latestBlockRefreshInterval,
+                     const RpcAcceptorConfig& rpcAcceptorConfig)
+    : numProcessors(numProcessors), numSigners(numSigners),
+      latestBlockRefreshInterval(latestBlockRefreshInterval), rpcAcceptorConfig(rpcAcceptorConfig)
 {
 }
 
@@ -36,6 +41,16 @@ unsigned int RpcConfig::getNumProcessors() const
     return numProcessors;
 }
 
+unsigned int RpcConfig::getNumSigners() const
+{
+    return numSigners;
+}
+
+std::chrono::milliseconds RpcConfig::getLatestBlockRefreshInterval() const
+{
+    return latestBlockRefreshInterval;
+}
+
 const RpcAcceptorConfig& RpcConfig::getRpcAcceptorConfig() const
 {
     return *rpcAcceptorConfig;
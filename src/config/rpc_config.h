@@ -20,6 +20,7 @@
 
 #include "rpc_acceptor_config.h"
 #include <boost/property_tree/ptree.hpp>
+#include <chrono>
 #include <optional>
 
 namespace pt = boost::property_tree;
@@ -28,10 +29,14 @@ class RpcConfig
 {
     public:
     RpcConfig(const pt::ptree&);
-    RpcConfig(const unsigned int, const RpcAcceptorConfig&);
+    RpcConfig(const unsigned int, const unsigned int, const std::chrono::milliseconds, const RpcAcceptorConfig&);
     unsigned int getNumProcessors() const;
+    unsigned int getNumSigners() const;
+    std::chrono::milliseconds getLatestBlockRefreshInterval() const;
     const RpcAcceptorConfig& getRpcAcceptorConfig() const;
     private:
     unsigned int numProcessors;
+    unsigned int numSigners;
+    std::chrono::milliseconds latestBlockRefreshInterval;
     std::optional<RpcAcceptorConfig> rpcAcceptorConfig;
 };
@@ -0,0 +1,156 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ripemd160.h"
+#include <cstdint>
+#include <cstring>
+
+namespace conclave
+{
+    namespace crypto
+    {
+        //
+        // Helpers
+        //
+        
+        const static size_t RIPEMD160_BLOCK_SIZE_BYTES = 64;
+        
+        // Message word and rotation for each of the 80 steps, left line then right line
+        const static BYTE LEFT_WORDS[80] = {
+            0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+            7, 4, 13, 1, 10, 6, 15, 3, 12, 0, 9, 5, 2, 14, 11, 8,
+            3, 10, 14, 4, 9, 15, 8, 1, 2, 7, 0, 6, 13, 11, 5, 12,
+            1, 9, 11, 10, 0, 8, 12, 4, 13, 3, 7, 15, 14, 5, 6, 2,
+            4, 0, 5, 9, 7, 12, 2, 10, 14, 1, 3, 8, 11, 6, 15, 13
+        };
+        const static BYTE RIGHT_WORDS[80] = {
+            5, 14, 7, 0, 9, 2, 11, 4, 13, 6, 15, 8, 1, 10, 3, 12,
+            6, 11, 3, 7, 0, 13, 5, 10, 14, 15, 8, 12, 4, 9, 1, 2,
+            15, 5, 1, 3, 7, 14, 6, 9, 11, 8, 12, 2, 10, 0, 4, 13,
+            8, 6, 4, 1, 3, 11, 15, 0, 5, 12, 2, 13, 9, 7, 10, 14,
+            12, 15, 10, 4, 1, 5, 8, 7, 6, 2, 13, 14, 0, 3, 9, 11
+        };
+        const static BYTE LEFT_ROTATIONS[80] = {
+            11, 14, 15, 12, 5, 8, 7, 9, 11, 13, 14, 15, 6, 7, 9, 8,
+            7, 6, 8, 13, 11, 9, 7, 15, 7, 12, 15, 9, 11, 7, 13, 12,
+            11, 13, 6, 7, 14, 9, 13, 15, 14, 8, 13, 6, 5, 12, 7, 5,
+            11, 12, 14, 15, 14, 15, 9, 8, 9, 14, 5, 6, 8, 6, 5, 12,
+            9, 15, 5, 11, 6, 8, 13, 12, 5, 12, 13, 14, 11, 8, 5, 6
+        };
+        const static BYTE RIGHT_ROTATIONS[80] = {
+            8, 9, 9, 11, 13, 15, 15, 5, 7, 7, 8, 11, 14, 14, 12, 6,
+            9, 13, 15, 7, 12, 8, 9, 11, 7, 7, 12, 7, 6, 15, 13, 11,
+            9, 7, 15, 11, 8, 6, 6, 14, 12, 13, 5, 14, 13, 13, 7, 5,
+            15, 5, 8, 11, 14, 14, 6, 14, 6, 9, 12, 9, 12, 5, 15, 8,
+            8, 5, 12, 9, 12, 5, 14, 6, 8, 13, 6, 5, 15, 13, 11, 11
+        };
+        const static uint32_t LEFT_CONSTANTS[5] = {0x00000000, 0x5a827999, 0x6ed9eba1, 0x8f1bbcdc, 0xa953fd4e};
+        const static uint32_t RIGHT_CONSTANTS[5] = {0x50a28be6, 0x5c4dd124, 0x6d703ef3, 0x7a6d76e9, 0x00000000};
+        
+        inline static uint32_t rotl(const uint32_t x, const int n)
+        {
+            return (x << n) | (x >> (32 - n));
+        }
+        
+        inline static uint32_t f(const size_t round, const uint32_t x, const uint32_t y, const uint32_t z)
+        {
+            switch (round) {
+                case 0:
+                    return x ^ y ^ z;
+                case 1:
+                    return (x & y) | (~x & z);
+                case 2:
+                    return (x | ~y) ^ z;
+                case 3:
+                    return (x & z) | (y & ~z);
+                default:
+                    return x ^ (y | ~z);
+            }
+        }
+        
+        static void transform(uint32_t* state, const BYTE* block)
+        {
+            uint32_t x[16];
+            for (size_t i = 0; i < 16; i++) {
+                const BYTE* word = block + 4 * i;
+                x[i] = uint32_t(word[0]) | (uint32_t(word[1]) << 8) | (uint32_t(word[2]) << 16) |
+                       (uint32_t(word[3]) << 24);
+            }
+            uint32_t al = state[0], bl = state[1], cl = state[2], dl = state[3], el = state[4];
+            uint32_t ar = al, br = bl, cr = cl, dr = dl, er = el;
+            for (size_t j = 0; j < 80; j++) {
+                const size_t round = j / 16;
+                uint32_t t = rotl(al + f(round, bl, cl, dl) + x[LEFT_WORDS[j]] + LEFT_CONSTANTS[round],
+                                  LEFT_ROTATIONS[j]) + el;
+                al = el;
+                el = dl;
+                dl = rotl(cl, 10);
+                cl = bl;
+                bl = t;
+                // The right line runs the boolean functions in reverse order
+                t = rotl(ar + f(4 - round, br, cr, dr) + x[RIGHT_WORDS[j]] + RIGHT_CONSTANTS[round],
+                         RIGHT_ROTATIONS[j]) + er;
+                ar = er;
+                er = dr;
+                dr = rotl(cr, 10);
+                cr = br;
+                br = t;
+            }
+            const uint32_t t = state[1] + cl + dr;
+            state[1] = state[2] + dl + er;
+            state[2] = state[3] + el + ar;
+            state[3] = state[4] + al + br;
+            state[4] = state[0] + bl + cr;
+            state[0] = t;
+        }
+        
+        //
+        // Hashing
+        //
+        
+        void ripemd160(const BYTE* data, const size_t size, BYTE* out)
+        {
+            uint32_t state[5] = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0};
+            const size_t nBodyBlocks = size / RIPEMD160_BLOCK_SIZE_BYTES;
+            for (size_t i = 0; i < nBodyBlocks; i++) {
+                transform(state, data + i * RIPEMD160_BLOCK_SIZE_BYTES);
+            }
+            // Same padding as SHA-256, except that the length is little-endian
+            const size_t remainder = size % RIPEMD160_BLOCK_SIZE_BYTES;
+            const size_t tailSize = (remainder + 9 <= RIPEMD160_BLOCK_SIZE_BYTES ? 1 : 2) * RIPEMD160_BLOCK_SIZE_BYTES;
+            BYTE tail[2 * RIPEMD160_BLOCK_SIZE_BYTES] = {};
+            if (remainder > 0) {
+                std::memcpy(tail, data + nBodyBlocks * RIPEMD160_BLOCK_SIZE_BYTES, remainder);
+            }
+            tail[remainder] = 0x80;
+            const uint64_t bitLength = uint64_t(size) * 8;
+            for (size_t i = 0; i < 8; i++) {
+                tail[tailSize - 8 + i] = BYTE(bitLength >> (8 * i));
+            }
+            for (size_t offset = 0; offset < tailSize; offset += RIPEMD160_BLOCK_SIZE_BYTES) {
+                transform(state, tail + offset);
+            }
+            for (size_t i = 0; i < 5; i++) {
+                out[4 * i] = BYTE(state[i]);
+                out[4 * i + 1] = BYTE(state[i] >> 8);
+                out[4 * i + 2] = BYTE(state[i] >> 16);
+                out[4 * i + 3] = BYTE(state[i] >> 24);
+            }
+        }
+    }
+}
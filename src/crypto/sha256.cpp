@@ -0,0 +1,460 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "sha256.h"
+#include "sha256_kernels.h"
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <string>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+namespace conclave
+{
+    namespace crypto
+    {
+        namespace kernels
+        {
+            const uint32_t SHA256_K[64] = {
+                0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+                0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+                0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+                0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+                0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+                0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+                0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+                0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+            };
+            
+            const uint32_t SHA256_INITIAL_STATE[8] = {
+                0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+            };
+            
+            inline static uint32_t rotr(const uint32_t x, const int n)
+            {
+                return (x >> n) | (x << (32 - n));
+            }
+            
+            void transformScalar(uint32_t* state, const BYTE* blocks, size_t nBlocks)
+            {
+                for (; nBlocks > 0; nBlocks--, blocks += SHA256_BLOCK_SIZE_BYTES) {
+                    uint32_t w[16];
+                    for (size_t t = 0; t < 16; t++) {
+                        const BYTE* word = blocks + 4 * t;
+                        w[t] = (uint32_t(word[0]) << 24) | (uint32_t(word[1]) << 16) |
+                               (uint32_t(word[2]) << 8) | uint32_t(word[3]);
+                    }
+                    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+                    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+                    for (size_t t = 0; t < 64; t++) {
+                        if (t >= 16) {
+                            const uint32_t w2 = w[(t - 2) & 15];
+                            const uint32_t w15 = w[(t - 15) & 15];
+                            w[t & 15] += (rotr(w2, 17) ^ rotr(w2, 19) ^ (w2 >> 10)) + w[(t - 7) & 15] +
+                                         (rotr(w15, 7) ^ rotr(w15, 18) ^ (w15 >> 3));
+                        }
+                        const uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) +
+                                            SHA256_K[t] + w[t & 15];
+                        const uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+                        h = g;
+                        g = f;
+                        f = e;
+                        e = d + t1;
+                        d = c;
+                        c = b;
+                        b = a;
+                        a = t1 + t2;
+                    }
+                    state[0] += a;
+                    state[1] += b;
+                    state[2] += c;
+                    state[3] += d;
+                    state[4] += e;
+                    state[5] += f;
+                    state[6] += g;
+                    state[7] += h;
+                }
+            }
+        }
+        
+        //
+        // Helpers
+        //
+        
+        using namespace kernels;
+        
+        struct CpuFeatures
+        {
+            bool sse41 = false;
+            bool avx2 = false;
+            bool avx512 = false;
+            bool shaNi = false;
+        };
+        
+        static const CpuFeatures detectCpuFeatures()
+        {
+            CpuFeatures cpuFeatures;
+#if defined(__x86_64__) || defined(__i386__)
+            uint32_t eax, ebx, ecx, edx;
+            if (__get_cpuid_max(0, nullptr) < 7) {
+                return cpuFeatures;
+            }
+            __cpuid_count(1, 0, eax, ebx, ecx, edx);
+            const bool ssse3 = (ecx >> 9) & 1;
+            cpuFeatures.sse41 = (ecx >> 19) & 1;
+            const bool osxsave = (ecx >> 27) & 1;
+            const bool avx = (ecx >> 28) & 1;
+            // The OS has to save the wider registers on context switch before we can use them
+            uint64_t xcr0 = 0;
+            if (osxsave) {
+                uint32_t xcr0Low, xcr0High;
+                __asm__("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+                xcr0 = (uint64_t(xcr0High) << 32) | xcr0Low;
+            }
+            __cpuid_count(7, 0, eax, ebx, ecx, edx);
+            cpuFeatures.avx2 = avx && ((xcr0 & 0x06) == 0x06) && ((ebx >> 5) & 1);
+            cpuFeatures.avx512 = cpuFeatures.avx2 && ((xcr0 & 0xE6) == 0xE6) && ((ebx >> 16) & 1);
+            cpuFeatures.shaNi = ssse3 && cpuFeatures.sse41 && ((ebx >> 29) & 1);
+#endif
+            return cpuFeatures;
+        }
+        
+        static const CpuFeatures& getCpuFeatures()
+        {
+            const static CpuFeatures cpuFeatures = detectCpuFeatures();
+            return cpuFeatures;
+        }
+        
+        inline static void writeDigest(const uint32_t* state, const size_t stride, BYTE* out)
+        {
+            for (size_t i = 0; i < 8; i++) {
+                const uint32_t word = state[i * stride];
+                out[4 * i] = BYTE(word >> 24);
+                out[4 * i + 1] = BYTE(word >> 16);
+                out[4 * i + 2] = BYTE(word >> 8);
+                out[4 * i + 3] = BYTE(word);
+            }
+        }
+        
+        /***
+         * A message split into whole blocks. The body is hashed in place and only the last partial
+         * block, plus the padding and length, is copied.
+         */
+        struct PaddedMessage
+        {
+            PaddedMessage(const BYTE* data, const size_t size)
+                : data(data), nBodyBlocks(size / SHA256_BLOCK_SIZE_BYTES)
+            {
+                const size_t remainder = size % SHA256_BLOCK_SIZE_BYTES;
+                nBlocks = nBodyBlocks + ((remainder + 9 <= SHA256_BLOCK_SIZE_BYTES) ? 1 : 2);
+                const size_t tailSize = (nBlocks - nBodyBlocks) * SHA256_BLOCK_SIZE_BYTES;
+                std::memset(tail, 0, tailSize);
+                if (remainder > 0) {
+                    std::memcpy(tail, data + nBodyBlocks * SHA256_BLOCK_SIZE_BYTES, remainder);
+                }
+                tail[remainder] = 0x80;
+                const uint64_t bitLength = uint64_t(size) * 8;
+                for (size_t i = 0; i < 8; i++) {
+                    tail[tailSize - 1 - i] = BYTE(bitLength >> (8 * i));
+                }
+            }
+            
+            const BYTE* getBlock(const size_t i) const
+            {
+                return i < nBodyBlocks
+                       ? data + i * SHA256_BLOCK_SIZE_BYTES
+                       : tail + (i - nBodyBlocks) * SHA256_BLOCK_SIZE_BYTES;
+            }
+            
+            const BYTE* data;
+            size_t nBodyBlocks;
+            size_t nBlocks;
+            BYTE tail[2 * SHA256_BLOCK_SIZE_BYTES];
+        };
+        
+        static void hashSingle(const PaddedMessage& message, BYTE* out, const bool shaNi)
+        {
+            uint32_t state[8];
+            std::memcpy(state, SHA256_INITIAL_STATE, sizeof(state));
+            const auto transform = shaNi ? transformShaNi : transformScalar;
+            transform(state, message.data, message.nBodyBlocks);
+            transform(state, message.tail, message.nBlocks - message.nBodyBlocks);
+            writeDigest(state, 1, out);
+        }
+        
+        /***
+         * Hashes LANES messages side by side. Lanes whose message runs out early keep computing
+         * garbage until the longest one finishes, which is why callers group messages of similar
+         * length together.
+         */
+        template<size_t LANES>
+        static void hashLanes(void (* transform)(uint32_t*, const BYTE* const*),
+                              const PaddedMessage* const* messages, BYTE* const* outs)
+        {
+            uint32_t states[8 * LANES];
+            size_t maxBlocks = 0;
+            for (size_t i = 0; i < 8; i++) {
+                std::fill(states + i * LANES, states + (i + 1) * LANES, SHA256_INITIAL_STATE[i]);
+            }
+            for (size_t lane = 0; lane < LANES; lane++) {
+                maxBlocks = std::max(maxBlocks, messages[lane]->nBlocks);
+            }
+            const BYTE* blocks[LANES];
+            for (size_t block = 0; block < maxBlocks; block++) {
+                for (size_t lane = 0; lane < LANES; lane++) {
+                    const PaddedMessage& message = *messages[lane];
+                    blocks[lane] = message.getBlock(std::min(block, message.nBlocks - 1));
+                }
+                transform(states, blocks);
+                for (size_t lane = 0; lane < LANES; lane++) {
+                    if (block + 1 == messages[lane]->nBlocks) {
+                        writeDigest(states + lane, LANES, outs[lane]);
+                    }
+                }
+            }
+        }
+        
+        template<size_t LANES>
+        static void hashAllLanes(void (* transform)(uint32_t*, const BYTE* const*),
+                                 const std::vector<PaddedMessage>& messages, const std::vector<size_t>& order,
+                                 BYTE* out, size_t& next)
+        {
+            const PaddedMessage* laneMessages[LANES];
+            BYTE* laneOuts[LANES];
+            for (; order.size() - next >= LANES; next += LANES) {
+                for (size_t lane = 0; lane < LANES; lane++) {
+                    laneMessages[lane] = &messages[order[next + lane]];
+                    laneOuts[lane] = out + order[next + lane] * SHA256_OUTPUT_SIZE_BYTES;
+                }
+                hashLanes<LANES>(transform, laneMessages, laneOuts);
+            }
+        }
+        
+        /***
+         * Buffers sha256Many() reuses from call to call on the same thread, so hashing a batch
+         * doesn't allocate once the buffers have grown to the usual batch size.
+         */
+        struct Sha256ManyScratch
+        {
+            // Beyond this many messages the buffers are freed after use rather than kept
+            const static size_t MAX_RETAINED_MESSAGES = 1024;
+            
+            void trim()
+            {
+                if (paddedMessages.capacity() > MAX_RETAINED_MESSAGES) {
+                    std::vector<PaddedMessage>().swap(paddedMessages);
+                    std::vector<size_t>().swap(order);
+                }
+            }
+            
+            std::vector<PaddedMessage> paddedMessages;
+            std::vector<size_t> order;
+        };
+        
+        static void hashMessages(const std::vector<PaddedMessage>& messages, std::vector<size_t>& order, BYTE* out,
+                                 const Sha256Kernel kernel)
+        {
+            // Longest first, so each group of lanes has messages of about the same length
+            order.resize(messages.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(), [&messages](const size_t a, const size_t b) {
+                return messages[a].nBlocks > messages[b].nBlocks;
+            });
+            size_t next = 0;
+            if (kernel == Sha256Kernel::Avx512) {
+                hashAllLanes<16>(transform16Way, messages, order, out, next);
+            }
+            if (kernel == Sha256Kernel::Avx512 || kernel == Sha256Kernel::Avx2) {
+                hashAllLanes<8>(transform8Way, messages, order, out, next);
+            }
+            if (kernel == Sha256Kernel::Avx512 || kernel == Sha256Kernel::Avx2 || kernel == Sha256Kernel::Sse41) {
+                hashAllLanes<4>(transform4Way, messages, order, out, next);
+            }
+            // Whatever is left over doesn't fill the lanes, so it goes through SHA-NI if available
+            const bool shaNi = kernel != Sha256Kernel::Scalar && sha256KernelSupported(Sha256Kernel::ShaNi);
+            for (; next < order.size(); next++) {
+                hashSingle(messages[order[next]], out + order[next] * SHA256_OUTPUT_SIZE_BYTES, shaNi);
+            }
+        }
+        
+        //
+        // Kernel Selection
+        //
+        
+        bool sha256KernelSupported(const Sha256Kernel kernel)
+        {
+            const CpuFeatures& cpuFeatures = getCpuFeatures();
+            switch (kernel) {
+                case Sha256Kernel::Scalar:
+                    return true;
+                case Sha256Kernel::Sse41:
+                    return SSE41_COMPILED && cpuFeatures.sse41;
+                case Sha256Kernel::Avx2:
+                    // Falls back to the narrower kernels for the last few messages
+                    return AVX2_COMPILED && SSE41_COMPILED && cpuFeatures.avx2 && cpuFeatures.sse41;
+                case Sha256Kernel::Avx512:
+                    return AVX512_COMPILED && sha256KernelSupported(Sha256Kernel::Avx2) && cpuFeatures.avx512;
+                case Sha256Kernel::ShaNi:
+                    return SHANI_COMPILED && cpuFeatures.shaNi;
+            }
+            return false;
+        }
+        
+        Sha256Kernel getBestSha256Kernel()
+        {
+            // For batches, 8 and 16 lanes beat SHA-NI's one message at a time, but 4 lanes don't
+            const static Sha256Kernel bestKernel = []() {
+                for (const Sha256Kernel kernel : {Sha256Kernel::Avx512, Sha256Kernel::Avx2,
+                                                  Sha256Kernel::ShaNi, Sha256Kernel::Sse41}) {
+                    if (sha256KernelSupported(kernel)) {
+                        return kernel;
+                    }
+                }
+                return Sha256Kernel::Scalar;
+            }();
+            return bestKernel;
+        }
+        
+        const char* sha256KernelName(const Sha256Kernel kernel)
+        {
+            switch (kernel) {
+                case Sha256Kernel::Scalar:
+                    return "scalar";
+                case Sha256Kernel::Sse41:
+                    return "sse4.1 4-way";
+                case Sha256Kernel::Avx2:
+                    return "avx2 8-way";
+                case Sha256Kernel::Avx512:
+                    return "avx512 16-way";
+                case Sha256Kernel::ShaNi:
+                    return "sha-ni";
+            }
+            return "unknown";
+        }
+        
+        //
+        // Hashing
+        //
+        
+        void sha256(const BYTE* data, const size_t size, BYTE* out)
+        {
+            hashSingle(PaddedMessage(data, size), out, sha256KernelSupported(Sha256Kernel::ShaNi));
+        }
+        
+        void sha256d(const BYTE* data, const size_t size, BYTE* out)
+        {
+            const bool shaNi = sha256KernelSupported(Sha256Kernel::ShaNi);
+            BYTE first[SHA256_OUTPUT_SIZE_BYTES];
+            hashSingle(PaddedMessage(data, size), first, shaNi);
+            hashSingle(PaddedMessage(first, SHA256_OUTPUT_SIZE_BYTES), out, shaNi);
+        }
+        
+        void sha256Many(const BYTE* const* messages, const size_t* sizes, const size_t count, BYTE* out,
+                        const bool doubleHash, const Sha256Kernel kernel)
+        {
+            CONCLAVE_ASSERT(sha256KernelSupported(kernel),
+                            std::string("SHA-256 kernel not supported: ") + sha256KernelName(kernel));
+            thread_local Sha256ManyScratch scratch;
+            std::vector<PaddedMessage>& paddedMessages = scratch.paddedMessages;
+            paddedMessages.clear();
+            for (size_t i = 0; i < count; i++) {
+                paddedMessages.emplace_back(messages[i], sizes[i]);
+            }
+            hashMessages(paddedMessages, scratch.order, out, kernel);
+            if (doubleHash) {
+                // The first digests are copied into the padded tails, so they can be overwritten in place
+                paddedMessages.clear();
+                for (size_t i = 0; i < count; i++) {
+                    paddedMessages.emplace_back(out + i * SHA256_OUTPUT_SIZE_BYTES, SHA256_OUTPUT_SIZE_BYTES);
+                }
+                hashMessages(paddedMessages, scratch.order, out, kernel);
+            }
+            scratch.trim();
+        }
+        
+        //
+        // Sha256Hasher
+        //
+        
+        Sha256Hasher::Sha256Hasher()
+            : transform(sha256KernelSupported(Sha256Kernel::ShaNi) ? transformShaNi : transformScalar)
+        {
+            reset();
+        }
+        
+        Sha256Hasher& Sha256Hasher::update(const BYTE* data, size_t size)
+        {
+            size_t buffered = nBytes % SHA256_BLOCK_SIZE_BYTES;
+            nBytes += size;
+            if (buffered > 0) {
+                const size_t fill = std::min(size, SHA256_BLOCK_SIZE_BYTES - buffered);
+                std::memcpy(buffer + buffered, data, fill);
+                data += fill;
+                size -= fill;
+                buffered += fill;
+                if (buffered < SHA256_BLOCK_SIZE_BYTES) {
+                    return *this;
+                }
+                transform(state, buffer, 1);
+            }
+            const size_t nBlocks = size / SHA256_BLOCK_SIZE_BYTES;
+            transform(state, data, nBlocks);
+            data += nBlocks * SHA256_BLOCK_SIZE_BYTES;
+            size -= nBlocks * SHA256_BLOCK_SIZE_BYTES;
+            if (size > 0) {
+                std::memcpy(buffer, data, size);
+            }
+            return *this;
+        }
+        
+        void Sha256Hasher::finalize(BYTE* out)
+        {
+            const size_t buffered = nBytes % SHA256_BLOCK_SIZE_BYTES;
+            const uint64_t bitLength = nBytes * 8;
+            buffer[buffered] = 0x80;
+            std::memset(buffer + buffered + 1, 0, SHA256_BLOCK_SIZE_BYTES - buffered - 1);
+            if (buffered + 9 > SHA256_BLOCK_SIZE_BYTES) {
+                transform(state, buffer, 1);
+                std::memset(buffer, 0, SHA256_BLOCK_SIZE_BYTES);
+            }
+            for (size_t i = 0; i < 8; i++) {
+                buffer[SHA256_BLOCK_SIZE_BYTES - 1 - i] = BYTE(bitLength >> (8 * i));
+            }
+            transform(state, buffer, 1);
+            writeDigest(state, 1, out);
+            reset();
+        }
+        
+        void Sha256Hasher::finalizeDouble(BYTE* out)
+        {
+            BYTE first[SHA256_OUTPUT_SIZE_BYTES];
+            finalize(first);
+            update(first, SHA256_OUTPUT_SIZE_BYTES);
+            finalize(out);
+        }
+        
+        void Sha256Hasher::reset()
+        {
+            std::memcpy(state, SHA256_INITIAL_STATE, sizeof(state));
+            nBytes = 0;
+        }
+    }
+}
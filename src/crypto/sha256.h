@@ -0,0 +1,88 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "../conclave.h"
+#include <cstddef>
+#include <cstdint>
+
+/***
+ * SHA-256 with runtime CPU dispatch. Single messages go through SHA-NI when the CPU has it and
+ * a portable implementation otherwise. Batches of independent messages can additionally be
+ * spread across the lanes of an SSE4.1 (4 lanes), AVX2 (8 lanes) or AVX-512 (16 lanes) kernel,
+ * one message per lane. getBestSha256Kernel() picks the fastest of those for batches.
+ */
+
+namespace conclave
+{
+    namespace crypto
+    {
+        const static size_t SHA256_BLOCK_SIZE_BYTES = 64;
+        const static size_t SHA256_OUTPUT_SIZE_BYTES = 32;
+        
+        enum class Sha256Kernel
+        {
+            Scalar,
+            Sse41,
+            Avx2,
+            Avx512,
+            ShaNi
+        };
+        
+        // Kernel Selection
+        bool sha256KernelSupported(const Sha256Kernel);
+        Sha256Kernel getBestSha256Kernel();
+        const char* sha256KernelName(const Sha256Kernel);
+        // Hashing
+        void sha256(const BYTE*, const size_t, BYTE*);
+        void sha256d(const BYTE*, const size_t, BYTE*);
+        /***
+         * Hashes `count` independent messages, writing the 32-byte digests back to back to `out`.
+         * Its working buffers are kept per thread and reused by later calls.
+         * @param messages - Pointers to the start of each message
+         * @param sizes - Size of each message in bytes
+         * @param doubleHash - Whether to hash each digest a second time (sha256d)
+         * @param kernel - The kernel to use. Must be supported by the CPU.
+         */
+        void sha256Many(const BYTE* const* messages, const size_t* sizes, const size_t count, BYTE* out,
+                        const bool doubleHash, const Sha256Kernel kernel = getBestSha256Kernel());
+        
+        /***
+         * Incremental SHA-256 for data that arrives in pieces. Whole blocks are compressed as soon
+         * as they are complete, so only the current partial block is ever buffered.
+         */
+        class Sha256Hasher final
+        {
+            public:
+            Sha256Hasher();
+            
+            Sha256Hasher& update(const BYTE*, const size_t);
+            // Both finalizers write 32 bytes to `out` and reset the hasher
+            void finalize(BYTE* out);
+            void finalizeDouble(BYTE* out);
+            void reset();
+            
+            private:
+            uint32_t state[8];
+            BYTE buffer[SHA256_BLOCK_SIZE_BYTES];
+            uint64_t nBytes;
+            void (* transform)(uint32_t*, const BYTE*, size_t);
+        };
+    }
+}
@@ -0,0 +1,61 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "sha256_kernels.h"
+
+#if defined(__AVX512F__)
+
+#include "sha256_multiway.h"
+
+namespace conclave
+{
+    namespace crypto
+    {
+        namespace kernels
+        {
+            typedef uint32_t Vector16 __attribute__((vector_size(64)));
+            
+            const bool AVX512_COMPILED = true;
+            
+            void transform16Way(uint32_t* states, const BYTE* const* blocks)
+            {
+                transformMultiway<Vector16, 16>(states, blocks);
+            }
+        }
+    }
+}
+
+#else
+
+namespace conclave
+{
+    namespace crypto
+    {
+        namespace kernels
+        {
+            // Built without AVX-512F support
+            const bool AVX512_COMPILED = false;
+            
+            void transform16Way(uint32_t*, const BYTE* const*)
+            {
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,57 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "sha256.h"
+#include "../conclave.h"
+#include <cstddef>
+#include <cstdint>
+
+/***
+ * Block transforms behind sha256.h. Each kernel lives in its own translation unit so it can be
+ * built for its instruction set without letting the compiler use that instruction set anywhere
+ * else. A kernel built without its instruction set (e.g. on a non-x86 target) sets its
+ * `_COMPILED` flag to false and must never be called.
+ */
+
+namespace conclave
+{
+    namespace crypto
+    {
+        namespace kernels
+        {
+            extern const uint32_t SHA256_K[64];
+            extern const uint32_t SHA256_INITIAL_STATE[8];
+            
+            // Single lane: process `nBlocks` consecutive 64-byte blocks
+            void transformScalar(uint32_t* state, const BYTE* blocks, size_t nBlocks);
+            extern const bool SHANI_COMPILED;
+            void transformShaNi(uint32_t* state, const BYTE* blocks, size_t nBlocks);
+            
+            // Multiple lanes: process one 64-byte block per lane. The lane states are interleaved
+            // word by word, so word `i` of lane `j` lives at states[i * LANES + j].
+            extern const bool SSE41_COMPILED;
+            void transform4Way(uint32_t* states, const BYTE* const* blocks);
+            extern const bool AVX2_COMPILED;
+            void transform8Way(uint32_t* states, const BYTE* const* blocks);
+            extern const bool AVX512_COMPILED;
+            void transform16Way(uint32_t* states, const BYTE* const* blocks);
+        }
+    }
+}
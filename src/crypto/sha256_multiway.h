@@ -0,0 +1,118 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "sha256_kernels.h"
+#include <cstring>
+
+/***
+ * Lane-parallel SHA-256 compression written once with GCC vector extensions. Each of
+ * sha256_sse41.cpp, sha256_avx2.cpp and sha256_avx512.cpp instantiates it with a vector as wide
+ * as its instruction set, and the compiler lowers the vector arithmetic to those instructions.
+ *
+ * Everything here is in an unnamed namespace on purpose: the same template built with different
+ * -m flags must never be merged by the linker.
+ */
+
+namespace conclave
+{
+    namespace crypto
+    {
+        namespace kernels
+        {
+            namespace
+            {
+                template<typename V>
+                inline V rotr(const V x, const int n)
+                {
+                    return (x >> n) | (x << (32 - n));
+                }
+                
+                template<typename V>
+                inline V bigSigma0(const V x)
+                {
+                    return rotr(x, 2) ^ rotr(x, 13) ^ rotr(x, 22);
+                }
+                
+                template<typename V>
+                inline V bigSigma1(const V x)
+                {
+                    return rotr(x, 6) ^ rotr(x, 11) ^ rotr(x, 25);
+                }
+                
+                template<typename V>
+                inline V smallSigma0(const V x)
+                {
+                    return rotr(x, 7) ^ rotr(x, 18) ^ (x >> 3);
+                }
+                
+                template<typename V>
+                inline V smallSigma1(const V x)
+                {
+                    return rotr(x, 17) ^ rotr(x, 19) ^ (x >> 10);
+                }
+                
+                inline uint32_t readBigEndian32(const BYTE* ptr)
+                {
+                    return (uint32_t(ptr[0]) << 24) | (uint32_t(ptr[1]) << 16) |
+                           (uint32_t(ptr[2]) << 8) | uint32_t(ptr[3]);
+                }
+                
+                template<typename V, size_t LANES>
+                inline void transformMultiway(uint32_t* states, const BYTE* const* blocks)
+                {
+                    V state[8];
+                    std::memcpy(state, states, sizeof(state));
+                    V w[16];
+                    for (size_t t = 0; t < 16; t++) {
+                        for (size_t lane = 0; lane < LANES; lane++) {
+                            w[t][lane] = readBigEndian32(blocks[lane] + 4 * t);
+                        }
+                    }
+                    V a = state[0], b = state[1], c = state[2], d = state[3];
+                    V e = state[4], f = state[5], g = state[6], h = state[7];
+                    for (size_t t = 0; t < 64; t++) {
+                        if (t >= 16) {
+                            w[t & 15] += smallSigma1(w[(t - 2) & 15]) + w[(t - 7) & 15] + smallSigma0(w[(t - 15) & 15]);
+                        }
+                        const V t1 = h + bigSigma1(e) + ((e & f) ^ (~e & g)) + SHA256_K[t] + w[t & 15];
+                        const V t2 = bigSigma0(a) + ((a & b) ^ (a & c) ^ (b & c));
+                        h = g;
+                        g = f;
+                        f = e;
+                        e = d + t1;
+                        d = c;
+                        c = b;
+                        b = a;
+                        a = t1 + t2;
+                    }
+                    state[0] += a;
+                    state[1] += b;
+                    state[2] += c;
+                    state[3] += d;
+                    state[4] += e;
+                    state[5] += f;
+                    state[6] += g;
+                    state[7] += h;
+                    std::memcpy(states, state, sizeof(state));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,100 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "sha256_kernels.h"
+
+#if defined(__SHA__) && defined(__SSE4_1__)
+
+#include <immintrin.h>
+
+namespace conclave
+{
+    namespace crypto
+    {
+        namespace kernels
+        {
+            const bool SHANI_COMPILED = true;
+            
+            /***
+             * The SHA extensions keep the state as two registers, ABEF and CDGH, and do two rounds
+             * per sha256rnds2. The message schedule is updated four words at a time with
+             * sha256msg1/sha256msg2.
+             */
+            void transformShaNi(uint32_t* state, const BYTE* blocks, size_t nBlocks)
+            {
+                const __m128i byteSwapMask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+                __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*) &state[0]), 0xB1);
+                __m128i cdgh = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*) &state[4]), 0x1B);
+                __m128i abef = _mm_alignr_epi8(tmp, cdgh, 8);
+                cdgh = _mm_blend_epi16(cdgh, tmp, 0xF0);
+                
+                for (; nBlocks > 0; nBlocks--, blocks += SHA256_BLOCK_SIZE_BYTES) {
+                    const __m128i abefSaved = abef;
+                    const __m128i cdghSaved = cdgh;
+                    __m128i msgs[4];
+                    for (int i = 0; i < 4; i++) {
+                        msgs[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (blocks + 16 * i)),
+                                                   byteSwapMask);
+                    }
+                    for (int group = 0; group < 16; group++) {
+                        // msgs[group & 3] still holds the words from four groups ago
+                        __m128i& msg = msgs[group & 3];
+                        if (group >= 4) {
+                            const __m128i& prev3 = msgs[(group + 1) & 3];
+                            const __m128i& prev2 = msgs[(group + 2) & 3];
+                            const __m128i& prev1 = msgs[(group + 3) & 3];
+                            msg = _mm_sha256msg2_epu32(
+                                _mm_add_epi32(_mm_sha256msg1_epu32(msg, prev3), _mm_alignr_epi8(prev1, prev2, 4)),
+                                prev1);
+                        }
+                        const __m128i wk = _mm_add_epi32(msg, _mm_loadu_si128((const __m128i*) &SHA256_K[4 * group]));
+                        cdgh = _mm_sha256rnds2_epu32(cdgh, abef, wk);
+                        abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(wk, 0x0E));
+                    }
+                    abef = _mm_add_epi32(abef, abefSaved);
+                    cdgh = _mm_add_epi32(cdgh, cdghSaved);
+                }
+                
+                tmp = _mm_shuffle_epi32(abef, 0x1B);
+                cdgh = _mm_shuffle_epi32(cdgh, 0xB1);
+                _mm_storeu_si128((__m128i*) &state[0], _mm_blend_epi16(tmp, cdgh, 0xF0));
+                _mm_storeu_si128((__m128i*) &state[4], _mm_alignr_epi8(cdgh, tmp, 8));
+            }
+        }
+    }
+}
+
+#else
+
+namespace conclave
+{
+    namespace crypto
+    {
+        namespace kernels
+        {
+            // Built without SHA extension support
+            const bool SHANI_COMPILED = false;
+            
+            void transformShaNi(uint32_t*, const BYTE*, size_t)
+            {
+            }
+        }
+    }
+}
+
+#endif
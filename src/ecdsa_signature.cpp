@@ -17,6 +17,7 @@
  */
 
 #include "ecdsa_signature.h"
+#include "util/serialization.h"
 #include <bitcoin/system.hpp>
 
 namespace bc_system = libbitcoin::system;
@@ -26,16 +27,24 @@ namespace conclave
     /// Factories
     ///
     
-    EcdsaSignature EcdsaSignature::deserialize(const std::vector<BYTE>& data, size_t& pos)
+    EcdsaSignature EcdsaSignature::deserialize(ByteReader& reader)
     {
-        // DER deserialization
-        const auto derSig =
-            std::vector<BYTE>(data.cbegin() + pos, data.cbegin() + pos + ECDSA_SIGNATURE_DER_MAX_SIZE_BYTES);
+        // DER deserialization: a sequence tag, the length of the rest, then the rest
+        const BYTE* header = reader.read(2);
+        const size_t bodySize = header[1];
+        CONCLAVE_ASSERT(bodySize + 2 <= ECDSA_SIGNATURE_DER_MAX_SIZE_BYTES, "DER signature too long");
+        const BYTE* body = reader.read(bodySize);
+        const bc_system::der_signature derSig(header, body + bodySize);
         bc_system::ec_signature sig;
         bc_system::parse_signature(sig, derSig, false);
         return static_cast<EcdsaSignature>(sig);
     }
     
+    EcdsaSignature EcdsaSignature::deserialize(const std::vector<BYTE>& data, size_t& pos)
+    {
+        return deserializeFromByteVector<EcdsaSignature>(data, pos);
+    }
+    
     EcdsaSignature EcdsaSignature::deserialize(const std::vector<BYTE>& data)
     {
         size_t pos = 0;
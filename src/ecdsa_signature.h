@@ -37,6 +37,7 @@ namespace conclave
     {
         public:
         // Factories
+        static EcdsaSignature deserialize(ByteReader&);
         static EcdsaSignature deserialize(const std::vector<BYTE>&, size_t&);
         static EcdsaSignature deserialize(const std::vector<BYTE>&);
         // Constructors
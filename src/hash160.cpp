@@ -17,10 +17,13 @@
  */
 
 #include "hash160.h"
+#include "crypto/ripemd160.h"
+#include "crypto/sha256.h"
 #include "util/random.h"
 #include "util/hex.h"
-#include <bitcoin/system.hpp>
+#include "util/serialization.h"
 #include <algorithm>
+#include <cstring>
 #include <string>
 
 namespace conclave
@@ -29,9 +32,18 @@ namespace conclave
     // Factories
     //
     
+    Hash160 Hash160::digest(const BYTE* data, const size_t size)
+    {
+        BYTE sha256Digest[LARGE_HASH_SIZE_BYTES];
+        std::array<BYTE, SMALL_HASH_SIZE_BYTES> hash;
+        crypto::sha256(data, size, sha256Digest);
+        crypto::ripemd160(sha256Digest, LARGE_HASH_SIZE_BYTES, hash.data());
+        return Hash160(hash);
+    }
+    
     Hash160 Hash160::digest(const std::vector<BYTE>& data)
     {
-        return static_cast<Hash160>(bc::system::bitcoin_short_hash(data));
+        return digest(data.data(), data.size());
     }
     
     Hash160 Hash160::digest(const std::string& str)
@@ -44,33 +56,48 @@ namespace conclave
         return digest(std::string(cStr));
     }
     
-    Hash160 Hash160::deserialize(const std::vector<BYTE>& data, size_t& pos)
+    /***
+     * Same as calling digest() on each message. The SHA256 half is batched across SIMD lanes;
+     * RIPEMD160 of the 32-byte results is cheap by comparison and done one at a time.
+     */
+    std::vector<Hash160> Hash160::digestMany(const std::vector<std::vector<BYTE>>& messages)
     {
-        std::array<BYTE, SMALL_HASH_SIZE_BYTES> arr;
-        std::copy(data.begin() + pos, data.begin() + pos + SMALL_HASH_SIZE_BYTES, arr.begin());
-        pos += SMALL_HASH_SIZE_BYTES;
-        return Hash160(arr);
+        std::vector<const BYTE*> data;
+        std::vector<size_t> sizes;
+        data.reserve(messages.size());
+        sizes.reserve(messages.size());
+        for (const std::vector<BYTE>& message : messages) {
+            data.push_back(message.data());
+            sizes.push_back(message.size());
+        }
+        std::vector<BYTE> digests(messages.size() * LARGE_HASH_SIZE_BYTES);
+        crypto::sha256Many(data.data(), sizes.data(), messages.size(), digests.data(), false);
+        std::vector<Hash160> hashes(messages.size());
+        for (size_t i = 0; i < messages.size(); i++) {
+            crypto::ripemd160(digests.data() + i * LARGE_HASH_SIZE_BYTES, LARGE_HASH_SIZE_BYTES, hashes[i].data.data());
+        }
+        return hashes;
     }
     
-    //
-    // Constructors
-    //
-    
-    Hash160::Hash160()
-        : data(makeRandomByteArray<SMALL_HASH_SIZE_BYTES>())
+    Hash160 Hash160::deserialize(ByteReader& reader)
     {
+        return Hash160(bytePointerToByteArray<SMALL_HASH_SIZE_BYTES>(reader.read(SMALL_HASH_SIZE_BYTES)));
     }
     
-    Hash160::Hash160(const std::array<BYTE, SMALL_HASH_SIZE_BYTES>& data)
-        : data(data)
+    Hash160 Hash160::deserialize(const std::vector<BYTE>& data, size_t& pos)
     {
+        return deserializeFromByteVector<Hash160>(data, pos);
     }
     
-    Hash160::Hash160(std::array<BYTE, SMALL_HASH_SIZE_BYTES>&& data)
-        : data(std::move(data))
+    Hash160 Hash160::random()
     {
+        return Hash160(makeRandomByteArray<SMALL_HASH_SIZE_BYTES>());
     }
     
+    //
+    // Constructors
+    //
+    
     Hash160::Hash160(const std::vector<BYTE>& data)
         : data(BYTE_VECTOR_TO_ARRAY(data, SMALL_HASH_SIZE_BYTES))
     {
@@ -81,26 +108,6 @@ namespace conclave
     {
     }
     
-    Hash160::Hash160(const BYTE* data)
-        : data(bytePointerToByteArray<SMALL_HASH_SIZE_BYTES>(data))
-    {
-    }
-    
-    Hash160::Hash160(const char* hex)
-        : Hash160(std::string(hex))
-    {
-    }
-    
-    Hash160::Hash160(const Hash160& other)
-        : data(other.data)
-    {
-    }
-    
-    Hash160::Hash160(Hash160&& other)
-        : data(std::move(other.data))
-    {
-    }
-    
     //
     // Public Functions
     //
@@ -157,26 +164,20 @@ namespace conclave
     // Operator Overloads
     //
     
-    Hash160& Hash160::operator=(const Hash160& other)
-    {
-        data = other.data;
-        return *this;
-    }
-    
-    Hash160& Hash160::operator=(Hash160&& other)
+    bool Hash160::operator==(const Hash160& other) const
     {
-        data = std::move(other.data);
-        return *this;
+        return std::memcmp(data.data(), other.data.data(), SMALL_HASH_SIZE_BYTES) == 0;
     }
     
-    bool Hash160::operator==(const Hash160& other) const
+    bool Hash160::operator!=(const Hash160& other) const
     {
-        return data == other.data;
+        return !(*this == other);
     }
     
-    bool Hash160::operator!=(const Hash160& other) const
+    bool Hash160::operator<(const Hash160& other) const
     {
-        return data != other.data;
+        // Same byte order as comparing the arrays
+        return std::memcmp(data.data(), other.data.data(), SMALL_HASH_SIZE_BYTES) < 0;
     }
     
     BYTE& Hash160::operator[](const size_t index) const
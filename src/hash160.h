@@ -19,8 +19,12 @@
 #pragma once
 
 #include "conclave.h"
+#include "util/byte_reader.h"
 #include <array>
+#include <cstring>
+#include <functional>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace conclave
@@ -29,20 +33,26 @@ namespace conclave
     {
         public:
         // Factories
+        static Hash160 random();
+        static Hash160 digest(const BYTE*, const size_t);
         static Hash160 digest(const std::vector<BYTE>&);
         static Hash160 digest(const std::string&);
         static Hash160 digest(const char*);
+        static std::vector<Hash160> digestMany(const std::vector<std::vector<BYTE>>&);
+        static Hash160 deserialize(ByteReader&);
         static Hash160 deserialize(const std::vector<BYTE>&, size_t&);
         // Constructors
-        Hash160();
-        Hash160(const std::array<BYTE, SMALL_HASH_SIZE_BYTES>&);
-        Hash160(std::array<BYTE, SMALL_HASH_SIZE_BYTES>&&);
+        // All zeros
+        Hash160() = default;
+        constexpr Hash160(const std::array<BYTE, SMALL_HASH_SIZE_BYTES>&);
+        constexpr Hash160(std::array<BYTE, SMALL_HASH_SIZE_BYTES>&&);
         Hash160(const std::vector<BYTE>&);
         Hash160(const std::string&);
-        Hash160(const BYTE*);
-        Hash160(const char*);
-        Hash160(const Hash160& other);
-        Hash160(Hash160&& other);
+        constexpr Hash160(const BYTE*);
+        // Exactly 40 hex digits. Parsed at compile time when initializing a constexpr Hash160.
+        constexpr Hash160(const char*);
+        Hash160(const Hash160&) = default;
+        Hash160(Hash160&&) = default;
         // Public Functions
         const Hash160 reversed() const;
         std::array<BYTE, SMALL_HASH_SIZE_BYTES>::const_iterator begin() const;
@@ -54,15 +64,60 @@ namespace conclave
         operator std::vector<BYTE>() const;
         operator const unsigned char*() const;
         // Operator Overloads
-        Hash160& operator=(const Hash160&);
-        Hash160& operator=(Hash160&&);
+        Hash160& operator=(const Hash160&) = default;
+        Hash160& operator=(Hash160&&) = default;
         bool operator==(const Hash160&) const;
         bool operator!=(const Hash160&) const;
+        bool operator<(const Hash160&) const;
         BYTE& operator[](const size_t) const;
         friend std::ostream& operator<<(std::ostream&, const Hash160&);
         friend Hash160 operator^(const Hash160&, const Hash160&);
         private:
         // Properties
-        std::array<BYTE, SMALL_HASH_SIZE_BYTES> data;
+        std::array<BYTE, SMALL_HASH_SIZE_BYTES> data{};
+    };
+    
+    //
+    // Constexpr Constructors
+    //
+    
+    constexpr Hash160::Hash160(const std::array<BYTE, SMALL_HASH_SIZE_BYTES>& data)
+        : data(data)
+    {
+    }
+    
+    constexpr Hash160::Hash160(std::array<BYTE, SMALL_HASH_SIZE_BYTES>&& data)
+        : data(std::move(data))
+    {
+    }
+    
+    constexpr Hash160::Hash160(const BYTE* data)
+        : data(bytePointerToByteArray<SMALL_HASH_SIZE_BYTES>(data))
+    {
+    }
+    
+    constexpr Hash160::Hash160(const char* hex)
+        : data(hexCStringToByteArray<SMALL_HASH_SIZE_BYTES>(hex))
+    {
+    }
+    
+    static_assert(std::is_trivially_copyable<Hash160>::value, "Hash160 should copy like a plain byte array");
+}
+
+namespace std
+{
+    template<>
+    struct hash<conclave::Hash160>
+    {
+        size_t operator()(const conclave::Hash160& hash) const noexcept
+        {
+            // Take the digest's first bytes, which are stored last, as Hash256 does. Those are uniformly
+            // distributed for every kind of hash, unlike the leading stored bytes of a block hash.
+            size_t ret;
+            const unsigned char* const tail =
+                static_cast<const unsigned char*>(hash) + SMALL_HASH_SIZE_BYTES - sizeof(ret);
+            std::memcpy(&ret, tail, sizeof(ret));
+            return ret;
+        }
     };
 }
@@ -19,8 +19,14 @@
 #pragma once
 
 #include "conclave.h"
+#include "crypto/sha256.h"
+#include "util/byte_reader.h"
+#include "util/byte_sink.h"
 #include <array>
+#include <cstring>
+#include <functional>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace conclave
@@ -29,40 +35,107 @@ namespace conclave
     {
         public:
         // Factories
+        static Hash256 random();
+        static Hash256 digest(const BYTE*, const size_t);
         static Hash256 digest(const std::vector<BYTE>&);
         static Hash256 digest(const std::string&);
         static Hash256 digest(const char*);
+        static std::vector<Hash256> digestMany(const std::vector<std::vector<BYTE>>&);
+        static Hash256 deserialize(ByteReader&);
         static Hash256 deserialize(const std::vector<BYTE>&, size_t&);
         // Constructors
-        Hash256();
-        Hash256(const std::array<BYTE, LARGE_HASH_SIZE_BYTES>&);
-        Hash256(std::array<BYTE, LARGE_HASH_SIZE_BYTES>&&);
+        // All zeros
+        Hash256() = default;
+        constexpr Hash256(const std::array<BYTE, LARGE_HASH_SIZE_BYTES>&);
+        constexpr Hash256(std::array<BYTE, LARGE_HASH_SIZE_BYTES>&&);
         Hash256(const std::vector<BYTE>&);
         Hash256(const std::string&);
-        Hash256(const BYTE*);
-        Hash256(const char*);
-        Hash256(const Hash256& other);
-        Hash256(Hash256&& other);
+        constexpr Hash256(const BYTE*);
+        // Exactly 64 hex digits. Parsed at compile time when initializing a constexpr Hash256.
+        constexpr Hash256(const char*);
+        Hash256(const Hash256&) = default;
+        Hash256(Hash256&&) = default;
         // Public Functions
         const Hash256 reversed() const;
         std::array<BYTE, LARGE_HASH_SIZE_BYTES>::const_iterator begin() const;
         std::array<BYTE, LARGE_HASH_SIZE_BYTES>::const_iterator end() const;
         const std::vector<BYTE> serialize() const;
+        void serialize(ByteSink&) const;
+        const size_t serializedSize() const;
         // Conversions
         operator std::string() const;
         operator std::array<BYTE, LARGE_HASH_SIZE_BYTES>() const;
         operator std::vector<BYTE>() const;
         operator const unsigned char*() const;
         // Operator Overloads
-        Hash256& operator=(const Hash256&);
-        Hash256& operator=(Hash256&&);
+        Hash256& operator=(const Hash256&) = default;
+        Hash256& operator=(Hash256&&) = default;
         bool operator==(const Hash256&) const;
         bool operator!=(const Hash256&) const;
+        bool operator<(const Hash256&) const;
         BYTE& operator[](const size_t) const;
         friend std::ostream& operator<<(std::ostream&, const Hash256&);
         friend Hash256 operator^(const Hash256&, const Hash256&);
         private:
         // Properties
-        std::array<BYTE, LARGE_HASH_SIZE_BYTES> data;
+        std::array<BYTE, LARGE_HASH_SIZE_BYTES> data{};
+    };
+    
+    //
+    // Constexpr Constructors
+    //
+    
+    constexpr Hash256::Hash256(const std::array<BYTE, LARGE_HASH_SIZE_BYTES>& data)
+        : data(data)
+    {
+    }
+    
+    constexpr Hash256::Hash256(std::array<BYTE, LARGE_HASH_SIZE_BYTES>&& data)
+        : data(std::move(data))
+    {
+    }
+    
+    constexpr Hash256::Hash256(const BYTE* data)
+        : data(bytePointerToByteArray<LARGE_HASH_SIZE_BYTES>(data))
+    {
+    }
+    
+    constexpr Hash256::Hash256(const char* hex)
+        : data(hexCStringToByteArray<LARGE_HASH_SIZE_BYTES>(hex))
+    {
+    }
+    
+    static_assert(std::is_trivially_copyable<Hash256>::value, "Hash256 should copy like a plain byte array");
+    
+    /***
+     * A ByteSink which double-SHA256s everything written to it, so that getHash256() gives the same result as
+     * Hash256::digest() over the concatenated writes without them ever being held in memory together.
+     */
+    class Hash256Writer final : public ByteSink
+    {
+        public:
+        void write(const BYTE*, const size_t) override;
+        // Resets the writer, so it can be reused for the next hash
+        Hash256 getHash256();
+        private:
+        crypto::Sha256Hasher hasher;
+    };
+}
+
+namespace std
+{
+    template<>
+    struct hash<conclave::Hash256>
+    {
+        size_t operator()(const conclave::Hash256& hash) const noexcept
+        {
+            // The bytes are stored reversed from the digest, and the leading stored bytes of a block hash are its
+            // proof-of-work zeros. The trailing ones are the digest's first bytes, which are uniformly distributed.
+            size_t ret;
+            const unsigned char* const tail =
+                static_cast<const unsigned char*>(hash) + LARGE_HASH_SIZE_BYTES - sizeof(ret);
+            std::memcpy(&ret, tail, sizeof(ret));
+            return ret;
+        }
     };
 }
@@ -30,7 +30,7 @@ namespace conclave
     /// Helpers
     ///
     
-    inline static Hash256 getY(const Hash256& x, const bool odd)
+    inline static Hash256 decompressY(const Hash256& x, const bool odd)
     {
         ec_compressed ecc;
         ec_uncompressed ecu;
@@ -44,55 +44,76 @@ namespace conclave
     /// Factories
     ///
     
-    PublicKey PublicKey::deserialize(const std::vector<BYTE>& data, size_t& pos)
+    PublicKey PublicKey::deserialize(ByteReader& reader)
     {
-        const auto leadingByte = deserializeIntegral<uint8_t>(data, pos);
+        const auto leadingByte = reader.readIntegral<uint8_t>();
         if (leadingByte < 0x04) {
             // Compressed
-            const Hash256 x = Hash256::deserialize(data, pos).reversed();
+            const Hash256 x = Hash256::deserialize(reader).reversed();
             return PublicKey(x, leadingByte == 0x03);
         } else {
             // Uncompressed
-            const Hash256 x = Hash256::deserialize(data, pos).reversed();
-            const Hash256 y = Hash256::deserialize(data, pos).reversed();
+            const Hash256 x = Hash256::deserialize(reader).reversed();
+            const Hash256 y = Hash256::deserialize(reader).reversed();
             return PublicKey(x, y);
         }
     }
     
+    PublicKey PublicKey::deserialize(const std::vector<BYTE>& data, size_t& pos)
+    {
+        return deserializeFromByteVector<PublicKey>(data, pos);
+    }
+    
     PublicKey PublicKey::deserialize(const std::vector<BYTE>& data)
     {
         size_t pos = 0;
         return deserialize(data, pos);
     }
     
+    /***
+     * Recovers the public key which produced the given signature over the given message.
+     * @param recoveryId - Which of the (up to four) candidate keys to recover, 0 to 3
+     * @return - The candidate key, or std::nullopt if it does not exist
+     */
+    std::optional<PublicKey> PublicKey::recover(const Hash256& message, const EcdsaSignature& signature,
+                                                const uint8_t recoveryId)
+    {
+        ec_uncompressed ecu;
+        const recoverable_signature recoverable{
+            static_cast<std::array<BYTE, ECDSA_SIGNATURE_SIZE_BYTES>>(signature), recoveryId
+        };
+        if (!recover_public(ecu, recoverable, static_cast<hash_digest>(message))) {
+            return std::nullopt;
+        }
+        return PublicKey(ecu);
+    }
+    
     ///
     /// Constructors
     ///
     
-    PublicKey::PublicKey(const PublicKey& other) = default;
+    PublicKey::PublicKey(const PublicKey& other)
+        : x(other.x), yOdd(other.yOdd), y(std::atomic_load(&other.y))
+    {
+    }
     
     PublicKey::PublicKey(PublicKey&& other) noexcept
-        : x(std::move(other.x)), y(std::move(other.y))
+        : x(std::move(other.x)), yOdd(other.yOdd), y(std::move(other.y))
     {
     }
     
     PublicKey::PublicKey(Hash256 x, Hash256 y)
-        : x(std::move(x)), y(std::move(y))
+        : x(std::move(x)), yOdd(y[SECP256K1_SCALAR_SIZE_BYTES - 1] & 1u), y(std::make_shared<const Hash256>(y))
     {
     }
     
     PublicKey::PublicKey(Hash256 x, bool odd)
-        : x(std::move(x)), y(getY(x, odd))
+        : x(std::move(x)), yOdd(odd), y(nullptr)
     {
     }
     
     PublicKey::PublicKey(const std::array<BYTE, SECP256K1_PUBKEY_UNCOMPRESSED_SIZE_BYTES>& data)
-        : x(&data[1]), y(&data[1 + SECP256K1_SCALAR_SIZE_BYTES])
-    {
-    }
-    
-    PublicKey::PublicKey(const std::array<BYTE, SECP256K1_PUBKEY_COMPRESSED_SIZE_BYTES>& data)
-        : x(&data[1]), y(getY(Hash256(&data[1]), data[0] == 0x03))
+        : PublicKey(Hash256(&data[1]), Hash256(&data[1 + SECP256K1_SCALAR_SIZE_BYTES]))
     {
     }
     
@@ -101,11 +122,6 @@ namespace conclave
     {
     }
     
-    PublicKey::PublicKey(const char* hex)
-        : PublicKey(std::string(hex))
-    {
-    }
-    
     ///
     /// Public Functions
     ///
@@ -149,9 +165,32 @@ namespace conclave
         return static_cast<std::vector<BYTE>>(*this);
     }
     
+    void PublicKey::serialize(ByteSink& sink) const
+    {
+        const auto array = static_cast<std::array<BYTE, SECP256K1_PUBKEY_COMPRESSED_SIZE_BYTES>>(*this);
+        sink.write(array.data(), array.size());
+    }
+    
+    const size_t PublicKey::serializedSize() const
+    {
+        return SECP256K1_PUBKEY_COMPRESSED_SIZE_BYTES;
+    }
+    
     bool PublicKey::yIsEven() const
     {
-        return y[sizeof(y) - 1] % 2;
+        return yOdd;
+    }
+    
+    bool PublicKey::verify(const Hash256& message, const EcdsaSignature& signature) const
+    {
+        const auto sig = static_cast<std::array<BYTE, ECDSA_SIGNATURE_SIZE_BYTES>>(signature);
+        if (std::atomic_load(&y)) {
+            return verify_signature(static_cast<std::array<BYTE, SECP256K1_PUBKEY_UNCOMPRESSED_SIZE_BYTES>>(*this),
+                                    static_cast<hash_digest>(message), sig);
+        }
+        // Let libsecp256k1 decompress the key rather than decompressing it twice
+        return verify_signature(static_cast<std::array<BYTE, SECP256K1_PUBKEY_COMPRESSED_SIZE_BYTES>>(*this),
+                                static_cast<hash_digest>(message), sig);
     }
     
     ///
@@ -160,17 +199,18 @@ namespace conclave
     
     PublicKey::operator std::array<BYTE, SECP256K1_PUBKEY_UNCOMPRESSED_SIZE_BYTES>() const
     {
+        const Hash256 fullY = getY();
         std::array<BYTE, SECP256K1_PUBKEY_UNCOMPRESSED_SIZE_BYTES> arr{};
         arr[0] = 0x04;
         std::copy(x.begin(), x.end(), arr.begin() + 1);
-        std::copy(y.begin(), y.end(), arr.begin() + 1 + SECP256K1_SCALAR_SIZE_BYTES);
+        std::copy(fullY.begin(), fullY.end(), arr.begin() + 1 + SECP256K1_SCALAR_SIZE_BYTES);
         return arr;
     }
     
     PublicKey::operator std::array<BYTE, SECP256K1_PUBKEY_COMPRESSED_SIZE_BYTES>() const
     {
         std::array<BYTE, SECP256K1_PUBKEY_COMPRESSED_SIZE_BYTES> arr{};
-        arr[0] = (y[SECP256K1_SCALAR_SIZE_BYTES - 1] & 1u) + 2u;
+        arr[0] = yOdd + 2u;
         std::copy(x.begin(), x.end(), arr.begin() + 1);
         return arr;
     }
@@ -194,23 +234,49 @@ namespace conclave
     /// Operator Overloads
     ///
     
-    PublicKey& PublicKey::operator=(const PublicKey& other) = default;
+    PublicKey& PublicKey::operator=(const PublicKey& other)
+    {
+        x = other.x;
+        yOdd = other.yOdd;
+        std::atomic_store(&y, std::atomic_load(&other.y));
+        return *this;
+    }
     
     PublicKey& PublicKey::operator=(PublicKey&& other) noexcept
     {
         x = std::move(other.x);
+        yOdd = other.yOdd;
         y = std::move(other.y);
         return *this;
     }
     
     bool PublicKey::operator==(const PublicKey& other) const
     {
-        return (x == other.x) && (y == other.y);
+        // x and the parity of y determine the point
+        return (x == other.x) && (yOdd == other.yOdd);
     }
     
     bool PublicKey::operator!=(const PublicKey& other) const
     {
-        return (x != other.x) || (y != other.y);
+        return (x != other.x) || (yOdd != other.yOdd);
+    }
+    
+    ///
+    /// Private Functions
+    ///
+    
+    /***
+     * Returns y, decompressing and caching it on first use. Concurrent first calls may
+     * each decompress, but they compute the same value and the cache is swapped in atomically.
+     */
+    Hash256 PublicKey::getY() const
+    {
+        std::shared_ptr<const Hash256> cached = std::atomic_load(&y);
+        if (!cached) {
+            cached = std::make_shared<const Hash256>(decompressY(x, yOdd));
+            std::atomic_store(&y, cached);
+        }
+        return *cached;
     }
     
     std::ostream& operator<<(std::ostream& os, const PublicKey& publicKey)
@@ -19,28 +19,40 @@
 #pragma once
 
 #include "conclave.h"
+#include "ecdsa_signature.h"
 #include "hash256.h"
 #include "hash160.h"
 #include <array>
+#include <memory>
+#include <optional>
 #include <string>
 
 namespace conclave
 {
+    /***
+     * secp256k1 public key, held in compressed form: x plus the parity of y. The full y
+     * coordinate costs a modular square root to compute, so it is only derived when an
+     * operation needs the uncompressed point, and is then cached. Keys built from an
+     * uncompressed point keep their y from the start.
+     */
     class PublicKey
     {
         public:
         // Factories
+        static PublicKey deserialize(ByteReader&);
         static PublicKey deserialize(const std::vector<BYTE>&, size_t&);
         static PublicKey deserialize(const std::vector<BYTE>&);
+        static std::optional<PublicKey> recover(const Hash256&, const EcdsaSignature&, const uint8_t);
         // Constructors
         PublicKey(const PublicKey&);
         PublicKey(PublicKey&&) noexcept;
         PublicKey(Hash256, Hash256);
         PublicKey(Hash256, bool);
-        explicit PublicKey(const std::array<BYTE, SECP256K1_PUBKEY_COMPRESSED_SIZE_BYTES>&);
+        constexpr explicit PublicKey(const std::array<BYTE, SECP256K1_PUBKEY_COMPRESSED_SIZE_BYTES>&);
         explicit PublicKey(const std::array<BYTE, SECP256K1_PUBKEY_UNCOMPRESSED_SIZE_BYTES>&);
         explicit PublicKey(const std::string&);
-        explicit PublicKey(const char*);
+        // Compressed key, exactly 66 hex digits
+        constexpr explicit PublicKey(const char*);
         // Public Functions
         [[nodiscard]] std::string asHexStringUncompressed() const;
         [[nodiscard]] std::string asHexStringCompressed() const;
@@ -49,7 +61,10 @@ namespace conclave
         [[nodiscard]] Hash256 getHash256Uncompressed() const;
         [[nodiscard]] Hash256 getHash256Compressed() const;
         [[nodiscard]] std::vector<BYTE> serialize() const;
+        void serialize(ByteSink&) const;
+        const size_t serializedSize() const;
         [[nodiscard]] bool yIsEven() const;
+        [[nodiscard]] bool verify(const Hash256&, const EcdsaSignature&) const;
         // Conversions
         explicit operator std::array<BYTE, SECP256K1_PUBKEY_COMPRESSED_SIZE_BYTES>() const;
         explicit operator std::array<BYTE, SECP256K1_PUBKEY_UNCOMPRESSED_SIZE_BYTES>() const;
@@ -62,8 +77,28 @@ namespace conclave
         bool operator!=(const PublicKey&) const;
         friend std::ostream& operator<<(std::ostream&, const PublicKey&);
         private:
+        // Private Functions
+        [[nodiscard]] Hash256 getY() const;
         // Properties
         Hash256 x;
-        Hash256 y;
+        bool yOdd;
+        mutable std::shared_ptr<const Hash256> y; // Lazily decompressed, accessed atomically
     };
+    
+    //
+    // Constexpr Constructors
+    //
+    
+    constexpr PublicKey::PublicKey(const std::array<BYTE, SECP256K1_PUBKEY_COMPRESSED_SIZE_BYTES>& data)
+        : x(&data[1]), yOdd(data[0] == 0x03), y(nullptr)
+    {
+        if (data[0] != 0x02 && data[0] != 0x03) {
+            throw std::runtime_error("Invalid compressed public key prefix");
+        }
+    }
+    
+    constexpr PublicKey::PublicKey(const char* hex)
+        : PublicKey(hexCStringToByteArray<SECP256K1_PUBKEY_COMPRESSED_SIZE_BYTES>(hex))
+    {
+    }
 }
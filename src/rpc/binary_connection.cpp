@@ -0,0 +1,127 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "binary_connection.h"
+#include "rpc_binary.h"
+
+namespace conclave
+{
+    namespace rpc
+    {
+        //
+        // Constructors
+        //
+        
+        BinaryConnection::BinaryConnection(struct mg_connection* conn, const RpcAcceptorConfig& rpcAcceptorConfig,
+                                           ConcurrentList<Request*>& requestQueue)
+            : conn(conn), idleTimeout(rpcAcceptorConfig.getIdleTimeout()),
+              maxRequests(rpcAcceptorConfig.getMaxRequestsPerConnection()), requestQueue(requestQueue),
+              lastActive(std::chrono::steady_clock::now())
+        {
+        }
+        
+        //
+        // Public Functions
+        //
+        
+        /***
+         * Called by the acceptor as each frame arrives in full, before it is parsed.
+         * @return - Whether the frame should be answered. Once the connection has taken its last request, later
+         *           frames are dropped and the connection closes after its last response.
+         */
+        bool BinaryConnection::startRequest()
+        {
+            if (!open || (maxRequests > 0 && numRequests >= maxRequests)) {
+                return false;
+            }
+            numRequests++;
+            lastActive = std::chrono::steady_clock::now();
+            return true;
+        }
+        
+        void BinaryConnection::queue(std::unique_ptr<Request> request)
+        {
+            request->tag = this;
+            inFlight++;
+            requestQueue.addToEnd(request.release());
+        }
+        
+        /***
+         * Answers a frame the acceptor couldn't make sense of straight away
+         */
+        void BinaryConnection::reject(const Hash256& requestHash, const std::string_view message)
+        {
+            if (open) {
+                const std::pmr::string frame = makeBinaryErrorFrame(requestHash, message);
+                mg_send(conn, frame.data(), frame.size());
+                closeIfDone();
+            }
+        }
+        
+        /***
+         * Called with a framed response, which the connection takes ownership of. Deletes the connection if it has
+         * closed and this was the last response it was waiting for.
+         */
+        void BinaryConnection::respond(Response* response)
+        {
+            if (open) {
+                const std::pmr::string& frame = response->getWrapped();
+                mg_send(conn, frame.data(), frame.size());
+                lastActive = std::chrono::steady_clock::now();
+            }
+            delete response;
+            inFlight--;
+            if (!open && inFlight == 0) {
+                delete this;
+                return;
+            }
+            closeIfDone();
+        }
+        
+        bool BinaryConnection::isIdle(const std::chrono::steady_clock::time_point now) const
+        {
+            return open && inFlight == 0 && now - lastActive >= idleTimeout;
+        }
+        
+        /***
+         * Called by the acceptor when mongoose closes the connection. Responses still in flight are thrown away as
+         * they arrive, and the last of them deletes the connection.
+         */
+        void BinaryConnection::close()
+        {
+            open = false;
+            if (inFlight == 0) {
+                delete this;
+            }
+        }
+        
+        //
+        // Private Functions
+        //
+        
+        /***
+         * Closes the connection, once what has been sent is flushed, when it has answered its last request
+         */
+        void BinaryConnection::closeIfDone()
+        {
+            if (open && maxRequests > 0 && numRequests >= maxRequests && inFlight == 0) {
+                conn->flags |= MG_F_SEND_AND_CLOSE;
+            }
+        }
+    }
+}
@@ -0,0 +1,72 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "methods/request.h"
+#include "methods/response.h"
+#include "../config/rpc_acceptor_config.h"
+#include "../mongoose/mongoose.h"
+#include "../util/concurrent_list.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+namespace conclave
+{
+    namespace rpc
+    {
+        /***
+         * State for one connection to the binary transport. Responses go back in whatever order they finish, but
+         * the connection may close while requests are still being processed, so it counts what is in flight and
+         * stays around until the last of those responses has been dropped.
+         *
+         * Like an HTTP connection, it is closed once it has been idle for the configured timeout, counting a frame
+         * that has only partly arrived as idle, and once it has answered its cap of requests.
+         *
+         * A connection is made when mongoose accepts it and deleted once it has closed with nothing left in flight.
+         * It is only used from the acceptor's event loop.
+         */
+        class BinaryConnection final
+        {
+            public:
+            // Constructors
+            BinaryConnection(struct mg_connection*, const RpcAcceptorConfig&, ConcurrentList<Request*>&);
+            // Public Functions
+            bool startRequest();
+            void queue(std::unique_ptr<Request>);
+            void reject(const Hash256&, const std::string_view);
+            void respond(Response*);
+            bool isIdle(const std::chrono::steady_clock::time_point) const;
+            void close();
+            private:
+            // Private Functions
+            void closeIfDone();
+            // Properties
+            struct mg_connection* const conn;
+            const std::chrono::milliseconds idleTimeout;
+            const unsigned int maxRequests;
+            ConcurrentList<Request*>& requestQueue;
+            bool open = true;
+            uint64_t numRequests = 0;
+            uint64_t inFlight = 0;
+            std::chrono::steady_clock::time_point lastActive;
+        };
+    }
+}
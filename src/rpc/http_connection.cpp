@@ -0,0 +1,160 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "http_connection.h"
+#include "rpc.h"
+
+namespace conclave
+{
+    namespace rpc
+    {
+        //
+        // Constructors
+        //
+        
+        HttpConnection::HttpConnection(struct mg_connection* conn, const RpcAcceptorConfig& rpcAcceptorConfig,
+                                       ConcurrentList<Request*>& requestQueue)
+            : conn(conn), idleTimeout(rpcAcceptorConfig.getIdleTimeout()),
+              maxRequests(rpcAcceptorConfig.getMaxRequestsPerConnection()), requestQueue(requestQueue),
+              lastActive(std::chrono::steady_clock::now())
+        {
+        }
+        
+        //
+        // Public Functions
+        //
+        
+        /***
+         * HTTP/1.1 connections are persistent unless the client says otherwise, HTTP/1.0 ones only if it asks
+         */
+        bool HttpConnection::wantsKeepAlive(const struct http_message& hm)
+        {
+            const struct mg_str* connection = mg_get_http_header(const_cast<struct http_message*>(&hm), "Connection");
+            if (connection != nullptr) {
+                if (mg_vcasecmp(connection, "close") == 0) {
+                    return false;
+                }
+                if (mg_vcasecmp(connection, "keep-alive") == 0) {
+                    return true;
+                }
+            }
+            return mg_vcmp(&hm.proto, "HTTP/1.1") == 0;
+        }
+        
+        /***
+         * Called by the acceptor as each request arrives, before it is parsed.
+         * @param keepAlive - Whether the client wants the connection kept open after this request
+         * @return - The request's place in the order of responses, or nothing if the connection has already
+         *           taken its last request
+         */
+        std::optional<uint64_t> HttpConnection::startRequest(const bool keepAlive)
+        {
+            if (!open || lastSequence.has_value()) {
+                return std::nullopt;
+            }
+            const uint64_t sequence = nextSequence++;
+            if (!keepAlive || (maxRequests > 0 && nextSequence >= maxRequests)) {
+                lastSequence = sequence;
+            }
+            lastActive = std::chrono::steady_clock::now();
+            return sequence;
+        }
+        
+        void HttpConnection::queue(std::unique_ptr<Request> request)
+        {
+            requestQueue.addToEnd(request.release());
+        }
+        
+        /***
+         * Answers a request the acceptor couldn't make sense of, in its turn
+         */
+        void HttpConnection::reject(const uint64_t sequence, const std::string& message)
+        {
+            waiting.emplace(sequence, Outgoing{nullptr, message});
+            sendReady();
+        }
+        
+        /***
+         * Called with a wrapped response, which the connection takes ownership of. Deletes the connection if it has
+         * closed and this was the last response it was waiting for.
+         */
+        void HttpConnection::respond(const uint64_t sequence, Response* response)
+        {
+            waiting.emplace(sequence, Outgoing{std::unique_ptr<Response>(response), std::string()});
+            sendReady();
+            if (!open && nextToSend == nextSequence) {
+                delete this;
+            }
+        }
+        
+        bool HttpConnection::isIdle(const std::chrono::steady_clock::time_point now) const
+        {
+            return open && nextToSend == nextSequence && now - lastActive >= idleTimeout;
+        }
+        
+        /***
+         * Called by the acceptor when mongoose closes the connection. Responses still in flight are thrown away as
+         * they arrive, and the last of them deletes the connection.
+         */
+        void HttpConnection::close()
+        {
+            open = false;
+            if (nextToSend == nextSequence) {
+                delete this;
+            }
+        }
+        
+        //
+        // Private Functions
+        //
+        
+        /***
+         * Sends every waiting response whose turn has come
+         */
+        void HttpConnection::sendReady()
+        {
+            bool sent = false;
+            for (auto it = waiting.begin(); it != waiting.end() && it->first == nextToSend; it = waiting.erase(it)) {
+                if (open) {
+                    send(it->second, lastSequence == nextToSend);
+                    sent = true;
+                }
+                nextToSend++;
+            }
+            if (sent) {
+                lastActive = std::chrono::steady_clock::now();
+            }
+        }
+        
+        void HttpConnection::send(const Outgoing& outgoing, const bool closing)
+        {
+            if (outgoing.response) {
+                const std::pmr::string& wrapped = outgoing.response->getWrapped();
+                mg_send_head(conn, 200, wrapped.size(), closing ? CLOSING_RESPONSE_HEADERS : RESPONSE_HEADERS);
+                mg_send(conn, wrapped.data(), wrapped.size());
+            } else {
+                mg_send_head(conn, 500, outgoing.error.size(),
+                             closing ? CLOSING_ERROR_RESPONSE_HEADERS : ERROR_RESPONSE_HEADERS);
+                mg_send(conn, outgoing.error.data(), outgoing.error.size());
+            }
+            if (closing) {
+                conn->flags |= MG_F_SEND_AND_CLOSE;
+            }
+        }
+    }
+}
@@ -0,0 +1,82 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "methods/request.h"
+#include "methods/response.h"
+#include "../config/rpc_acceptor_config.h"
+#include "../mongoose/mongoose.h"
+#include "../util/concurrent_list.h"
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace conclave
+{
+    namespace rpc
+    {
+        /***
+         * State for one kept-alive HTTP connection to the acceptor. Clients may pipeline requests down a connection
+         * without waiting for the responses, but the processors finish requests in any order. So each request is
+         * numbered as it arrives, and its response is held back until every earlier response has been sent.
+         *
+         * A connection is made when mongoose accepts it and deleted once it has closed with nothing left in flight.
+         * It is only used from the acceptor's event loop, which the dispatcher hands completed responses back to.
+         */
+        class HttpConnection final
+        {
+            public:
+            // Constructors
+            HttpConnection(struct mg_connection*, const RpcAcceptorConfig&, ConcurrentList<Request*>&);
+            // Public Functions
+            static bool wantsKeepAlive(const struct http_message&);
+            std::optional<uint64_t> startRequest(const bool);
+            void queue(std::unique_ptr<Request>);
+            void reject(const uint64_t, const std::string&);
+            void respond(const uint64_t, Response*);
+            bool isIdle(const std::chrono::steady_clock::time_point) const;
+            void close();
+            private:
+            // Either a response, or the message from a request the acceptor rejected
+            struct Outgoing
+            {
+                std::unique_ptr<Response> response;
+                std::string error;
+            };
+            // Private Functions
+            void sendReady();
+            void send(const Outgoing&, const bool);
+            // Properties
+            struct mg_connection* const conn;
+            const std::chrono::milliseconds idleTimeout;
+            const unsigned int maxRequests;
+            ConcurrentList<Request*>& requestQueue;
+            bool open = true;
+            // Set once the last request the connection will carry has arrived
+            std::optional<uint64_t> lastSequence;
+            uint64_t nextSequence = 0;
+            uint64_t nextToSend = 0;
+            std::map<uint64_t, Outgoing> waiting;
+            std::chrono::steady_clock::time_point lastActive;
+        };
+    }
+}
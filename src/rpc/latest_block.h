@@ -0,0 +1,89 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "../chain/structs/bitcoin_block_header.h"
+#include "../hash256.h"
+#include "../util/json_writer.h"
+#include "../util/serialization.h"
+#include <boost/property_tree/ptree.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace pt = boost::property_tree;
+namespace conclave
+{
+    namespace rpc
+    {
+        /***
+         * The Bitcoin chain tip as reported in the `latestBlock` field of every wrapped RPC response.
+         */
+        struct LatestBlock final
+        {
+            // Constructors
+            LatestBlock(const chain::BitcoinBlockHeader& header, const uint64_t height)
+                : hash(header.getHash256()), height(height), time(header.time)
+            {
+            }
+            
+            // Public Functions
+            const std::vector<BYTE> serialize() const
+            {
+                return serializeToByteVector(*this);
+            }
+            
+            void serialize(ByteSink& sink) const
+            {
+                hash.serialize(sink);
+                writeIntegral(sink, height);
+                writeIntegral(sink, time);
+            }
+            
+            const size_t serializedSize() const
+            {
+                return LARGE_HASH_SIZE_BYTES + sizeof(height) + sizeof(time);
+            }
+            
+            void writeJson(JsonWriter& writer) const
+            {
+                writer.startObject();
+                writer.key("time").number(time);
+                writer.key("hash").hex(hash, LARGE_HASH_SIZE_BYTES);
+                writer.key("height").number(height);
+                writer.endObject();
+            }
+            
+            // Conversions
+            explicit operator pt::ptree() const
+            {
+                pt::ptree tree;
+                tree.put("time", std::to_string(time));
+                tree.put("hash", static_cast<std::string>(hash));
+                tree.put<uint64_t>("height", height);
+                return tree;
+            }
+            
+            // Properties
+            const Hash256 hash;
+            const uint64_t height;
+            const uint32_t time;
+        };
+    }
+}
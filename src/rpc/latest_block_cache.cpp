@@ -0,0 +1,82 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "latest_block_cache.h"
+#include <iostream>
+
+namespace conclave
+{
+    namespace rpc
+    {
+        //
+        // Constructors
+        //
+        
+        LatestBlockCache::LatestBlockCache(chain::BitcoinChain& bitcoinChain,
+                                           const std::chrono::milliseconds refreshInterval)
+            : bitcoinChain(bitcoinChain), refreshInterval(refreshInterval), fetchedAt(0)
+        {
+        }
+        
+        //
+        // Public Functions
+        //
+        
+        const std::shared_ptr<const LatestBlock> LatestBlockCache::get()
+        {
+            std::shared_ptr<const LatestBlock> cached = std::atomic_load(&latestBlock);
+            if (!cached) {
+                std::lock_guard<std::mutex> lock(refreshMutex);
+                // Another caller may have fetched it while we were waiting
+                if (!std::atomic_load(&latestBlock)) {
+                    refresh();
+                }
+                return std::atomic_load(&latestBlock);
+            }
+            const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+            const auto age = std::chrono::steady_clock::duration(now - fetchedAt.load());
+            if (age >= refreshInterval) {
+                std::unique_lock<std::mutex> lock(refreshMutex, std::try_to_lock);
+                if (lock.owns_lock()) {
+                    // Back off for a full interval even if the fetch below fails
+                    fetchedAt = now;
+                    try {
+                        refresh();
+                        return std::atomic_load(&latestBlock);
+                    } catch (std::exception& e) {
+                        // Keep serving the stale tip rather than failing the response
+                        std::cout << "LatestBlockCache: refresh failed: " << e.what() << std::endl;
+                    }
+                }
+            }
+            return cached;
+        }
+        
+        //
+        // Private Functions
+        //
+        
+        void LatestBlockCache::refresh()
+        {
+            const std::pair<chain::BitcoinBlockHeader, uint64_t> tip = bitcoinChain.getLatestBlock();
+            std::atomic_store(&latestBlock, std::shared_ptr<const LatestBlock>(
+                std::make_shared<const LatestBlock>(tip.first, tip.second)));
+            fetchedAt = std::chrono::steady_clock::now().time_since_epoch().count();
+        }
+    }
+}
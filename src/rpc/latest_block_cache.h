@@ -0,0 +1,56 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "latest_block.h"
+#include "../chain/bitcoin_chain.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+namespace conclave
+{
+    namespace rpc
+    {
+        /***
+         * Holds the most recently fetched Bitcoin chain tip so that wrapping a response never costs
+         * an ElectrumX round trip. Once the cached tip is older than the refresh interval, the next
+         * caller to get() refreshes it while everyone else keeps using the stale copy. Only the very
+         * first call, when nothing is cached yet, waits on the fetch.
+         */
+        class LatestBlockCache final
+        {
+            public:
+            // Constructors
+            LatestBlockCache(chain::BitcoinChain&, const std::chrono::milliseconds);
+            // Public Functions
+            const std::shared_ptr<const LatestBlock> get();
+            private:
+            // Private Functions
+            void refresh();
+            // Properties
+            chain::BitcoinChain& bitcoinChain;
+            const std::chrono::milliseconds refreshInterval;
+            std::shared_ptr<const LatestBlock> latestBlock;
+            std::atomic<std::chrono::steady_clock::rep> fetchedAt;
+            std::mutex refreshMutex;
+        };
+    }
+}
@@ -0,0 +1,107 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "batch.h"
+
+namespace conclave
+{
+    namespace rpc
+    {
+        //
+        // Constructors
+        //
+        
+        Batch::Batch(const size_t nCalls, void* tag, const uint64_t sequence, const Hash256& requestHash,
+                     std::unique_ptr<Arena> arena)
+            : responses(nCalls), nOutstanding(nCalls), tag(tag), sequence(sequence), requestHash(requestHash),
+              arena(std::move(arena))
+        {
+        }
+        
+        //
+        // Public Functions
+        //
+        
+        /***
+         * Records the response to one call. Called from the processors, each for a different call.
+         * @return - The response for the whole batch when this was the last call outstanding, nullptr otherwise
+         */
+        Response* Batch::complete(const size_t index, Response* response)
+        {
+            responses[index].reset(response);
+            // The last one in sees every other processor's response
+            if (nOutstanding.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+                return nullptr;
+            }
+            // Nothing else touches the batch's arena any more, so the response can be built in it
+            const Arena::Scope scope(arena.get());
+            BatchResponse* batchResponse = new BatchResponse(std::move(responses));
+            batchResponse->tag = tag;
+            batchResponse->sequence = sequence;
+            batchResponse->requestHash = requestHash;
+            batchResponse->arena = std::move(arena);
+            return batchResponse;
+        }
+        
+        BatchResponse::BatchResponse(std::vector<std::unique_ptr<Response>>&& responses)
+            : Response(), responses(std::move(responses))
+        {
+            // A batch has no method of its own
+            methodName = "Batch";
+        }
+        
+        FailedCall::FailedCall(const std::string& reason)
+            : reason(reason)
+        {
+        }
+        
+        std::string_view FailedCall::getMethodName() const
+        {
+            return "Invalid";
+        }
+        
+        /***
+         * Throws, so that the processor answers the call with an error in its place in the batch
+         */
+        Response* FailedCall::handle(ConclaveNode&) const
+        {
+            throw std::runtime_error(reason);
+        }
+        
+        //
+        // Private Functions
+        //
+        
+        void BatchResponse::serialize()
+        {
+            size_t size = 2 + responses.size();
+            for (const std::unique_ptr<Response>& response : responses) {
+                size += response->getSerializedJson().size();
+            }
+            serializedJson.reserve(size);
+            serializedJson.push_back('[');
+            for (size_t i = 0; i < responses.size(); i++) {
+                if (i > 0) {
+                    serializedJson.push_back(',');
+                }
+                serializedJson.append(responses[i]->getSerializedJson());
+            }
+            serializedJson.push_back(']');
+        }
+    }
+}
@@ -0,0 +1,85 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "request.h"
+#include "response.h"
+#include "../../hash256.h"
+#include "../../util/arena.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace conclave
+{
+    namespace rpc
+    {
+        /***
+         * A JSON-RPC 2.0 batch: an array of calls sent in one HTTP request. The calls are queued as separate
+         * requests so that the processors can work through them in parallel, and their responses are collected
+         * here. Whichever processor finishes the last call assembles the single response for the whole batch.
+         */
+        class Batch final
+        {
+            public:
+            // Constructors
+            Batch(const size_t, void*, const uint64_t, const Hash256&, std::unique_ptr<Arena>);
+            // Public Functions
+            Response* complete(const size_t, Response*);
+            // Upper limit on the number of calls in one batch
+            constexpr static size_t MAX_CALLS = 1000;
+            private:
+            // Properties
+            std::vector<std::unique_ptr<Response>> responses;
+            std::atomic<size_t> nOutstanding;
+            void* tag;
+            const uint64_t sequence;
+            const Hash256 requestHash;
+            std::unique_ptr<Arena> arena;
+        };
+        
+        /***
+         * Stands in for a call in a batch that couldn't be made into a request, so that the call still gets its place
+         * in the batch's response. Handling it fails with the reason the call was rejected.
+         */
+        class FailedCall final : public Request
+        {
+            public:
+            explicit FailedCall(const std::string&);
+            std::string_view getMethodName() const override;
+            Response* handle(ConclaveNode&) const override;
+            private:
+            const std::string reason;
+        };
+        
+        /***
+         * The response to a batch: the responses to its calls, as a JSON array in the order of the calls
+         */
+        class BatchResponse final : public Response
+        {
+            public:
+            explicit BatchResponse(std::vector<std::unique_ptr<Response>>&&);
+            private:
+            void serialize() override;
+            const std::vector<std::unique_ptr<Response>> responses;
+        };
+    }
+}
@@ -19,10 +19,9 @@
 #pragma once
 
 #include "response.h"
-#include "../../util/json.h"
-#include <boost/property_tree/ptree.hpp>
+#include "../../util/json_writer.h"
+#include "../../util/serialization.h"
 
-namespace pt = boost::property_tree;
 namespace conclave
 {
     namespace rpc
@@ -32,30 +31,30 @@ namespace conclave
             class ErrorResponse : public Response
             {
                 public:
-                ErrorResponse(const RpcMethod& rpcMethod, const std::string& message)
-                    : rpcMethod(rpcMethod), message(message)
+                explicit ErrorResponse(const std::string& message)
+                    : message(message)
                 {
                 }
                 
-                RpcMethod getMethod() const override
+                bool isError() const override
                 {
-                    return rpcMethod;
+                    return true;
                 }
                 
-                const std::string& getMethodName() const override
+                private:
+                void serialize()
                 {
-                    return rpcMethodToString(rpcMethod);
+                    JsonWriter writer(serializedJson);
+                    writer.startObject();
+                    writer.key("message").string(message);
+                    writer.endObject();
                 }
                 
-                private:
-                void serialize()
+                void serializeBinary(ByteSink& sink) const override
                 {
-                    pt::ptree tree;
-                    tree.put("message", message);
-                    serializedJson = ptreeToString(tree);
+                    writeVarString(sink, message);
                 }
                 
-                const RpcMethod rpcMethod;
                 const std::string message;
             };
         }
@@ -22,9 +22,8 @@
 #include "../request.h"
 #include "../../../address.h"
 #include "../../../util/json.h"
-#include <boost/property_tree/ptree.hpp>
+#include "../../../util/serialization.h"
 
-namespace pt = boost::property_tree;
 namespace conclave
 {
     class ConclaveNode;
@@ -38,27 +37,21 @@ namespace conclave
                 
                 GetAddressBalanceResponse* getAddressBalanceHandler(const GetAddressBalanceRequest&, ConclaveNode&);
                 
-                class GetAddressBalanceRequest : public Request
+                class GetAddressBalanceRequest
+                    : public MethodRequest<GetAddressBalanceRequest, GetAddressBalanceResponse,
+                                           getAddressBalanceHandler>
                 {
                     public:
-                    GetAddressBalanceRequest(const pt::ptree& params)
-                        : address(getPrimitiveFromJson<std::string>(params, "address"))
-                    {
-                    }
+                    constexpr static std::string_view name = "GetAddressBalance";
                     
-                    RpcMethod getMethod() const override
-                    {
-                        return rpcMethod;
-                    }
-                    
-                    const std::string& getMethodName() const override
+                    GetAddressBalanceRequest(const JsonValue& params)
+                        : address(getPrimitiveFromJson<std::string>(params, "address"))
                     {
-                        return rpcMethodToString(rpcMethod);
                     }
                     
-                    Response* handle(ConclaveNode& conclaveNode) const override
+                    GetAddressBalanceRequest(ByteReader& params)
+                        : address(readVarString(params))
                     {
-                        return getAddressBalanceHandler(*this, conclaveNode);
                     }
                     
                     const Address& getAddress() const
@@ -67,7 +60,6 @@ namespace conclave
                     }
                     
                     private:
-                    const static RpcMethod rpcMethod = RpcMethod::GetAddressBalance;
                     const Address address;
                 };
             }
@@ -19,10 +19,9 @@
 #pragma once
 
 #include "../response.h"
-#include "../../../util/json.h"
-#include <boost/property_tree/ptree.hpp>
+#include "../../../util/json_writer.h"
+#include "../../../util/serialization.h"
 
-namespace pt = boost::property_tree;
 namespace conclave
 {
     namespace rpc
@@ -39,23 +38,17 @@ namespace conclave
                     {
                     }
                     
-                    RpcMethod getMethod() const override
-                    {
-                        return rpcMethod;
-                    }
-                    
-                    const std::string& getMethodName() const override
+                    private:
+                    void serialize()
                     {
-                        return rpcMethodToString(rpcMethod);
+                        JsonWriter(serializedJson).number(balance);
                     }
                     
-                    private:
-                    void serialize()
+                    void serializeBinary(ByteSink& sink) const override
                     {
-                        serializedJson = "\"" + std::to_string(balance) + "\"";
+                        writeIntegral(sink, balance);
                     }
                     
-                    const static RpcMethod rpcMethod = RpcMethod::GetAddressBalance;
                     const uint64_t balance;
                 };
             }
@@ -0,0 +1,48 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "get_state_root_request.h"
+#include "get_state_root_response.h"
+#include "../../../conclave_node.h"
+#include "../../rpc.h"
+
+namespace conclave
+{
+    namespace rpc
+    {
+        namespace methods
+        {
+            namespace get_state_root
+            {
+                GetStateRootResponse* getStateRootHandler(const GetStateRootRequest& getStateRootRequest,
+                                                          ConclaveNode& conclaveNode)
+                {
+                    ConclaveChain& conclaveChain = conclaveNode.getConclaveChain();
+                    const std::optional<Hash256>& txId = getStateRootRequest.getTxId();
+                    if (!txId.has_value()) {
+                        return new GetStateRootResponse(conclaveChain.getStateRoot());
+                    }
+                    const std::optional<Hash256> stateRoot = conclaveChain.getStateRoot(*txId);
+                    ensure_correct_user_input(stateRoot.has_value(),
+                                              "No state root is recorded for transaction " + std::string(*txId));
+                    return new GetStateRootResponse(*stateRoot);
+                }
+            }
+        }
+    }
+}
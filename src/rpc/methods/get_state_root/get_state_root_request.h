@@ -0,0 +1,63 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "get_state_root_response.h"
+#include "../request.h"
+#include "../../../hash256.h"
+#include "../../../util/json.h"
+#include <optional>
+
+namespace conclave
+{
+    class ConclaveNode;
+    namespace rpc
+    {
+        namespace methods
+        {
+            namespace get_state_root
+            {
+                class GetStateRootRequest;
+                
+                GetStateRootResponse* getStateRootHandler(const GetStateRootRequest&, ConclaveNode&);
+                
+                class GetStateRootRequest
+                    : public MethodRequest<GetStateRootRequest, GetStateRootResponse, getStateRootHandler>
+                {
+                    public:
+                    constexpr static std::string_view name = "GetStateRoot";
+                    
+                    GetStateRootRequest(const JsonValue& params)
+                        : txId(getOptionalPrimitiveFromJson<std::string>(params, "txId"))
+                    {
+                    }
+                    
+                    // Without a transaction, the request is for the current root
+                    const std::optional<Hash256>& getTxId() const
+                    {
+                        return txId;
+                    }
+                    
+                    private:
+                    const std::optional<Hash256> txId;
+                };
+            }
+        }
+    }
+}
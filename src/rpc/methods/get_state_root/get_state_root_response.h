@@ -0,0 +1,55 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "../response.h"
+#include "../../../hash256.h"
+#include "../../../util/json_writer.h"
+
+namespace conclave
+{
+    namespace rpc
+    {
+        namespace methods
+        {
+            namespace get_state_root
+            {
+                class GetStateRootResponse : public Response
+                {
+                    public:
+                    GetStateRootResponse(const Hash256& stateRoot)
+                        : stateRoot(stateRoot)
+                    {
+                    }
+                    
+                    private:
+                    void serialize()
+                    {
+                        JsonWriter writer(serializedJson);
+                        writer.startObject();
+                        writer.key("StateRoot").hex(stateRoot, LARGE_HASH_SIZE_BYTES);
+                        writer.endObject();
+                    }
+                    
+                    const Hash256 stateRoot;
+                };
+            }
+        }
+    }
+}
@@ -0,0 +1,50 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "get_state_tree_node_request.h"
+#include "get_state_tree_node_response.h"
+#include "../../../conclave_node.h"
+#include "../../rpc.h"
+
+namespace conclave
+{
+    namespace rpc
+    {
+        namespace methods
+        {
+            namespace get_state_tree_node
+            {
+                GetStateTreeNodeResponse*
+                getStateTreeNodeHandler(const GetStateTreeNodeRequest& getStateTreeNodeRequest,
+                                        ConclaveNode& conclaveNode)
+                {
+                    const uint16_t depth = getStateTreeNodeRequest.getDepth();
+                    // A path is a 256-bit key, so no node is deeper than that
+                    ensure_correct_user_input(depth <= 8 * LARGE_HASH_SIZE_BYTES,
+                                              "depth must be at most " + std::to_string(8 * LARGE_HASH_SIZE_BYTES));
+                    const std::optional<StateTree::Node> node =
+                        conclaveNode.getConclaveChain().getStateTreeNode(depth, getStateTreeNodeRequest.getPath());
+                    if (!node.has_value()) {
+                        return new GetStateTreeNodeResponse();
+                    }
+                    return new GetStateTreeNodeResponse(node->hash, node->leafKey);
+                }
+            }
+        }
+    }
+}
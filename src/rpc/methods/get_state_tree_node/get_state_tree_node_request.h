@@ -0,0 +1,70 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "get_state_tree_node_response.h"
+#include "../request.h"
+#include "../../../hash256.h"
+#include "../../../util/json.h"
+
+namespace conclave
+{
+    class ConclaveNode;
+    namespace rpc
+    {
+        namespace methods
+        {
+            namespace get_state_tree_node
+            {
+                class GetStateTreeNodeRequest;
+                
+                GetStateTreeNodeResponse* getStateTreeNodeHandler(const GetStateTreeNodeRequest&, ConclaveNode&);
+                
+                class GetStateTreeNodeRequest
+                    : public MethodRequest<GetStateTreeNodeRequest, GetStateTreeNodeResponse,
+                                           getStateTreeNodeHandler>
+                {
+                    public:
+                    constexpr static std::string_view name = "GetStateTreeNode";
+                    
+                    GetStateTreeNodeRequest(const JsonValue& params)
+                        : depth(getPrimitiveFromJson<uint16_t>(params, "depth")),
+                          path(getPrimitiveFromJson<std::string>(params, "path"))
+                    {
+                    }
+                    
+                    const uint16_t getDepth() const
+                    {
+                        return depth;
+                    }
+                    
+                    // Only the first depth bits pick the node
+                    const Hash256& getPath() const
+                    {
+                        return path;
+                    }
+                    
+                    private:
+                    const uint16_t depth;
+                    const Hash256 path;
+                };
+            }
+        }
+    }
+}
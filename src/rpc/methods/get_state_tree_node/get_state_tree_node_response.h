@@ -0,0 +1,69 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "../response.h"
+#include "../../../hash256.h"
+#include "../../../util/json_writer.h"
+#include <optional>
+
+namespace conclave
+{
+    namespace rpc
+    {
+        namespace methods
+        {
+            namespace get_state_tree_node
+            {
+                class GetStateTreeNodeResponse : public Response
+                {
+                    public:
+                    // For a position with no node under it, i.e. no unspent output has that path prefix
+                    GetStateTreeNodeResponse()
+                    {
+                    }
+                    
+                    GetStateTreeNodeResponse(const Hash256& hash, const std::optional<Hash256>& leafKey)
+                        : hash(hash), leafKey(leafKey)
+                    {
+                    }
+                    
+                    private:
+                    void serialize()
+                    {
+                        JsonWriter writer(serializedJson);
+                        if (!hash.has_value()) {
+                            writer.null();
+                            return;
+                        }
+                        writer.startObject();
+                        writer.key("Hash").hex(*hash, LARGE_HASH_SIZE_BYTES);
+                        if (leafKey.has_value()) {
+                            writer.key("LeafKey").hex(*leafKey, LARGE_HASH_SIZE_BYTES);
+                        }
+                        writer.endObject();
+                    }
+                    
+                    const std::optional<Hash256> hash;
+                    const std::optional<Hash256> leafKey;
+                };
+            }
+        }
+    }
+}
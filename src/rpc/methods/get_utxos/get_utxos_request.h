@@ -22,9 +22,8 @@
 #include "../request.h"
 #include "../../../address.h"
 #include "../../../util/json.h"
-#include <boost/property_tree/ptree.hpp>
+#include "../../../util/serialization.h"
 
-namespace pt = boost::property_tree;
 namespace conclave
 {
     class ConclaveNode;
@@ -38,27 +37,20 @@ namespace conclave
                 
                 GetUtxosResponse* getUtxosHandler(const GetUtxosRequest&, ConclaveNode&);
                 
-                class GetUtxosRequest : public Request
+                class GetUtxosRequest
+                    : public MethodRequest<GetUtxosRequest, GetUtxosResponse, getUtxosHandler>
                 {
                     public:
-                    GetUtxosRequest(const pt::ptree& params)
-                        : address(getPrimitiveFromJson<std::string>(params, "address"))
-                    {
-                    }
+                    constexpr static std::string_view name = "GetUtxos";
                     
-                    RpcMethod getMethod() const override
-                    {
-                        return rpcMethod;
-                    }
-                    
-                    const std::string& getMethodName() const override
+                    GetUtxosRequest(const JsonValue& params)
+                        : address(getPrimitiveFromJson<std::string>(params, "address"))
                     {
-                        return rpcMethodToString(rpcMethod);
                     }
                     
-                    Response* handle(ConclaveNode& conclaveNode) const override
+                    GetUtxosRequest(ByteReader& params)
+                        : address(readVarString(params))
                     {
-                        return getUtxosHandler(*this, conclaveNode);
                     }
                     
                     const Address& getAddress() const
@@ -67,7 +59,6 @@ namespace conclave
                     }
                     
                     private:
-                    const static RpcMethod rpcMethod = RpcMethod::GetUtxos;
                     const Address address;
                 };
             }
@@ -21,10 +21,9 @@
 #include "../response.h"
 #include "../../../structs/bitcoin_rich_output.h"
 #include "../../../structs/conclave_rich_output.h"
-#include "../../../util/json.h"
-#include <boost/property_tree/ptree.hpp>
+#include "../../../util/json_writer.h"
+#include "../../../util/serialization.h"
 
-namespace pt = boost::property_tree;
 namespace conclave
 {
     namespace rpc
@@ -46,32 +45,26 @@ namespace conclave
                     {
                     }
                     
-                    RpcMethod getMethod() const override
-                    {
-                        return rpcMethod;
-                    }
-                    
-                    const std::string& getMethodName() const override
-                    {
-                        return rpcMethodToString(rpcMethod);
-                    }
-                    
                     private:
                     void serialize()
                     {
-                        pt::ptree tree;
+                        JsonWriter writer(serializedJson);
+                        writer.startObject();
                         if (bitcoinRichOutputs.size() > 0) {
-                            tree.add_child("BitcoinRichOutputs",
-                                           vectorOfObjectsToArray(bitcoinRichOutputs));
+                            writer.key("BitcoinRichOutputs").objects(bitcoinRichOutputs);
                         }
                         if (conclaveRichOutputs.size() > 0) {
-                            tree.add_child("ConclaveRichOutputs",
-                                           vectorOfObjectsToArray(conclaveRichOutputs));
+                            writer.key("ConclaveRichOutputs").objects(conclaveRichOutputs);
                         }
-                        serializedJson = ptreeToString(tree);
+                        writer.endObject();
+                    }
+                    
+                    void serializeBinary(ByteSink& sink) const override
+                    {
+                        writeVectorOfObjects(sink, bitcoinRichOutputs);
+                        writeVectorOfObjects(sink, conclaveRichOutputs);
                     }
                     
-                    const static RpcMethod rpcMethod = RpcMethod::GetUtxos;
                     const std::vector<BitcoinRichOutput> bitcoinRichOutputs;
                     const std::vector<ConclaveRichOutput> conclaveRichOutputs;
                 };
@@ -23,9 +23,7 @@
 #include "structs/sources.h"
 #include "structs/destinations.h"
 #include "../../../structs/outpoint.h"
-#include <boost/property_tree/ptree.hpp>
 
-namespace pt = boost::property_tree;
 namespace conclave
 {
     class ConclaveNode;
@@ -39,28 +37,16 @@ namespace conclave
                 
                 MakeEntryTxResponse* makeEntryTxHandler(const MakeEntryTxRequest&, ConclaveNode&);
                 
-                class MakeEntryTxRequest : public Request
+                class MakeEntryTxRequest
+                    : public MethodRequest<MakeEntryTxRequest, MakeEntryTxResponse, makeEntryTxHandler>
                 {
                     public:
-                    MakeEntryTxRequest(const pt::ptree& params)
-                        : sources(params.get_child("sources")),
-                          destinations(params.get_child("destinations"))
-                    {
-                    }
-                    
-                    RpcMethod getMethod() const override
-                    {
-                        return rpcMethod;
-                    }
-                    
-                    const std::string& getMethodName() const override
-                    {
-                        return rpcMethodToString(rpcMethod);
-                    }
+                    constexpr static std::string_view name = "MakeEntryTx";
                     
-                    Response* handle(ConclaveNode& conclaveNode) const override
+                    MakeEntryTxRequest(const JsonValue& params)
+                        : sources(params.get("sources")),
+                          destinations(params.get("destinations"))
                     {
-                        return makeEntryTxHandler(*this, conclaveNode);
                     }
                     
                     const Sources& getSources() const
@@ -74,7 +60,6 @@ namespace conclave
                     }
                     
                     private:
-                    const static RpcMethod rpcMethod = RpcMethod::MakeEntryTx;
                     const Sources sources;
                     const Destinations destinations;
                 };
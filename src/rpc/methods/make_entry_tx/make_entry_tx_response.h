@@ -20,10 +20,8 @@
 
 #include "../response.h"
 #include "../../../structs/entry_tx.h"
-#include "../../../util/json.h"
-#include <boost/property_tree/ptree.hpp>
+#include "../../../util/json_writer.h"
 
-namespace pt = boost::property_tree;
 namespace conclave
 {
     namespace rpc
@@ -40,25 +38,16 @@ namespace conclave
                     {
                     }
                     
-                    RpcMethod getMethod() const override
-                    {
-                        return rpcMethod;
-                    }
-                    
-                    const std::string& getMethodName() const override
-                    {
-                        return rpcMethodToString(rpcMethod);
-                    }
-                    
                     private:
                     void serialize()
                     {
-                        pt::ptree tree;
-                        tree.add_child("EntryTx", static_cast<pt::ptree>(entryTx));
-                        serializedJson = ptreeToString(tree);
+                        JsonWriter writer(serializedJson);
+                        writer.startObject();
+                        writer.key("EntryTx");
+                        entryTx.writeJson(writer);
+                        writer.endObject();
                     }
                     
-                    const static RpcMethod rpcMethod = RpcMethod::MakeEntryTx;
                     const EntryTx entryTx;
                 };
             }
@@ -42,6 +42,12 @@ namespace conclave
                 {
                 }
                 
+                Destinations::Destinations(const JsonValue& tree)
+                    : Destinations(getVectorOfObjectsFromJson<Destination>(tree, JSONKEY_BITCOIN),
+                                   getVectorOfObjectsFromJson<Destination>(tree, JSONKEY_CONCLAVE))
+                {
+                }
+                
                 Destinations::operator pt::ptree() const
                 {
                     pt::ptree tree;
@@ -39,6 +39,7 @@ namespace conclave
                     // Constructors
                     Destinations(const std::vector<Destination>&, const std::vector<Destination>&);
                     Destinations(const pt::ptree&);
+                    Destinations(const JsonValue&);
                     // Operators
                     explicit operator pt::ptree() const;
                     explicit operator std::string() const;
@@ -38,6 +38,11 @@ namespace conclave
                 {
                 }
                 
+                Sources::Sources(const JsonValue& tree)
+                    : Sources(getVectorOfObjectsFromJson<Outpoint>(tree, JSONKEY_OUTPOINTS))
+                {
+                }
+                
                 Sources::operator pt::ptree() const
                 {
                     pt::ptree tree;
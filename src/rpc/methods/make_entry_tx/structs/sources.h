@@ -38,6 +38,7 @@ namespace conclave
                     // Constructors
                     Sources(const std::vector<Outpoint>&);
                     Sources(const pt::ptree&);
+                    Sources(const JsonValue&);
                     // Operators
                     explicit operator pt::ptree() const;
                     explicit operator std::string() const;
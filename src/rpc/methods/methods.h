@@ -18,47 +18,98 @@
 
 #pragma once
 
-#include <string>
-#include <stdexcept>
+#include <array>
+#include <cstdint>
+#include <string_view>
 
 namespace conclave
 {
     namespace rpc
     {
-        // Order matters!
-        enum RpcMethod
+        // Method names are looked up through a perfect hash: a seed is picked at compile time under which every
+        // name hashes to a different slot, so a lookup is one hash and one string compare. The names come from the
+        // request types listed in a MethodRegistry.
+        
+        /***
+         * Enough slot bits for the table to be at most half full
+         */
+        constexpr size_t rpcMethodSlotBits(const size_t nMethods)
+        {
+            size_t bits = 1;
+            while ((size_t(1) << bits) < 2 * nMethods) {
+                bits++;
+            }
+            return bits;
+        }
+        
+        /***
+         * Seeded FNV-1a, taking the slot from the top bits since the low bits barely depend on the seed
+         */
+        constexpr size_t rpcMethodSlot(const std::string_view name, const uint32_t seed, const size_t slotBits)
+        {
+            uint32_t hash = 2166136261u ^ seed;
+            for (const char c : name) {
+                hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+            }
+            return hash >> (32 - slotBits);
+        }
+        
+        template<size_t N>
+        constexpr bool hasDistinctRpcMethodNames(const std::array<std::string_view, N>& names)
         {
-            NodeInfo,
-            GetAddressBalance,
-            GetUtxos,
-            MakeEntryTx,
-            SubmitBitcoinTx,
-            SubmitConclaveTx,
-        };
-        // Order matters!
-        static const std::string RPC_METHOD_NAMES[] = {
-            "NodeInfo",
-            "GetAddressBalance",
-            "GetUtxos",
-            "MakeEntryTx",
-            "SubmitBitcoinTx",
-            "SubmitConclaveTx"
-        };
-        static const size_t NUM_RPC_METHODS = sizeof(RPC_METHOD_NAMES) / sizeof(std::string);
+            for (size_t i = 0; i < N; i++) {
+                for (size_t j = i + 1; j < N; j++) {
+                    if (names[i] == names[j]) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
         
-        inline RpcMethod stringToRpcMethod(const std::string str)
+        template<size_t N>
+        constexpr bool isPerfectRpcMethodSeed(const std::array<std::string_view, N>& names, const uint32_t seed)
         {
-            for (size_t i = 0; i < NUM_RPC_METHODS; i++) {
-                if (str == RPC_METHOD_NAMES[i]) {
-                    return (RpcMethod) i;
+            constexpr size_t slotBits = rpcMethodSlotBits(N);
+            std::array<bool, size_t(1) << slotBits> used{};
+            for (const std::string_view name : names) {
+                const size_t slot = rpcMethodSlot(name, seed, slotBits);
+                if (used[slot]) {
+                    return false;
                 }
+                used[slot] = true;
             }
-            throw std::runtime_error("Unknown RPC method: " + str);
+            return true;
         }
         
-        inline static const std::string& rpcMethodToString(const RpcMethod rpcMethod)
+        /***
+         * Only terminates for distinct names, which callers check first
+         */
+        template<size_t N>
+        constexpr uint32_t findPerfectRpcMethodSeed(const std::array<std::string_view, N>& names)
         {
-            return RPC_METHOD_NAMES[rpcMethod];
+            uint32_t seed = 0;
+            while (!isPerfectRpcMethodSeed(names, seed)) {
+                seed++;
+            }
+            return seed;
+        }
+        
+        /***
+         * Index into `names` for each slot, or -1 where no name lands
+         */
+        template<size_t N>
+        constexpr std::array<int16_t, size_t(1) << rpcMethodSlotBits(N)> makeRpcMethodSlots(
+            const std::array<std::string_view, N>& names, const uint32_t seed)
+        {
+            std::array<int16_t, size_t(1) << rpcMethodSlotBits(N)> slots{};
+            for (int16_t& slot : slots) {
+                slot = -1;
+            }
+            for (size_t i = 0; i < N; i++) {
+                slots[rpcMethodSlot(names[i], seed, rpcMethodSlotBits(N))] = static_cast<int16_t>(i);
+            }
+            return slots;
         }
     }
 }
@@ -20,7 +20,6 @@
 
 #include "node_info_response.h"
 #include "../request.h"
-#include <boost/property_tree/ptree.hpp>
 
 namespace conclave
 {
@@ -35,30 +34,15 @@ namespace conclave
                 
                 NodeInfoResponse* nodeInfoHandler(const NodeInfoRequest&, ConclaveNode&);
                 
-                class NodeInfoRequest : public Request
+                class NodeInfoRequest
+                    : public MethodRequest<NodeInfoRequest, NodeInfoResponse, nodeInfoHandler>
                 {
                     public:
-                    NodeInfoRequest(const pt::ptree& params)
-                    {
-                    }
-                    
-                    RpcMethod getMethod() const override
-                    {
-                        return rpcMethod;
-                    }
+                    constexpr static std::string_view name = "NodeInfo";
                     
-                    const std::string& getMethodName() const override
+                    NodeInfoRequest(const JsonValue& params)
                     {
-                        return rpcMethodToString(rpcMethod);
                     }
-                    
-                    Response* handle(ConclaveNode& conclaveNode) const override
-                    {
-                        return nodeInfoHandler(*this, conclaveNode);
-                    }
-                    
-                    private:
-                    const static RpcMethod rpcMethod = RpcMethod::NodeInfo;
                 };
             }
         }
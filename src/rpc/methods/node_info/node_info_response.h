@@ -19,10 +19,8 @@
 #pragma once
 
 #include "../response.h"
-#include "../../../util/json.h"
-#include <boost/property_tree/ptree.hpp>
+#include "../../../util/json_writer.h"
 
-namespace pt = boost::property_tree;
 namespace conclave
 {
     namespace rpc
@@ -39,26 +37,16 @@ namespace conclave
                     {
                     }
                     
-                    RpcMethod getMethod() const override
-                    {
-                        return rpcMethod;
-                    }
-                    
-                    const std::string& getMethodName() const override
-                    {
-                        return rpcMethodToString(rpcMethod);
-                    }
-                    
                     private:
                     void serialize()
                     {
-                        pt::ptree tree;
-                        tree.put("DisplayName", displayName);
-                        tree.put("PublicKey", publicKey);
-                        serializedJson = ptreeToString(tree);
+                        JsonWriter writer(serializedJson);
+                        writer.startObject();
+                        writer.key("DisplayName").string(displayName);
+                        writer.key("PublicKey").string(publicKey);
+                        writer.endObject();
                     }
                     
-                    const static RpcMethod rpcMethod = RpcMethod::NodeInfo;
                     const std::string displayName;
                     const std::string publicKey;
                 };
@@ -0,0 +1,103 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "methods.h"
+#include "request.h"
+#include "../../util/byte_reader.h"
+#include "../../util/json_parser.h"
+#include <array>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace conclave
+{
+    namespace rpc
+    {
+        using RequestFactory = Request* (*)(const JsonValue&);
+        using BinaryRequestFactory = Request* (*)(ByteReader&);
+        
+        template<typename RequestT>
+        constexpr BinaryRequestFactory getBinaryRequestFactory()
+        {
+            if constexpr (std::is_constructible<RequestT, ByteReader&>::value) {
+                return &RequestT::makeFromBytes;
+            } else {
+                return nullptr;
+            }
+        }
+        
+        /***
+         * The set of RPC methods the node serves, given as their MethodRequest types. Everything about a method is
+         * declared on its request type, so registering a method is just listing it here. The name table and its
+         * perfect hash are built from the list.
+         *
+         * A method's position in the list is the byte that picks it on the binary transport, so new methods go on
+         * the end.
+         */
+        template<typename... Requests>
+        class MethodRegistry final
+        {
+            public:
+            constexpr static size_t NUM_METHODS = sizeof...(Requests);
+            constexpr static std::array<std::string_view, NUM_METHODS> NAMES{Requests::name...};
+            
+            /***
+             * @return - The method's position in the list, or nothing if no method has that name
+             */
+            static std::optional<size_t> findMethod(const std::string_view name)
+            {
+                const int16_t index = SLOTS[rpcMethodSlot(name, SEED, rpcMethodSlotBits(NUM_METHODS))];
+                if (index < 0 || NAMES[index] != name) {
+                    return std::nullopt;
+                }
+                return index;
+            }
+            
+            static Request* makeRequest(const std::string_view name, const JsonValue& params)
+            {
+                const std::optional<size_t> index = findMethod(name);
+                CONCLAVE_ASSERT(index.has_value(), "Unknown RPC method: " + std::string(name));
+                return FACTORIES[*index](params);
+            }
+            
+            static Request* makeRequest(const uint8_t method, ByteReader& params)
+            {
+                CONCLAVE_ASSERT(method < NUM_METHODS, "Unknown RPC method: " + std::to_string(method));
+                const BinaryRequestFactory factory = BINARY_FACTORIES[method];
+                CONCLAVE_ASSERT(factory != nullptr,
+                                std::string(NAMES[method]) + " is not available over the binary transport");
+                return factory(params);
+            }
+            
+            private:
+            static_assert(NUM_METHODS <= 256, "Binary requests pick their method with a single byte");
+            static_assert(hasDistinctRpcMethodNames(NAMES), "Every RPC method must be registered exactly once");
+            constexpr static uint32_t SEED = findPerfectRpcMethodSeed(NAMES);
+            constexpr static std::array<int16_t, size_t(1) << rpcMethodSlotBits(NUM_METHODS)> SLOTS =
+                makeRpcMethodSlots(NAMES, SEED);
+            constexpr static std::array<RequestFactory, NUM_METHODS> FACTORIES{&Requests::make...};
+            constexpr static std::array<BinaryRequestFactory, NUM_METHODS> BINARY_FACTORIES{
+                getBinaryRequestFactory<Requests>()...
+            };
+        };
+    }
+}
@@ -17,12 +17,16 @@
  */
 
 #include "request.h"
+#include "batch.h"
+#include "registry.h"
 #include "node_info/node_info_request.h"
 #include "get_address_balance/get_address_balance_request.h"
 #include "get_utxos/get_utxos_request.h"
 #include "make_entry_tx/make_entry_tx_request.h"
 #include "submit_bitcoin_tx/submit_bitcoin_tx_request.h"
 #include "submit_conclave_tx/submit_conclave_tx_request.h"
+#include "get_state_root/get_state_root_request.h"
+#include "get_state_tree_node/get_state_tree_node_request.h"
 
 namespace conclave
 {
@@ -34,34 +38,83 @@ namespace conclave
         using namespace methods::make_entry_tx;
         using namespace methods::submit_bitcoin_tx;
         using namespace methods::submit_conclave_tx;
+        using namespace methods::get_state_root;
+        using namespace methods::get_state_tree_node;
         
-        Request* Request::deserializeJson(const std::string& json)
+        Request* Request::deserializeJson(const std::string_view json)
         {
-            return deserializeJson(stringToPtree(json));
+            // The request structs bind straight off the document, which only has to last until they are built
+            const JsonDocument document(json);
+            return deserializeJson(document.getRoot());
         }
         
-        Request* Request::deserializeJson(const pt::ptree& root)
+        // Every method the node serves. Only ever append: a method's position is its byte on the binary transport.
+        using RpcMethods = MethodRegistry<NodeInfoRequest,
+                                          GetAddressBalanceRequest,
+                                          GetUtxosRequest,
+                                          MakeEntryTxRequest,
+                                          SubmitBitcoinTxRequest,
+                                          SubmitConclaveTxRequest,
+                                          GetStateRootRequest,
+                                          GetStateTreeNodeRequest>;
+        
+        Request* Request::deserializeJson(const JsonValue& root)
         {
             // Go for JSON-RPC 2.0 specification (https://www.jsonrpc.org/specification)
-            std::string method = getPrimitiveFromJson<std::string>(root, "method");
-            const pt::ptree params = root.get_child("params", pt::ptree());
-            // TODO - find out a way to lose this switch statement
-            switch (stringToRpcMethod(method)) {
-                case RpcMethod::NodeInfo:
-                    return new NodeInfoRequest(params);
-                case RpcMethod::GetAddressBalance:
-                    return new GetAddressBalanceRequest(params);
-                case RpcMethod::GetUtxos:
-                    return new GetUtxosRequest(params);
-                case RpcMethod::MakeEntryTx:
-                    return new MakeEntryTxRequest(params);
-                case RpcMethod::SubmitBitcoinTx:
-                    return new SubmitBitcoinTxRequest(params);
-                case RpcMethod::SubmitConclaveTx:
-                    return new SubmitConclaveTxRequest(params);
-                default:
-                    throw std::logic_error("No implementation found for RPC method: " + method);
+            const std::string_view method = getPrimitiveFromJson<std::string_view>(root, "method");
+            const JsonValue params = root.find("params").value_or(JsonValue());
+            return RpcMethods::makeRequest(method, params);
+        }
+        
+        /***
+         * A binary request is the method's position in RpcMethods as a single byte, followed by its parameters in the
+         * node's own serialization. See docs/rpc/Binary.md.
+         */
+        Request* Request::deserializeBinary(const BYTE* payload, const size_t size)
+        {
+            ByteReader reader(payload, size);
+            const uint8_t method = reader.readIntegral<uint8_t>();
+            std::unique_ptr<Request> request(RpcMethods::makeRequest(method, reader));
+            CONCLAVE_ASSERT(reader.getRemaining() == 0, "Unexpected bytes after the parameters");
+            request->binary = true;
+            return request.release();
+        }
+        
+        /***
+         * Makes a request for each call in a batch, all reporting back to one Batch. A malformed call is answered with
+         * an error in its place in the batch while the others still run, so only an empty or oversized batch is
+         * rejected outright.
+         * @param calls - The batch array
+         * @param tag - Return address for the batch's response
+         * @param sequence - Where the batch falls among the requests on its connection
+         * @param requestHash - Hash of the whole request body
+         * @param arena - Memory for the batch's response
+         */
+        std::vector<std::unique_ptr<Request>> Request::deserializeJsonBatch(const JsonValue& calls, void* tag,
+                                                                              const uint64_t sequence,
+                                                                              const Hash256& requestHash,
+                                                                              std::unique_ptr<Arena> arena)
+        {
+            CONCLAVE_ASSERT(calls.size() > 0, "Empty batch");
+            CONCLAVE_ASSERT(calls.size() <= Batch::MAX_CALLS,
+                            "Batch has more than " + std::to_string(Batch::MAX_CALLS) + " calls");
+            std::vector<std::unique_ptr<Request>> requests;
+            requests.reserve(calls.size());
+            for (const JsonValue call : calls) {
+                try {
+                    requests.emplace_back(Request::deserializeJson(call));
+                } catch (const std::exception& e) {
+                    requests.emplace_back(new FailedCall(e.what()));
+                }
+            }
+            const std::shared_ptr<Batch> batch = std::make_shared<Batch>(requests.size(), tag, sequence, requestHash,
+                                                                         std::move(arena));
+            for (size_t i = 0; i < requests.size(); i++) {
+                requests[i]->tag = tag;
+                requests[i]->batch = batch;
+                requests[i]->batchIndex = i;
             }
+            return requests;
         }
     }
 }
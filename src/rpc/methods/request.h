@@ -18,11 +18,17 @@
 
 #pragma once
 
-#include "methods.h"
 #include "response.h"
+#include "../../hash256.h"
+#include "../../util/arena.h"
+#include "../../util/byte_reader.h"
 #include "../../util/json.h"
+#include "../../util/json_parser.h"
 #include <boost/property_tree/ptree.hpp>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace pt = boost::property_tree;
 namespace conclave
@@ -30,21 +36,72 @@ namespace conclave
     class ConclaveNode;
     namespace rpc
     {
+        class Batch;
+        
         class Request
         {
             public:
             virtual ~Request() = default;
-            static Request* deserializeJson(const std::string&);
-            virtual RpcMethod getMethod() const = 0;
-            virtual const std::string& getMethodName() const = 0;
+            static Request* deserializeJson(const std::string_view);
+            static Request* deserializeJson(const JsonValue&);
+            static Request* deserializeBinary(const BYTE*, const size_t);
+            static std::vector<std::unique_ptr<Request>> deserializeJsonBatch(const JsonValue&, void*, const uint64_t,
+                                                                              const Hash256&, std::unique_ptr<Arena>);
+            virtual std::string_view getMethodName() const = 0;
             virtual Response* handle(ConclaveNode&) const = 0;
             // Tag some arbitrary data to the request. Typically this will point to
             // something the networking library understands which contains the
             // return address, and will be copied to the `tag` on the generated
             // response.
             void* tag;
-            private:
-            static Request* deserializeJson(const pt::ptree&);
+            // Where the request falls among those on its connection, so that the responses can be sent back in the
+            // same order
+            uint64_t sequence = 0;
+            // Hash of the raw request body. Echoed back in the response wrapper so the client can
+            // tie a signed response to the request it sent.
+            Hash256 requestHash;
+            // Memory for everything the request needs until it is answered. Handed on to the response.
+            std::unique_ptr<Arena> arena;
+            // Set when the request is one call in a batch, in which case its response goes to the batch rather
+            // than straight back to the client
+            std::shared_ptr<Batch> batch;
+            size_t batchIndex = 0;
+            // Set when the request came in over the binary transport, so it is answered the same way
+            bool binary = false;
+        };
+        
+        /***
+         * Base for each method's request, which is where a method is declared: its request and response types, the
+         * handler that turns one into the other, and its name, which the request type gives as
+         * `constexpr static std::string_view name`. A request type that can also be built from a ByteReader is served
+         * over the binary transport as well.
+         */
+        template<typename RequestT, typename ResponseT, ResponseT* (* handler)(const RequestT&, ConclaveNode&)>
+        class MethodRequest : public Request
+        {
+            public:
+            using ResponseType = ResponseT;
+            
+            static Request* make(const JsonValue& params)
+            {
+                return new RequestT(params);
+            }
+            
+            // Only for the methods served over the binary transport, which can be built from a ByteReader
+            static Request* makeFromBytes(ByteReader& params)
+            {
+                return new RequestT(params);
+            }
+            
+            std::string_view getMethodName() const override
+            {
+                return RequestT::name;
+            }
+            
+            Response* handle(ConclaveNode& conclaveNode) const override
+            {
+                return handler(static_cast<const RequestT&>(*this), conclaveNode);
+            }
         };
     }
 }
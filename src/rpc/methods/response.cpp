@@ -17,12 +17,23 @@
  */
 
 #include "response.h"
+#include "../rpc_binary.h"
+#include "../../util/serialization.h"
 
 namespace conclave
 {
     namespace rpc
     {
-        const std::string& Response::getSerializedJson()
+        /***
+         * Responses are made while their request's arena is current, and keep their JSON in it
+         */
+        Response::Response()
+            : serializedJson(Arena::getCurrentResource()), serializedBinary(Arena::getCurrentResource()),
+              wrapped(Arena::getCurrentResource())
+        {
+        }
+        
+        const std::pmr::string& Response::getSerializedJson()
         {
             // Lazily serialize
             if (!serialized) {
@@ -31,5 +42,45 @@ namespace conclave
             }
             return serializedJson;
         }
+        
+        const std::pmr::string& Response::getSerializedBinary()
+        {
+            if (!serializedAsBinary) {
+                ByteStringSink sink(serializedBinary);
+                writeIntegral<uint8_t>(sink, isError() ? BINARY_ERROR : BINARY_OK);
+                serializeBinary(sink);
+                serializedAsBinary = true;
+            }
+            return serializedBinary;
+        }
+        
+        bool Response::isError() const
+        {
+            return false;
+        }
+        
+        const std::pmr::string& Response::getWrapped() const
+        {
+            return wrapped;
+        }
+        
+        void Response::setWrapped(const std::string_view bytes)
+        {
+            wrapped = bytes;
+        }
+        
+        void Response::setWrapped(std::pmr::string&& bytes)
+        {
+            // Free when both strings come from the same arena, a copy otherwise
+            wrapped = std::move(bytes);
+        }
+        
+        /***
+         * Only the methods served over the binary transport have a binary form
+         */
+        void Response::serializeBinary(ByteSink& sink) const
+        {
+            throw std::runtime_error(std::string(methodName) + " responses have no binary form");
+        }
     }
 }
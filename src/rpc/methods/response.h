@@ -18,8 +18,14 @@
 
 #pragma once
 
-#include "methods.h"
+#include "../../hash256.h"
+#include "../../util/arena.h"
+#include "../../util/byte_sink.h"
 #include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
 
 namespace conclave
 {
@@ -29,19 +35,42 @@ namespace conclave
         {
             public:
             virtual ~Response() = default;
-            virtual RpcMethod getMethod() const = 0;
-            virtual const std::string& getMethodName() const = 0;
-            const std::string& getSerializedJson();
+            const std::pmr::string& getSerializedJson();
+            // Status byte followed by the response's binary serialization, for the binary transport
+            const std::pmr::string& getSerializedBinary();
+            // Whether the response reports a failed request
+            virtual bool isError() const;
+            // The signed wrapper around the serialized response, which is what actually goes out on
+            // the wire: JSON, or a frame for the binary transport. Set by the `RpcSigner` stage.
+            const std::pmr::string& getWrapped() const;
+            void setWrapped(const std::string_view);
+            void setWrapped(std::pmr::string&&);
             // Tag some arbitrary data to the request. Typically this will point to
             // something the networking library understands which contains the
             // return address, and will be copied from the `tag` on the original
             // request.
             void* tag;
+            // The name of the method that was called, copied from the original request
+            std::string_view methodName;
+            // Copied from the original request
+            uint64_t sequence = 0;
+            // Hash of the raw request body, copied from the original request.
+            Hash256 requestHash;
+            // The original request's arena, which the JSON strings below are allocated from. Declared ahead of
+            // them so it outlives them.
+            std::unique_ptr<Arena> arena;
+            // Set when the request came in over the binary transport, copied from the original request
+            bool binary = false;
             protected:
-            std::string serializedJson;
+            Response();
+            std::pmr::string serializedJson;
             private:
             virtual void serialize() = 0;
+            virtual void serializeBinary(ByteSink&) const;
             bool serialized = false;
+            bool serializedAsBinary = false;
+            std::pmr::string serializedBinary;
+            std::pmr::string wrapped;
         };
     }
 }
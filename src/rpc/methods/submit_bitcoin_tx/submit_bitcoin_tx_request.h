@@ -21,9 +21,7 @@
 #include "submit_bitcoin_tx_response.h"
 #include "../request.h"
 #include "../../../structs/bitcoin_tx.h"
-#include <boost/property_tree/ptree.hpp>
 
-namespace pt = boost::property_tree;
 namespace conclave
 {
     class ConclaveNode;
@@ -37,27 +35,20 @@ namespace conclave
                 
                 SubmitBitcoinTxResponse* submitBitcoinTxHandler(const SubmitBitcoinTxRequest&, ConclaveNode&);
                 
-                class SubmitBitcoinTxRequest : public Request
+                class SubmitBitcoinTxRequest
+                    : public MethodRequest<SubmitBitcoinTxRequest, SubmitBitcoinTxResponse, submitBitcoinTxHandler>
                 {
                     public:
-                    SubmitBitcoinTxRequest(const pt::ptree& params)
-                        : bitcoinTx(params.get_child("BitcoinTx"))
-                    {
-                    }
-                    
-                    RpcMethod getMethod() const override
-                    {
-                        return rpcMethod;
-                    }
+                    constexpr static std::string_view name = "SubmitBitcoinTx";
                     
-                    const std::string& getMethodName() const override
+                    SubmitBitcoinTxRequest(const JsonValue& params)
+                        : bitcoinTx(params.get("BitcoinTx"))
                     {
-                        return rpcMethodToString(rpcMethod);
                     }
                     
-                    Response* handle(ConclaveNode& conclaveNode) const override
+                    SubmitBitcoinTxRequest(ByteReader& params)
+                        : bitcoinTx(BitcoinTx::deserialize(params))
                     {
-                        return submitBitcoinTxHandler(*this, conclaveNode);
                     }
                     
                     const BitcoinTx& getBitcoinTx() const
@@ -66,7 +57,6 @@ namespace conclave
                     }
                     
                     private:
-                    const static RpcMethod rpcMethod = RpcMethod::SubmitBitcoinTx;
                     const BitcoinTx bitcoinTx;
                 };
             }
@@ -21,9 +21,7 @@
 #include "submit_conclave_tx_response.h"
 #include "../request.h"
 #include "../../../structs/conclave_tx.h"
-#include <boost/property_tree/ptree.hpp>
 
-namespace pt = boost::property_tree;
 namespace conclave
 {
     class ConclaveNode;
@@ -37,27 +35,20 @@ namespace conclave
                 
                 SubmitConclaveTxResponse* submitConclaveTxHandler(const SubmitConclaveTxRequest&, ConclaveNode&);
                 
-                class SubmitConclaveTxRequest : public Request
+                class SubmitConclaveTxRequest
+                    : public MethodRequest<SubmitConclaveTxRequest, SubmitConclaveTxResponse, submitConclaveTxHandler>
                 {
                     public:
-                    SubmitConclaveTxRequest(const pt::ptree& params)
-                        : conclaveTx(params.get_child("ConclaveTx"))
-                    {
-                    }
-                    
-                    RpcMethod getMethod() const override
-                    {
-                        return rpcMethod;
-                    }
+                    constexpr static std::string_view name = "SubmitConclaveTx";
                     
-                    const std::string& getMethodName() const override
+                    SubmitConclaveTxRequest(const JsonValue& params)
+                        : conclaveTx(params.get("ConclaveTx"))
                     {
-                        return rpcMethodToString(rpcMethod);
                     }
                     
-                    Response* handle(ConclaveNode& conclaveNode) const override
+                    SubmitConclaveTxRequest(ByteReader& params)
+                        : conclaveTx(ConclaveTx::deserialize(params))
                     {
-                        return submitConclaveTxHandler(*this, conclaveNode);
                     }
                     
                     const ConclaveTx& getConclaveTx() const
@@ -66,7 +57,6 @@ namespace conclave
                     }
                     
                     private:
-                    const static RpcMethod rpcMethod = RpcMethod::SubmitConclaveTx;
                     const ConclaveTx conclaveTx;
                 };
             }
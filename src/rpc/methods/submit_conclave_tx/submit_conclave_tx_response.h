@@ -19,11 +19,10 @@
 #pragma once
 
 #include "../response.h"
-#include "../../../util/json.h"
+#include "../../../util/json_writer.h"
+#include "../../../util/serialization.h"
 #include "../../../hash256.h"
-#include <boost/property_tree/ptree.hpp>
 
-namespace pt = boost::property_tree;
 namespace conclave
 {
     namespace rpc
@@ -40,25 +39,20 @@ namespace conclave
                     {
                     }
                     
-                    RpcMethod getMethod() const override
-                    {
-                        return rpcMethod;
-                    }
-                    
-                    const std::string& getMethodName() const override
+                    private:
+                    void serialize()
                     {
-                        return rpcMethodToString(rpcMethod);
+                        JsonWriter writer(serializedJson);
+                        writer.startObject();
+                        writer.key("TxId").hex(txId, LARGE_HASH_SIZE_BYTES);
+                        writer.endObject();
                     }
                     
-                    private:
-                    void serialize()
+                    void serializeBinary(ByteSink& sink) const override
                     {
-                        pt::ptree tree;
-                        tree.put("TxId", txId);
-                        serializedJson = ptreeToString(tree);
+                        txId.serialize(sink);
                     }
                     
-                    const static RpcMethod rpcMethod = RpcMethod::SubmitConclaveTx;
                     const Hash256 txId;
                 };
             }
@@ -24,7 +24,12 @@ namespace conclave
 {
     namespace rpc
     {
-        const static char* RESPONSE_HEADERS = "Content-Type: application/json\nConnection: close";
+        const static char* RESPONSE_HEADERS = "Content-Type: application/json\r\nConnection: keep-alive";
+        // For the last response on a connection
+        const static char* CLOSING_RESPONSE_HEADERS = "Content-Type: application/json\r\nConnection: close";
+        // For requests rejected by the acceptor
+        const static char* ERROR_RESPONSE_HEADERS = "Content-Type: text/plain\r\nConnection: keep-alive";
+        const static char* CLOSING_ERROR_RESPONSE_HEADERS = "Content-Type: text/plain\r\nConnection: close";
         
         inline void ensure_correct_user_input(const bool predicate, const std::string& errMsg)
         {
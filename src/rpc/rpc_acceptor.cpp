@@ -17,10 +17,18 @@
  */
 
 #include "rpc_acceptor.h"
+#include "rpc_binary.h"
+#include "binary_connection.h"
+#include "http_connection.h"
 #include "methods/request.h"
 #include "../mongoose/mongoose.h"
 #include "../mongoose/mongoose_helpers.h"
+#include <chrono>
 #include <iostream>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
 
 namespace conclave
 {
@@ -37,19 +45,63 @@ namespace conclave
         {
             mg_mgr_init(&mgMgr, nullptr);
             auto handler = [](struct mg_connection* conn, int ev, void* p) {
-                if (ev == MG_EV_HTTP_REQUEST) {
+                // The listener itself gets events too, but only accepted connections carry requests
+                if (conn->listener == nullptr) {
+                    return;
+                }
+                if (ev == MG_EV_ACCEPT) {
+                    // Accepted connections start out with the listener's user_data
+                    RpcAcceptor& rpcAcceptor = *(RpcAcceptor*) conn->user_data;
+                    conn->user_data = new HttpConnection(conn, rpcAcceptor.rpcAcceptorConfig,
+                                                         rpcAcceptor.requestQueue);
+                    return;
+                }
+                HttpConnection& connection = *(HttpConnection*) conn->user_data;
+                if (ev == MG_EV_POLL) {
+                    if (connection.isIdle(std::chrono::steady_clock::now())) {
+                        conn->flags |= MG_F_CLOSE_IMMEDIATELY;
+                    }
+                } else if (ev == MG_EV_CLOSE) {
+                    connection.close();
+                } else if (ev == MG_EV_HTTP_REQUEST) {
                     struct http_message* hm = (struct http_message*) p;
-                    Request* pRequest;
+                    const std::optional<uint64_t> sequence = connection.startRequest(
+                        HttpConnection::wantsKeepAlive(*hm));
+                    if (!sequence.has_value()) {
+                        // Pipelined behind the connection's last request, so it won't be answered
+                        return;
+                    }
+                    std::vector<std::unique_ptr<Request>> requests;
                     try {
-                        pRequest = Request::deserializeJson(mgStrToString(hm->body));
-                        pRequest->tag = (void*) conn;
+                        // The body is parsed and hashed where mongoose holds it
+                        std::unique_ptr<Arena> arena = std::make_unique<Arena>();
+                        const Arena::Scope scope(arena.get());
+                        const std::string_view body(hm->body.p, hm->body.len);
+                        Hash256Writer bodyHashWriter;
+                        bodyHashWriter.write(reinterpret_cast<const BYTE*>(body.data()), body.size());
+                        const Hash256 requestHash = bodyHashWriter.getHash256();
+                        const JsonDocument document(body);
+                        const JsonValue root = document.getRoot();
+                        if (root.isArray()) {
+                            // A batch's calls are queued separately, so that they are processed in parallel
+                            requests = Request::deserializeJsonBatch(root, &connection, *sequence, requestHash,
+                                                                     std::move(arena));
+                        } else {
+                            requests.emplace_back(Request::deserializeJson(root));
+                            requests[0]->tag = &connection;
+                            requests[0]->sequence = *sequence;
+                            requests[0]->requestHash = requestHash;
+                            requests[0]->arena = std::move(arena);
+                        }
                     } catch (std::exception& e) {
                         std::cerr << "RpcAcceptor handler caught:" << e.what() << std::endl;
-                        mg_http_send_error(conn, 500, e.what());
+                        connection.reject(*sequence, e.what());
                         return;
                     }
-                    // Queue the request for processing
-                    ((ConcurrentList<Request*>*) (conn->user_data))->addToEnd(pRequest);
+                    // Queue the requests for processing
+                    for (std::unique_ptr<Request>& request : requests) {
+                        connection.queue(std::move(request));
+                    }
                 }
             };
             std::string mgAddressString = mgMakeAddressString(rpcAcceptorConfig.getIPAddress(),
@@ -59,9 +111,146 @@ namespace conclave
             }
             std::cout << "RpcAcceptor: listening on " << mgAddressString << std::endl;
             
-            // Pass a reference to the request queue so handler can en-queue new requests
-            mgConn->user_data = &requestQueue;
+            // Accepted connections use this to find the request queue and their config
+            mgConn->user_data = this;
             mg_set_protocol_http_websocket(mgConn);
+            
+            if (rpcAcceptorConfig.getBinaryPort().has_value()) {
+                bindBinary();
+            }
+            addWakeup();
+        }
+        
+        /***
+         * Listens for the binary transport, where each connection carries a stream of length-prefixed frames and
+         * stays open between requests. A client may send its next request before the last one is answered.
+         */
+        void RpcAcceptor::bindBinary()
+        {
+            auto handler = [](struct mg_connection* conn, int ev, void* p) {
+                if (conn->listener == nullptr) {
+                    return;
+                }
+                if (ev == MG_EV_ACCEPT) {
+                    // Accepted connections start out with the listener's user_data
+                    const RpcAcceptor& acceptor = *(RpcAcceptor*) conn->user_data;
+                    conn->user_data = new BinaryConnection(conn, acceptor.rpcAcceptorConfig, acceptor.requestQueue);
+                    return;
+                }
+                BinaryConnection& connection = *(BinaryConnection*) conn->user_data;
+                if (ev == MG_EV_POLL) {
+                    if (connection.isIdle(std::chrono::steady_clock::now())) {
+                        conn->flags |= MG_F_CLOSE_IMMEDIATELY;
+                    }
+                    return;
+                }
+                if (ev == MG_EV_CLOSE) {
+                    connection.close();
+                    return;
+                }
+                if (ev != MG_EV_RECV) {
+                    return;
+                }
+                struct mbuf& received = conn->recv_mbuf;
+                // Take every complete frame, leaving any partial one for the next read
+                while (received.len >= BINARY_FRAME_HEADER_SIZE_BYTES) {
+                    const uint32_t frameSize = ByteReader(reinterpret_cast<const BYTE*>(received.buf),
+                                                          BINARY_FRAME_HEADER_SIZE_BYTES).readIntegral<uint32_t>();
+                    if (frameSize > MAX_BINARY_FRAME_SIZE_BYTES) {
+                        // There's no finding the next frame after a bad length, so the connection is done
+                        std::cerr << "RpcAcceptor dropping a binary connection sending a " << frameSize <<
+                                  " byte frame" << std::endl;
+                        conn->flags |= MG_F_CLOSE_IMMEDIATELY;
+                        return;
+                    }
+                    if (received.len < BINARY_FRAME_HEADER_SIZE_BYTES + frameSize) {
+                        return;
+                    }
+                    if (!connection.startRequest()) {
+                        // Sent after the connection's last request, so it won't be answered
+                        mbuf_remove(&received, received.len);
+                        return;
+                    }
+                    const BYTE* payload = reinterpret_cast<const BYTE*>(received.buf) + BINARY_FRAME_HEADER_SIZE_BYTES;
+                    // Hashed first, so that even a frame that can't be parsed gets an answer the client can place
+                    Hash256Writer payloadHashWriter;
+                    payloadHashWriter.write(payload, frameSize);
+                    const Hash256 requestHash = payloadHashWriter.getHash256();
+                    std::unique_ptr<Request> request;
+                    try {
+                        std::unique_ptr<Arena> arena = std::make_unique<Arena>();
+                        const Arena::Scope scope(arena.get());
+                        request.reset(Request::deserializeBinary(payload, frameSize));
+                        request->requestHash = requestHash;
+                        request->arena = std::move(arena);
+                    } catch (std::exception& e) {
+                        std::cerr << "RpcAcceptor binary handler caught:" << e.what() << std::endl;
+                        connection.reject(requestHash, e.what());
+                    }
+                    mbuf_remove(&received, BINARY_FRAME_HEADER_SIZE_BYTES + frameSize);
+                    if (request) {
+                        connection.queue(std::move(request));
+                    }
+                }
+            };
+            std::string mgAddressString = mgMakeAddressString(rpcAcceptorConfig.getIPAddress(),
+                                                              *rpcAcceptorConfig.getBinaryPort());
+            if ((mgBinaryConn = mg_bind(&mgMgr, mgAddressString.c_str(), handler)) == nullptr) {
+                throw std::runtime_error("RpcAcceptor: Failed to bind binary transport to " + mgAddressString);
+            }
+            std::cout << "RpcAcceptor: binary transport listening on " << mgAddressString << std::endl;
+            // Accepted connections use this to find the request queue
+            mgBinaryConn->user_data = this;
+        }
+        
+        /***
+         * Adds a socket pair to the event loop, so that the dispatcher can wake it to send completed responses
+         * rather than touching mongoose from its own thread
+         */
+        void RpcAcceptor::addWakeup()
+        {
+            sock_t wakeSockets[2];
+            if (!mg_socketpair(wakeSockets, SOCK_STREAM)) {
+                throw std::runtime_error("RpcAcceptor: Failed to make wakeup socket pair");
+            }
+            auto handler = [](struct mg_connection* conn, int ev, void* p) {
+                if (ev == MG_EV_RECV) {
+                    // A single byte may stand for any number of responses
+                    mbuf_remove(&conn->recv_mbuf, conn->recv_mbuf.len);
+                    ((RpcAcceptor*) conn->user_data)->sendCompleted();
+                }
+            };
+            struct mg_connection* mgWakeConn = mg_add_sock(&mgMgr, wakeSockets[1], handler);
+            if (mgWakeConn == nullptr) {
+                closesocket(wakeSockets[0]);
+                closesocket(wakeSockets[1]);
+                throw std::runtime_error("RpcAcceptor: Failed to add wakeup socket");
+            }
+            mgWakeConn->user_data = this;
+            const std::lock_guard<std::mutex> lock(completedMutex);
+            wakeSocket = wakeSockets[0];
+            stopped = false;
+        }
+        
+        /***
+         * Called by the dispatcher with a wrapped response, which the acceptor takes ownership of. Only wakes the
+         * event loop if it isn't already due to wake, so a burst of responses costs a single write.
+         */
+        void RpcAcceptor::complete(Response* response)
+        {
+            const std::lock_guard<std::mutex> lock(completedMutex);
+            if (stopped) {
+                // Nothing is listening any more, and the connections have all closed, so they only drop it. The lock
+                // keeps dispatcher threads from dropping responses on the same connection at once.
+                send(response);
+                return;
+            }
+            completed.push_back(response);
+            if (!wakePending) {
+                wakePending = true;
+                const char wake = 0;
+                ::send(wakeSocket, &wake, 1, MSG_DONTWAIT);
+            }
         }
         
         void RpcAcceptor::work()
@@ -73,6 +262,42 @@ namespace conclave
         {
             std::cout << "RpcAcceptor: Freeing mongoose manager" << std::endl;
             mg_mgr_free(&mgMgr);
+            const std::lock_guard<std::mutex> lock(completedMutex);
+            stopped = true;
+            closesocket(wakeSocket);
+            wakeSocket = INVALID_SOCKET;
+            // Every connection has closed, so these are only thrown away
+            for (Response* response : completed) {
+                send(response);
+            }
+            completed.clear();
+        }
+        
+        /***
+         * Sends everything the dispatcher has handed over since the last wakeup. Runs on the event loop.
+         */
+        void RpcAcceptor::sendCompleted()
+        {
+            std::vector<Response*> ready;
+            {
+                const std::lock_guard<std::mutex> lock(completedMutex);
+                ready.swap(completed);
+                wakePending = false;
+            }
+            for (Response* response : ready) {
+                send(response);
+            }
+        }
+        
+        void RpcAcceptor::send(Response* response)
+        {
+            if (response->binary) {
+                // Binary responses are already framed and can go out in any order
+                ((BinaryConnection*) response->tag)->respond(response);
+            } else {
+                // The connection sends it when its turn comes, and takes care of deleting it
+                ((HttpConnection*) response->tag)->respond(response->sequence, response);
+            }
         }
     }
 }
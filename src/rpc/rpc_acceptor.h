@@ -23,6 +23,9 @@
 #include "../mongoose/mongoose.h"
 #include "../util/concurrent_list.h"
 #include "methods/request.h"
+#include "methods/response.h"
+#include <mutex>
+#include <vector>
 
 namespace conclave
 {
@@ -34,16 +37,29 @@ namespace conclave
         {
             public:
             RpcAcceptor(const unsigned int, const RpcAcceptorConfig&, ConcurrentList<Request*>&);
+            void complete(Response*);
             private:
             void prepare() override final;
             void work() override final;
             void cleanup() override final;
+            void bindBinary();
+            void addWakeup();
+            void sendCompleted();
+            static void send(Response*);
             const unsigned int id;
             const RpcAcceptorConfig& rpcAcceptorConfig;
             ConcurrentList<Request*>& requestQueue;
             // Mongoose structs
             struct mg_mgr mgMgr;
             struct mg_connection* mgConn;
+            struct mg_connection* mgBinaryConn = nullptr;
+            // Responses handed over by the dispatcher, sent from the event loop when it is woken. Once stopped,
+            // responses are dropped while holding the lock, since connections no longer lock themselves.
+            std::mutex completedMutex;
+            std::vector<Response*> completed;
+            bool wakePending = false;
+            bool stopped = false;
+            sock_t wakeSocket = INVALID_SOCKET;
         };
     }
 }
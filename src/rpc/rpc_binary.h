@@ -0,0 +1,80 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "../conclave.h"
+#include "../hash256.h"
+#include "../util/arena.h"
+#include "../util/byte_sink.h"
+#include "../util/serialization.h"
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+
+namespace conclave
+{
+    namespace rpc
+    {
+        // The binary transport, described in docs/rpc/Binary.md. Every message either way is a frame: a 4-byte
+        // little-endian length followed by that many bytes of payload.
+        const static size_t BINARY_FRAME_HEADER_SIZE_BYTES = sizeof(uint32_t);
+        // Comfortably more than the largest transaction
+        const static uint32_t MAX_BINARY_FRAME_SIZE_BYTES = 1 << 22;
+        
+        // First byte of every binary response body
+        enum BinaryStatus : uint8_t
+        {
+            BINARY_OK = 0,
+            BINARY_ERROR = 1
+        };
+        
+        /***
+         * Frames a binary response.
+         * @param requestHash - Hash of the request payload, which leads every frame so that clients can match
+         *                      responses to pipelined requests even when they are unsigned
+         * @param body - Status byte followed by the method's response, or by an error message
+         * @param wrapper - Signature, responder, requestHash and latestBlock, or empty if the body is unsigned
+         */
+        inline std::pmr::string makeBinaryFrame(const Hash256& requestHash, const std::string_view body,
+                                                const std::string_view wrapper)
+        {
+            const size_t payloadSize = LARGE_HASH_SIZE_BYTES + varIntSize(body.size()) + body.size() +
+                                       varIntSize(wrapper.size()) + wrapper.size();
+            std::pmr::string frame(Arena::getCurrentResource());
+            frame.reserve(BINARY_FRAME_HEADER_SIZE_BYTES + payloadSize);
+            ByteStringSink sink(frame);
+            writeIntegral(sink, static_cast<uint32_t>(payloadSize));
+            requestHash.serialize(sink);
+            writeVarString(sink, body);
+            writeVarString(sink, wrapper);
+            return frame;
+        }
+        
+        /***
+         * Frames an unsigned error, for requests that were rejected before they could be handled
+         */
+        inline std::pmr::string makeBinaryErrorFrame(const Hash256& requestHash, const std::string_view message)
+        {
+            std::string body(1, static_cast<char>(BINARY_ERROR));
+            body.append(message);
+            return makeBinaryFrame(requestHash, body, std::string_view());
+        }
+    }
+}
@@ -16,18 +16,17 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
-#include "rpc.h"
 #include "rpc_dispatcher.h"
-#include "../mongoose/mongoose.h"
 #include <iostream>
 
 namespace conclave
 {
     namespace rpc
     {
-        RpcDispatcher::RpcDispatcher(const unsigned int id, ConcurrentList<Response*>& responseQueue)
+        RpcDispatcher::RpcDispatcher(const unsigned int id, ConcurrentList<Response*>& responseQueue,
+                                     RpcAcceptor& rpcAcceptor)
             : Worker(),
-              id(id), responseQueue(responseQueue)
+              id(id), responseQueue(responseQueue), rpcAcceptor(rpcAcceptor)
         {
         }
         
@@ -41,14 +40,9 @@ namespace conclave
             }
             Response& response = **opResponse;
             std::cout << "RPC dispatcher " << id << " dequeued a " <<
-                      response.getMethodName() << " response" << std::endl;
-            struct mg_connection* conn = (struct mg_connection*) response.tag;
-            const std::string& json = response.getSerializedJson();
-            const size_t len = json.length();
-            mg_send_head(conn, 200, len, RESPONSE_HEADERS);
-            mg_send(conn, json.c_str(), len);
-            mg_mgr_poll(conn->mgr, 0);
-            delete &response;
+                      response.methodName << " response" << std::endl;
+            // Sockets belong to the acceptor's event loop, so the response is sent from there
+            rpcAcceptor.complete(&response);
         }
     }
 }
@@ -18,8 +18,8 @@
 
 #pragma once
 
+#include "rpc_acceptor.h"
 #include "../worker.h"
-#include "../mongoose/mongoose.h"
 #include "../util/concurrent_list.h"
 #include "methods/response.h"
 
@@ -30,11 +30,12 @@ namespace conclave
         class RpcDispatcher final : public Worker
         {
             public:
-            RpcDispatcher(const unsigned int, ConcurrentList<Response*>&);
+            RpcDispatcher(const unsigned int, ConcurrentList<Response*>&, RpcAcceptor&);
             private:
             void work() override final;
             const unsigned int id;
             ConcurrentList<Response*>& responseQueue;
+            RpcAcceptor& rpcAcceptor;
         };
     }
 }
@@ -17,6 +17,7 @@
  */
 
 #include "rpc_manager.h"
+#include "../conclave_node.h"
 #include <iostream>
 
 namespace conclave
@@ -27,7 +28,8 @@ namespace conclave
             : Worker(), rpcConfig(rpcConfig),
               conclaveNode(conclaveNode),
               rpcAcceptor(RpcAcceptor(0, rpcConfig.getRpcAcceptorConfig(), requestQueue)),
-              rpcDispatcher(0, responseQueue)
+              rpcDispatcher(0, responseQueue, rpcAcceptor),
+              latestBlockCache(conclaveNode.getBitcoinChain(), rpcConfig.getLatestBlockRefreshInterval())
         {
         }
         
@@ -36,6 +38,7 @@ namespace conclave
             std::cout << "Starting RPC manager..." << std::endl;
             // Order matters!
             rpcDispatcher.start();
+            startSigners();
             startProcessors();
             rpcAcceptor.start();
         }
@@ -47,6 +50,8 @@ namespace conclave
             rpcAcceptor.stop();
             stopProcessors();
             requestQueue.shutdown();
+            stopSigners();
+            signingQueue.shutdown();
             rpcDispatcher.stop(false);
             responseQueue.shutdown();
         }
@@ -55,7 +60,7 @@ namespace conclave
         {
             // Create processors
             for (unsigned int i = 0; i < rpcConfig.getNumProcessors(); i++) {
-                processors.emplace_back(std::move(RpcProcessor(i, conclaveNode, requestQueue, responseQueue)));
+                processors.emplace_back(std::move(RpcProcessor(i, conclaveNode, requestQueue, signingQueue)));
                 std::cout << "Created RPC processor " << i << std::endl;
             }
             std::cout << "Created " << rpcConfig.getNumProcessors() <<
@@ -79,5 +84,29 @@ namespace conclave
             std::cout << "Stopped " << rpcConfig.getNumProcessors() <<
                       " RPC processors" << std::endl;
         }
+        
+        void RpcManager::startSigners()
+        {
+            for (unsigned int i = 0; i < rpcConfig.getNumSigners(); i++) {
+                signers.emplace_back(std::move(RpcSigner(i, conclaveNode.getPrivateKey(), latestBlockCache,
+                                                         signingQueue, responseQueue)));
+            }
+            for (unsigned int i = 0; i < rpcConfig.getNumSigners(); i++) {
+                signers[i].start();
+                std::cout << "Started RPC signer " << i << std::endl;
+            }
+            std::cout << "Started " << rpcConfig.getNumSigners() <<
+                      " RPC signers" << std::endl;
+        }
+        
+        void RpcManager::stopSigners()
+        {
+            for (unsigned int i = 0; i < rpcConfig.getNumSigners(); i++) {
+                signers[i].stop(false);
+                std::cout << "Stopped RPC signer " << i << std::endl;
+            }
+            std::cout << "Stopped " << rpcConfig.getNumSigners() <<
+                      " RPC signers" << std::endl;
+        }
     }
 }
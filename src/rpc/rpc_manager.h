@@ -20,9 +20,11 @@
 
 #include "methods/request.h"
 #include "methods/response.h"
+#include "latest_block_cache.h"
 #include "rpc_acceptor.h"
 #include "rpc_dispatcher.h"
 #include "rpc_processor.h"
+#include "rpc_signer.h"
 #include "../config/rpc_config.h"
 #include "../worker.h"
 #include "../util/concurrent_list.h"
@@ -43,13 +45,19 @@ namespace conclave
             void cleanup() override final;
             void startProcessors();
             void stopProcessors();
+            void startSigners();
+            void stopSigners();
             const RpcConfig& rpcConfig;
             // Reference to parent node
             ConclaveNode& conclaveNode;
             RpcAcceptor rpcAcceptor;
             RpcDispatcher rpcDispatcher;
             std::vector<RpcProcessor> processors;
+            std::vector<RpcSigner> signers;
+            LatestBlockCache latestBlockCache;
             ConcurrentList<Request*> requestQueue;
+            // Responses waiting to be wrapped and signed
+            ConcurrentList<Response*> signingQueue;
             ConcurrentList<Response*> responseQueue;
         };
     }
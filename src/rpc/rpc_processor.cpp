@@ -16,6 +16,7 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include "methods/batch.h"
 #include "methods/error_response.h"
 #include "rpc_processor.h"
 #include <iostream>
@@ -51,16 +52,30 @@ namespace conclave
              * client.
              */
             
+            const Arena::Scope scope(request.arena.get());
             Response* response;
             try {
                 response = request.handle(conclaveNode);
             } catch (std::exception& e) {
                 std::cout << "RpcProcessor caught: " << e.what() << std::endl;
                 std::cout << "Queueing an error response" << std::endl;
-                response = new ErrorResponse(request.getMethod(), e.what());
+                response = new ErrorResponse(e.what());
+            }
+            response->methodName = request.getMethodName();
+            if (request.batch) {
+                // Only the last call in a batch to finish has a response to pass on, which covers the whole batch
+                Response* batchResponse = request.batch->complete(request.batchIndex, response);
+                if (batchResponse != nullptr) {
+                    responseQueue.addToStart(batchResponse);
+                }
+            } else {
+                response->tag = request.tag;
+                response->sequence = request.sequence;
+                response->requestHash = request.requestHash;
+                response->arena = std::move(request.arena);
+                response->binary = request.binary;
+                responseQueue.addToStart(response);
             }
-            response->tag = request.tag;
-            responseQueue.addToStart(response);
             delete &request;
         }
     }
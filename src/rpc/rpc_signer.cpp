@@ -0,0 +1,135 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "rpc_signer.h"
+#include "rpc_binary.h"
+#include "../util/json_writer.h"
+#include "../util/serialization.h"
+#include <iostream>
+
+namespace conclave
+{
+    namespace rpc
+    {
+        //
+        // Factories
+        //
+        
+        /***
+         * Build the wrapped JSON for a response. The inner response is embedded as a string rather
+         * than a nested object so that clients can check the signature against the exact bytes
+         * that were signed.
+         */
+        std::pmr::string RpcSigner::wrap(Response& response, const PrivateKey& privateKey,
+                                         const PublicKey& responder, const LatestBlock& latestBlock)
+        {
+            const std::pmr::string& json = response.getSerializedJson();
+            const Hash256 sigHash = getWrapperSigHash(json, responder, response.requestHash, latestBlock);
+            std::pmr::string wrapped(Arena::getCurrentResource());
+            // Room for the embedded response, some escaping of it and the fixed-size fields
+            wrapped.reserve(json.size() + json.size() / 8 + 512);
+            JsonWriter writer(wrapped);
+            writer.startObject();
+            writer.key("response").string(json);
+            writer.key("signature").string(static_cast<std::string>(privateKey.sign(sigHash)));
+            writer.key("responder").string(static_cast<std::string>(responder));
+            writer.key("requestHash").hex(response.requestHash, LARGE_HASH_SIZE_BYTES);
+            writer.key("latestBlock");
+            latestBlock.writeJson(writer);
+            writer.endObject();
+            return wrapped;
+        }
+        
+        /***
+         * Build the frame for a response to the binary transport. The wrapper fields are the same as the JSON
+         * wrapper's and are signed the same way, with the response's binary body in place of its JSON.
+         */
+        std::pmr::string RpcSigner::wrapBinary(Response& response, const PrivateKey& privateKey,
+                                               const PublicKey& responder, const LatestBlock& latestBlock)
+        {
+            const std::pmr::string& body = response.getSerializedBinary();
+            const Hash256 sigHash = getWrapperSigHash(body, responder, response.requestHash, latestBlock);
+            std::pmr::string wrapper(Arena::getCurrentResource());
+            ByteStringSink sink(wrapper);
+            writeBytes(sink, privateKey.sign(sigHash).serialize());
+            responder.serialize(sink);
+            response.requestHash.serialize(sink);
+            latestBlock.serialize(sink);
+            return makeBinaryFrame(response.requestHash, body, wrapper);
+        }
+        
+        /***
+         * The signed message is the double SHA256 of:
+         *   response JSON || responder (compressed) || requestHash || latestBlock hash || height || time
+         */
+        const Hash256 RpcSigner::getWrapperSigHash(const std::string_view json, const PublicKey& responder,
+                                                   const Hash256& requestHash, const LatestBlock& latestBlock)
+        {
+            Hash256Writer writer;
+            writer.write(reinterpret_cast<const BYTE*>(json.data()), json.size());
+            responder.serialize(writer);
+            requestHash.serialize(writer);
+            latestBlock.serialize(writer);
+            return writer.getHash256();
+        }
+        
+        //
+        // Constructors
+        //
+        
+        RpcSigner::RpcSigner(const unsigned int id, const PrivateKey& privateKey, LatestBlockCache& latestBlockCache,
+                             ConcurrentList<Response*>& signingQueue, ConcurrentList<Response*>& responseQueue)
+            : Worker(), id(id), privateKey(privateKey), publicKey(privateKey.getPublicKey()),
+              latestBlockCache(latestBlockCache), signingQueue(signingQueue), responseQueue(responseQueue)
+        {
+        }
+        
+        //
+        // Private Functions
+        //
+        
+        void RpcSigner::work()
+        {
+            std::optional<Response*> opResponse = signingQueue.popFromStart();
+            if (!opResponse.has_value()) {
+                std::cout << "RPC signer " << id << " popped an empty optional" << std::endl;
+                return;
+            }
+            Response& response = **opResponse;
+            const Arena::Scope scope(response.arena.get());
+            try {
+                if (response.binary) {
+                    response.setWrapped(wrapBinary(response, privateKey, publicKey, *latestBlockCache.get()));
+                } else {
+                    response.setWrapped(wrap(response, privateKey, publicKey, *latestBlockCache.get()));
+                }
+            } catch (std::exception& e) {
+                // Without a tip we can't produce a valid wrapper, so the client gets nothing better
+                // than the bare response
+                std::cout << "RPC signer " << id << " caught: " << e.what() << std::endl;
+                if (response.binary) {
+                    response.setWrapped(makeBinaryFrame(response.requestHash, response.getSerializedBinary(),
+                                                        std::string_view()));
+                } else {
+                    response.setWrapped(response.getSerializedJson());
+                }
+            }
+            responseQueue.addToEnd(&response);
+        }
+    }
+}
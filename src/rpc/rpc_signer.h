@@ -0,0 +1,66 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "latest_block.h"
+#include "latest_block_cache.h"
+#include "methods/response.h"
+#include "../private_key.h"
+#include "../public_key.h"
+#include "../worker.h"
+#include "../util/concurrent_list.h"
+#include <memory_resource>
+#include <string>
+#include <string_view>
+
+namespace conclave
+{
+    namespace rpc
+    {
+        /***
+         * Pipeline stage between the `RpcProcessor`s and the `RpcDispatcher` which wraps every
+         * response in the signed envelope described in docs/rpc/Index.md. ECDSA signing is the
+         * expensive part of answering cheap requests, so it gets its own workers instead of
+         * running on the processors, and the chain tip comes from a `LatestBlockCache` instead
+         * of a fresh ElectrumX call per response.
+         */
+        class RpcSigner final : public Worker
+        {
+            public:
+            // Factories
+            static std::pmr::string wrap(Response&, const PrivateKey&, const PublicKey&, const LatestBlock&);
+            static std::pmr::string wrapBinary(Response&, const PrivateKey&, const PublicKey&, const LatestBlock&);
+            static const Hash256 getWrapperSigHash(const std::string_view, const PublicKey&,
+                                                   const Hash256&, const LatestBlock&);
+            // Constructors
+            RpcSigner(const unsigned int, const PrivateKey&, LatestBlockCache&,
+                      ConcurrentList<Response*>&, ConcurrentList<Response*>&);
+            private:
+            // Private Functions
+            void work() override final;
+            // Properties
+            const unsigned int id;
+            const PrivateKey& privateKey;
+            const PublicKey publicKey;
+            LatestBlockCache& latestBlockCache;
+            ConcurrentList<Response*>& signingQueue;
+            ConcurrentList<Response*>& responseQueue;
+        };
+    }
+}
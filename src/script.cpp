@@ -21,12 +21,86 @@
 #include "util/json.h"
 #include "util/serialization.h"
 #include "script.h"
+#include "crypto/sha256.h"
+#include <array>
+#include <stdexcept>
 
 namespace conclave
 {
     using namespace bc::system;
     using namespace bc::system::machine;
     
+    //
+    // Helpers
+    //
+    
+    // The handful of opcodes the byte-level code below needs
+    const static uint8_t OP_0 = 0x00;
+    const static uint8_t OP_PUSHDATA1 = 0x4c;
+    const static uint8_t OP_PUSHDATA2 = 0x4d;
+    const static uint8_t OP_PUSHDATA4 = 0x4e;
+    const static uint8_t OP_1 = 0x51;
+    const static uint8_t OP_16 = 0x60;
+    const static uint8_t OP_DROP = 0x75;
+    const static uint8_t OP_DUP = 0x76;
+    const static uint8_t OP_EQUAL = 0x87;
+    const static uint8_t OP_EQUALVERIFY = 0x88;
+    const static uint8_t OP_HASH160 = 0xa9;
+    const static uint8_t OP_CHECKSIG = 0xac;
+    const static uint8_t OP_CHECKMULTISIG = 0xae;
+    
+    // Sizes of the standard output scripts
+    const static size_t P2PKH_SIZE_BYTES = 3 + SMALL_HASH_SIZE_BYTES + 2;
+    const static size_t P2SH_SIZE_BYTES = 2 + SMALL_HASH_SIZE_BYTES + 1;
+    const static size_t P2WPKH_SIZE_BYTES = 2 + SMALL_HASH_SIZE_BYTES;
+    const static size_t P2WSH_SIZE_BYTES = 2 + LARGE_HASH_SIZE_BYTES;
+    
+    /***
+     * Builds `prefix <push of hash> suffix`, the shape of every pay-to-hash script
+     */
+    inline const static std::vector<BYTE> makePayToHashScript(const std::vector<BYTE>& prefix,
+                                                              const std::vector<BYTE>& hash,
+                                                              const std::vector<BYTE>& suffix)
+    {
+        std::vector<BYTE> script;
+        script.reserve(prefix.size() + 1 + hash.size() + suffix.size());
+        script.insert(script.end(), prefix.begin(), prefix.end());
+        script.push_back(static_cast<BYTE>(hash.size()));
+        script.insert(script.end(), hash.begin(), hash.end());
+        script.insert(script.end(), suffix.begin(), suffix.end());
+        return script;
+    }
+    
+    /***
+     * Walks a script's operations, calling `visit` with each one
+     * @return - false if the script ends in the middle of a push
+     */
+    template<typename F>
+    inline static bool forEachOperation(const BYTE* bytes, const size_t nBytes, F visit)
+    {
+        ByteReader reader(bytes, nBytes);
+        try {
+            while (reader.getRemaining() > 0) {
+                const uint8_t code = reader.readIntegral<uint8_t>();
+                size_t dataSize = 0;
+                if (code < OP_PUSHDATA1) {
+                    dataSize = code;
+                } else if (code == OP_PUSHDATA1) {
+                    dataSize = reader.readIntegral<uint8_t>();
+                } else if (code == OP_PUSHDATA2) {
+                    dataSize = reader.readIntegral<uint16_t>();
+                } else if (code == OP_PUSHDATA4) {
+                    dataSize = reader.readIntegral<uint32_t>();
+                }
+                const BYTE* data = reader.read(dataSize);
+                visit(ScriptOperation{code, data, dataSize});
+            }
+        } catch (const std::runtime_error&) {
+            return false;
+        }
+        return true;
+    }
+    
     //
     // Helpers For Constructors
     //
@@ -60,6 +134,11 @@ namespace conclave
         return vec;
     }
     
+    inline const static std::vector<BYTE> machineOpVectorToBytes(const std::vector<machine::operation>& ops)
+    {
+        return chain::script(ops).to_data(false);
+    }
+    
     //
     // Helpers For Casts
     //
@@ -78,12 +157,16 @@ namespace conclave
     // Factories
     //
     
+    Script Script::deserialize(ByteReader& reader)
+    {
+        const uint64_t len = reader.readVarInt();
+        const BYTE* bytes = reader.read(len);
+        return Script(bytes, len);
+    }
+    
     Script Script::deserialize(const std::vector<BYTE>& data, size_t& pos)
     {
-        size_t len = deserializeVarInt(data, pos);
-        Script ret = Script(std::vector<BYTE>(data.begin() + pos, data.begin() + pos + len));
-        pos += len;
-        return ret;
+        return deserializeFromByteVector<Script>(data, pos);
     }
     
     Script Script::deserialize(const std::vector<BYTE>& data)
@@ -120,55 +203,33 @@ namespace conclave
     
     Script Script::p2pkhScript(const Address& address)
     {
-        return Script(std::vector<machine::operation>{
-            opcode::dup,
-            opcode::hash160,
-            address.getHashData(),
-            opcode::equalverify,
-            opcode::checksig
-        });
+        return Script(makePayToHashScript({OP_DUP, OP_HASH160}, address.getHashData(), {OP_EQUALVERIFY, OP_CHECKSIG}));
     }
     
     Script Script::p2shScript(const Address& address)
     {
-        return Script(std::vector<machine::operation>{
-            opcode::hash160,
-            address.getHashData(),
-            opcode::equal
-        });
+        return Script(makePayToHashScript({OP_HASH160}, address.getHashData(), {OP_EQUAL}));
     }
     
     Script Script::p2wpkhScript(const Address& address)
     {
-        return Script(std::vector<machine::operation>{
-            opcode::push_size_0,
-            address.getHashData()
-        });
+        return Script(makePayToHashScript({OP_0}, address.getHashData(), {}));
     }
     
     Script Script::p2wshScript(const Address& address)
     {
-        return Script(std::vector<machine::operation>{
-            opcode::push_size_0,
-            address.getHashData()
-        });
+        return Script(makePayToHashScript({OP_0}, address.getHashData(), {}));
     }
     
     Script Script::p2shScript(const Script& script)
     {
-        return Script(std::vector<machine::operation>{
-            opcode::hash160,
-            static_cast<std::vector<BYTE>>(script.getHash160()),
-            opcode::equal
-        });
+        return Script(makePayToHashScript({OP_HASH160}, static_cast<std::vector<BYTE>>(script.getHash160()),
+                                          {OP_EQUAL}));
     }
     
     Script Script::p2wshScript(const Script& script)
     {
-        return Script(std::vector<machine::operation>{
-            opcode::push_size_0,
-            static_cast<std::vector<BYTE>>(script.getSingleSHA256())
-        });
+        return Script(makePayToHashScript({OP_0}, static_cast<std::vector<BYTE>>(script.getSingleSHA256()), {}));
     }
     
     //
@@ -176,22 +237,22 @@ namespace conclave
     //
     
     Script::Script()
-        : script()
+        : bytes()
     {
     }
     
     Script::Script(const std::vector<BYTE>& data)
-        : script(data, false)
+        : bytes(data.data(), data.size())
     {
     }
     
     Script::Script(const std::vector<ScriptElement>& seVec)
-        : Script(scriptElementVectorToMachineOpVector(seVec))
+        : Script(machineOpVectorToBytes(scriptElementVectorToMachineOpVector(seVec)))
     {
     }
     
     Script::Script(const std::vector<std::string>& strVec)
-        : Script(stringVectorToMachineOpVector(strVec))
+        : Script(machineOpVectorToBytes(stringVectorToMachineOpVector(strVec)))
     {
     }
     
@@ -210,18 +271,23 @@ namespace conclave
     {
     }
     
-    Script::Script(const std::vector<machine::operation>& operations)
-        : script(chain::script(operations))
+    Script::Script(const JsonValue& tree)
+        : Script(arrayToVectorOfPrimitives<std::string>(tree))
+    {
+    }
+    
+    Script::Script(const BYTE* data, const size_t size)
+        : bytes(data, size)
     {
     }
     
     Script::Script(const Script& other)
-        : script(other.script)
+        : bytes(other.bytes)
     {
     }
     
     Script::Script(Script&& other)
-        : script(std::move(other.script))
+        : bytes(std::move(other.bytes))
     {
     }
     
@@ -229,49 +295,235 @@ namespace conclave
     // Public Functions
     //
     
+    /***
+     * @return - The raw script bytes, without a length prefix
+     */
+    const BYTE* Script::data() const
+    {
+        return bytes.data();
+    }
+    
+    const size_t Script::size() const
+    {
+        return bytes.size();
+    }
+    
     const Hash160 Script::getHash160() const
     {
-        return Hash160::digest(script.to_data(false));
+        return Hash160::digest(bytes.data(), bytes.size());
     }
     
     const Hash256 Script::getHash256() const
     {
-        return Hash256::digest(script.to_data(false));
+        return Hash256::digest(bytes.data(), bytes.size());
     }
     
     const Hash256 Script::getSingleSHA256() const
     {
-        return sha256_hash(script.to_data(false));
+        std::array<BYTE, LARGE_HASH_SIZE_BYTES> hash;
+        crypto::sha256(bytes.data(), bytes.size(), hash.data());
+        return Hash256(hash);
     }
     
     const std::vector<BYTE> Script::serialize() const
     {
-        return script.to_data(true);
+        return serializeToByteVector(*this);
+    }
+    
+    void Script::serialize(ByteSink& sink) const
+    {
+        writeVarInt(sink, bytes.size());
+        sink.write(bytes.data(), bytes.size());
+    }
+    
+    const size_t Script::serializedSize() const
+    {
+        return varIntSize(bytes.size()) + bytes.size();
     }
     
     const std::string Script::toHexString() const
     {
-        return byteVectorToHexString(script.to_data(false));
+        return byteVectorToHexString(static_cast<std::vector<BYTE>>(*this));
     }
     
     const bool Script::isP2wsh() const
     {
         return (
-            (script.size() == 2) &&
-            (script[0].code() == opcode::push_size_0) &&
-            (script[1].data().size() == 32)
+            (bytes.size() == P2WSH_SIZE_BYTES) &&
+            (bytes[0] == OP_0) &&
+            (bytes[1] == LARGE_HASH_SIZE_BYTES)
         );
     }
     
     const std::optional<Hash256> Script::getP2wshHash() const
     {
         if (isP2wsh()) {
-            return Hash256(script[1].data());
+            return Hash256(bytes.data() + 2);
         } else {
             return std::nullopt;
         }
     }
     
+    const bool Script::isP2pkh() const
+    {
+        return (
+            (bytes.size() == P2PKH_SIZE_BYTES) &&
+            (bytes[0] == OP_DUP) &&
+            (bytes[1] == OP_HASH160) &&
+            (bytes[2] == SMALL_HASH_SIZE_BYTES) &&
+            (bytes[23] == OP_EQUALVERIFY) &&
+            (bytes[24] == OP_CHECKSIG)
+        );
+    }
+    
+    const std::optional<Hash160> Script::getP2pkhHash() const
+    {
+        if (isP2pkh()) {
+            return Hash160(bytes.data() + 3);
+        } else {
+            return std::nullopt;
+        }
+    }
+    
+    const bool Script::isP2wpkh() const
+    {
+        return (
+            (bytes.size() == P2WPKH_SIZE_BYTES) &&
+            (bytes[0] == OP_0) &&
+            (bytes[1] == SMALL_HASH_SIZE_BYTES)
+        );
+    }
+    
+    const std::optional<Hash160> Script::getP2wpkhHash() const
+    {
+        if (isP2wpkh()) {
+            return Hash160(bytes.data() + 2);
+        } else {
+            return std::nullopt;
+        }
+    }
+    
+    const bool Script::isP2sh() const
+    {
+        return (
+            (bytes.size() == P2SH_SIZE_BYTES) &&
+            (bytes[0] == OP_HASH160) &&
+            (bytes[1] == SMALL_HASH_SIZE_BYTES) &&
+            (bytes[22] == OP_EQUAL)
+        );
+    }
+    
+    const std::optional<Hash160> Script::getP2shHash() const
+    {
+        if (isP2sh()) {
+            return Hash160(bytes.data() + 2);
+        } else {
+            return std::nullopt;
+        }
+    }
+    
+    /***
+     * Parses an m-of-n CHECKMULTISIG script: `m <pubkey 1> ... <pubkey n> n checkmultisig`,
+     * optionally prefixed by `<data> drop` as claim scripts are.
+     * @return - m and the n public keys, or std::nullopt if the script has any other shape
+     */
+    const std::optional<std::pair<uint32_t, std::vector<PublicKey>>> Script::getMultisigParams() const
+    {
+        const std::optional<std::vector<ScriptOperation>> opsOp = getOperations();
+        if (!opsOp.has_value()) {
+            return std::nullopt;
+        }
+        const std::vector<ScriptOperation>& ops = *opsOp;
+        size_t pos = 0;
+        if (ops.size() >= 2 && ops[1].code == OP_DROP && ops[0].code <= OP_PUSHDATA4) {
+            pos = 2;
+        }
+        const auto smallNumber = [](const ScriptOperation& op) -> std::optional<uint32_t> {
+            if (op.code == OP_0) {
+                return 0;
+            }
+            if (op.code >= OP_1 && op.code <= OP_16) {
+                return static_cast<uint32_t>(op.code) - OP_1 + 1;
+            }
+            return std::nullopt;
+        };
+        if (ops.size() < pos + 3 || ops.back().code != OP_CHECKMULTISIG) {
+            return std::nullopt;
+        }
+        const std::optional<uint32_t> minSigs = smallNumber(ops[pos]);
+        const std::optional<uint32_t> nKeys = smallNumber(ops[ops.size() - 2]);
+        if (!minSigs.has_value() || !nKeys.has_value() || *nKeys != ops.size() - pos - 3 || *minSigs > *nKeys) {
+            return std::nullopt;
+        }
+        std::vector<PublicKey> publicKeys;
+        publicKeys.reserve(*nKeys);
+        for (size_t i = pos + 1; i < ops.size() - 2; i++) {
+            const ScriptOperation& op = ops[i];
+            const bool compressed = (op.dataSize == SECP256K1_PUBKEY_COMPRESSED_SIZE_BYTES) &&
+                                    (op.data[0] == 0x02 || op.data[0] == 0x03);
+            const bool uncompressed = (op.dataSize == SECP256K1_PUBKEY_UNCOMPRESSED_SIZE_BYTES) &&
+                                      (op.data[0] == 0x04);
+            if (!compressed && !uncompressed) {
+                return std::nullopt;
+            }
+            ByteReader reader(op.data, op.dataSize);
+            publicKeys.push_back(PublicKey::deserialize(reader));
+        }
+        return std::make_pair(*minSigs, publicKeys);
+    }
+    
+    /***
+     * Returns the data of every push in the script, in order, provided the
+     * script consists of data pushes only. This is the shape every scriptSig
+     * must have.
+     * @return - The pushed data, or std::nullopt if the script contains any
+     * non-push operation
+     */
+    const std::optional<std::vector<std::vector<BYTE>>> Script::getPushedData() const
+    {
+        std::vector<std::vector<BYTE>> pushedData;
+        bool pushOnly = true;
+        const bool wellFormed = forEachOperation(bytes.data(), bytes.size(), [&](const ScriptOperation& op) {
+            pushOnly = pushOnly && op.code <= OP_PUSHDATA4;
+            if (pushOnly) {
+                pushedData.emplace_back(op.data, op.data + op.dataSize);
+            }
+        });
+        if (!wellFormed || !pushOnly) {
+            return std::nullopt;
+        }
+        return pushedData;
+    }
+    
+    /***
+     * Parses the script into its operations
+     * @return - The operations, or std::nullopt if the script ends in the middle of a push
+     */
+    const std::optional<std::vector<ScriptOperation>> Script::getOperations() const
+    {
+        std::vector<ScriptOperation> ops;
+        const bool wellFormed = forEachOperation(bytes.data(), bytes.size(), [&ops](const ScriptOperation& op) {
+            ops.push_back(op);
+        });
+        if (!wellFormed) {
+            return std::nullopt;
+        }
+        return ops;
+    }
+    
+    /***
+     * Writes the script as an array of operation strings, the same as the ptree conversion
+     */
+    void Script::writeJson(JsonWriter& writer) const
+    {
+        const chain::script script(static_cast<std::vector<BYTE>>(*this), false);
+        writer.startArray();
+        for (const machine::operation& op: script.operations()) {
+            writer.string(op.to_string(0));
+        }
+        writer.endArray();
+    }
+    
     //
     // Conversions
     //
@@ -283,17 +535,17 @@ namespace conclave
     
     Script::operator std::string() const
     {
-        return script.to_string(0);
+        return chain::script(static_cast<std::vector<BYTE>>(*this), false).to_string(0);
     }
     
     Script::operator std::vector<BYTE>() const
     {
-        return script.to_data(false);
+        return std::vector<BYTE>(bytes.begin(), bytes.end());
     }
     
     Script::operator std::vector<std::string>() const
     {
-        return machineOpVectorToStringVector(script.operations());
+        return machineOpVectorToStringVector(chain::script(static_cast<std::vector<BYTE>>(*this), false).operations());
     }
     
     //
@@ -302,24 +554,24 @@ namespace conclave
     
     Script& Script::operator=(const Script& other)
     {
-        script = other.script;
+        bytes = other.bytes;
         return *this;
     }
     
     Script& Script::operator=(Script&& other)
     {
-        script = std::move(other.script);
+        bytes = std::move(other.bytes);
         return *this;
     }
     
     bool Script::operator==(const Script& other) const
     {
-        return (script == other.script);
+        return (bytes == other.bytes);
     }
     
     bool Script::operator!=(const Script& other) const
     {
-        return (script != other.script);
+        return (bytes != other.bytes);
     }
     
     std::ostream& operator<<(std::ostream& os, const Script& script)
@@ -23,23 +23,40 @@
 #include "address.h"
 #include "hash160.h"
 #include "hash256.h"
+#include "util/json_parser.h"
+#include "util/json_writer.h"
+#include "util/small_byte_vector.h"
 #include <boost/property_tree/ptree.hpp>
-#include <bitcoin/system.hpp>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <optional>
+#include <utility>
 
-namespace bc_chain = bc::system::chain;
 namespace pt = boost::property_tree;
 namespace conclave
 {
     /***
-     * Wrapper around libbitcoin's chain::script class
+     * One operation of a script. Pushes point at their data inside the script's bytes.
+     */
+    struct ScriptOperation final
+    {
+        uint8_t code;
+        const BYTE* data;
+        size_t dataSize;
+    };
+    
+    /***
+     * A script, held as its raw bytes. The common templates (P2PKH, P2SH, P2WPKH, P2WSH) are recognised by
+     * comparing bytes, and the bytes are only parsed into operations when something iterates over them. libbitcoin
+     * is only involved when converting to and from the human-readable form.
      */
     class Script final
     {
         public:
         // Factories
+        static Script deserialize(ByteReader&);
         static Script deserialize(const std::vector<BYTE>&, size_t&);
         static Script deserialize(const std::vector<BYTE>&);
         static Script p2hScript(const Address&);
@@ -57,16 +74,32 @@ namespace conclave
         Script(const std::string&);
         Script(const char*);
         Script(const pt::ptree&);
+        Script(const JsonValue&);
+        Script(const BYTE*, const size_t);
         Script(const Script&);
         Script(Script&&);
         // Public Functions
+        const BYTE* data() const;
+        const size_t size() const;
         const Hash160 getHash160() const;
         const Hash256 getHash256() const;
         const Hash256 getSingleSHA256() const;
         const std::vector<BYTE> serialize() const;
+        void serialize(ByteSink&) const;
+        void writeJson(JsonWriter&) const;
+        const size_t serializedSize() const;
         const std::string toHexString() const;
         const bool isP2wsh() const;
         const std::optional<Hash256> getP2wshHash() const;
+        const bool isP2pkh() const;
+        const std::optional<Hash160> getP2pkhHash() const;
+        const bool isP2wpkh() const;
+        const std::optional<Hash160> getP2wpkhHash() const;
+        const bool isP2sh() const;
+        const std::optional<Hash160> getP2shHash() const;
+        const std::optional<std::pair<uint32_t, std::vector<PublicKey>>> getMultisigParams() const;
+        const std::optional<std::vector<std::vector<BYTE>>> getPushedData() const;
+        const std::optional<std::vector<ScriptOperation>> getOperations() const;
         // Conversions
         explicit operator pt::ptree() const;
         explicit operator std::string() const;
@@ -78,10 +111,10 @@ namespace conclave
         bool operator==(const Script&) const;
         bool operator!=(const Script&) const;
         friend std::ostream& operator<<(std::ostream&, const Script&);
+        // Scripts up to this size are stored without a heap allocation. Covers every standard output script.
+        constexpr static size_t INLINE_SIZE_BYTES = 40;
         private:
-        // Private Constructors
-        Script(const std::vector<machine::operation>&); // Only used by factories
         // Properties
-        bc_chain::script script;
+        SmallByteVector<INLINE_SIZE_BYTES> bytes;
     };
 };
@@ -34,14 +34,19 @@ namespace conclave
     // Factories
     //
     
-    BitcoinInput BitcoinInput::deserialize(const std::vector<BYTE>& data, size_t& pos)
+    BitcoinInput BitcoinInput::deserialize(ByteReader& reader)
     {
-        const Outpoint outpoint = Outpoint::deserialize(data, pos);
-        const Script scriptSig = Script::deserialize(data, pos);
-        const uint32_t sequence = deserializeIntegral<uint32_t>(data, pos);
+        const Outpoint outpoint = Outpoint::deserialize(reader);
+        const Script scriptSig = Script::deserialize(reader);
+        const uint32_t sequence = reader.readIntegral<uint32_t>();
         return BitcoinInput(std::move(outpoint), std::move(scriptSig), sequence);
     }
     
+    BitcoinInput BitcoinInput::deserialize(const std::vector<BYTE>& data, size_t& pos)
+    {
+        return deserializeFromByteVector<BitcoinInput>(data, pos);
+    }
+    
     BitcoinInput BitcoinInput::deserialize(const std::vector<BYTE>& data)
     {
         size_t pos = 0;
@@ -69,6 +74,13 @@ namespace conclave
     {
     }
     
+    BitcoinInput::BitcoinInput(const JsonValue& tree)
+        : BitcoinInput(getObjectFromJson<Outpoint>(tree, JSONKEY_OUTPOINT),
+                       getObjectFromJson<Script>(tree, JSONKEY_SCRIPTSIG),
+                       getPrimitiveFromJson<uint32_t>(tree, JSONKEY_SEQUENCE))
+    {
+    }
+    
     BitcoinInput::BitcoinInput(const std::vector<BYTE>& data)
         : BitcoinInput(deserialize(data))
     {
@@ -90,21 +102,37 @@ namespace conclave
     
     const Hash256 BitcoinInput::getHash256() const
     {
-        return Hash256::digest(serialize());
+        Hash256Writer writer;
+        serialize(writer);
+        return writer.getHash256();
     }
     
     const std::vector<BYTE> BitcoinInput::serialize() const
     {
-        const std::vector<BYTE> outpointSerialized = outpoint.serialize();
-        const std::vector<BYTE> scriptSigSerialized = scriptSig.serialize();
-        const std::vector<BYTE> sequenceSerialized = serializeIntegral(sequence);
-        std::vector<BYTE> serialized(
-            outpointSerialized.size() + scriptSigSerialized.size() + sequenceSerialized.size());
-        size_t pos = 0;
-        writeToByteVector(serialized, outpointSerialized, pos);
-        writeToByteVector(serialized, scriptSigSerialized, pos);
-        writeToByteVector(serialized, sequenceSerialized, pos);
-        return serialized;
+        return serializeToByteVector(*this);
+    }
+    
+    void BitcoinInput::serialize(ByteSink& sink) const
+    {
+        outpoint.serialize(sink);
+        scriptSig.serialize(sink);
+        writeIntegral(sink, sequence);
+    }
+    
+    const size_t BitcoinInput::serializedSize() const
+    {
+        return outpoint.serializedSize() + scriptSig.serializedSize() + UINT32_SIZE_BYTES;
+    }
+    
+    void BitcoinInput::writeJson(JsonWriter& writer) const
+    {
+        writer.startObject();
+        writer.key(JSONKEY_OUTPOINT);
+        outpoint.writeJson(writer);
+        writer.key(JSONKEY_SCRIPTSIG);
+        scriptSig.writeJson(writer);
+        writer.key(JSONKEY_SEQUENCE).number(sequence);
+        writer.endObject();
     }
     
     //
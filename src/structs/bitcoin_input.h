@@ -35,18 +35,23 @@ namespace conclave
         const static std::string JSONKEY_SCRIPTSIG;
         const static std::string JSONKEY_SEQUENCE;
         // Factories
+        static BitcoinInput deserialize(ByteReader&);
         static BitcoinInput deserialize(const std::vector<BYTE>&, size_t&);
         static BitcoinInput deserialize(const std::vector<BYTE>&);
         // Constructors
         BitcoinInput(const Outpoint&, const Script&, const uint32_t);
         BitcoinInput(Outpoint&&, Script&&, const uint32_t);
         BitcoinInput(const pt::ptree&);
+        BitcoinInput(const JsonValue&);
         BitcoinInput(const std::vector<BYTE>&);
         BitcoinInput(const BitcoinInput&);
         BitcoinInput(BitcoinInput&&);
         // Public Functions
         const Hash256 getHash256() const;
         const std::vector<BYTE> serialize() const;
+        void serialize(ByteSink&) const;
+        void writeJson(JsonWriter&) const;
+        const size_t serializedSize() const;
         // Conversions
         explicit operator pt::ptree() const;
         explicit operator std::string() const;
@@ -33,13 +33,18 @@ namespace conclave
     // Factories
     //
     
-    BitcoinOutput BitcoinOutput::deserialize(const std::vector<BYTE>& data, size_t& pos)
+    BitcoinOutput BitcoinOutput::deserialize(ByteReader& reader)
     {
-        const uint64_t value = deserializeIntegral<uint64_t>(data, pos);
-        const Script scriptPubKey = Script::deserialize(data, pos);
+        const uint64_t value = reader.readIntegral<uint64_t>();
+        const Script scriptPubKey = Script::deserialize(reader);
         return BitcoinOutput(value, std::move(scriptPubKey));
     }
     
+    BitcoinOutput BitcoinOutput::deserialize(const std::vector<BYTE>& data, size_t& pos)
+    {
+        return deserializeFromByteVector<BitcoinOutput>(data, pos);
+    }
+    
     BitcoinOutput BitcoinOutput::deserialize(const std::vector<BYTE>& data)
     {
         size_t pos = 0;
@@ -66,6 +71,12 @@ namespace conclave
     {
     }
     
+    BitcoinOutput::BitcoinOutput(const JsonValue& tree)
+        : BitcoinOutput(getPrimitiveFromJson<uint64_t>(tree, JSONKEY_VALUE),
+                        getObjectFromJson<Script>(tree, JSONKEY_SCRIPTPUBKEY))
+    {
+    }
+    
     BitcoinOutput::BitcoinOutput(const std::vector<BYTE>& data)
         : BitcoinOutput(deserialize(data))
     {
@@ -87,18 +98,34 @@ namespace conclave
     
     const Hash256 BitcoinOutput::getHash256() const
     {
-        return Hash256::digest(serialize());
+        Hash256Writer writer;
+        serialize(writer);
+        return writer.getHash256();
     }
     
     const std::vector<BYTE> BitcoinOutput::serialize() const
     {
-        const std::vector<BYTE> valueSerialized = serializeIntegral(value);
-        const std::vector<BYTE> scriptPubKeySerialized = scriptPubKey.serialize();
-        std::vector<BYTE> serialized(valueSerialized.size() + scriptPubKeySerialized.size());
-        size_t pos = 0;
-        writeToByteVector(serialized, valueSerialized, pos);
-        writeToByteVector(serialized, scriptPubKeySerialized, pos);
-        return serialized;
+        return serializeToByteVector(*this);
+    }
+    
+    void BitcoinOutput::serialize(ByteSink& sink) const
+    {
+        writeIntegral(sink, value);
+        scriptPubKey.serialize(sink);
+    }
+    
+    const size_t BitcoinOutput::serializedSize() const
+    {
+        return UINT64_SIZE_BYTES + scriptPubKey.serializedSize();
+    }
+    
+    void BitcoinOutput::writeJson(JsonWriter& writer) const
+    {
+        writer.startObject();
+        writer.key(JSONKEY_VALUE).number(value);
+        writer.key(JSONKEY_SCRIPTPUBKEY);
+        scriptPubKey.writeJson(writer);
+        writer.endObject();
     }
     
     //
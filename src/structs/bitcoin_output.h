@@ -32,18 +32,23 @@ namespace conclave
         const static std::string JSONKEY_VALUE;
         const static std::string JSONKEY_SCRIPTPUBKEY;
         // Factories
+        static BitcoinOutput deserialize(ByteReader&);
         static BitcoinOutput deserialize(const std::vector<BYTE>&, size_t&);
         static BitcoinOutput deserialize(const std::vector<BYTE>&);
         // Constructors
         BitcoinOutput(const uint64_t, const Script&);
         BitcoinOutput(const uint64_t, Script&&);
         BitcoinOutput(const pt::ptree&);
+        BitcoinOutput(const JsonValue&);
         BitcoinOutput(const std::vector<BYTE>&);
         BitcoinOutput(const BitcoinOutput&);
         BitcoinOutput(BitcoinOutput&&);
         // Public functions
         const Hash256 getHash256() const;
         const std::vector<BYTE> serialize() const;
+        void serialize(ByteSink&) const;
+        void writeJson(JsonWriter&) const;
+        const size_t serializedSize() const;
         // Conversions
         explicit operator pt::ptree() const;
         explicit operator std::string() const;
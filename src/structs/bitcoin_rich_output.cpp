@@ -34,13 +34,18 @@ namespace conclave
     // Factories
     //
     
-    BitcoinRichOutput BitcoinRichOutput::deserialize(const std::vector<BYTE>& data, size_t& pos)
+    BitcoinRichOutput BitcoinRichOutput::deserialize(ByteReader& reader)
     {
-        Outpoint outpoint = Outpoint::deserialize(data, pos);
-        BitcoinOutput bitcoinOutput = BitcoinOutput::deserialize(data, pos);
+        Outpoint outpoint = Outpoint::deserialize(reader);
+        BitcoinOutput bitcoinOutput = BitcoinOutput::deserialize(reader);
         return BitcoinRichOutput(std::move(outpoint), std::move(bitcoinOutput));
     }
     
+    BitcoinRichOutput BitcoinRichOutput::deserialize(const std::vector<BYTE>& data, size_t& pos)
+    {
+        return deserializeFromByteVector<BitcoinRichOutput>(data, pos);
+    }
+    
     BitcoinRichOutput BitcoinRichOutput::deserialize(const std::vector<BYTE>& data)
     {
         size_t pos = 0;
@@ -88,18 +93,35 @@ namespace conclave
     
     const Hash256 BitcoinRichOutput::getHash256() const
     {
-        return Hash256::digest(serialize());
+        Hash256Writer writer;
+        serialize(writer);
+        return writer.getHash256();
     }
     
     const std::vector<BYTE> BitcoinRichOutput::serialize() const
     {
-        const std::vector<BYTE> outpointSerialized = outpoint.serialize();
-        const std::vector<BYTE> bitcoinOutputSerialized = bitcoinOutput.serialize();
-        std::vector<BYTE> serialized(outpointSerialized.size() + bitcoinOutputSerialized.size());
-        size_t pos = 0;
-        writeToByteVector(serialized, outpointSerialized, pos);
-        writeToByteVector(serialized, bitcoinOutputSerialized, pos);
-        return serialized;
+        return serializeToByteVector(*this);
+    }
+    
+    void BitcoinRichOutput::serialize(ByteSink& sink) const
+    {
+        outpoint.serialize(sink);
+        bitcoinOutput.serialize(sink);
+    }
+    
+    const size_t BitcoinRichOutput::serializedSize() const
+    {
+        return outpoint.serializedSize() + bitcoinOutput.serializedSize();
+    }
+    
+    void BitcoinRichOutput::writeJson(JsonWriter& writer) const
+    {
+        writer.startObject();
+        writer.key(JSONKEY_OUTPOINT);
+        outpoint.writeJson(writer);
+        writer.key(JSONKEY_BITCOIN_OUTPUT);
+        bitcoinOutput.writeJson(writer);
+        writer.endObject();
     }
     
     //
@@ -35,15 +35,20 @@ namespace conclave
     // Factories
     //
     
-    BitcoinTx BitcoinTx::deserialize(const std::vector<BYTE>& data, size_t& pos)
+    BitcoinTx BitcoinTx::deserialize(ByteReader& reader)
     {
-        const uint32_t version = deserializeIntegral<uint32_t>(data, pos);
-        const std::vector<BitcoinInput> inputs = deserializeVectorOfObjects<BitcoinInput>(data, pos);
-        const std::vector<BitcoinOutput> outputs = deserializeVectorOfObjects<BitcoinOutput>(data, pos);
-        const uint32_t lockTime = deserializeIntegral<uint32_t>(data, pos);
+        const uint32_t version = reader.readIntegral<uint32_t>();
+        const std::vector<BitcoinInput> inputs = readVectorOfObjects<BitcoinInput>(reader);
+        const std::vector<BitcoinOutput> outputs = readVectorOfObjects<BitcoinOutput>(reader);
+        const uint32_t lockTime = reader.readIntegral<uint32_t>();
         return BitcoinTx(version, std::move(inputs), std::move(outputs), lockTime);
     }
     
+    BitcoinTx BitcoinTx::deserialize(const std::vector<BYTE>& data, size_t& pos)
+    {
+        return deserializeFromByteVector<BitcoinTx>(data, pos);
+    }
+    
     BitcoinTx BitcoinTx::deserialize(const std::vector<BYTE>& data)
     {
         size_t pos = 0;
@@ -75,6 +80,15 @@ namespace conclave
     {
     }
     
+    BitcoinTx::BitcoinTx(const JsonValue& tree)
+        : BitcoinTx(
+        getPrimitiveFromJson<uint32_t>(tree, JSONKEY_VERSION),
+        getVectorOfObjectsFromJson<BitcoinInput>(tree, JSONKEY_INPUTS),
+        getVectorOfObjectsFromJson<BitcoinOutput>(tree, JSONKEY_OUTPUTS),
+        getPrimitiveFromJson<uint32_t>(tree, JSONKEY_LOCKTIME))
+    {
+    }
+    
     BitcoinTx::BitcoinTx(const std::vector<BYTE>& data)
         : BitcoinTx(deserialize(data))
     {
@@ -96,25 +110,38 @@ namespace conclave
     
     const Hash256 BitcoinTx::getHash256() const
     {
-        return Hash256::digest(serialize());
+        Hash256Writer writer;
+        serialize(writer);
+        return writer.getHash256();
     }
     
     const std::vector<BYTE> BitcoinTx::serialize() const
     {
-        const std::vector<BYTE> versionSerialized = serializeIntegral(version);
-        const std::vector<BYTE> inputsSerialized = serializeVectorOfObjects(inputs);
-        const std::vector<BYTE> outputsSerialized = serializeVectorOfObjects(outputs);
-        const std::vector<BYTE> lockTimeSerialized = serializeIntegral(lockTime);
-        std::vector<BYTE> serialized(
-            versionSerialized.size() + inputsSerialized.size() +
-            outputsSerialized.size() + lockTimeSerialized.size()
-        );
-        size_t pos = 0;
-        writeToByteVector(serialized, versionSerialized, pos);
-        writeToByteVector(serialized, inputsSerialized, pos);
-        writeToByteVector(serialized, outputsSerialized, pos);
-        writeToByteVector(serialized, lockTimeSerialized, pos);
-        return serialized;
+        return serializeToByteVector(*this);
+    }
+    
+    void BitcoinTx::serialize(ByteSink& sink) const
+    {
+        writeIntegral(sink, version);
+        writeVectorOfObjects(sink, inputs);
+        writeVectorOfObjects(sink, outputs);
+        writeIntegral(sink, lockTime);
+    }
+    
+    const size_t BitcoinTx::serializedSize() const
+    {
+        return sizeof(version) + vectorOfObjectsSerializedSize(inputs) + vectorOfObjectsSerializedSize(outputs) +
+               sizeof(lockTime);
+    }
+    
+    void BitcoinTx::writeJson(JsonWriter& writer) const
+    {
+        writer.startObject();
+        writer.key(JSONKEY_VERSION).number(version);
+        writer.key(JSONKEY_INPUTS).objects(inputs);
+        writer.key(JSONKEY_OUTPUTS).objects(outputs);
+        writer.key(JSONKEY_LOCKTIME).number(lockTime);
+        writer.endObject();
     }
     
     //
@@ -21,6 +21,8 @@
 #include <boost/property_tree/ptree.hpp>
 #include "bitcoin_input.h"
 #include "bitcoin_output.h"
+#include "../util/json_parser.h"
+#include "../util/json_writer.h"
 #include <cstdint>
 #include <vector>
 
@@ -34,18 +36,23 @@ namespace conclave
         const static std::string JSONKEY_OUTPUTS;
         const static std::string JSONKEY_LOCKTIME;
         // Factories
+        static BitcoinTx deserialize(ByteReader&);
         static BitcoinTx deserialize(const std::vector<BYTE>&, size_t&);
         static BitcoinTx deserialize(const std::vector<BYTE>&);
         // Constructors
         BitcoinTx(const uint32_t, const std::vector<BitcoinInput>&, const std::vector<BitcoinOutput>&, const uint32_t);
         BitcoinTx(const uint32_t, std::vector<BitcoinInput>&&, std::vector<BitcoinOutput>&&, const uint32_t);
         BitcoinTx(const pt::ptree&);
+        BitcoinTx(const JsonValue&);
         BitcoinTx(const std::vector<BYTE>&);
         BitcoinTx(const BitcoinTx&);
         BitcoinTx(BitcoinTx&&);
         // Public Functions
         const Hash256 getHash256() const;
         const std::vector<BYTE> serialize() const;
+        void serialize(ByteSink&) const;
+        void writeJson(JsonWriter&) const;
+        const size_t serializedSize() const;
         // Conversions
         explicit operator pt::ptree() const;
         explicit operator std::string() const;
@@ -0,0 +1,421 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "compact_encoding.h"
+#include "../util/serialization.h"
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace conclave
+{
+    namespace compact
+    {
+        //
+        // Helpers
+        //
+        
+        // A varint never needs more than 10 base-128 digits to hold 64 bits
+        const static size_t MAX_VARINT_SIZE_BYTES = 10;
+        const static uint8_t FLAG_ABSENT = 0x00;
+        const static uint8_t FLAG_PRESENT = 0x01;
+        
+        /***
+         * A standard scriptPubKey: fixed bytes around a single pushed hash
+         */
+        struct ScriptTemplate
+        {
+            std::vector<BYTE> prefix;
+            size_t hashSize;
+            std::vector<BYTE> suffix;
+        };
+        
+        // A script is stored as its index in this table followed by its hash, or, if it matches none of them, as
+        // (its size + the table size) followed by its bytes. Append only: the indexes are part of the format.
+        const static std::array<ScriptTemplate, 4> SCRIPT_TEMPLATES{{
+            {{0x76, 0xa9, 0x14}, SMALL_HASH_SIZE_BYTES, {0x88, 0xac}}, // P2PKH
+            {{0xa9, 0x14}, SMALL_HASH_SIZE_BYTES, {0x87}},             // P2SH
+            {{0x00, 0x14}, SMALL_HASH_SIZE_BYTES, {}},                 // P2WPKH
+            {{0x00, 0x20}, LARGE_HASH_SIZE_BYTES, {}}                  // P2WSH
+        }};
+        
+        static const bool matchesTemplate(const Script& script, const ScriptTemplate& scriptTemplate)
+        {
+            const size_t suffixPos = scriptTemplate.prefix.size() + scriptTemplate.hashSize;
+            return script.size() == suffixPos + scriptTemplate.suffix.size() &&
+                   std::equal(scriptTemplate.prefix.begin(), scriptTemplate.prefix.end(), script.data()) &&
+                   std::equal(scriptTemplate.suffix.begin(), scriptTemplate.suffix.end(), script.data() + suffixPos);
+        }
+        
+        static const uint32_t readUint32(ByteReader& reader)
+        {
+            const uint64_t value = readCompactInt(reader);
+            CONCLAVE_ASSERT(value <= std::numeric_limits<uint32_t>::max(), "varint does not fit in 32 bits");
+            return static_cast<uint32_t>(value);
+        }
+        
+        static const bool readFlag(ByteReader& reader)
+        {
+            const uint8_t flag = reader.readIntegral<uint8_t>();
+            CONCLAVE_ASSERT(flag == FLAG_ABSENT || flag == FLAG_PRESENT, "invalid presence flag: " +
+                                                                         std::to_string(flag));
+            return flag == FLAG_PRESENT;
+        }
+        
+        template<typename T, typename F>
+        static void writeVector(ByteSink& sink, const std::vector<T>& items, F writeItem)
+        {
+            writeCompactInt(sink, items.size());
+            for (const T& item : items) {
+                writeItem(sink, item);
+            }
+        }
+        
+        template<typename T, typename F>
+        static std::vector<T> readVector(ByteReader& reader, F readItem)
+        {
+            const uint64_t nItems = readCompactInt(reader);
+            std::vector<T> items;
+            // Every item takes at least a byte, which bounds a corrupt count
+            items.reserve(std::min<uint64_t>(nItems, reader.getRemaining()));
+            for (uint64_t i = 0; i < nItems; i++) {
+                items.emplace_back(readItem(reader));
+            }
+            return items;
+        }
+        
+        //
+        // Integers
+        //
+        
+        /***
+         * Writes `value` as little-endian base-128 digits, the high bit of each byte marking that another follows
+         */
+        void writeCompactInt(ByteSink& sink, const uint64_t value)
+        {
+            BYTE buffer[MAX_VARINT_SIZE_BYTES];
+            size_t size = 0;
+            uint64_t remaining = value;
+            while (remaining >= 0x80) {
+                buffer[size++] = static_cast<BYTE>(remaining | 0x80);
+                remaining >>= 7;
+            }
+            buffer[size++] = static_cast<BYTE>(remaining);
+            sink.write(buffer, size);
+        }
+        
+        /***
+         * Reads a varint written by writeCompactInt(). Overlong and overflowing encodings are rejected, so that every
+         * value has exactly one encoding.
+         */
+        const uint64_t readCompactInt(ByteReader& reader)
+        {
+            uint64_t value = 0;
+            for (size_t i = 0; i < MAX_VARINT_SIZE_BYTES; i++) {
+                const uint8_t byte = reader.readIntegral<uint8_t>();
+                const uint64_t digit = byte & 0x7f;
+                CONCLAVE_ASSERT(i + 1 < MAX_VARINT_SIZE_BYTES || digit <= 1, "varint overflows 64 bits");
+                value |= digit << (7 * i);
+                if ((byte & 0x80) == 0) {
+                    CONCLAVE_ASSERT(i == 0 || byte != 0, "varint is not minimally encoded");
+                    return value;
+                }
+            }
+            throw std::runtime_error("varint overflows 64 bits");
+        }
+        
+        //
+        // Scripts
+        //
+        
+        void writeScript(ByteSink& sink, const Script& script)
+        {
+            for (size_t i = 0; i < SCRIPT_TEMPLATES.size(); i++) {
+                if (matchesTemplate(script, SCRIPT_TEMPLATES[i])) {
+                    writeCompactInt(sink, i);
+                    sink.write(script.data() + SCRIPT_TEMPLATES[i].prefix.size(), SCRIPT_TEMPLATES[i].hashSize);
+                    return;
+                }
+            }
+            writeCompactInt(sink, script.size() + SCRIPT_TEMPLATES.size());
+            sink.write(script.data(), script.size());
+        }
+        
+        const Script readScript(ByteReader& reader)
+        {
+            const uint64_t tag = readCompactInt(reader);
+            if (tag < SCRIPT_TEMPLATES.size()) {
+                const ScriptTemplate& scriptTemplate = SCRIPT_TEMPLATES[tag];
+                const BYTE* hash = reader.read(scriptTemplate.hashSize);
+                std::vector<BYTE> bytes;
+                bytes.reserve(scriptTemplate.prefix.size() + scriptTemplate.hashSize + scriptTemplate.suffix.size());
+                bytes.insert(bytes.end(), scriptTemplate.prefix.begin(), scriptTemplate.prefix.end());
+                bytes.insert(bytes.end(), hash, hash + scriptTemplate.hashSize);
+                bytes.insert(bytes.end(), scriptTemplate.suffix.begin(), scriptTemplate.suffix.end());
+                return Script(bytes);
+            }
+            const uint64_t size = tag - SCRIPT_TEMPLATES.size();
+            const BYTE* bytes = reader.read(size);
+            return Script(bytes, size);
+        }
+        
+        void skipScript(ByteReader& reader)
+        {
+            const uint64_t tag = readCompactInt(reader);
+            if (tag < SCRIPT_TEMPLATES.size()) {
+                reader.skip(SCRIPT_TEMPLATES[tag].hashSize);
+            } else {
+                reader.skip(tag - SCRIPT_TEMPLATES.size());
+            }
+        }
+        
+        //
+        // Keys
+        //
+        
+        void writePublicKey(ByteSink& sink, const PublicKey& publicKey)
+        {
+            // PublicKey's own serialization is already the 33 byte compressed form
+            publicKey.serialize(sink);
+        }
+        
+        const PublicKey readPublicKey(ByteReader& reader)
+        {
+            const uint8_t leadingByte = reader.readIntegral<uint8_t>();
+            CONCLAVE_ASSERT(leadingByte == 0x02 || leadingByte == 0x03, "public key is not compressed");
+            const Hash256 x = Hash256::deserialize(reader).reversed();
+            return PublicKey(x, leadingByte == 0x03);
+        }
+        
+        void skipPublicKey(ByteReader& reader)
+        {
+            reader.skip(SECP256K1_PUBKEY_COMPRESSED_SIZE_BYTES);
+        }
+        
+        //
+        // Points
+        //
+        
+        void writeOutpoint(ByteSink& sink, const Outpoint& outpoint)
+        {
+            outpoint.txId.serialize(sink);
+            writeCompactInt(sink, outpoint.index);
+        }
+        
+        const Outpoint readOutpoint(ByteReader& reader)
+        {
+            const Hash256 txId = Hash256::deserialize(reader);
+            const uint32_t index = readUint32(reader);
+            return Outpoint(txId, index);
+        }
+        
+        void skipOutpoint(ByteReader& reader)
+        {
+            reader.skip(LARGE_HASH_SIZE_BYTES);
+            readCompactInt(reader);
+        }
+        
+        void writeOptionalOutpoint(ByteSink& sink, const std::optional<Outpoint>& outpoint)
+        {
+            writeIntegral<uint8_t>(sink, outpoint.has_value() ? FLAG_PRESENT : FLAG_ABSENT);
+            if (outpoint.has_value()) {
+                writeOutpoint(sink, *outpoint);
+            }
+        }
+        
+        const std::optional<Outpoint> readOptionalOutpoint(ByteReader& reader)
+        {
+            if (readFlag(reader)) {
+                return readOutpoint(reader);
+            } else {
+                return std::nullopt;
+            }
+        }
+        
+        void skipOptionalOutpoint(ByteReader& reader)
+        {
+            if (readFlag(reader)) {
+                skipOutpoint(reader);
+            }
+        }
+        
+        void writeInpoint(ByteSink& sink, const Inpoint& inpoint)
+        {
+            inpoint.txId.serialize(sink);
+            writeCompactInt(sink, inpoint.index);
+        }
+        
+        const Inpoint readInpoint(ByteReader& reader)
+        {
+            const Hash256 txId = Hash256::deserialize(reader);
+            const uint32_t index = readUint32(reader);
+            return Inpoint(txId, index);
+        }
+        
+        void writeOptionalInpoint(ByteSink& sink, const std::optional<Inpoint>& inpoint)
+        {
+            writeIntegral<uint8_t>(sink, inpoint.has_value() ? FLAG_PRESENT : FLAG_ABSENT);
+            if (inpoint.has_value()) {
+                writeInpoint(sink, *inpoint);
+            }
+        }
+        
+        const std::optional<Inpoint> readOptionalInpoint(ByteReader& reader)
+        {
+            if (readFlag(reader)) {
+                return readInpoint(reader);
+            } else {
+                return std::nullopt;
+            }
+        }
+        
+        void skipOptionalInpoint(ByteReader& reader)
+        {
+            if (readFlag(reader)) {
+                reader.skip(LARGE_HASH_SIZE_BYTES);
+                readCompactInt(reader);
+            }
+        }
+        
+        //
+        // Inputs and Outputs
+        //
+        
+        void writeConclaveInput(ByteSink& sink, const ConclaveInput& conclaveInput)
+        {
+            // Sequences are usually 0xffffffff, which a varint would only make longer
+            writeOutpoint(sink, conclaveInput.outpoint);
+            writeScript(sink, conclaveInput.scriptSig);
+            writeIntegral<uint32_t>(sink, conclaveInput.sequence);
+            writeOptionalInpoint(sink, conclaveInput.predecessor);
+        }
+        
+        const ConclaveInput readConclaveInput(ByteReader& reader)
+        {
+            Outpoint outpoint = readOutpoint(reader);
+            Script scriptSig = readScript(reader);
+            const uint32_t sequence = reader.readIntegral<uint32_t>();
+            std::optional<Inpoint> predecessor = readOptionalInpoint(reader);
+            return ConclaveInput(std::move(outpoint), std::move(scriptSig), sequence, std::move(predecessor));
+        }
+        
+        void skipConclaveInput(ByteReader& reader)
+        {
+            skipOutpoint(reader);
+            skipScript(reader);
+            reader.skip(UINT32_SIZE_BYTES);
+            skipOptionalInpoint(reader);
+        }
+        
+        void writeBitcoinOutput(ByteSink& sink, const BitcoinOutput& bitcoinOutput)
+        {
+            writeCompactInt(sink, bitcoinOutput.value);
+            writeScript(sink, bitcoinOutput.scriptPubKey);
+        }
+        
+        const BitcoinOutput readBitcoinOutput(ByteReader& reader)
+        {
+            const uint64_t value = readCompactInt(reader);
+            Script scriptPubKey = readScript(reader);
+            return BitcoinOutput(value, std::move(scriptPubKey));
+        }
+        
+        void skipBitcoinOutput(ByteReader& reader)
+        {
+            readCompactInt(reader);
+            skipScript(reader);
+        }
+        
+        void writeConclaveOutput(ByteSink& sink, const ConclaveOutput& conclaveOutput)
+        {
+            writeScript(sink, conclaveOutput.scriptPubKey);
+            writeCompactInt(sink, conclaveOutput.value);
+            writeOptionalOutpoint(sink, conclaveOutput.predecessor);
+        }
+        
+        const ConclaveOutput readConclaveOutput(ByteReader& reader)
+        {
+            Script scriptPubKey = readScript(reader);
+            const uint64_t value = readCompactInt(reader);
+            std::optional<Outpoint> predecessor = readOptionalOutpoint(reader);
+            return ConclaveOutput(std::move(scriptPubKey), value, std::move(predecessor));
+        }
+        
+        void skipConclaveOutput(ByteReader& reader)
+        {
+            skipScript(reader);
+            readCompactInt(reader);
+            skipOptionalOutpoint(reader);
+        }
+        
+        //
+        // Transactions
+        //
+        
+        void writeConclaveTx(ByteSink& sink, const ConclaveTx& conclaveTx)
+        {
+            writeCompactInt(sink, conclaveTx.version);
+            writeCompactInt(sink, conclaveTx.lockTime);
+            writeCompactInt(sink, conclaveTx.minSigs);
+            writeOptionalOutpoint(sink, conclaveTx.fundPoint);
+            writeVector(sink, conclaveTx.trustees, writePublicKey);
+            writeVector(sink, conclaveTx.conclaveInputs, writeConclaveInput);
+            writeVector(sink, conclaveTx.bitcoinOutputs, writeBitcoinOutput);
+            writeVector(sink, conclaveTx.conclaveOutputs, writeConclaveOutput);
+        }
+        
+        const ConclaveTx readConclaveTx(ByteReader& reader)
+        {
+            const uint32_t version = readUint32(reader);
+            const uint32_t lockTime = readUint32(reader);
+            const uint32_t minSigs = readUint32(reader);
+            const std::optional<Outpoint> fundPoint = readOptionalOutpoint(reader);
+            const std::vector<PublicKey> trustees = readVector<PublicKey>(reader, readPublicKey);
+            const std::vector<ConclaveInput> conclaveInputs = readVector<ConclaveInput>(reader, readConclaveInput);
+            const std::vector<BitcoinOutput> bitcoinOutputs = readVector<BitcoinOutput>(reader, readBitcoinOutput);
+            const std::vector<ConclaveOutput> conclaveOutputs =
+                readVector<ConclaveOutput>(reader, readConclaveOutput);
+            return ConclaveTx(version, lockTime, minSigs, fundPoint, trustees, conclaveInputs, bitcoinOutputs,
+                              conclaveOutputs);
+        }
+        
+        const std::vector<BYTE> serializeConclaveTx(const ConclaveTx& conclaveTx)
+        {
+            // The consensus size is only a bound for typical transactions, so it is a reservation, not a buffer
+            std::vector<BYTE> serialized;
+            serialized.reserve(conclaveTx.serializedSize());
+            ByteVectorSink sink(serialized);
+            writeConclaveTx(sink, conclaveTx);
+            return serialized;
+        }
+        
+        /***
+         * @param data - A transaction's compact encoding, and nothing more
+         */
+        const ConclaveTx deserializeConclaveTx(const std::vector<BYTE>& data)
+        {
+            ByteReader reader(data);
+            const ConclaveTx conclaveTx = readConclaveTx(reader);
+            CONCLAVE_ASSERT(reader.getRemaining() == 0, "trailing bytes after compact transaction");
+            return conclaveTx;
+        }
+    }
+}
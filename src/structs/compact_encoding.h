@@ -0,0 +1,90 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "outpoint.h"
+#include "inpoint.h"
+#include "conclave_input.h"
+#include "bitcoin_output.h"
+#include "conclave_output.h"
+#include "conclave_tx.h"
+#include "../script.h"
+#include "../util/byte_reader.h"
+#include "../util/byte_sink.h"
+#include "../conclave.h"
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+/**
+ * Compact encoding used to store transactions in the database. It is a storage format only: transactions are still
+ * identified, hashed and signed over their consensus serialization, and every compact encoding decodes back to a
+ * transaction whose consensus serialization is exactly the one that was encoded.
+ *
+ * Compared to the consensus serialization:
+ *  - Integers (versions, amounts, indexes, counts) are base-128 varints instead of fixed width
+ *  - Standard scriptPubKeys (P2PKH, P2SH, P2WPKH, P2WSH) are a one byte template tag plus their hash
+ *  - Optional fields are a one byte flag instead of a length prefix
+ *  - Trustee keys are always stored compressed
+ */
+
+namespace conclave
+{
+    namespace compact
+    {
+        // Integers
+        void writeCompactInt(ByteSink&, const uint64_t);
+        const uint64_t readCompactInt(ByteReader&);
+        // Scripts
+        void writeScript(ByteSink&, const Script&);
+        const Script readScript(ByteReader&);
+        void skipScript(ByteReader&);
+        // Keys
+        void writePublicKey(ByteSink&, const PublicKey&);
+        const PublicKey readPublicKey(ByteReader&);
+        void skipPublicKey(ByteReader&);
+        // Points
+        void writeOutpoint(ByteSink&, const Outpoint&);
+        const Outpoint readOutpoint(ByteReader&);
+        void skipOutpoint(ByteReader&);
+        void writeOptionalOutpoint(ByteSink&, const std::optional<Outpoint>&);
+        const std::optional<Outpoint> readOptionalOutpoint(ByteReader&);
+        void skipOptionalOutpoint(ByteReader&);
+        void writeInpoint(ByteSink&, const Inpoint&);
+        const Inpoint readInpoint(ByteReader&);
+        void writeOptionalInpoint(ByteSink&, const std::optional<Inpoint>&);
+        const std::optional<Inpoint> readOptionalInpoint(ByteReader&);
+        void skipOptionalInpoint(ByteReader&);
+        // Inputs and Outputs
+        void writeConclaveInput(ByteSink&, const ConclaveInput&);
+        const ConclaveInput readConclaveInput(ByteReader&);
+        void skipConclaveInput(ByteReader&);
+        void writeBitcoinOutput(ByteSink&, const BitcoinOutput&);
+        const BitcoinOutput readBitcoinOutput(ByteReader&);
+        void skipBitcoinOutput(ByteReader&);
+        void writeConclaveOutput(ByteSink&, const ConclaveOutput&);
+        const ConclaveOutput readConclaveOutput(ByteReader&);
+        void skipConclaveOutput(ByteReader&);
+        // Transactions
+        void writeConclaveTx(ByteSink&, const ConclaveTx&);
+        const ConclaveTx readConclaveTx(ByteReader&);
+        const std::vector<BYTE> serializeConclaveTx(const ConclaveTx&);
+        const ConclaveTx deserializeConclaveTx(const std::vector<BYTE>&);
+    }
+}
@@ -35,15 +35,20 @@ namespace conclave
     // Factories
     //
     
-    ConclaveInput ConclaveInput::deserialize(const std::vector<BYTE>& data, size_t& pos)
+    ConclaveInput ConclaveInput::deserialize(ByteReader& reader)
     {
-        const Outpoint outpoint = Outpoint::deserialize(data, pos);
-        const Script scriptSig = Script::deserialize(data, pos);
-        const uint32_t sequence = deserializeIntegral<uint32_t>(data, pos);
-        const std::optional<Inpoint> predecessor = deserializeOptionalObject<Inpoint>(data, pos);
+        const Outpoint outpoint = Outpoint::deserialize(reader);
+        const Script scriptSig = Script::deserialize(reader);
+        const uint32_t sequence = reader.readIntegral<uint32_t>();
+        const std::optional<Inpoint> predecessor = readOptionalObject<Inpoint>(reader);
         return ConclaveInput(std::move(outpoint), std::move(scriptSig), sequence, std::move(predecessor));
     }
     
+    ConclaveInput ConclaveInput::deserialize(const std::vector<BYTE>& data, size_t& pos)
+    {
+        return deserializeFromByteVector<ConclaveInput>(data, pos);
+    }
+    
     ConclaveInput ConclaveInput::deserialize(const std::vector<BYTE>& data)
     {
         size_t pos = 0;
@@ -98,6 +103,14 @@ namespace conclave
     {
     }
     
+    ConclaveInput::ConclaveInput(const JsonValue& tree)
+        : outpoint(getObjectFromJson<Outpoint>(tree, JSONKEY_OUTPOINT)),
+          scriptSig(getObjectFromJson<Script>(tree, JSONKEY_SCRIPTSIG)),
+          sequence(getPrimitiveFromJson<uint32_t>(tree, JSONKEY_SEQUENCE)),
+          predecessor(getOptionalObjectFromJson<Inpoint>(tree, JSONKEY_PREDECESSOR))
+    {
+    }
+    
     ConclaveInput::ConclaveInput(const std::vector<BYTE>& data)
         : ConclaveInput(deserialize(data))
     {
@@ -120,24 +133,43 @@ namespace conclave
     
     const Hash256 ConclaveInput::getHash256() const
     {
-        return Hash256::digest(serialize());
+        Hash256Writer writer;
+        serialize(writer);
+        return writer.getHash256();
     }
     
     const std::vector<BYTE> ConclaveInput::serialize() const
     {
-        const std::vector<BYTE> outpointSerialized = outpoint.serialize();
-        const std::vector<BYTE> scriptSigSerialized = scriptSig.serialize();
-        const std::vector<BYTE> sequenceSerialized = serializeIntegral(sequence);
-        const std::vector<BYTE> predecessorSerialized = serializeOptionalObject(predecessor);
-        std::vector<BYTE> serialized(
-            outpointSerialized.size() + scriptSigSerialized.size() + sequenceSerialized.size() +
-            predecessorSerialized.size());
-        size_t pos = 0;
-        writeToByteVector(serialized, outpointSerialized, pos);
-        writeToByteVector(serialized, scriptSigSerialized, pos);
-        writeToByteVector(serialized, sequenceSerialized, pos);
-        writeToByteVector(serialized, predecessorSerialized, pos);
-        return serialized;
+        return serializeToByteVector(*this);
+    }
+    
+    void ConclaveInput::serialize(ByteSink& sink) const
+    {
+        outpoint.serialize(sink);
+        scriptSig.serialize(sink);
+        writeIntegral(sink, sequence);
+        writeOptionalObject(sink, predecessor);
+    }
+    
+    const size_t ConclaveInput::serializedSize() const
+    {
+        return outpoint.serializedSize() + scriptSig.serializedSize() + UINT32_SIZE_BYTES +
+               optionalObjectSerializedSize(predecessor);
+    }
+    
+    void ConclaveInput::writeJson(JsonWriter& writer) const
+    {
+        writer.startObject();
+        writer.key(JSONKEY_OUTPOINT);
+        outpoint.writeJson(writer);
+        writer.key(JSONKEY_SCRIPTSIG);
+        scriptSig.writeJson(writer);
+        writer.key(JSONKEY_SEQUENCE).number(sequence);
+        if (predecessor.has_value()) {
+            writer.key(JSONKEY_PREDECESSOR);
+            predecessor->writeJson(writer);
+        }
+        writer.endObject();
     }
     
     //
@@ -38,6 +38,7 @@ namespace conclave
         const static std::string JSONKEY_SEQUENCE;
         const static std::string JSONKEY_PREDECESSOR;
         // Factories
+        static ConclaveInput deserialize(ByteReader&);
         static ConclaveInput deserialize(const std::vector<BYTE>&, size_t&);
         static ConclaveInput deserialize(const std::vector<BYTE>&);
         // Constructors
@@ -48,12 +49,16 @@ namespace conclave
         ConclaveInput(const Outpoint&, const Script&, const uint32_t, const std::optional<Inpoint>&);
         ConclaveInput(Outpoint&&, Script&&, const uint32_t, std::optional<Inpoint>&&);
         ConclaveInput(const pt::ptree&);
+        ConclaveInput(const JsonValue&);
         ConclaveInput(const std::vector<BYTE>&);
         ConclaveInput(const ConclaveInput&);
         ConclaveInput(ConclaveInput&&);
         // Public Functions
         const Hash256 getHash256() const;
         const std::vector<BYTE> serialize() const;
+        void serialize(ByteSink&) const;
+        void writeJson(JsonWriter&) const;
+        const size_t serializedSize() const;
         // Conversions
         explicit operator pt::ptree() const;
         explicit operator std::string() const;
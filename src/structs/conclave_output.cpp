@@ -34,14 +34,19 @@ namespace conclave
     // Factories
     //
     
-    ConclaveOutput ConclaveOutput::deserialize(const std::vector<BYTE>& data, size_t& pos)
+    ConclaveOutput ConclaveOutput::deserialize(ByteReader& reader)
     {
-        const Script scriptPubKey = Script::deserialize(data, pos);
-        const uint64_t value = deserializeIntegral<uint64_t>(data, pos);
-        const std::optional<Outpoint> predecessor = deserializeOptionalObject<Outpoint>(data, pos);
+        const Script scriptPubKey = Script::deserialize(reader);
+        const uint64_t value = reader.readIntegral<uint64_t>();
+        const std::optional<Outpoint> predecessor = readOptionalObject<Outpoint>(reader);
         return ConclaveOutput(std::move(scriptPubKey), value, std::move(predecessor));
     }
     
+    ConclaveOutput ConclaveOutput::deserialize(const std::vector<BYTE>& data, size_t& pos)
+    {
+        return deserializeFromByteVector<ConclaveOutput>(data, pos);
+    }
+    
     ConclaveOutput ConclaveOutput::deserialize(const std::vector<BYTE>& data)
     {
         size_t pos = 0;
@@ -90,6 +95,13 @@ namespace conclave
     {
     }
     
+    ConclaveOutput::ConclaveOutput(const JsonValue& tree)
+        : ConclaveOutput(std::move(getObjectFromJson<Script>(tree, JSONKEY_SCRIPTPUBKEY)),
+                         getPrimitiveFromJson<uint64_t>(tree, JSONKEY_VALUE),
+                         std::move(getOptionalObjectFromJson<Outpoint>(tree, JSONKEY_PREDECESSOR)))
+    {
+    }
+    
     ConclaveOutput::ConclaveOutput(const std::vector<BYTE>& data)
         : ConclaveOutput(deserialize(data))
     {
@@ -111,21 +123,39 @@ namespace conclave
     
     const Hash256 ConclaveOutput::getHash256() const
     {
-        return Hash256::digest(serialize());
+        Hash256Writer writer;
+        serialize(writer);
+        return writer.getHash256();
     }
     
     const std::vector<BYTE> ConclaveOutput::serialize() const
     {
-        const std::vector<BYTE> scriptPubKeySerialized = scriptPubKey.serialize();
-        const std::vector<BYTE> valueSerialized = serializeIntegral(value);
-        const std::vector<BYTE> predecessorSerialized = serializeOptionalObject(predecessor);
-        std::vector<BYTE> serialized(
-            scriptPubKeySerialized.size() + valueSerialized.size() + predecessorSerialized.size());
-        size_t pos = 0;
-        writeToByteVector(serialized, scriptPubKeySerialized, pos);
-        writeToByteVector(serialized, valueSerialized, pos);
-        writeToByteVector(serialized, predecessorSerialized, pos);
-        return serialized;
+        return serializeToByteVector(*this);
+    }
+    
+    void ConclaveOutput::serialize(ByteSink& sink) const
+    {
+        scriptPubKey.serialize(sink);
+        writeIntegral(sink, value);
+        writeOptionalObject(sink, predecessor);
+    }
+    
+    const size_t ConclaveOutput::serializedSize() const
+    {
+        return scriptPubKey.serializedSize() + UINT64_SIZE_BYTES + optionalObjectSerializedSize(predecessor);
+    }
+    
+    void ConclaveOutput::writeJson(JsonWriter& writer) const
+    {
+        writer.startObject();
+        writer.key(JSONKEY_SCRIPTPUBKEY);
+        scriptPubKey.writeJson(writer);
+        writer.key(JSONKEY_VALUE).number(value);
+        if (predecessor.has_value()) {
+            writer.key(JSONKEY_PREDECESSOR);
+            predecessor->writeJson(writer);
+        }
+        writer.endObject();
     }
     
     //
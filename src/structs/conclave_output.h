@@ -35,6 +35,7 @@ namespace conclave
         const static std::string JSONKEY_VALUE;
         const static std::string JSONKEY_PREDECESSOR;
         // Factories
+        static ConclaveOutput deserialize(ByteReader&);
         static ConclaveOutput deserialize(const std::vector<BYTE>&, size_t&);
         static ConclaveOutput deserialize(const std::vector<BYTE>&);
         // Constructors
@@ -45,12 +46,16 @@ namespace conclave
         ConclaveOutput(const Script&, const uint64_t, const std::optional<Outpoint>&);
         ConclaveOutput(Script&&, const uint64_t, std::optional<Outpoint>&&);
         ConclaveOutput(const pt::ptree&);
+        ConclaveOutput(const JsonValue&);
         ConclaveOutput(const std::vector<BYTE>&);
         ConclaveOutput(const ConclaveOutput&);
         ConclaveOutput(ConclaveOutput&&);
         // Public Functions
         const Hash256 getHash256() const;
         const std::vector<BYTE> serialize() const;
+        void serialize(ByteSink&) const;
+        void writeJson(JsonWriter&) const;
+        const size_t serializedSize() const;
         // Conversions
         explicit operator pt::ptree() const;
         explicit operator std::string() const;
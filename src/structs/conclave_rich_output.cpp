@@ -34,13 +34,18 @@ namespace conclave
     // Factories
     //
     
-    ConclaveRichOutput ConclaveRichOutput::deserialize(const std::vector<BYTE>& data, size_t& pos)
+    ConclaveRichOutput ConclaveRichOutput::deserialize(ByteReader& reader)
     {
-        Outpoint outpoint = Outpoint::deserialize(data, pos);
-        ConclaveOutput conclaveOutput = ConclaveOutput::deserialize(data, pos);
+        Outpoint outpoint = Outpoint::deserialize(reader);
+        ConclaveOutput conclaveOutput = ConclaveOutput::deserialize(reader);
         return ConclaveRichOutput(std::move(outpoint), std::move(conclaveOutput));
     }
     
+    ConclaveRichOutput ConclaveRichOutput::deserialize(const std::vector<BYTE>& data, size_t& pos)
+    {
+        return deserializeFromByteVector<ConclaveRichOutput>(data, pos);
+    }
+    
     ConclaveRichOutput ConclaveRichOutput::deserialize(const std::vector<BYTE>& data)
     {
         size_t pos = 0;
@@ -88,18 +93,35 @@ namespace conclave
     
     const Hash256 ConclaveRichOutput::getHash256() const
     {
-        return Hash256::digest(serialize());
+        Hash256Writer writer;
+        serialize(writer);
+        return writer.getHash256();
     }
     
     const std::vector<BYTE> ConclaveRichOutput::serialize() const
     {
-        const std::vector<BYTE> outpointSerialized = outpoint.serialize();
-        const std::vector<BYTE> conclaveOutputSerialized = conclaveOutput.serialize();
-        std::vector<BYTE> serialized(outpointSerialized.size() + conclaveOutputSerialized.size());
-        size_t pos = 0;
-        writeToByteVector(serialized, outpointSerialized, pos);
-        writeToByteVector(serialized, conclaveOutputSerialized, pos);
-        return serialized;
+        return serializeToByteVector(*this);
+    }
+    
+    void ConclaveRichOutput::serialize(ByteSink& sink) const
+    {
+        outpoint.serialize(sink);
+        conclaveOutput.serialize(sink);
+    }
+    
+    const size_t ConclaveRichOutput::serializedSize() const
+    {
+        return outpoint.serializedSize() + conclaveOutput.serializedSize();
+    }
+    
+    void ConclaveRichOutput::writeJson(JsonWriter& writer) const
+    {
+        writer.startObject();
+        writer.key(JSONKEY_OUTPOINT);
+        outpoint.writeJson(writer);
+        writer.key(JSONKEY_CONCLAVE_OUTPUT);
+        conclaveOutput.writeJson(writer);
+        writer.endObject();
     }
     
     //
@@ -32,6 +32,7 @@ namespace conclave
         const static std::string JSONKEY_OUTPOINT;
         const static std::string JSONKEY_CONCLAVE_OUTPUT;
         // Factories
+        static ConclaveRichOutput deserialize(ByteReader&);
         static ConclaveRichOutput deserialize(const std::vector<BYTE>&, size_t&);
         static ConclaveRichOutput deserialize(const std::vector<BYTE>&);
         // Constructors
@@ -44,6 +45,9 @@ namespace conclave
         // Public Functions
         const Hash256 getHash256() const;
         const std::vector<BYTE> serialize() const;
+        void serialize(ByteSink&) const;
+        void writeJson(JsonWriter&) const;
+        const size_t serializedSize() const;
         // Conversions
         explicit operator pt::ptree() const;
         explicit operator std::string() const;
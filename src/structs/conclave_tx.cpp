@@ -17,6 +17,7 @@
  */
 
 #include "conclave_tx.h"
+#include "sig_hash_context.h"
 #include "../util/json.h"
 #include "../util/serialization.h"
 
@@ -39,20 +40,25 @@ namespace conclave
     // Factories
     //
     
-    ConclaveTx ConclaveTx::deserialize(const std::vector<BYTE>& data, size_t& pos)
+    ConclaveTx ConclaveTx::deserialize(ByteReader& reader)
     {
-        const uint32_t version = deserializeIntegral<uint32_t>(data, pos);
-        const uint32_t lockTime = deserializeIntegral<uint32_t>(data, pos);
-        const uint32_t minSigs = deserializeIntegral<uint32_t>(data, pos);
-        const std::optional<Outpoint> fundPoint = deserializeOptionalObject<Outpoint>(data, pos);
-        const std::vector<PublicKey> trustees = deserializeVectorOfObjects<PublicKey>(data, pos);
-        const std::vector<ConclaveInput> conclaveInputs = deserializeVectorOfObjects<ConclaveInput>(data, pos);
-        const std::vector<BitcoinOutput> bitcoinOutputs = deserializeVectorOfObjects<BitcoinOutput>(data, pos);
-        const std::vector<ConclaveOutput> conclaveOutputs = deserializeVectorOfObjects<ConclaveOutput>(data, pos);
+        const uint32_t version = reader.readIntegral<uint32_t>();
+        const uint32_t lockTime = reader.readIntegral<uint32_t>();
+        const uint32_t minSigs = reader.readIntegral<uint32_t>();
+        const std::optional<Outpoint> fundPoint = readOptionalObject<Outpoint>(reader);
+        const std::vector<PublicKey> trustees = readVectorOfObjects<PublicKey>(reader);
+        const std::vector<ConclaveInput> conclaveInputs = readVectorOfObjects<ConclaveInput>(reader);
+        const std::vector<BitcoinOutput> bitcoinOutputs = readVectorOfObjects<BitcoinOutput>(reader);
+        const std::vector<ConclaveOutput> conclaveOutputs = readVectorOfObjects<ConclaveOutput>(reader);
         return ConclaveTx(version, lockTime, minSigs, fundPoint, trustees, conclaveInputs, bitcoinOutputs,
                           conclaveOutputs);
     }
     
+    ConclaveTx ConclaveTx::deserialize(const std::vector<BYTE>& data, size_t& pos)
+    {
+        return deserializeFromByteVector<ConclaveTx>(data, pos);
+    }
+    
     ConclaveTx ConclaveTx::deserialize(const std::vector<BYTE>& data)
     {
         size_t pos = 0;
@@ -118,6 +124,18 @@ namespace conclave
     {
     }
     
+    ConclaveTx::ConclaveTx(const JsonValue& tree)
+        : ConclaveTx(getPrimitiveFromJson<uint32_t>(tree, JSONKEY_VERSION),
+                     getPrimitiveFromJson<uint32_t>(tree, JSONKEY_LOCK_TIME),
+                     getPrimitiveFromJson<uint32_t>(tree, JSONKEY_MIN_SIGS),
+                     getOptionalObjectFromJson<Outpoint>(tree, JSONKEY_FUND_POINT),
+                     getVectorOfPrimitivesFromJson<PublicKey>(tree, JSONKEY_TRUSTEES),
+                     getVectorOfObjectsFromJson<ConclaveInput>(tree, JSONKEY_CONCLAVE_INPUTS),
+                     getVectorOfObjectsFromJson<BitcoinOutput>(tree, JSONKEY_BITCOIN_OUTPUTS),
+                     getVectorOfObjectsFromJson<ConclaveOutput>(tree, JSONKEY_CONCLAVE_OUTPUTS))
+    {
+    }
+    
     ConclaveTx::ConclaveTx(const std::vector<BYTE>& data)
         : ConclaveTx(deserialize(data))
     {
@@ -142,34 +160,50 @@ namespace conclave
     
     const Hash256 ConclaveTx::getHash256(const bool preFund) const
     {
-        return Hash256::digest(serialize(preFund));
+        Hash256Writer writer;
+        serialize(writer, preFund);
+        return writer.getHash256();
     }
     
     const std::vector<BYTE> ConclaveTx::serialize(const bool preFund) const
     {
-        const std::optional<Outpoint> fundPoint = preFund ? std::nullopt : this->fundPoint;
-        const std::vector<BYTE> versionSerialized = serializeIntegral<uint32_t>(version);
-        const std::vector<BYTE> lockTimeSerialized = serializeIntegral<uint32_t>(lockTime);
-        const std::vector<BYTE> minSigsSerialized = serializeIntegral<uint32_t>(minSigs);
-        const std::vector<BYTE> fundPointSerialized = serializeOptionalObject<Outpoint>(fundPoint);
-        const std::vector<BYTE> trusteesSerialized = serializeVectorOfObjects<PublicKey>(trustees);
-        const std::vector<BYTE> conclaveInputsSerialized = serializeVectorOfObjects<ConclaveInput>(conclaveInputs);
-        const std::vector<BYTE> bitcoinOutputsSerialized = serializeVectorOfObjects<BitcoinOutput>(bitcoinOutputs);
-        const std::vector<BYTE> conclaveOutputsSerialized = serializeVectorOfObjects<ConclaveOutput>(conclaveOutputs);
-        std::vector<BYTE> serialized(versionSerialized.size() + lockTimeSerialized.size() +
-                                     minSigsSerialized.size() + fundPointSerialized.size() +
-                                     trusteesSerialized.size() + conclaveInputsSerialized.size() +
-                                     bitcoinOutputsSerialized.size() + conclaveOutputsSerialized.size());
-        size_t pos = 0;
-        writeToByteVector(serialized, versionSerialized, pos);
-        writeToByteVector(serialized, lockTimeSerialized, pos);
-        writeToByteVector(serialized, minSigsSerialized, pos);
-        writeToByteVector(serialized, fundPointSerialized, pos);
-        writeToByteVector(serialized, trusteesSerialized, pos);
-        writeToByteVector(serialized, conclaveInputsSerialized, pos);
-        writeToByteVector(serialized, bitcoinOutputsSerialized, pos);
-        writeToByteVector(serialized, conclaveOutputsSerialized, pos);
-        return serialized;
+        return serializeToByteVector(*this, preFund);
+    }
+    
+    void ConclaveTx::serialize(ByteSink& sink, const bool preFund) const
+    {
+        writeIntegral<uint32_t>(sink, version);
+        writeIntegral<uint32_t>(sink, lockTime);
+        writeIntegral<uint32_t>(sink, minSigs);
+        writeOptionalObject<Outpoint>(sink, preFund ? std::nullopt : fundPoint);
+        writeVectorOfObjects<PublicKey>(sink, trustees);
+        writeVectorOfObjects<ConclaveInput>(sink, conclaveInputs);
+        writeVectorOfObjects<BitcoinOutput>(sink, bitcoinOutputs);
+        writeVectorOfObjects<ConclaveOutput>(sink, conclaveOutputs);
+    }
+    
+    const size_t ConclaveTx::serializedSize(const bool preFund) const
+    {
+        return 3 * UINT32_SIZE_BYTES +
+               optionalObjectSerializedSize<Outpoint>(preFund ? std::nullopt : fundPoint) +
+               vectorOfObjectsSerializedSize<PublicKey>(trustees) +
+               vectorOfObjectsSerializedSize<ConclaveInput>(conclaveInputs) +
+               vectorOfObjectsSerializedSize<BitcoinOutput>(bitcoinOutputs) +
+               vectorOfObjectsSerializedSize<ConclaveOutput>(conclaveOutputs);
+    }
+    
+    /***
+     * Computes the message which the owner of the output spent by the given input signs.
+     * Use a SigHashContext directly when computing the sighash of more than one input.
+     * @param inputIndex - Index of the input being signed
+     * @param scriptCode - scriptPubKey (or redeem script) of the output being spent
+     * @param value - Value of the output being spent
+     * @return - The hash to be signed
+     */
+    const Hash256 ConclaveTx::getSigHash(const size_t inputIndex, const Script& scriptCode,
+                                         const uint64_t value) const
+    {
+        return SigHashContext(*this).getSigHash(inputIndex, scriptCode, value);
     }
     
     const bool ConclaveTx::isClaimTx() const
@@ -215,6 +249,31 @@ namespace conclave
         return getBitcoinOutputValue() + getConclaveOutputValue();
     }
     
+    void ConclaveTx::writeJson(JsonWriter& writer) const
+    {
+        writer.startObject();
+        writer.key(JSONKEY_VERSION).number(version);
+        writer.key(JSONKEY_LOCK_TIME).number(lockTime);
+        writer.key(JSONKEY_MIN_SIGS).number(minSigs);
+        if (fundPoint.has_value()) {
+            writer.key(JSONKEY_FUND_POINT);
+            fundPoint->writeJson(writer);
+        }
+        if (trustees.size() > 0) {
+            writer.key(JSONKEY_TRUSTEES).strings(trustees);
+        }
+        if (conclaveInputs.size() > 0) {
+            writer.key(JSONKEY_CONCLAVE_INPUTS).objects(conclaveInputs);
+        }
+        if (bitcoinOutputs.size() > 0) {
+            writer.key(JSONKEY_BITCOIN_OUTPUTS).objects(bitcoinOutputs);
+        }
+        if (conclaveOutputs.size() > 0) {
+            writer.key(JSONKEY_CONCLAVE_OUTPUTS).objects(conclaveOutputs);
+        }
+        writer.endObject();
+    }
+    
     //
     // Conversions
     //
@@ -25,6 +25,8 @@
 #include "conclave_output.h"
 #include "../hash256.h"
 #include "../public_key.h"
+#include "../util/json_parser.h"
+#include "../util/json_writer.h"
 #include "../util/serialization.h"
 #include "../conclave.h"
 #include <optional>
@@ -46,6 +48,7 @@ namespace conclave
         const static std::string JSONKEY_BITCOIN_OUTPUTS;
         const static std::string JSONKEY_CONCLAVE_OUTPUTS;
         // Factories
+        static ConclaveTx deserialize(ByteReader&);
         static ConclaveTx deserialize(const std::vector<BYTE>&, size_t&);
         static ConclaveTx deserialize(const std::vector<BYTE>&);
         // Constructors
@@ -60,12 +63,17 @@ namespace conclave
                    const std::vector<PublicKey>&, const std::vector<ConclaveInput>&, const std::vector<BitcoinOutput>&,
                    const std::vector<ConclaveOutput>&);
         ConclaveTx(const pt::ptree&);
+        ConclaveTx(const JsonValue&);
         ConclaveTx(const std::vector<BYTE>&);
         ConclaveTx(const ConclaveTx&);
         ConclaveTx(ConclaveTx&&);
         // Public Functions
         const Hash256 getHash256(const bool = false) const;
         const std::vector<BYTE> serialize(const bool = false) const;
+        void serialize(ByteSink&, const bool = false) const;
+        void writeJson(JsonWriter&) const;
+        const size_t serializedSize(const bool = false) const;
+        const Hash256 getSigHash(const size_t, const Script&, const uint64_t) const;
         const bool isClaimTx() const;
         const Script getClaimScript() const;
         const uint64_t getBitcoinOutputValue() const;
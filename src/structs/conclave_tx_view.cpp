@@ -0,0 +1,233 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "conclave_tx_view.h"
+#include "compact_encoding.h"
+#include <algorithm>
+#include <string>
+#include <utility>
+
+namespace conclave
+{
+    //
+    // Helpers
+    //
+    
+    // Order of the fields at the start of a compact ConclaveTx
+    const static size_t VERSION_FIELD = 0;
+    const static size_t LOCK_TIME_FIELD = 1;
+    const static size_t MIN_SIGS_FIELD = 2;
+    const static size_t FUND_POINT_FIELD = 3;
+    
+    /***
+     * Walks a count-prefixed vector of objects, recording where each one starts
+     */
+    template<typename F>
+    inline static std::vector<size_t> indexEach(ByteReader& reader, F skipItem)
+    {
+        const uint64_t nItems = compact::readCompactInt(reader);
+        std::vector<size_t> offsets;
+        offsets.reserve(std::min<uint64_t>(nItems, reader.getRemaining()));
+        for (uint64_t i = 0; i < nItems; i++) {
+            offsets.push_back(reader.getPosition());
+            skipItem(reader);
+        }
+        return offsets;
+    }
+    
+    //
+    // Constructors
+    //
+    
+    /***
+     * @param data - A ConclaveTx's compact encoding, as stored in the database
+     */
+    ConclaveTxView::ConclaveTxView(std::vector<BYTE> data)
+        : data(std::move(data)), indexed(false)
+    {
+    }
+    
+    //
+    // Public Functions
+    //
+    
+    /***
+     * The transaction's ID. The stored bytes are not what it hashes, so this decodes the whole transaction.
+     */
+    const Hash256 ConclaveTxView::getHash256() const
+    {
+        return toConclaveTx().getHash256();
+    }
+    
+    const uint32_t ConclaveTxView::getVersion() const
+    {
+        ByteReader reader = headerFieldReader(VERSION_FIELD);
+        return static_cast<uint32_t>(compact::readCompactInt(reader));
+    }
+    
+    const uint32_t ConclaveTxView::getLockTime() const
+    {
+        ByteReader reader = headerFieldReader(LOCK_TIME_FIELD);
+        return static_cast<uint32_t>(compact::readCompactInt(reader));
+    }
+    
+    const uint32_t ConclaveTxView::getMinSigs() const
+    {
+        ByteReader reader = headerFieldReader(MIN_SIGS_FIELD);
+        return static_cast<uint32_t>(compact::readCompactInt(reader));
+    }
+    
+    const std::optional<Outpoint> ConclaveTxView::getFundPoint() const
+    {
+        ByteReader reader = headerFieldReader(FUND_POINT_FIELD);
+        return compact::readOptionalOutpoint(reader);
+    }
+    
+    const size_t ConclaveTxView::getNumConclaveInputs() const
+    {
+        buildIndex();
+        return conclaveInputOffsets.size();
+    }
+    
+    const size_t ConclaveTxView::getNumBitcoinOutputs() const
+    {
+        buildIndex();
+        return bitcoinOutputOffsets.size();
+    }
+    
+    const size_t ConclaveTxView::getNumConclaveOutputs() const
+    {
+        buildIndex();
+        return conclaveOutputOffsets.size();
+    }
+    
+    const ConclaveInput ConclaveTxView::getConclaveInput(const size_t index) const
+    {
+        ByteReader reader = conclaveInputReader(index);
+        return compact::readConclaveInput(reader);
+    }
+    
+    const Outpoint ConclaveTxView::getConclaveInputOutpoint(const size_t index) const
+    {
+        ByteReader reader = conclaveInputReader(index);
+        return compact::readOutpoint(reader);
+    }
+    
+    const std::optional<Inpoint> ConclaveTxView::getConclaveInputPredecessor(const size_t index) const
+    {
+        ByteReader reader = conclaveInputReader(index);
+        compact::skipOutpoint(reader);
+        compact::skipScript(reader);
+        reader.skip(UINT32_SIZE_BYTES);
+        return compact::readOptionalInpoint(reader);
+    }
+    
+    const BitcoinOutput ConclaveTxView::getBitcoinOutput(const size_t index) const
+    {
+        ByteReader reader = bitcoinOutputReader(index);
+        return compact::readBitcoinOutput(reader);
+    }
+    
+    const ConclaveOutput ConclaveTxView::getConclaveOutput(const size_t index) const
+    {
+        ByteReader reader = conclaveOutputReader(index);
+        return compact::readConclaveOutput(reader);
+    }
+    
+    const uint64_t ConclaveTxView::getConclaveOutputValue(const size_t index) const
+    {
+        ByteReader reader = conclaveOutputReader(index);
+        compact::skipScript(reader);
+        return compact::readCompactInt(reader);
+    }
+    
+    const std::optional<Outpoint> ConclaveTxView::getConclaveOutputPredecessor(const size_t index) const
+    {
+        ByteReader reader = conclaveOutputReader(index);
+        compact::skipScript(reader);
+        compact::readCompactInt(reader);
+        return compact::readOptionalOutpoint(reader);
+    }
+    
+    /***
+     * Decodes the whole transaction
+     */
+    const ConclaveTx ConclaveTxView::toConclaveTx() const
+    {
+        return compact::deserializeConclaveTx(data);
+    }
+    
+    //
+    // Private Functions
+    //
+    
+    void ConclaveTxView::buildIndex() const
+    {
+        if (indexed) {
+            return;
+        }
+        ByteReader reader = headerFieldReader(FUND_POINT_FIELD);
+        compact::skipOptionalOutpoint(reader);
+        const uint64_t nTrustees = compact::readCompactInt(reader);
+        for (uint64_t i = 0; i < nTrustees; i++) {
+            compact::skipPublicKey(reader);
+        }
+        conclaveInputOffsets = indexEach(reader, compact::skipConclaveInput);
+        bitcoinOutputOffsets = indexEach(reader, compact::skipBitcoinOutput);
+        conclaveOutputOffsets = indexEach(reader, compact::skipConclaveOutput);
+        indexed = true;
+    }
+    
+    ByteReader ConclaveTxView::readerAt(const size_t offset) const
+    {
+        return ByteReader(data, offset);
+    }
+    
+    /***
+     * The header's integers are varints, so a header field is found by skipping the ones before it
+     */
+    ByteReader ConclaveTxView::headerFieldReader(const size_t field) const
+    {
+        ByteReader reader = readerAt(0);
+        for (size_t i = 0; i < field; i++) {
+            compact::readCompactInt(reader);
+        }
+        return reader;
+    }
+    
+    ByteReader ConclaveTxView::conclaveInputReader(const size_t index) const
+    {
+        buildIndex();
+        CONCLAVE_ASSERT(index < conclaveInputOffsets.size(), "input index out of range: " + std::to_string(index));
+        return readerAt(conclaveInputOffsets[index]);
+    }
+    
+    ByteReader ConclaveTxView::bitcoinOutputReader(const size_t index) const
+    {
+        buildIndex();
+        CONCLAVE_ASSERT(index < bitcoinOutputOffsets.size(), "output index out of range: " + std::to_string(index));
+        return readerAt(bitcoinOutputOffsets[index]);
+    }
+    
+    ByteReader ConclaveTxView::conclaveOutputReader(const size_t index) const
+    {
+        buildIndex();
+        CONCLAVE_ASSERT(index < conclaveOutputOffsets.size(), "output index out of range: " + std::to_string(index));
+        return readerAt(conclaveOutputOffsets[index]);
+    }
+}
@@ -0,0 +1,85 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "outpoint.h"
+#include "inpoint.h"
+#include "conclave_input.h"
+#include "bitcoin_output.h"
+#include "conclave_output.h"
+#include "conclave_tx.h"
+#include "../hash256.h"
+#include "../util/byte_reader.h"
+#include "../conclave.h"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace conclave
+{
+    /***
+     * Read-only view over a ConclaveTx in its compact storage encoding (see compact_encoding.h). Nothing is decoded
+     * up front: the first access to an input or output walks the encoding once, skipping over trustees and scripts,
+     * and records where each input and output starts. Individual inputs, outputs or single fields of them are then
+     * decoded straight from the bytes on demand.
+     *
+     * Use this where only a few fields of a stored transaction are needed - following predecessor links, say -
+     * and ConclaveTx where the whole transaction is.
+     *
+     * NOTE: The index is built lazily from const functions, so a view must not be shared between threads.
+     */
+    class ConclaveTxView final
+    {
+        public:
+        // Constructors
+        ConclaveTxView(std::vector<BYTE>);
+        // Public Functions
+        const Hash256 getHash256() const;
+        const uint32_t getVersion() const;
+        const uint32_t getLockTime() const;
+        const uint32_t getMinSigs() const;
+        const std::optional<Outpoint> getFundPoint() const;
+        const size_t getNumConclaveInputs() const;
+        const size_t getNumBitcoinOutputs() const;
+        const size_t getNumConclaveOutputs() const;
+        const ConclaveInput getConclaveInput(const size_t) const;
+        const Outpoint getConclaveInputOutpoint(const size_t) const;
+        const std::optional<Inpoint> getConclaveInputPredecessor(const size_t) const;
+        const BitcoinOutput getBitcoinOutput(const size_t) const;
+        const ConclaveOutput getConclaveOutput(const size_t) const;
+        const uint64_t getConclaveOutputValue(const size_t) const;
+        const std::optional<Outpoint> getConclaveOutputPredecessor(const size_t) const;
+        const ConclaveTx toConclaveTx() const;
+        private:
+        // Private Functions
+        void buildIndex() const;
+        ByteReader readerAt(const size_t) const;
+        ByteReader headerFieldReader(const size_t) const;
+        ByteReader conclaveInputReader(const size_t) const;
+        ByteReader bitcoinOutputReader(const size_t) const;
+        ByteReader conclaveOutputReader(const size_t) const;
+        // Properties
+        const std::vector<BYTE> data;
+        mutable bool indexed;
+        mutable std::vector<size_t> conclaveInputOffsets;
+        mutable std::vector<size_t> bitcoinOutputOffsets;
+        mutable std::vector<size_t> conclaveOutputOffsets;
+    };
+}
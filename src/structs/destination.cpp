@@ -35,6 +35,12 @@ namespace conclave
     {
     }
     
+    Destination::Destination(const JsonValue& tree)
+        : Destination(getPrimitiveFromJson<std::string>(tree, JSONKEY_ADDRESS),
+                      getPrimitiveFromJson<uint64_t>(tree, JSONKEY_VALUE))
+    {
+    }
+    
     Destination::operator pt::ptree() const
     {
         pt::ptree tree;
@@ -35,6 +35,7 @@ namespace conclave
         // Constructors
         Destination(const Address&, const uint64_t);
         Destination(const pt::ptree&);
+        Destination(const JsonValue&);
         // Operators
         explicit operator pt::ptree() const;
         explicit operator std::string() const;
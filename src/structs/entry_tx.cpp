@@ -34,6 +34,16 @@ namespace conclave
     {
     }
     
+    void EntryTx::writeJson(JsonWriter& writer) const
+    {
+        writer.startObject();
+        writer.key(JSONKEY_FUND_TX);
+        fundTx.writeJson(writer);
+        writer.key(JSONKEY_CLAIM_TX);
+        claimTx.writeJson(writer);
+        writer.endObject();
+    }
+    
     EntryTx::operator pt::ptree() const
     {
         pt::ptree tree;
@@ -31,6 +31,8 @@ namespace conclave
         // Constructors
         EntryTx(const BitcoinTx&, const ConclaveTx&);
         EntryTx(const pt::ptree&);
+        // Public Functions
+        void writeJson(JsonWriter&) const;
         // Operators
         explicit operator pt::ptree() const;
         explicit operator std::string() const;
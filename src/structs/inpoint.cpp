@@ -34,13 +34,18 @@ namespace conclave
     // Factories
     //
     
-    Inpoint Inpoint::deserialize(const std::vector<BYTE>& data, size_t& pos)
+    Inpoint Inpoint::deserialize(ByteReader& reader)
     {
-        Hash256 txId = Hash256::deserialize(data, pos);
-        uint32_t index = deserializeIntegral<uint32_t>(data, pos);
+        Hash256 txId = Hash256::deserialize(reader);
+        uint32_t index = reader.readIntegral<uint32_t>();
         return Inpoint(txId, index);
     }
     
+    Inpoint Inpoint::deserialize(const std::vector<BYTE>& data, size_t& pos)
+    {
+        return deserializeFromByteVector<Inpoint>(data, pos);
+    }
+    
     Inpoint Inpoint::deserialize(const std::vector<BYTE>& data)
     {
         size_t pos = 0;
@@ -62,6 +67,12 @@ namespace conclave
     {
     }
     
+    Inpoint::Inpoint(const JsonValue& tree)
+        : Inpoint(getPrimitiveFromJson<std::string>(tree, JSONKEY_TXID),
+                  getPrimitiveFromJson<uint32_t>(tree, JSONKEY_INDEX))
+    {
+    }
+    
     Inpoint::Inpoint(const std::vector<BYTE>& data)
         : Inpoint(deserialize(data))
     {
@@ -83,18 +94,33 @@ namespace conclave
     
     const Hash256 Inpoint::getHash256() const
     {
-        return Hash256::digest(serialize());
+        Hash256Writer writer;
+        serialize(writer);
+        return writer.getHash256();
     }
     
     const std::vector<BYTE> Inpoint::serialize() const
     {
-        std::vector<BYTE> txIdSerialized = txId.serialize();
-        std::vector<BYTE> indexSerialized = serializeIntegral(index);
-        std::vector<BYTE> serialized(txIdSerialized.size() + indexSerialized.size());
-        size_t pos = 0;
-        writeToByteVector(serialized, txIdSerialized, pos);
-        writeToByteVector(serialized, indexSerialized, pos);
-        return serialized;
+        return serializeToByteVector(*this);
+    }
+    
+    void Inpoint::serialize(ByteSink& sink) const
+    {
+        txId.serialize(sink);
+        writeIntegral(sink, index);
+    }
+    
+    const size_t Inpoint::serializedSize() const
+    {
+        return SERIALIZED_SIZE_BYTES;
+    }
+    
+    void Inpoint::writeJson(JsonWriter& writer) const
+    {
+        writer.startObject();
+        writer.key(JSONKEY_TXID).hex(txId, LARGE_HASH_SIZE_BYTES);
+        writer.key(JSONKEY_INDEX).number(index);
+        writer.endObject();
     }
     
     //
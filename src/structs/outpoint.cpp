@@ -34,13 +34,18 @@ namespace conclave
     // Factories
     //
     
-    Outpoint Outpoint::deserialize(const std::vector<BYTE>& data, size_t& pos)
+    Outpoint Outpoint::deserialize(ByteReader& reader)
     {
-        Hash256 txId = Hash256::deserialize(data, pos);
-        uint32_t index = deserializeIntegral<uint32_t>(data, pos);
+        Hash256 txId = Hash256::deserialize(reader);
+        uint32_t index = reader.readIntegral<uint32_t>();
         return Outpoint(txId, index);
     }
     
+    Outpoint Outpoint::deserialize(const std::vector<BYTE>& data, size_t& pos)
+    {
+        return deserializeFromByteVector<Outpoint>(data, pos);
+    }
+    
     Outpoint Outpoint::deserialize(const std::vector<BYTE>& data)
     {
         size_t pos = 0;
@@ -62,6 +67,12 @@ namespace conclave
     {
     }
     
+    Outpoint::Outpoint(const JsonValue& tree)
+        : Outpoint(getPrimitiveFromJson<std::string>(tree, JSONKEY_TXID),
+                   getPrimitiveFromJson<uint32_t>(tree, JSONKEY_INDEX))
+    {
+    }
+    
     Outpoint::Outpoint(const std::vector<BYTE>& data)
         : Outpoint(deserialize(data))
     {
@@ -83,18 +94,33 @@ namespace conclave
     
     const Hash256 Outpoint::getHash256() const
     {
-        return Hash256::digest(serialize());
+        Hash256Writer writer;
+        serialize(writer);
+        return writer.getHash256();
     }
     
     const std::vector<BYTE> Outpoint::serialize() const
     {
-        std::vector<BYTE> txIdSerialized = txId.serialize();
-        std::vector<BYTE> indexSerialized = serializeIntegral(index);
-        std::vector<BYTE> serialized(txIdSerialized.size() + indexSerialized.size());
-        size_t pos = 0;
-        writeToByteVector(serialized, txIdSerialized, pos);
-        writeToByteVector(serialized, indexSerialized, pos);
-        return serialized;
+        return serializeToByteVector(*this);
+    }
+    
+    void Outpoint::serialize(ByteSink& sink) const
+    {
+        txId.serialize(sink);
+        writeIntegral(sink, index);
+    }
+    
+    const size_t Outpoint::serializedSize() const
+    {
+        return SERIALIZED_SIZE_BYTES;
+    }
+    
+    void Outpoint::writeJson(JsonWriter& writer) const
+    {
+        writer.startObject();
+        writer.key(JSONKEY_TXID).hex(txId, LARGE_HASH_SIZE_BYTES);
+        writer.key(JSONKEY_INDEX).number(index);
+        writer.endObject();
     }
     
     //
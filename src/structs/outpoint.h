@@ -20,6 +20,8 @@
 
 #include "../conclave.h"
 #include "../hash256.h"
+#include "../util/json_parser.h"
+#include "../util/json_writer.h"
 #include <boost/property_tree/ptree.hpp>
 #include <cstdint>
 #include <string>
@@ -33,18 +35,25 @@ namespace conclave
         // JSON keys
         const static std::string JSONKEY_TXID;
         const static std::string JSONKEY_INDEX;
+        // Size of the serialization: txId then index
+        const static size_t SERIALIZED_SIZE_BYTES = LARGE_HASH_SIZE_BYTES + UINT32_SIZE_BYTES;
         // Factories
+        static Outpoint deserialize(ByteReader&);
         static Outpoint deserialize(const std::vector<BYTE>&, size_t&);
         static Outpoint deserialize(const std::vector<BYTE>&);
         // Constructors
         Outpoint(const Hash256&, const uint32_t);
         Outpoint(const pt::ptree&);
+        Outpoint(const JsonValue&);
         Outpoint(const std::vector<BYTE>&);
         Outpoint(const Outpoint&);
         Outpoint(Outpoint&&);
         // Public functions
         const Hash256 getHash256() const;
         const std::vector<BYTE> serialize() const;
+        void serialize(ByteSink&) const;
+        void writeJson(JsonWriter&) const;
+        const size_t serializedSize() const;
         // Conversions
         explicit operator pt::ptree() const;
         explicit operator std::string() const;
@@ -0,0 +1,104 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "sig_hash_context.h"
+#include "../util/serialization.h"
+
+namespace conclave
+{
+    //
+    // Helpers
+    //
+    
+    template<typename T, typename F>
+    inline static const Hash256 hashEach(const std::vector<T>& items, F writeItem)
+    {
+        Hash256Writer writer;
+        for (const T& item: items) {
+            writeItem(writer, item);
+        }
+        return writer.getHash256();
+    }
+    
+    //
+    // Constructors
+    //
+    
+    SigHashContext::SigHashContext(const ConclaveTx& conclaveTx)
+        : conclaveTx(conclaveTx)
+    {
+        const Hash256 hashTrustees = hashEach(conclaveTx.trustees, [](ByteSink& sink, const PublicKey& trustee) {
+            trustee.serialize(sink);
+        });
+        const Hash256 hashOutpoints = hashEach(
+            conclaveTx.conclaveInputs, [](ByteSink& sink, const ConclaveInput& conclaveInput) {
+                conclaveInput.outpoint.serialize(sink);
+            });
+        const Hash256 hashSequences = hashEach(
+            conclaveTx.conclaveInputs, [](ByteSink& sink, const ConclaveInput& conclaveInput) {
+                writeIntegral<uint32_t>(sink, conclaveInput.sequence);
+            });
+        const Hash256 hashBitcoinOutputs = hashEach(
+            conclaveTx.bitcoinOutputs, [](ByteSink& sink, const BitcoinOutput& bitcoinOutput) {
+                bitcoinOutput.serialize(sink);
+            });
+        const Hash256 hashConclaveOutputs = hashEach(
+            conclaveTx.conclaveOutputs, [](ByteSink& sink, const ConclaveOutput& conclaveOutput) {
+                ConclaveOutput(conclaveOutput.scriptPubKey, conclaveOutput.value).serialize(sink);
+            });
+        sharedPreimage.resize(3 * UINT32_SIZE_BYTES + optionalObjectSerializedSize<Outpoint>(conclaveTx.fundPoint) +
+                              5 * LARGE_HASH_SIZE_BYTES);
+        ByteBufferSink sink(sharedPreimage.data(), sharedPreimage.size());
+        writeIntegral<uint32_t>(sink, conclaveTx.version);
+        writeIntegral<uint32_t>(sink, conclaveTx.lockTime);
+        writeIntegral<uint32_t>(sink, conclaveTx.minSigs);
+        writeOptionalObject<Outpoint>(sink, conclaveTx.fundPoint);
+        hashTrustees.serialize(sink);
+        hashOutpoints.serialize(sink);
+        hashSequences.serialize(sink);
+        hashBitcoinOutputs.serialize(sink);
+        hashConclaveOutputs.serialize(sink);
+    }
+    
+    //
+    // Public Functions
+    //
+    
+    /***
+     * @param inputIndex - Index of the input being signed
+     * @param scriptCode - scriptPubKey of the output being spent, or the redeem script for
+     * script hash outputs
+     * @param value - Value of the output being spent
+     * @return - The hash to be signed
+     */
+    const Hash256 SigHashContext::getSigHash(const size_t inputIndex, const Script& scriptCode,
+                                             const uint64_t value) const
+    {
+        CONCLAVE_ASSERT(inputIndex < conclaveTx.conclaveInputs.size(),
+                        "input index out of range: " + std::to_string(inputIndex));
+        const ConclaveInput& conclaveInput = conclaveTx.conclaveInputs[inputIndex];
+        Hash256Writer writer;
+        writeBytes(writer, sharedPreimage);
+        conclaveInput.outpoint.serialize(writer);
+        scriptCode.serialize(writer);
+        writeIntegral<uint64_t>(writer, value);
+        writeIntegral<uint32_t>(writer, conclaveInput.sequence);
+        writeIntegral<uint32_t>(writer, inputIndex);
+        return writer.getHash256();
+    }
+}
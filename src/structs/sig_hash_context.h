@@ -0,0 +1,60 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "conclave_tx.h"
+#include "../script.h"
+#include "../hash256.h"
+#include "../conclave.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace conclave
+{
+    /***
+     * Computes the sighashes of a transaction's inputs, in the manner of BIP143. The parts
+     * every input's sighash shares - header fields and the hashes of all outpoints, all
+     * sequences and all outputs - are serialized once on construction. Each sighash then
+     * only appends the input's own fields, so signing or verifying a transaction is linear
+     * rather than quadratic in its number of inputs.
+     *
+     * The preimage for input i is:
+     *   version || lockTime || minSigs || fundPoint || hashTrustees || hashOutpoints ||
+     *   hashSequences || hashBitcoinOutputs || hashConclaveOutputs ||
+     *   outpoint_i || scriptCode_i || value_i || sequence_i || i
+     *
+     * scriptSigs and predecessors are left out; the former carry the signatures and the
+     * latter are only filled in by the node once the transaction has been signed.
+     *
+     * NOTE: The context keeps a reference to the transaction, which must outlive it.
+     */
+    class SigHashContext final
+    {
+        public:
+        // Constructors
+        explicit SigHashContext(const ConclaveTx&);
+        // Public Functions
+        const Hash256 getSigHash(const size_t, const Script&, const uint64_t) const;
+        private:
+        // Properties
+        const ConclaveTx& conclaveTx;
+        std::vector<BYTE> sharedPreimage;
+    };
+}
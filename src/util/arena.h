@@ -0,0 +1,145 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "../conclave.h"
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+namespace conclave
+{
+    /***
+     * Monotonic memory for everything that lives exactly as long as one RPC request: its body, its response and
+     * the buffers in between. Allocations are pointer bumps into a buffer recycled from a process-wide pool (and
+     * fall back to the heap once that is used up); nothing is freed individually, the whole lot is released when
+     * the arena is destroyed.
+     *
+     * A request changes threads on its way through the acceptor, a processor and a signer, so the arena travels
+     * with it rather than belonging to any one thread. Each stage makes it current with an Arena::Scope while it
+     * works on the request, and request-scoped containers pick it up through getCurrentResource().
+     *
+     * NOTE: An arena must only be used by one thread at a time.
+     */
+    class Arena final
+    {
+        public:
+        /***
+         * Makes an arena the current one for this thread until the scope ends
+         */
+        class Scope final
+        {
+            public:
+            /***
+             * @param arena - The arena to make current, or nullptr for none
+             */
+            explicit Scope(Arena* arena)
+                : previous(current)
+            {
+                current = arena;
+            }
+            
+            ~Scope()
+            {
+                current = previous;
+            }
+            
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+            
+            private:
+            Arena* previous;
+        };
+        
+        /***
+         * @return - The current arena's memory, or the default resource when no arena is current
+         */
+        static std::pmr::memory_resource* getCurrentResource()
+        {
+            return current == nullptr ? std::pmr::get_default_resource() : current->getResource();
+        }
+        
+        Arena()
+            : buffer(acquireBuffer()),
+              resource(buffer.get(), BUFFER_SIZE_BYTES, std::pmr::new_delete_resource())
+        {
+        }
+        
+        ~Arena()
+        {
+            // Anything that overflowed to the heap goes first, then the buffer is handed back for reuse
+            resource.release();
+            releaseBuffer(std::move(buffer));
+        }
+        
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+        
+        std::pmr::memory_resource* getResource()
+        {
+            return &resource;
+        }
+        
+        // Large enough for all but the biggest responses, small enough to keep a pool of them around
+        constexpr static size_t BUFFER_SIZE_BYTES = 64 * 1024;
+        constexpr static size_t MAX_POOLED_BUFFERS = 64;
+        
+        private:
+        struct BufferPool
+        {
+            std::mutex mutex;
+            std::vector<std::unique_ptr<BYTE[]>> buffers;
+        };
+        
+        static BufferPool& getBufferPool()
+        {
+            static BufferPool bufferPool;
+            return bufferPool;
+        }
+        
+        static std::unique_ptr<BYTE[]> acquireBuffer()
+        {
+            BufferPool& bufferPool = getBufferPool();
+            {
+                std::lock_guard<std::mutex> lock(bufferPool.mutex);
+                if (!bufferPool.buffers.empty()) {
+                    std::unique_ptr<BYTE[]> buffer = std::move(bufferPool.buffers.back());
+                    bufferPool.buffers.pop_back();
+                    return buffer;
+                }
+            }
+            return std::unique_ptr<BYTE[]>(new BYTE[BUFFER_SIZE_BYTES]);
+        }
+        
+        static void releaseBuffer(std::unique_ptr<BYTE[]> buffer)
+        {
+            BufferPool& bufferPool = getBufferPool();
+            std::lock_guard<std::mutex> lock(bufferPool.mutex);
+            if (bufferPool.buffers.size() < MAX_POOLED_BUFFERS) {
+                bufferPool.buffers.emplace_back(std::move(buffer));
+            }
+        }
+        
+        inline static thread_local Arena* current = nullptr;
+        std::unique_ptr<BYTE[]> buffer;
+        std::pmr::monotonic_buffer_resource resource;
+    };
+}
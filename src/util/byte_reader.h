@@ -0,0 +1,115 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "../conclave.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace conclave
+{
+    /***
+     * Reads serialized data out of a span of bytes which it does not own - a byte vector, a database page, a socket
+     * buffer. Every read is checked against the end of the span and throws rather than running off it. Integrals are
+     * read as little-endian regardless of the host, without any unaligned casts.
+     *
+     * NOTE: The bytes must outlive the reader.
+     */
+    class ByteReader final
+    {
+        public:
+        ByteReader(const BYTE* data, const size_t size)
+            : data(data), size(size), pos(0)
+        {
+        }
+        
+        explicit ByteReader(const std::vector<BYTE>& vector, const size_t pos = 0)
+            : data(vector.data()), size(vector.size()), pos(pos)
+        {
+            CONCLAVE_ASSERT(pos <= size, "read position past end of data");
+        }
+        
+        /***
+         * @param nBytes - Number of bytes to consume
+         * @return - Pointer to the consumed bytes, which remain owned by the underlying span
+         */
+        const BYTE* read(const size_t nBytes)
+        {
+            CONCLAVE_ASSERT(nBytes <= size - pos, "read past end of data: wanted " + std::to_string(nBytes) +
+                                                  " bytes at position " + std::to_string(pos) + " of " +
+                                                  std::to_string(size));
+            const BYTE* ret = data + pos;
+            pos += nBytes;
+            return ret;
+        }
+        
+        template<typename T>
+        const T readIntegral()
+        {
+            static_assert(std::is_integral<T>::value, "Integral type required");
+            typedef typename std::make_unsigned<T>::type U;
+            const BYTE* bytes = read(sizeof(T));
+            U value = 0;
+            for (size_t i = 0; i < sizeof(T); i++) {
+                value |= static_cast<U>(static_cast<U>(bytes[i]) << (8 * i));
+            }
+            return static_cast<T>(value);
+        }
+        
+        /***
+         * Reads a varint, as written by writeVarInt()
+         */
+        const uint64_t readVarInt()
+        {
+            const uint8_t prefix = readIntegral<uint8_t>();
+            if (prefix <= 0xfc) {
+                return prefix;
+            } else if (prefix == 0xfd) {
+                return readIntegral<uint16_t>();
+            } else if (prefix == 0xfe) {
+                return readIntegral<uint32_t>();
+            } else {
+                return readIntegral<uint64_t>();
+            }
+        }
+        
+        void skip(const size_t nBytes)
+        {
+            read(nBytes);
+        }
+        
+        const size_t getPosition() const
+        {
+            return pos;
+        }
+        
+        const size_t getRemaining() const
+        {
+            return size - pos;
+        }
+        
+        private:
+        const BYTE* data;
+        const size_t size;
+        size_t pos;
+    };
+}
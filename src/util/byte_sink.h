@@ -0,0 +1,112 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "../conclave.h"
+#include <cstddef>
+#include <cstring>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace conclave
+{
+    /***
+     * Destination for serialized bytes. Structs that can serialize into a sink write straight into whatever
+     * consumes the bytes (a hasher, a buffer) rather than building a std::vector<BYTE> first.
+     */
+    class ByteSink
+    {
+        public:
+        virtual ~ByteSink() = default;
+        virtual void write(const BYTE*, const size_t) = 0;
+    };
+    
+    /***
+     * Appends everything written to it to a byte vector.
+     */
+    class ByteVectorSink final : public ByteSink
+    {
+        public:
+        explicit ByteVectorSink(std::vector<BYTE>& vector)
+            : vector(vector)
+        {
+        }
+        
+        void write(const BYTE* data, const size_t size) override
+        {
+            vector.insert(vector.end(), data, data + size);
+        }
+        
+        private:
+        std::vector<BYTE>& vector;
+    };
+    
+    /***
+     * Appends everything written to it to a string, for bytes that end up in the same buffers as text
+     */
+    class ByteStringSink final : public ByteSink
+    {
+        public:
+        explicit ByteStringSink(std::pmr::string& string)
+            : string(string)
+        {
+        }
+        
+        void write(const BYTE* data, const size_t size) override
+        {
+            string.append(reinterpret_cast<const char*>(data), size);
+        }
+        
+        private:
+        std::pmr::string& string;
+    };
+    
+    /***
+     * Writes into a caller-provided buffer of fixed capacity, typically one sized up front from an object's
+     * serializedSize(). Writing past the end of the buffer throws rather than reallocating.
+     */
+    class ByteBufferSink final : public ByteSink
+    {
+        public:
+        ByteBufferSink(BYTE* buffer, const size_t capacity)
+            : buffer(buffer), capacity(capacity), pos(0)
+        {
+        }
+        
+        void write(const BYTE* data, const size_t size) override
+        {
+            CONCLAVE_ASSERT(size <= capacity - pos, "write past end of buffer");
+            if (size > 0) {
+                std::memcpy(buffer + pos, data, size);
+                pos += size;
+            }
+        }
+        
+        const size_t getPosition() const
+        {
+            return pos;
+        }
+        
+        private:
+        BYTE* buffer;
+        const size_t capacity;
+        size_t pos;
+    };
+}
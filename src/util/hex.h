@@ -22,6 +22,7 @@
 #include <string>
 #include <vector>
 #include <array>
+#include <stdexcept>
 
 typedef unsigned char BYTE;
 static const char HEX_CHARACTERS[] = "0123456789abcdef";
@@ -102,3 +103,54 @@ inline const std::string byteArrayToHexString(const std::array<BYTE, size>& byte
 {
     BYTE_CONTAINER_TO_HEX_STRING(byteArray)
 }
+
+/**
+ * Value of a single hex digit. Can be evaluated at compile time, where an invalid digit is a compile error.
+ * @param c - Hex digit, either case
+ * @return
+ */
+constexpr BYTE hexCharToNibble(const char c)
+{
+    if ('0' <= c && c <= '9') {
+        return c - '0';
+    } else if ('a' <= c && c <= 'f') {
+        return c - 'a' + 10;
+    } else if ('A' <= c && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    throw std::runtime_error("Invalid hex character");
+}
+
+/**
+ * Convert a C string of exactly `2 * size` hex digits to a byte array. When this runs at compile time, e.g. to
+ * initialize a constexpr variable, a malformed string fails the build. At runtime it throws.
+ * @param hex - Input hex string
+ * @return
+ */
+template<size_t size>
+constexpr std::array<BYTE, size> hexCStringToByteArray(const char* hex)
+{
+    std::array<BYTE, size> res{};
+    for (size_t i = 0; i < size; i++) {
+        if (hex[i * 2] == '\0' || hex[i * 2 + 1] == '\0') {
+            throw std::runtime_error("Hex string too short");
+        }
+        res[i] = BYTE(hexCharToNibble(hex[i * 2]) << 4u) | hexCharToNibble(hex[i * 2 + 1]);
+    }
+    if (hex[size * 2] != '\0') {
+        throw std::runtime_error("Hex string too long");
+    }
+    return res;
+}
+
+/**
+ * Convert a hex string literal to a byte array sized to fit it
+ * @param hex - Input hex string literal
+ * @return
+ */
+template<size_t length>
+constexpr std::array<BYTE, (length - 1) / 2> hexLiteralToByteArray(const char (& hex)[length])
+{
+    static_assert(length % 2 == 1, "Hex literal must have an even number of digits");
+    return hexCStringToByteArray<(length - 1) / 2>(hex);
+}
@@ -18,14 +18,19 @@
 
 #pragma once
 
+#include "json_parser.h"
+#include "json_writer.h"
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/json_parser.hpp>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <iostream>
+#include <streambuf>
 
 /**
- * Utility functions for working with JSON, using the boost property tree classes
+ * Utility functions for working with JSON, using the boost property tree classes. The getters are also
+ * overloaded for conclave::JsonValue, so that structs can be read straight off a parsed request the same way.
  */
 
 namespace pt = boost::property_tree;
@@ -38,15 +43,29 @@ inline const std::string ptreeToString(const pt::ptree& tree, const bool pretty
     return str;
 }
 
-inline const pt::ptree stringToPtree(const std::string& str)
+/**
+ * Read-only stream buffer over characters it does not own, so that text can be parsed where it lies
+ */
+class StringViewStreamBuf final : public std::streambuf
+{
+    public:
+    explicit StringViewStreamBuf(const std::string_view str)
+    {
+        char* begin = const_cast<char*>(str.data());
+        setg(begin, begin, begin + str.size());
+    }
+};
+
+inline const pt::ptree stringToPtree(const std::string_view str)
 {
     pt::ptree root;
-    std::istringstream iss(str);
+    StringViewStreamBuf streamBuf(str);
+    std::istream is(&streamBuf);
     try {
-        pt::read_json(iss, root);
+        pt::read_json(is, root);
         return root;
     } catch (...) {
-        throw std::runtime_error("Malformed JSON: " + str);
+        throw std::runtime_error("Malformed JSON: " + std::string(str));
     }
 }
 
@@ -151,3 +170,80 @@ inline const std::vector<T> arrayToVectorOfObjects(const pt::ptree& tree)
     }
     return vec;
 }
+
+//
+// The same getters over a JsonDocument
+//
+
+template<typename T>
+inline const T getPrimitiveFromJson(const conclave::JsonValue& tree, const std::string& key)
+{
+    return tree.get(key).getValue<T>();
+}
+
+template<typename T>
+inline const T getObjectFromJson(const conclave::JsonValue& tree, const std::string& key)
+{
+    return T(tree.get(key));
+}
+
+template<typename T>
+inline const std::optional<T> getOptionalPrimitiveFromJson(const conclave::JsonValue& tree, const std::string& key)
+{
+    const std::optional<conclave::JsonValue> opt = tree.find(key);
+    if (opt.has_value()) {
+        return opt->getValue<T>();
+    } else {
+        return std::nullopt;
+    }
+}
+
+template<typename T>
+inline const std::optional<T> getOptionalObjectFromJson(const conclave::JsonValue& tree, const std::string& key)
+{
+    const std::optional<conclave::JsonValue> opt = tree.find(key);
+    if (opt.has_value()) {
+        return T(*opt);
+    } else {
+        return std::nullopt;
+    }
+}
+
+template<typename T>
+inline const std::vector<T> getVectorOfPrimitivesFromJson(const conclave::JsonValue& tree, const std::string childName)
+{
+    std::vector<T> vec;
+    const std::optional<conclave::JsonValue> childNode = tree.find(childName);
+    if (childNode.has_value()) {
+        vec.reserve(childNode->size());
+        for (const conclave::JsonValue item : *childNode) {
+            vec.push_back(T(item.getValue<std::string>()));
+        }
+    }
+    return vec;
+}
+
+template<typename T>
+inline const std::vector<T> getVectorOfObjectsFromJson(const conclave::JsonValue& tree, const std::string childName)
+{
+    std::vector<T> vec;
+    const std::optional<conclave::JsonValue> childNode = tree.find(childName);
+    if (childNode.has_value()) {
+        vec.reserve(childNode->size());
+        for (const conclave::JsonValue item : *childNode) {
+            vec.push_back(T(item));
+        }
+    }
+    return vec;
+}
+
+template<typename T>
+inline const std::vector<T> arrayToVectorOfPrimitives(const conclave::JsonValue& tree)
+{
+    std::vector<T> vec;
+    vec.reserve(tree.size());
+    for (const conclave::JsonValue item : tree) {
+        vec.push_back(item.getValue<T>());
+    }
+    return vec;
+}
@@ -0,0 +1,525 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "../conclave.h"
+#include "arena.h"
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace conclave
+{
+    enum class JsonType : uint8_t
+    {
+        Null,
+        Bool,
+        Number,
+        String,
+        Array,
+        Object
+    };
+    
+    /***
+     * One value on a JsonDocument's tape. A container's children follow it directly, and `next` is the index just
+     * past its last descendant, so siblings can be stepped over without looking inside them.
+     */
+    struct JsonNode final
+    {
+        JsonType type;
+        // Member name if the value sits in an object, empty otherwise
+        std::string_view key;
+        // String contents with escapes resolved, or the literal text of a number, true or false
+        std::string_view text;
+        uint32_t next;
+        uint32_t nChildren;
+    };
+    
+    class JsonDocument;
+    
+    /***
+     * Read-only handle to a value inside a JsonDocument. Cheap to copy; only valid while the document is.
+     * A default-constructed JsonValue stands in for a missing value and behaves as an empty null.
+     */
+    class JsonValue final
+    {
+        public:
+        class Iterator final
+        {
+            public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = JsonValue;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const JsonValue*;
+            using reference = JsonValue;
+            
+            Iterator(const JsonDocument* document, const uint32_t index)
+                : document(document), index(index)
+            {
+            }
+            
+            JsonValue operator*() const
+            {
+                return JsonValue(document, index);
+            }
+            
+            Iterator& operator++();
+            
+            bool operator==(const Iterator& other) const
+            {
+                return index == other.index;
+            }
+            
+            bool operator!=(const Iterator& other) const
+            {
+                return index != other.index;
+            }
+            
+            private:
+            const JsonDocument* document;
+            uint32_t index;
+        };
+        
+        JsonValue()
+            : document(nullptr), index(0)
+        {
+        }
+        
+        JsonValue(const JsonDocument* document, const uint32_t index)
+            : document(document), index(index)
+        {
+        }
+        
+        const JsonType getType() const;
+        const std::string_view getKey() const;
+        const std::string_view getText() const;
+        const size_t size() const;
+        Iterator begin() const;
+        Iterator end() const;
+        
+        const bool isNull() const
+        {
+            return getType() == JsonType::Null;
+        }
+        
+        const bool isObject() const
+        {
+            return getType() == JsonType::Object;
+        }
+        
+        const bool isArray() const
+        {
+            return getType() == JsonType::Array;
+        }
+        
+        /***
+         * Looks a member up by name. Objects in requests have a handful of members, so a scan along the tape beats
+         * building an index.
+         * @return - The first member called `key`, or std::nullopt if there is none or this is not an object
+         */
+        const std::optional<JsonValue> find(const std::string_view key) const
+        {
+            if (!isObject()) {
+                return std::nullopt;
+            }
+            for (const JsonValue child: *this) {
+                if (child.getKey() == key) {
+                    return child;
+                }
+            }
+            return std::nullopt;
+        }
+        
+        /***
+         * @return - The member called `key`; throws if there is none
+         */
+        const JsonValue get(const std::string_view key) const
+        {
+            const std::optional<JsonValue> child = find(key);
+            CONCLAVE_ASSERT(child.has_value(), "No such JSON node: " + std::string(key));
+            return *child;
+        }
+        
+        /***
+         * Converts a string, number or boolean to T. As with the property tree, numbers and booleans may also be
+         * given as strings.
+         */
+        template<typename T>
+        const T getValue() const
+        {
+            const JsonType type = getType();
+            CONCLAVE_ASSERT(type == JsonType::String || type == JsonType::Number || type == JsonType::Bool,
+                            "Expected a JSON primitive");
+            const std::string_view text = getText();
+            if constexpr (std::is_same<T, std::string>::value || std::is_same<T, std::string_view>::value) {
+                return T(text);
+            } else if constexpr (std::is_same<T, bool>::value) {
+                CONCLAVE_ASSERT(text == "true" || text == "false", "Bad JSON boolean: " + std::string(text));
+                return text == "true";
+            } else {
+                static_assert(std::is_integral<T>::value, "JSON values can only be read as strings and integrals");
+                T value = 0;
+                const char* end = text.data() + text.size();
+                const std::from_chars_result result = std::from_chars(text.data(), end, value);
+                CONCLAVE_ASSERT(result.ec == std::errc() && result.ptr == end,
+                                "Bad JSON integer: " + std::string(text));
+                return value;
+            }
+        }
+        
+        private:
+        const JsonNode* getNode() const;
+        
+        const JsonDocument* document;
+        uint32_t index;
+    };
+    
+    /***
+     * JSON text parsed into a flat tape of JsonNodes. Strings without escapes are views straight into the text,
+     * and the tape itself comes from the current arena, so parsing a typical request costs no heap allocations
+     * beyond the arena's. Numbers are kept as text and only converted when read.
+     *
+     * NOTE: The text must outlive the document, and the document every JsonValue taken from it.
+     */
+    class JsonDocument final
+    {
+        public:
+        explicit JsonDocument(const std::string_view json,
+                              std::pmr::memory_resource* resource = Arena::getCurrentResource())
+            : json(json), pos(0), nodes(resource), unescapedStrings(resource)
+        {
+            // A rough guess at the node count saves regrowing the tape for most requests
+            nodes.reserve(json.size() / 16 + 1);
+            parseValue(std::string_view(), 0);
+            skipWhitespace();
+            check(pos == json.size(), "trailing characters");
+        }
+        
+        JsonDocument(const JsonDocument&) = delete;
+        JsonDocument& operator=(const JsonDocument&) = delete;
+        
+        const JsonValue getRoot() const
+        {
+            return JsonValue(this, 0);
+        }
+        
+        // Deep enough for anything we accept, shallow enough that the recursion cannot blow the stack
+        constexpr static size_t MAX_DEPTH = 64;
+        
+        private:
+        friend class JsonValue;
+        
+        void check(const bool cond, const char* reason) const
+        {
+            CONCLAVE_ASSERT(cond, "Malformed JSON at position " + std::to_string(pos) + ": " + reason);
+        }
+        
+        void skipWhitespace()
+        {
+            while (pos < json.size() &&
+                   (json[pos] == ' ' || json[pos] == '\t' || json[pos] == '\n' || json[pos] == '\r')) {
+                pos++;
+            }
+        }
+        
+        void expect(const char c)
+        {
+            skipWhitespace();
+            check(pos < json.size() && json[pos] == c, "unexpected character");
+            pos++;
+        }
+        
+        const bool consumeIf(const char c)
+        {
+            skipWhitespace();
+            if (pos < json.size() && json[pos] == c) {
+                pos++;
+                return true;
+            }
+            return false;
+        }
+        
+        void parseValue(const std::string_view key, const size_t depth)
+        {
+            check(depth <= MAX_DEPTH, "nested too deeply");
+            skipWhitespace();
+            check(pos < json.size(), "unexpected end");
+            const uint32_t index = nodes.size();
+            nodes.push_back(JsonNode{JsonType::Null, key, std::string_view(), 0, 0});
+            switch (json[pos]) {
+                case '{':
+                    nodes[index].type = JsonType::Object;
+                    parseObject(index, depth);
+                    break;
+                case '[':
+                    nodes[index].type = JsonType::Array;
+                    parseArray(index, depth);
+                    break;
+                case '"':
+                    nodes[index].type = JsonType::String;
+                    nodes[index].text = parseString();
+                    break;
+                case 't':
+                    nodes[index].type = JsonType::Bool;
+                    nodes[index].text = parseLiteral("true");
+                    break;
+                case 'f':
+                    nodes[index].type = JsonType::Bool;
+                    nodes[index].text = parseLiteral("false");
+                    break;
+                case 'n':
+                    parseLiteral("null");
+                    break;
+                default:
+                    nodes[index].type = JsonType::Number;
+                    nodes[index].text = parseNumber();
+            }
+            nodes[index].next = nodes.size();
+        }
+        
+        void parseObject(const uint32_t index, const size_t depth)
+        {
+            pos++;
+            if (consumeIf('}')) {
+                return;
+            }
+            do {
+                skipWhitespace();
+                check(pos < json.size() && json[pos] == '"', "expected a member name");
+                const std::string_view key = parseString();
+                expect(':');
+                parseValue(key, depth + 1);
+                nodes[index].nChildren++;
+            } while (consumeIf(','));
+            expect('}');
+        }
+        
+        void parseArray(const uint32_t index, const size_t depth)
+        {
+            pos++;
+            if (consumeIf(']')) {
+                return;
+            }
+            do {
+                parseValue(std::string_view(), depth + 1);
+                nodes[index].nChildren++;
+            } while (consumeIf(','));
+            expect(']');
+        }
+        
+        const std::string_view parseLiteral(const std::string_view literal)
+        {
+            check(json.substr(pos, literal.size()) == literal, "bad literal");
+            pos += literal.size();
+            return literal;
+        }
+        
+        const std::string_view parseNumber()
+        {
+            const size_t start = pos;
+            const auto isDigit = [this]() {
+                return pos < json.size() && json[pos] >= '0' && json[pos] <= '9';
+            };
+            const auto skipDigits = [this, &isDigit]() {
+                check(isDigit(), "expected a digit");
+                while (isDigit()) {
+                    pos++;
+                }
+            };
+            if (json[pos] == '-') {
+                pos++;
+            }
+            if (pos < json.size() && json[pos] == '0') {
+                pos++;
+            } else {
+                skipDigits();
+            }
+            if (pos < json.size() && json[pos] == '.') {
+                pos++;
+                skipDigits();
+            }
+            if (pos < json.size() && (json[pos] == 'e' || json[pos] == 'E')) {
+                pos++;
+                if (pos < json.size() && (json[pos] == '+' || json[pos] == '-')) {
+                    pos++;
+                }
+                skipDigits();
+            }
+            return json.substr(start, pos - start);
+        }
+        
+        /***
+         * Parses the string starting at `pos`. The result is a view into the text itself unless the string
+         * contains escapes, in which case it is unescaped into storage owned by the document.
+         */
+        const std::string_view parseString()
+        {
+            pos++;
+            const size_t start = pos;
+            while (pos < json.size() && json[pos] != '"' && json[pos] != '\\') {
+                check(static_cast<unsigned char>(json[pos]) >= 0x20, "control character in string");
+                pos++;
+            }
+            check(pos < json.size(), "unterminated string");
+            if (json[pos] == '"') {
+                return json.substr(start, pos++ - start);
+            }
+            std::pmr::string& unescaped = unescapedStrings.emplace_back(json.substr(start, pos - start));
+            while (true) {
+                check(pos < json.size(), "unterminated string");
+                const char c = json[pos++];
+                if (c == '"') {
+                    return unescaped;
+                }
+                check(static_cast<unsigned char>(c) >= 0x20, "control character in string");
+                if (c != '\\') {
+                    unescaped.push_back(c);
+                    continue;
+                }
+                check(pos < json.size(), "unterminated string");
+                switch (json[pos++]) {
+                    case '"': unescaped.push_back('"'); break;
+                    case '\\': unescaped.push_back('\\'); break;
+                    case '/': unescaped.push_back('/'); break;
+                    case 'b': unescaped.push_back('\b'); break;
+                    case 'f': unescaped.push_back('\f'); break;
+                    case 'n': unescaped.push_back('\n'); break;
+                    case 'r': unescaped.push_back('\r'); break;
+                    case 't': unescaped.push_back('\t'); break;
+                    case 'u': appendUtf8(unescaped, parseCodePoint()); break;
+                    default: check(false, "bad escape");
+                }
+            }
+        }
+        
+        const uint32_t parseHex4()
+        {
+            check(json.size() - pos >= 4, "truncated \\u escape");
+            uint32_t value = 0;
+            for (size_t i = 0; i < 4; i++) {
+                const char c = json[pos++];
+                value <<= 4;
+                if (c >= '0' && c <= '9') {
+                    value |= c - '0';
+                } else if (c >= 'a' && c <= 'f') {
+                    value |= c - 'a' + 10;
+                } else if (c >= 'A' && c <= 'F') {
+                    value |= c - 'A' + 10;
+                } else {
+                    check(false, "bad \\u escape");
+                }
+            }
+            return value;
+        }
+        
+        const uint32_t parseCodePoint()
+        {
+            const uint32_t high = parseHex4();
+            if (high < 0xd800 || high > 0xdfff) {
+                return high;
+            }
+            // Outside the basic plane, characters are escaped as a UTF-16 surrogate pair
+            check(high <= 0xdbff, "unpaired surrogate");
+            check(json.substr(pos, 2) == "\\u", "unpaired surrogate");
+            pos += 2;
+            const uint32_t low = parseHex4();
+            check(low >= 0xdc00 && low <= 0xdfff, "unpaired surrogate");
+            return 0x10000 + ((high - 0xd800) << 10) + (low - 0xdc00);
+        }
+        
+        static void appendUtf8(std::pmr::string& str, const uint32_t codePoint)
+        {
+            if (codePoint < 0x80) {
+                str.push_back(static_cast<char>(codePoint));
+            } else if (codePoint < 0x800) {
+                str.push_back(static_cast<char>(0xc0 | (codePoint >> 6)));
+                str.push_back(static_cast<char>(0x80 | (codePoint & 0x3f)));
+            } else if (codePoint < 0x10000) {
+                str.push_back(static_cast<char>(0xe0 | (codePoint >> 12)));
+                str.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f)));
+                str.push_back(static_cast<char>(0x80 | (codePoint & 0x3f)));
+            } else {
+                str.push_back(static_cast<char>(0xf0 | (codePoint >> 18)));
+                str.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3f)));
+                str.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f)));
+                str.push_back(static_cast<char>(0x80 | (codePoint & 0x3f)));
+            }
+        }
+        
+        const std::string_view json;
+        size_t pos;
+        std::pmr::vector<JsonNode> nodes;
+        // A deque so that growing it never moves a string that a node already points into
+        std::pmr::deque<std::pmr::string> unescapedStrings;
+    };
+    
+    //
+    // JsonValue, which needs the whole of JsonDocument
+    //
+    
+    inline JsonValue::Iterator& JsonValue::Iterator::operator++()
+    {
+        index = document->nodes[index].next;
+        return *this;
+    }
+    
+    inline const JsonNode* JsonValue::getNode() const
+    {
+        return document == nullptr ? nullptr : &document->nodes[index];
+    }
+    
+    inline const JsonType JsonValue::getType() const
+    {
+        return document == nullptr ? JsonType::Null : getNode()->type;
+    }
+    
+    inline const std::string_view JsonValue::getKey() const
+    {
+        return document == nullptr ? std::string_view() : getNode()->key;
+    }
+    
+    inline const std::string_view JsonValue::getText() const
+    {
+        return document == nullptr ? std::string_view() : getNode()->text;
+    }
+    
+    inline const size_t JsonValue::size() const
+    {
+        return document == nullptr ? 0 : getNode()->nChildren;
+    }
+    
+    inline JsonValue::Iterator JsonValue::begin() const
+    {
+        // Scalars have no children, so for them begin() == end()
+        return document == nullptr ? Iterator(nullptr, 0) : Iterator(document, index + 1);
+    }
+    
+    inline JsonValue::Iterator JsonValue::end() const
+    {
+        return document == nullptr ? Iterator(nullptr, 0) : Iterator(document, getNode()->next);
+    }
+}
@@ -0,0 +1,220 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "../conclave.h"
+#include "hex.h"
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace conclave
+{
+    /***
+     * Writes compact JSON straight onto the end of a string, with no intermediate tree. Commas are placed
+     * automatically; the caller is responsible for nesting objects and arrays correctly and for giving every
+     * object member a key. Numbers are written as JSON numbers and strings are escaped in one pass over them.
+     *
+     * Structs write themselves with a `writeJson(JsonWriter&) const` member, so that a whole response goes into
+     * the output in one go.
+     */
+    class JsonWriter final
+    {
+        public:
+        explicit JsonWriter(std::pmr::string& out)
+            : out(out), needsComma(false)
+        {
+        }
+        
+        JsonWriter(const JsonWriter&) = delete;
+        JsonWriter& operator=(const JsonWriter&) = delete;
+        
+        JsonWriter& startObject()
+        {
+            startValue();
+            out.push_back('{');
+            needsComma = false;
+            return *this;
+        }
+        
+        JsonWriter& endObject()
+        {
+            out.push_back('}');
+            needsComma = true;
+            return *this;
+        }
+        
+        JsonWriter& startArray()
+        {
+            startValue();
+            out.push_back('[');
+            needsComma = false;
+            return *this;
+        }
+        
+        JsonWriter& endArray()
+        {
+            out.push_back(']');
+            needsComma = true;
+            return *this;
+        }
+        
+        /***
+         * Writes an object member's key. The member's value must be written next.
+         */
+        JsonWriter& key(const std::string_view key)
+        {
+            startValue();
+            appendQuoted(key);
+            out.push_back(':');
+            needsComma = false;
+            return *this;
+        }
+        
+        JsonWriter& string(const std::string_view value)
+        {
+            startValue();
+            appendQuoted(value);
+            needsComma = true;
+            return *this;
+        }
+        
+        /***
+         * Writes bytes as a string of hex digits, without going through a std::string
+         */
+        JsonWriter& hex(const BYTE* bytes, const size_t nBytes)
+        {
+            startValue();
+            out.push_back('"');
+            const size_t pos = out.size();
+            out.resize(pos + 2 * nBytes);
+            char* buf = out.data() + pos;
+            for (size_t i = 0; i < nBytes; i++) {
+                *buf++ = HEX_CHARACTERS[bytes[i] >> 4];
+                *buf++ = HEX_CHARACTERS[bytes[i] & 0x0F];
+            }
+            out.push_back('"');
+            needsComma = true;
+            return *this;
+        }
+        
+        template<typename T>
+        JsonWriter& number(const T value)
+        {
+            static_assert(std::is_integral<T>::value && !std::is_same<T, bool>::value, "Integral type required");
+            startValue();
+            // Enough for any 64 bit integer and its sign
+            char buf[24];
+            const std::to_chars_result result = std::to_chars(buf, buf + sizeof(buf), value);
+            out.append(buf, result.ptr - buf);
+            needsComma = true;
+            return *this;
+        }
+        
+        JsonWriter& boolean(const bool value)
+        {
+            startValue();
+            out.append(value ? "true" : "false");
+            needsComma = true;
+            return *this;
+        }
+        
+        JsonWriter& null()
+        {
+            startValue();
+            out.append("null");
+            needsComma = true;
+            return *this;
+        }
+        
+        /***
+         * Writes an array of structs, each with its writeJson()
+         */
+        template<typename T>
+        JsonWriter& objects(const std::vector<T>& items)
+        {
+            startArray();
+            for (const T& item : items) {
+                item.writeJson(*this);
+            }
+            return endArray();
+        }
+        
+        /***
+         * Writes an array of anything that converts to a string
+         */
+        template<typename T>
+        JsonWriter& strings(const std::vector<T>& items)
+        {
+            startArray();
+            for (const T& item : items) {
+                string(static_cast<std::string>(item));
+            }
+            return endArray();
+        }
+        
+        private:
+        void startValue()
+        {
+            if (needsComma) {
+                out.push_back(',');
+            }
+        }
+        
+        void appendQuoted(const std::string_view str)
+        {
+            out.push_back('"');
+            // Copy runs of characters that need no escaping in one go
+            size_t runStart = 0;
+            for (size_t i = 0; i < str.size(); i++) {
+                const unsigned char c = str[i];
+                if (c >= 0x20 && c != '"' && c != '\\') {
+                    continue;
+                }
+                out.append(str.data() + runStart, i - runStart);
+                runStart = i + 1;
+                out.push_back('\\');
+                switch (c) {
+                    case '"': out.push_back('"'); break;
+                    case '\\': out.push_back('\\'); break;
+                    case '\b': out.push_back('b'); break;
+                    case '\f': out.push_back('f'); break;
+                    case '\n': out.push_back('n'); break;
+                    case '\r': out.push_back('r'); break;
+                    case '\t': out.push_back('t'); break;
+                    default:
+                        out.append("u00");
+                        out.push_back(HEX_CHARACTERS[c >> 4]);
+                        out.push_back(HEX_CHARACTERS[c & 0x0F]);
+                }
+            }
+            out.append(str.data() + runStart, str.size() - runStart);
+            out.push_back('"');
+        }
+        
+        std::pmr::string& out;
+        // Whether a value has been written at the current level, so the next one needs separating from it
+        bool needsComma;
+    };
+}
@@ -19,13 +19,20 @@
 #pragma once
 
 #include "../conclave.h"
+#include "byte_reader.h"
+#include "byte_sink.h"
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 #include <optional>
+#include <string>
+#include <string_view>
 #include <type_traits>
 
 /**
- * Quick-and-dirty serialization routines which are probably not very efficient.
+ * Serialization routines. The functions returning a std::vector<BYTE> are the original quick-and-dirty versions;
+ * structs serialize through the Sink Functions, sized up front by the Size Functions, so that a serialization is
+ * built in one pass into one allocation.
  */
 
 namespace conclave
@@ -157,6 +164,217 @@ namespace conclave
         return ret;
     }
     
+    //
+    // Size Functions
+    //
+    // Exact sizes of the encodings below, so that a buffer can be allocated once before anything is written
+    //
+    
+    constexpr size_t varIntSize(const uint64_t value)
+    {
+        if (value <= 0xfcu) {
+            return UINT8_SIZE_BYTES;
+        } else if (value <= 0xffffu) {
+            return 1 + UINT16_SIZE_BYTES;
+        } else if (value <= 0xffffffffu) {
+            return 1 + UINT32_SIZE_BYTES;
+        } else {
+            return 1 + UINT64_SIZE_BYTES;
+        }
+    }
+    
+    /**
+     * Size of serializeOptionalObject(). `T` must have a serializedSize() method.
+     */
+    template<class T>
+    inline const size_t optionalObjectSerializedSize(const std::optional<T>& optional)
+    {
+        if (optional.has_value()) {
+            const size_t objectSize = optional->serializedSize();
+            return varIntSize(objectSize) + objectSize;
+        } else {
+            return varIntSize(0);
+        }
+    }
+    
+    /**
+     * Size of serializeVectorOfObjects(). `T` must have a serializedSize() method.
+     */
+    template<class T>
+    inline const size_t vectorOfObjectsSerializedSize(const std::vector<T>& objects)
+    {
+        size_t size = varIntSize(objects.size());
+        for (const T& object: objects) {
+            size += object.serializedSize();
+        }
+        return size;
+    }
+    
+    //
+    // Sink Functions
+    //
+    // These write the same encodings as the functions above, but straight into a ByteSink
+    //
+    
+    template<typename T>
+    inline void writeIntegral(ByteSink& sink, const T value)
+    {
+        static_assert(std::is_integral<T>::value, "Integral type required");
+        sink.write(reinterpret_cast<const BYTE*>(&value), sizeof(T));
+    }
+    
+    template<typename T>
+    inline void writeVarInt(ByteSink& sink, const T value)
+    {
+        static_assert(std::is_unsigned<T>::value, "Unsigned type required");
+        const uint64_t uvalue = value;
+        BYTE buffer[1 + UINT64_SIZE_BYTES];
+        size_t size;
+        if (uvalue <= 0xfcu) {
+            buffer[0] = BYTE(uvalue);
+            size = UINT8_SIZE_BYTES;
+        } else if (uvalue <= 0xffffu) {
+            buffer[0] = 0xfd;
+            size = 1 + UINT16_SIZE_BYTES;
+        } else if (uvalue <= 0xffffffffu) {
+            buffer[0] = 0xfe;
+            size = 1 + UINT32_SIZE_BYTES;
+        } else {
+            buffer[0] = 0xff;
+            size = 1 + UINT64_SIZE_BYTES;
+        }
+        if (size > 1) {
+            std::memcpy(&buffer[1], &uvalue, size - 1);
+        }
+        sink.write(buffer, size);
+    }
+    
+    inline void writeBytes(ByteSink& sink, const std::vector<BYTE>& bytes)
+    {
+        sink.write(bytes.data(), bytes.size());
+    }
+    
+    /**
+     * Writes a string prefixed with a varint-encoding of its length
+     */
+    inline void writeVarString(ByteSink& sink, const std::string_view string)
+    {
+        writeVarInt(sink, string.size());
+        sink.write(reinterpret_cast<const BYTE*>(string.data()), string.size());
+    }
+    
+    /**
+     * Sink version of serializeOptionalObject(). `T` must have serializedSize() and serialize(ByteSink&) methods.
+     */
+    template<class T>
+    inline void writeOptionalObject(ByteSink& sink, const std::optional<T>& optional)
+    {
+        if (optional.has_value()) {
+            writeVarInt(sink, optional->serializedSize());
+            optional->serialize(sink);
+        } else {
+            writeVarInt(sink, 0u);
+        }
+    }
+    
+    /**
+     * Sink version of serializeVectorOfObjects(). `T` must have a serialize(ByteSink&) method.
+     */
+    template<class T>
+    inline void writeVectorOfObjects(ByteSink& sink, const std::vector<T>& objects)
+    {
+        writeVarInt(sink, objects.size());
+        for (const T& object: objects) {
+            object.serialize(sink);
+        }
+    }
+    
+    /**
+     * Serializes `object` into a byte vector which is allocated exactly once, at the size reported by
+     * `object.serializedSize(args...)`, and then filled by `object.serialize(sink, args...)`.
+     *
+     * @tparam T - Type with matching serializedSize() and serialize(ByteSink&) methods
+     * @param object - The object being serialized
+     * @param args - Any further arguments to serializedSize() and serialize()
+     * @return - Serialized form of `object`
+     */
+    template<class T, class... Args>
+    inline const std::vector<BYTE> serializeToByteVector(const T& object, const Args& ... args)
+    {
+        std::vector<BYTE> serialized(object.serializedSize(args...));
+        ByteBufferSink sink(serialized.data(), serialized.size());
+        object.serialize(sink, args...);
+        CONCLAVE_ASSERT(sink.getPosition() == serialized.size(), "serializedSize() does not match serialization");
+        return serialized;
+    }
+    
+    //
+    // Reader Functions
+    //
+    // Counterparts of the Sink Functions, decoding from a ByteReader
+    //
+    
+    /**
+     * Reader version of deserializeOptionalObject(). `T` must have a static deserialize(ByteReader&) factory.
+     */
+    template<class T>
+    inline const std::optional<T> readOptionalObject(ByteReader& reader)
+    {
+        const uint64_t size = reader.readVarInt();
+        if (size == 0) {
+            return std::nullopt;
+        }
+        const size_t start = reader.getPosition();
+        std::optional<T> object = T::deserialize(reader);
+        CONCLAVE_ASSERT(reader.getPosition() - start == size, "optional object does not match its size prefix");
+        return object;
+    }
+    
+    /**
+     * Reads a string as written by writeVarString()
+     */
+    inline const std::string readVarString(ByteReader& reader)
+    {
+        const uint64_t size = reader.readVarInt();
+        CONCLAVE_ASSERT(size <= reader.getRemaining(), "string runs past end of data");
+        const char* chars = reinterpret_cast<const char*>(reader.read(size));
+        return std::string(chars, size);
+    }
+    
+    /**
+     * Reader version of deserializeVectorOfObjects(). `T` must have a static deserialize(ByteReader&) factory.
+     */
+    template<class T>
+    inline const std::vector<T> readVectorOfObjects(ByteReader& reader)
+    {
+        const uint64_t nObjects = reader.readVarInt();
+        std::vector<T> objects;
+        // Every object takes at least a byte, so a corrupt count can't reserve more than the data could hold
+        objects.reserve(std::min<uint64_t>(nObjects, reader.getRemaining()));
+        for (uint64_t i = 0; i < nObjects; i++) {
+            objects.emplace_back(T::deserialize(reader));
+        }
+        return objects;
+    }
+    
+    /**
+     * Deserializes a `T` from `data` starting at `pos`, advancing `pos` past it. This is how structs implement their
+     * std::vector<BYTE> deserialize() factories on top of the ByteReader one.
+     *
+     * @tparam T - Type with a static deserialize(ByteReader&) factory
+     * @param data - Data stream
+     * @param pos - Position within data stream where first byte appears
+     * @return - Deserialized object
+     */
+    template<class T>
+    inline T deserializeFromByteVector(const std::vector<BYTE>& data, size_t& pos)
+    {
+        ByteReader reader(data, pos);
+        T object = T::deserialize(reader);
+        pos = reader.getPosition();
+        return object;
+    }
+    
     //
     // Deserialization Functions
     //
@@ -172,9 +390,9 @@ namespace conclave
     template<typename T>
     inline const T deserializeIntegral(const std::vector<BYTE>& data, size_t& pos)
     {
-        static_assert(std::is_integral<T>::value, "Integral type required");
-        T ret = *((T*) (&data[pos]));
-        pos += sizeof(T);
+        ByteReader reader(data, pos);
+        const T ret = reader.readIntegral<T>();
+        pos = reader.getPosition();
         return ret;
     }
     
@@ -187,17 +405,9 @@ namespace conclave
      */
     inline const uint64_t deserializeVarInt(const std::vector<BYTE>& data, size_t& pos)
     {
-        uint8_t size = data[pos++];
-        uint64_t ret;
-        if (size <= 0xfc) {
-            ret = size;
-        } else if (size == 0xfd) {
-            ret = deserializeIntegral<uint16_t>(data, pos);
-        } else if (size == 0xfe) {
-            ret = deserializeIntegral<uint32_t>(data, pos);
-        } else {
-            ret = deserializeIntegral<uint64_t>(data, pos);
-        }
+        ByteReader reader(data, pos);
+        const uint64_t ret = reader.readVarInt();
+        pos = reader.getPosition();
         return ret;
     }
     
@@ -232,7 +442,7 @@ namespace conclave
     {
         uint64_t nObjects = deserializeVarInt(data, pos);
         std::vector<T> objects;
-        objects.reserve(nObjects);
+        objects.reserve(std::min<uint64_t>(nObjects, data.size() - pos));
         for (uint64_t i = 0; i < nObjects; i++) {
             objects.emplace_back(T::deserialize(data, pos));
         }
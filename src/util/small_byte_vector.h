@@ -0,0 +1,139 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "../conclave.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+
+namespace conclave
+{
+    /***
+     * Immutable run of bytes which is stored inline when it is no longer than N bytes and on the heap otherwise.
+     * For values that are usually short - scripts, mostly - this saves an allocation per copy.
+     */
+    template<size_t N>
+    class SmallByteVector final
+    {
+        public:
+        SmallByteVector()
+            : nBytes(0)
+        {
+        }
+        
+        SmallByteVector(const BYTE* bytes, const size_t nBytes)
+            : nBytes(nBytes)
+        {
+            if (nBytes > N) {
+                heapBytes.reset(new BYTE[nBytes]);
+            }
+            if (nBytes > 0) {
+                std::memcpy(mutableData(), bytes, nBytes);
+            }
+        }
+        
+        SmallByteVector(const SmallByteVector& other)
+            : SmallByteVector(other.data(), other.size())
+        {
+        }
+        
+        SmallByteVector(SmallByteVector&& other) noexcept
+            : heapBytes(std::move(other.heapBytes)), nBytes(other.nBytes)
+        {
+            if (!heapBytes) {
+                inlineBytes = other.inlineBytes;
+            }
+            other.nBytes = 0;
+        }
+        
+        SmallByteVector& operator=(const SmallByteVector& other)
+        {
+            if (this != &other) {
+                *this = SmallByteVector(other);
+            }
+            return *this;
+        }
+        
+        SmallByteVector& operator=(SmallByteVector&& other) noexcept
+        {
+            if (this != &other) {
+                heapBytes = std::move(other.heapBytes);
+                nBytes = other.nBytes;
+                if (!heapBytes) {
+                    inlineBytes = other.inlineBytes;
+                }
+                other.nBytes = 0;
+            }
+            return *this;
+        }
+        
+        const BYTE* data() const
+        {
+            return heapBytes ? heapBytes.get() : inlineBytes.data();
+        }
+        
+        const size_t size() const
+        {
+            return nBytes;
+        }
+        
+        const bool empty() const
+        {
+            return nBytes == 0;
+        }
+        
+        const BYTE* begin() const
+        {
+            return data();
+        }
+        
+        const BYTE* end() const
+        {
+            return data() + nBytes;
+        }
+        
+        const BYTE operator[](const size_t index) const
+        {
+            return data()[index];
+        }
+        
+        bool operator==(const SmallByteVector& other) const
+        {
+            return nBytes == other.nBytes && std::equal(begin(), end(), other.begin());
+        }
+        
+        bool operator!=(const SmallByteVector& other) const
+        {
+            return !(*this == other);
+        }
+        
+        private:
+        BYTE* mutableData()
+        {
+            return heapBytes ? heapBytes.get() : inlineBytes.data();
+        }
+        
+        std::array<BYTE, N> inlineBytes;
+        std::unique_ptr<BYTE[]> heapBytes;
+        size_t nBytes;
+    };
+}
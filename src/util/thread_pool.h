@@ -0,0 +1,111 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/***
+ * Fixed-size pool of threads which run submitted tasks in FIFO order. Used
+ * for short, CPU-bound jobs that can be fanned out and joined, such as
+ * verifying the signatures of a transaction in parallel.
+ */
+class ThreadPool
+{
+    public:
+    explicit ThreadPool(const unsigned int numThreads)
+    {
+        threads.reserve(numThreads);
+        for (unsigned int i = 0; i < numThreads; i++) {
+            threads.emplace_back([this] { run(); });
+        }
+    }
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(tasksMutex);
+            willShutDown = true;
+        }
+        tasksCondition.notify_all();
+        for (std::thread& thread: threads) {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+    }
+    
+    template<typename F>
+    std::future<std::invoke_result_t<F>> submit(F&& function)
+    {
+        using R = std::invoke_result_t<F>;
+        auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(function));
+        std::future<R> future = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(tasksMutex);
+            if (willShutDown) {
+                throw std::runtime_error("Cannot submit task to a thread pool which is shutting down");
+            }
+            tasks.emplace([task] { (*task)(); });
+        }
+        tasksCondition.notify_one();
+        return future;
+    }
+    
+    size_t size() const
+    {
+        return threads.size();
+    }
+    
+    private:
+    void run()
+    {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(tasksMutex);
+                tasksCondition.wait(lock, [this] { return willShutDown || !tasks.empty(); });
+                if (tasks.empty()) {
+                    // Only reachable when shutting down with nothing left to do
+                    return;
+                }
+                task = std::move(tasks.front());
+                tasks.pop();
+            }
+            task();
+        }
+    }
+    
+    std::vector<std::thread> threads;
+    std::queue<std::function<void()>> tasks;
+    std::mutex tasksMutex;
+    std::condition_variable tasksCondition;
+    bool willShutDown = false;
+};
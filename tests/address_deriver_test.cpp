@@ -0,0 +1,69 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Address_Deriver_Test
+
+#include <boost/test/included/unit_test.hpp>
+#include "../src/address_deriver.h"
+#include <string>
+#include <vector>
+
+namespace conclave
+{
+    static const std::vector<PublicKey> makePublicKeys(const size_t count)
+    {
+        std::vector<PublicKey> publicKeys;
+        for (size_t i = 0; i < count; i++) {
+            publicKeys.emplace_back(Hash256::digest(std::to_string(i)), i % 2 == 0);
+        }
+        return publicKeys;
+    }
+    
+    BOOST_AUTO_TEST_SUITE(AddressDeriverTestSuite)
+        
+        BOOST_AUTO_TEST_CASE(AddressDeriverDeriveHash160sTest)
+        {
+            // Enough keys to fill the widest SIMD lanes a few times and leave a remainder
+            const std::vector<PublicKey> publicKeys = makePublicKeys(37);
+            AddressDeriver addressDeriver(Address::AddressFormat::CLASSIC, Address::NetworkType::MAINNET);
+            const std::vector<Hash160> hash160s = addressDeriver.deriveHash160s(publicKeys);
+            BOOST_TEST(hash160s.size() == publicKeys.size());
+            for (size_t i = 0; i < publicKeys.size(); i++) {
+                BOOST_TEST((hash160s[i] == publicKeys[i].getHash160Compressed()));
+            }
+            // Reusing the deriver for a smaller batch
+            const std::vector<PublicKey> fewerPublicKeys(publicKeys.begin() + 5, publicKeys.begin() + 8);
+            const std::vector<Hash160> fewerHash160s = addressDeriver.deriveHash160s(fewerPublicKeys);
+            BOOST_TEST((fewerHash160s == std::vector<Hash160>(hash160s.begin() + 5, hash160s.begin() + 8)));
+            BOOST_TEST(addressDeriver.deriveHash160s({}).empty());
+        }
+        
+        BOOST_AUTO_TEST_CASE(AddressDeriverDeriveAddressesTest)
+        {
+            const std::vector<PublicKey> publicKeys = makePublicKeys(9);
+            AddressDeriver addressDeriver(Address::AddressFormat::CONCLAVE, Address::NetworkType::TESTNET);
+            const std::vector<Address> addresses = addressDeriver.deriveAddresses(publicKeys);
+            BOOST_TEST(addresses.size() == publicKeys.size());
+            for (size_t i = 0; i < publicKeys.size(); i++) {
+                BOOST_TEST((addresses[i] == Address(publicKeys[i], Address::AddressFormat::CONCLAVE,
+                                                    Address::NetworkType::TESTNET)));
+            }
+        }
+    
+    BOOST_AUTO_TEST_SUITE_END()
+}
@@ -22,6 +22,8 @@
 #include "../../../src/chain/database/database_client.h"
 #include "../../../src/util/filesystem.h"
 #include "../../../src/conclave.h"
+#include <algorithm>
+#include <stdexcept>
 #include <vector>
 #include <string>
 
@@ -75,6 +77,30 @@ namespace conclave
                     BOOST_TEST((immutableItem2 == std::nullopt));
                 }
                 
+                BOOST_AUTO_TEST_CASE(DatabaseClientEncodedItemTest)
+                {
+                    // Test that an encoded item is stored under the given key, which need not be its hash
+                    fs::remove_all(DB_ROOT);
+                    DatabaseClient databaseClient(DB_ROOT);
+                    databaseClient.putEncodedItem(ITEM_1_KEY, ITEM_2);
+                    BOOST_TEST((databaseClient.getEncodedItem(ITEM_1_KEY) == ITEM_2));
+                    BOOST_TEST((databaseClient.getEncodedItem(ITEM_2_KEY) == std::nullopt));
+                    BOOST_CHECK_THROW(databaseClient.getItem(ITEM_1_KEY), std::runtime_error);
+                    WriteBatch writeBatch;
+                    writeBatch.putEncodedItem(ITEM_2_KEY, ITEM_3);
+                    databaseClient.writeBatch(writeBatch);
+                    BOOST_TEST((databaseClient.getEncodedItem(ITEM_2_KEY) == ITEM_3));
+                }
+                
+                BOOST_AUTO_TEST_CASE(DatabaseClientIsEmptyTest)
+                {
+                    fs::remove_all(DB_ROOT);
+                    DatabaseClient databaseClient(DB_ROOT);
+                    BOOST_TEST(databaseClient.isEmpty());
+                    databaseClient.putMutableItem(COLLECTION_NAME_1, RANDOM_HASH_1, ITEM_1);
+                    BOOST_TEST(!databaseClient.isEmpty());
+                }
+                
                 BOOST_AUTO_TEST_CASE(DatabaseClientPutMutableItemTest)
                 {
                     // Test that putMutableItem replaces the value when called with the same key
@@ -128,6 +154,61 @@ namespace conclave
                     singletonItem1 = databaseClient.getSingletonItem(COLLECTION_NAME_1);
                     BOOST_TEST((singletonItem1 == ITEM_2));
                 }
+                
+                BOOST_AUTO_TEST_CASE(DatabaseClientWriteBatchTest)
+                {
+                    // Test that a batch writes all its items and applies erasures before puts
+                    fs::remove_all(DB_ROOT);
+                    DatabaseClient databaseClient(DB_ROOT);
+                    databaseClient.putMutableItem(COLLECTION_NAME_1, RANDOM_HASH_1, ITEM_1);
+                    databaseClient.putMutableItem(COLLECTION_NAME_2, RANDOM_HASH_1, ITEM_2);
+                    WriteBatch writeBatch;
+                    BOOST_TEST(writeBatch.empty());
+                    BOOST_TEST(writeBatch.putItem(ITEM_1) == ITEM_1_KEY);
+                    writeBatch.erase(DatabaseClient::makeCollectionKey(COLLECTION_NAME_1, RANDOM_HASH_1));
+                    writeBatch.erase(DatabaseClient::makeCollectionKey(COLLECTION_NAME_2, RANDOM_HASH_1));
+                    writeBatch.putMutableItem(COLLECTION_NAME_2, RANDOM_HASH_1, ITEM_3);
+                    BOOST_TEST(writeBatch.size() == 4);
+                    databaseClient.writeBatch(writeBatch);
+                    BOOST_TEST((databaseClient.getItem(ITEM_1_KEY) == ITEM_1));
+                    BOOST_TEST((databaseClient.getMutableItem(COLLECTION_NAME_1, RANDOM_HASH_1) == std::nullopt));
+                    BOOST_TEST((databaseClient.getMutableItem(COLLECTION_NAME_2, RANDOM_HASH_1) == ITEM_3));
+                    writeBatch.clear();
+                    BOOST_TEST(writeBatch.empty());
+                }
+                
+                BOOST_AUTO_TEST_CASE(DatabaseClientScanTest)
+                {
+                    // Test that disjoint ranges together visit every entry exactly once, in key order
+                    fs::remove_all(DB_ROOT);
+                    DatabaseClient databaseClient(DB_ROOT);
+                    databaseClient.putItem(ITEM_1);
+                    databaseClient.putItem(ITEM_2);
+                    databaseClient.putMutableItem(COLLECTION_NAME_1, RANDOM_HASH_1, ITEM_3);
+                    databaseClient.putMutableItem(COLLECTION_NAME_2, RANDOM_HASH_2, ITEM_4);
+                    const Hash256 zero("0000000000000000000000000000000000000000000000000000000000000000");
+                    const Hash256 middle("8000000000000000000000000000000000000000000000000000000000000000");
+                    std::vector<std::vector<BYTE>> keys;
+                    std::vector<std::vector<BYTE>> values;
+                    const auto visitor = [&keys, &values](const Hash256& key, const std::vector<BYTE>& value) {
+                        keys.emplace_back(static_cast<std::vector<BYTE>>(key));
+                        values.emplace_back(value);
+                    };
+                    databaseClient.scan(zero, middle, visitor);
+                    for (const std::vector<BYTE>& key : keys) {
+                        BOOST_TEST(key[0] < 0x80);
+                    }
+                    const size_t nLow = keys.size();
+                    databaseClient.scan(middle, std::nullopt, visitor);
+                    for (size_t i = nLow; i < keys.size(); i++) {
+                        BOOST_TEST(keys[i][0] >= 0x80);
+                    }
+                    BOOST_TEST(keys.size() == 4);
+                    BOOST_TEST(std::is_sorted(keys.begin(), keys.end()));
+                    for (const std::vector<BYTE>& item : {ITEM_1, ITEM_2, ITEM_3, ITEM_4}) {
+                        BOOST_TEST(std::count(values.begin(), values.end(), item) == 1);
+                    }
+                }
             
             BOOST_AUTO_TEST_SUITE_END()
         }
@@ -0,0 +1,87 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Multisig_Verifier_Test
+
+#include <boost/test/included/unit_test.hpp>
+#include "../../src/chain/multisig_verifier.h"
+#include "../../src/private_key.h"
+
+namespace conclave
+{
+    namespace chain
+    {
+        const static std::vector<PrivateKey> TRUSTEE_PRIVATE_KEYS{
+            PrivateKey(Hash256("017b8511ce04f889d3ef08df1c4497794a2fce1c92a84562bbe5c6d572bfc67c")),
+            PrivateKey(Hash256("5f0c3b4a6e1d2c8b9a7f6e5d4c3b2a1908f7e6d5c4b3a2918f7e6d5c4b3a2910")),
+            PrivateKey(Hash256("2a6c1e9b8d7f4a3c5e2b1d0f9e8c7a6b5d4c3e2f1a0b9c8d7e6f5a4b3c2d1e0f"))
+        };
+        const static Hash256 SIG_HASH("c48dc09b1e0495d33f6af7493fa10d050d5ffd5fc9a4f6bdaee0d1f1680f0feb");
+        const static Hash256 OTHER_SIG_HASH("8e188221e8c93e55c19b0ccc38fbe55a94c85a8ced56fcd36ef40197b61b6e35");
+        
+        inline static std::vector<PublicKey> makeTrustees()
+        {
+            std::vector<PublicKey> trustees;
+            for (const PrivateKey& privateKey: TRUSTEE_PRIVATE_KEYS) {
+                trustees.push_back(privateKey.getPublicKey());
+            }
+            return trustees;
+        }
+        
+        BOOST_AUTO_TEST_SUITE(MultisigVerifierTestSuite)
+            
+            BOOST_AUTO_TEST_CASE(MultisigVerifierMatchSignatureTest)
+            {
+                const MultisigVerifier multisigVerifier(makeTrustees());
+                for (size_t i = 0; i < TRUSTEE_PRIVATE_KEYS.size(); i++) {
+                    const EcdsaSignature signature = TRUSTEE_PRIVATE_KEYS[i].sign(SIG_HASH);
+                    BOOST_TEST((multisigVerifier.matchSignature(SIG_HASH, signature, 0) == i));
+                    BOOST_TEST((multisigVerifier.matchSignature(SIG_HASH, signature, i + 1) == std::nullopt));
+                    BOOST_TEST((multisigVerifier.matchSignature(OTHER_SIG_HASH, signature, 0) == std::nullopt));
+                }
+            }
+            
+            BOOST_AUTO_TEST_CASE(MultisigVerifierVerifyTest)
+            {
+                const MultisigVerifier multisigVerifier(makeTrustees());
+                const EcdsaSignature signature0 = TRUSTEE_PRIVATE_KEYS[0].sign(SIG_HASH);
+                const EcdsaSignature signature2 = TRUSTEE_PRIVATE_KEYS[2].sign(SIG_HASH);
+                BOOST_TEST(multisigVerifier.verify(SIG_HASH, {signature0, signature2}, 2));
+                // Out of trustee order
+                BOOST_TEST(!multisigVerifier.verify(SIG_HASH, {signature2, signature0}, 2));
+                // Same trustee twice
+                BOOST_TEST(!multisigVerifier.verify(SIG_HASH, {signature0, signature0}, 2));
+                // Wrong number of signatures
+                BOOST_TEST(!multisigVerifier.verify(SIG_HASH, {signature0}, 2));
+                BOOST_TEST(!multisigVerifier.verify(SIG_HASH, {signature0, signature2}, 1));
+                // Wrong message
+                BOOST_TEST(!multisigVerifier.verify(OTHER_SIG_HASH, {signature0, signature2}, 2));
+            }
+            
+            BOOST_AUTO_TEST_CASE(MultisigVerifierTrusteeSetIdTest)
+            {
+                std::vector<PublicKey> trustees = makeTrustees();
+                const Hash256 trusteeSetId = MultisigVerifier::makeTrusteeSetId(trustees);
+                BOOST_TEST((trusteeSetId == MultisigVerifier::makeTrusteeSetId(makeTrustees())));
+                std::swap(trustees[0], trustees[1]);
+                BOOST_TEST((trusteeSetId != MultisigVerifier::makeTrusteeSetId(trustees)));
+            }
+        
+        BOOST_AUTO_TEST_SUITE_END()
+    }
+}
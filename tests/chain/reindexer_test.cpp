@@ -0,0 +1,281 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Reindexer_Test
+
+#include <boost/test/included/unit_test.hpp>
+#include "../../src/chain/reindexer.h"
+#include "../../src/chain/conclave_chain.h"
+#include "../../src/chain/bitcoin_chain.h"
+#include "../../src/structs/compact_encoding.h"
+#include "../../src/structs/sig_hash_context.h"
+#include "../../src/private_key.h"
+#include "../../src/util/byte_sink.h"
+#include "../../src/util/filesystem.h"
+#include "../../src/util/serialization.h"
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace conclave
+{
+    namespace chain
+    {
+        const static std::string DB_ROOT = "/tmp/conclaveReindexerDB.mdb";
+        const static PrivateKey PRIVATE_KEY_1(Hash256("017b8511ce04f889d3ef08df1c4497794a2fce1c92a84562bbe5c6d572bfc67c"));
+        const static PrivateKey PRIVATE_KEY_2(Hash256("5f0c3b4a6e1d2c8b9a7f6e5d4c3b2a1908f7e6d5c4b3a2918f7e6d5c4b3a2910"));
+        const static Outpoint FUND_POINT(Hash256("b5c1e7f9d3a2c4e6f8a0b2c4d6e8f0a1b3c5d7e9f1a3b5c7d9e1f3a5b7c9d1e3"), 0);
+        
+        static const Address makeAddress(const PrivateKey& privateKey)
+        {
+            return Address(privateKey.getPublicKey(), Address::AddressFormat::CLASSIC, Address::NetworkType::MAINNET);
+        }
+        
+        static const ConclaveOutput payTo(const PrivateKey& privateKey, const uint64_t value)
+        {
+            return ConclaveOutput(Script::p2hScript(makeAddress(privateKey)), value);
+        }
+        
+        /***
+         * Builds a transaction spending the given outputs, all of which belong to the signer
+         */
+        static ConclaveTx makeSignedTx(const PrivateKey& signer,
+                                       const std::vector<std::pair<Outpoint, ConclaveOutput>>& spent,
+                                       const std::vector<ConclaveOutput>& conclaveOutputs)
+        {
+            std::vector<ConclaveInput> conclaveInputs;
+            for (const std::pair<Outpoint, ConclaveOutput>& prevOutput : spent) {
+                conclaveInputs.emplace_back(prevOutput.first, Script(), 0);
+            }
+            ConclaveTx conclaveTx(0, 0, conclaveInputs, {}, conclaveOutputs);
+            const SigHashContext sigHashContext(conclaveTx);
+            for (size_t i = 0; i < spent.size(); i++) {
+                const Hash256 sigHash =
+                    sigHashContext.getSigHash(i, spent[i].second.scriptPubKey, spent[i].second.value);
+                conclaveTx.conclaveInputs[i].scriptSig = Script(std::vector<ScriptElement>{
+                    signer.sign(sigHash).serialize(), signer.getPublicKey()
+                });
+            }
+            return conclaveTx;
+        }
+        
+        /***
+         * A node's view of the chain over DB_ROOT. The Bitcoin chain is never queried, so nothing listens on its
+         * port.
+         */
+        struct TestChain
+        {
+            TestChain()
+                : conclaveChainConfig(DatabaseClientConfig(DB_ROOT), 2, 100),
+                  bitcoinChainConfig(ElectrumxClientConfig("127.0.0.1", 50001)),
+                  bitcoinChain(bitcoinChainConfig),
+                  conclaveChain(conclaveChainConfig, bitcoinChain)
+            {
+            }
+            
+            ConclaveChainConfig conclaveChainConfig;
+            BitcoinChainConfig bitcoinChainConfig;
+            BitcoinChain bitcoinChain;
+            ConclaveChain conclaveChain;
+        };
+        
+        /***
+         * What a reindex must reproduce
+         */
+        struct ChainState
+        {
+            explicit ChainState(ConclaveChain& conclaveChain)
+                : balance1(conclaveChain.getAddressBalance(makeAddress(PRIVATE_KEY_1))),
+                  balance2(conclaveChain.getAddressBalance(makeAddress(PRIVATE_KEY_2))),
+                  utxos1(conclaveChain.getUtxos(makeAddress(PRIVATE_KEY_1))),
+                  utxos2(conclaveChain.getUtxos(makeAddress(PRIVATE_KEY_2))),
+                  stateRoot(conclaveChain.getStateRoot())
+            {
+            }
+            
+            void check(ConclaveChain& conclaveChain) const
+            {
+                const ChainState reindexed(conclaveChain);
+                BOOST_TEST(reindexed.balance1 == balance1);
+                BOOST_TEST(reindexed.balance2 == balance2);
+                BOOST_TEST((reindexed.utxos1 == utxos1));
+                BOOST_TEST((reindexed.utxos2 == utxos2));
+                BOOST_TEST(reindexed.stateRoot == stateRoot);
+            }
+            
+            uint64_t balance1;
+            uint64_t balance2;
+            std::vector<ConclaveRichOutput> utxos1;
+            std::vector<ConclaveRichOutput> utxos2;
+            Hash256 stateRoot;
+        };
+        
+        /***
+         * Builds a small chain: a claim funding both keys, then two transactions submitted to the node moving funds
+         * from one key to the other and partly back. Claims need the Bitcoin chain, so the claim is stored directly
+         * and indexed by a first reindex. No transaction pays the same wallet twice, which the node does not support.
+         */
+        struct ChainFixture
+        {
+            ChainFixture()
+            {
+                fs::remove_all(DB_ROOT);
+                const ConclaveTx claimTx(1, FUND_POINT, {PRIVATE_KEY_1.getPublicKey()}, {},
+                                         {payTo(PRIVATE_KEY_1, 5000), payTo(PRIVATE_KEY_2, 3000)});
+                txIds.emplace_back(claimTx.getHash256());
+                {
+                    DatabaseClient databaseClient(DB_ROOT);
+                    databaseClient.putEncodedItem(txIds[0], compact::serializeConclaveTx(claimTx));
+                    Reindexer(databaseClient, 2).run();
+                }
+                TestChain testChain;
+                const ConclaveTx tx1 = makeSignedTx(PRIVATE_KEY_1,
+                                                    {{Outpoint(txIds[0], 0), payTo(PRIVATE_KEY_1, 5000)}},
+                                                    {payTo(PRIVATE_KEY_2, 2000), payTo(PRIVATE_KEY_1, 3000)});
+                txIds.emplace_back(testChain.conclaveChain.submitTx(tx1));
+                const ConclaveTx tx2 = makeSignedTx(PRIVATE_KEY_2,
+                                                    {{Outpoint(txIds[1], 0), payTo(PRIVATE_KEY_2, 2000)}},
+                                                    {payTo(PRIVATE_KEY_1, 1500), payTo(PRIVATE_KEY_2, 500)});
+                txIds.emplace_back(testChain.conclaveChain.submitTx(tx2));
+                state = std::make_unique<ChainState>(testChain.conclaveChain);
+            }
+            
+            std::vector<Hash256> txIds;
+            std::unique_ptr<ChainState> state;
+        };
+        
+        BOOST_FIXTURE_TEST_SUITE(ReindexerTestSuite, ChainFixture)
+            
+            BOOST_AUTO_TEST_CASE(ChainFixtureTest)
+            {
+                BOOST_TEST(state->balance1 == 3000 + 1500);
+                BOOST_TEST(state->balance2 == 3000 + 500);
+                BOOST_TEST(state->utxos1.size() == 3);
+                BOOST_TEST(state->utxos2.size() == 3);
+                BOOST_TEST(state->stateRoot != StateTree::EMPTY_ROOT);
+            }
+            
+            BOOST_AUTO_TEST_CASE(ReindexRebuildsIndexesTest)
+            {
+                const Hash256 wallet1 = Script::p2hScript(makeAddress(PRIVATE_KEY_1)).getHash256();
+                const Hash256 wallet2 = Script::p2hScript(makeAddress(PRIVATE_KEY_2)).getHash256();
+                const Outpoint unspent(txIds[2], 1);
+                const std::vector<BYTE> chainTip = static_cast<std::vector<BYTE>>(Hash256::digest("chain tip"));
+                {
+                    DatabaseClient databaseClient(DB_ROOT);
+                    // A wrong fund tip, a missing spend tip, an unspent output marked spent and a stray leaf
+                    databaseClient.putMutableItem(ConclaveChain::COLLECTION_FUND_TIPS, wallet1, Outpoint(txIds[2], 1));
+                    WriteBatch writeBatch;
+                    writeBatch.erase(DatabaseClient::makeCollectionKey(ConclaveChain::COLLECTION_SPEND_TIPS, wallet2));
+                    databaseClient.writeBatch(writeBatch);
+                    databaseClient.putMutableItem(ConclaveChain::COLLECTION_SPENDS, unspent.getHash256(),
+                                                  Inpoint(txIds[1], 0));
+                    StateTree stateTree(databaseClient, ConclaveChain::COLLECTION_STATE_TREE);
+                    stateTree.insert(Hash256::digest("stray"), Hash256::digest("value"));
+                    stateTree.commit();
+                    BOOST_TEST(stateTree.getRoot() != state->stateRoot);
+                    // Not rebuilt by a reindex, so it must survive one
+                    databaseClient.putSingletonItem(ConclaveChain::COLLECTION_CHAIN_TIP, chainTip);
+                }
+                {
+                    TestChain testChain;
+                    const Address address1 = makeAddress(PRIVATE_KEY_1);
+                    BOOST_TEST(testChain.conclaveChain.getAddressBalance(address1) != state->balance1);
+                }
+                {
+                    DatabaseClient databaseClient(DB_ROOT);
+                    Reindexer(databaseClient, 3).run();
+                    BOOST_TEST((databaseClient.getSingletonItem(ConclaveChain::COLLECTION_CHAIN_TIP) == chainTip));
+                    BOOST_TEST(!databaseClient.getMutableItem(ConclaveChain::COLLECTION_SPENDS,
+                                                              unspent.getHash256()).has_value());
+                }
+                TestChain testChain;
+                state->check(testChain.conclaveChain);
+                // Each transaction's state root is rebuilt too, and the last one is the current root
+                BOOST_TEST((testChain.conclaveChain.getStateRoot(txIds[2]) == state->stateRoot));
+            }
+            
+            BOOST_AUTO_TEST_CASE(ReindexUpgradesLegacyEncodingTest)
+            {
+                {
+                    // Rewrite the chain as an older node stored it: transactions content-addressed in their consensus
+                    // serialization
+                    DatabaseClient databaseClient(DB_ROOT);
+                    for (const Hash256& txId : txIds) {
+                        const ConclaveTx conclaveTx =
+                            compact::deserializeConclaveTx(*databaseClient.getEncodedItem(txId));
+                        WriteBatch writeBatch;
+                        writeBatch.erase(txId);
+                        databaseClient.writeBatch(writeBatch);
+                        BOOST_TEST(databaseClient.putItem(conclaveTx.serialize()) == txId);
+                    }
+                    databaseClient.putSingletonItem(ConclaveChain::COLLECTION_STORAGE_FORMAT, {0, 0, 0, 0});
+                }
+                BOOST_CHECK_THROW(TestChain(), std::runtime_error);
+                {
+                    DatabaseClient databaseClient(DB_ROOT);
+                    Reindexer(databaseClient, 2).run();
+                    for (const Hash256& txId : txIds) {
+                        const std::optional<std::vector<BYTE>> encoded = databaseClient.getEncodedItem(txId);
+                        BOOST_REQUIRE(encoded.has_value());
+                        BOOST_TEST(compact::deserializeConclaveTx(*encoded).getHash256() == txId);
+                    }
+                }
+                TestChain testChain;
+                state->check(testChain.conclaveChain);
+            }
+            
+            BOOST_AUTO_TEST_CASE(StorageFormatTest)
+            {
+                // A database with transactions but no storage format was written before there was one
+                fs::remove_all(DB_ROOT);
+                {
+                    DatabaseClient databaseClient(DB_ROOT);
+                    databaseClient.putItem(ConclaveTx(1, FUND_POINT, {PRIVATE_KEY_1.getPublicKey()}, {},
+                                                      {payTo(PRIVATE_KEY_1, 5000)}).serialize());
+                }
+                BOOST_CHECK_THROW(TestChain(), std::runtime_error);
+                // A new database is marked with the current format
+                fs::remove_all(DB_ROOT);
+                {
+                    TestChain testChain;
+                }
+                std::vector<BYTE> storageFormat;
+                ByteVectorSink sink(storageFormat);
+                writeIntegral(sink, ConclaveChain::STORAGE_FORMAT_VERSION);
+                {
+                    DatabaseClient databaseClient(DB_ROOT);
+                    BOOST_TEST((databaseClient.getSingletonItem(ConclaveChain::COLLECTION_STORAGE_FORMAT) ==
+                                storageFormat));
+                }
+                // Nor can this node read a database written by a newer one
+                std::vector<BYTE> newerFormat;
+                ByteVectorSink newerSink(newerFormat);
+                writeIntegral(newerSink, ConclaveChain::STORAGE_FORMAT_VERSION + 1);
+                {
+                    DatabaseClient databaseClient(DB_ROOT);
+                    databaseClient.putSingletonItem(ConclaveChain::COLLECTION_STORAGE_FORMAT, newerFormat);
+                }
+                BOOST_CHECK_THROW(TestChain(), std::runtime_error);
+            }
+        
+        BOOST_AUTO_TEST_SUITE_END()
+    }
+}
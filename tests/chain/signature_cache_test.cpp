@@ -0,0 +1,89 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Signature_Cache_Test
+
+#include <boost/test/included/unit_test.hpp>
+#include "../../src/chain/signature_cache.h"
+
+namespace conclave
+{
+    namespace chain
+    {
+        const static Hash256 ENTRY_1("7b1c5b3a21d3b0e3a4a03b45d4aa1d8d5c8d2aa8e1e44b6a7b4b5c8f0c3e7f11");
+        const static Hash256 ENTRY_2("0c9ad2b5e4e6b34e7c34c07bc9b4f0cfa51b43e9e3a7c8f8e7e23cd0f3a5a822");
+        const static Hash256 ENTRY_3("f4e54a6a0e1fdc6a2d8c6b5e3a9e6e1b7d6c8a2b0c9d1e4f5a6b7c8d9e0f1a33");
+        const static Hash256 SIG_HASH("c48dc09b1e0495d33f6af7493fa10d050d5ffd5fc9a4f6bdaee0d1f1680f0feb");
+        const static PublicKey PUBLIC_KEY("03f50ca6f27d1c1f461160ae4cc3588141dc048b262101b5faa8a22e9de4c99c08");
+        const static EcdsaSignature SIGNATURE(hexStringToByteArray<ECDSA_SIGNATURE_SIZE_BYTES>(
+            "ba19d85bb520ba8d05c8f2c2805868962ccda6d121ad76286c9431a04eaea91f"
+            "af5cbf2333b156e13de4f638014f9785ce6e85d287b0b89712a6ba1cc5834f27"));
+        
+        BOOST_AUTO_TEST_SUITE(SignatureCacheTestSuite)
+            
+            BOOST_AUTO_TEST_CASE(SignatureCacheInsertContainsTest)
+            {
+                SignatureCache signatureCache(10);
+                BOOST_TEST(!signatureCache.contains(ENTRY_1));
+                signatureCache.insert(ENTRY_1);
+                signatureCache.insert(ENTRY_1);
+                BOOST_TEST(signatureCache.contains(ENTRY_1));
+                BOOST_TEST(!signatureCache.contains(ENTRY_2));
+                BOOST_TEST(signatureCache.size() == 1);
+            }
+            
+            BOOST_AUTO_TEST_CASE(SignatureCacheEvictsOldestTest)
+            {
+                SignatureCache signatureCache(2);
+                signatureCache.insert(ENTRY_1);
+                signatureCache.insert(ENTRY_2);
+                signatureCache.insert(ENTRY_3);
+                BOOST_TEST(signatureCache.size() == 2);
+                BOOST_TEST(!signatureCache.contains(ENTRY_1));
+                BOOST_TEST(signatureCache.contains(ENTRY_2));
+                BOOST_TEST(signatureCache.contains(ENTRY_3));
+            }
+            
+            BOOST_AUTO_TEST_CASE(SignatureCacheZeroSizeTest)
+            {
+                SignatureCache signatureCache(0);
+                signatureCache.insert(ENTRY_1);
+                BOOST_TEST(signatureCache.size() == 0);
+                BOOST_TEST(!signatureCache.contains(ENTRY_1));
+            }
+            
+            BOOST_AUTO_TEST_CASE(SignatureCacheMakeEntryTest)
+            {
+                const Hash256 entry = SignatureCache::makeEntry(SIG_HASH, PUBLIC_KEY, SIGNATURE);
+                BOOST_TEST((entry == SignatureCache::makeEntry(SIG_HASH, PUBLIC_KEY, SIGNATURE)));
+                BOOST_TEST((entry != SignatureCache::makeEntry(ENTRY_1, PUBLIC_KEY, SIGNATURE)));
+            }
+            
+            BOOST_AUTO_TEST_CASE(SignatureCacheMakeMultisigEntryTest)
+            {
+                const Hash256 entry = SignatureCache::makeMultisigEntry(SIG_HASH, ENTRY_1, 1, {SIGNATURE});
+                BOOST_TEST((entry == SignatureCache::makeMultisigEntry(SIG_HASH, ENTRY_1, 1, {SIGNATURE})));
+                BOOST_TEST((entry != SignatureCache::makeMultisigEntry(SIG_HASH, ENTRY_2, 1, {SIGNATURE})));
+                BOOST_TEST((entry != SignatureCache::makeMultisigEntry(SIG_HASH, ENTRY_1, 2, {SIGNATURE})));
+                BOOST_TEST((entry != SignatureCache::makeMultisigEntry(SIG_HASH, ENTRY_1, 1, {SIGNATURE, SIGNATURE})));
+                BOOST_TEST((entry != SignatureCache::makeEntry(SIG_HASH, PUBLIC_KEY, SIGNATURE)));
+            }
+        
+        BOOST_AUTO_TEST_SUITE_END()
+    }
+}
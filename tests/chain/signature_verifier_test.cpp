@@ -0,0 +1,211 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Signature_Verifier_Test
+
+#include <boost/test/included/unit_test.hpp>
+#include "../../src/chain/signature_verifier.h"
+#include "../../src/private_key.h"
+
+namespace conclave
+{
+    namespace chain
+    {
+        const static PrivateKey PRIVATE_KEY_1(Hash256("017b8511ce04f889d3ef08df1c4497794a2fce1c92a84562bbe5c6d572bfc67c"));
+        const static PrivateKey PRIVATE_KEY_2(Hash256("5f0c3b4a6e1d2c8b9a7f6e5d4c3b2a1908f7e6d5c4b3a2918f7e6d5c4b3a2910"));
+        const static Hash256 PREV_TX_ID("b5c1e7f9d3a2c4e6f8a0b2c4d6e8f0a1b3c5d7e9f1a3b5c7d9e1f3a5b7c9d1e3");
+        const static size_t NUM_INPUTS = 9;
+        
+        inline static Script makeP2pkhScript(const PublicKey& publicKey)
+        {
+            return Script(std::vector<ScriptElement>{
+                ScriptOp::dup, ScriptOp::hash160, publicKey.getHash160Compressed(), ScriptOp::equalverify,
+                ScriptOp::checksig
+            });
+        }
+        
+        inline static std::vector<ConclaveOutput> makePrevOutputs(const PublicKey& publicKey)
+        {
+            return std::vector<ConclaveOutput>(NUM_INPUTS, ConclaveOutput(makeP2pkhScript(publicKey), 1000));
+        }
+        
+        /***
+         * Builds a transaction spending NUM_INPUTS outputs paid to PRIVATE_KEY_1, with every input signed by
+         * the given key.
+         */
+        inline static ConclaveTx makeSignedTx(const PrivateKey& signer, const uint64_t value)
+        {
+            const std::vector<ConclaveOutput> prevOutputs = makePrevOutputs(PRIVATE_KEY_1.getPublicKey());
+            std::vector<ConclaveInput> conclaveInputs;
+            for (uint32_t i = 0; i < NUM_INPUTS; i++) {
+                conclaveInputs.emplace_back(Outpoint(PREV_TX_ID, i), Script(), 0);
+            }
+            ConclaveTx conclaveTx(0, 0, conclaveInputs, {},
+                                  {ConclaveOutput(makeP2pkhScript(PRIVATE_KEY_2.getPublicKey()), value)});
+            const SigHashContext sigHashContext(conclaveTx);
+            for (size_t i = 0; i < NUM_INPUTS; i++) {
+                const Hash256 sigHash =
+                    sigHashContext.getSigHash(i, prevOutputs[i].scriptPubKey, prevOutputs[i].value);
+                conclaveTx.conclaveInputs[i].scriptSig = Script(std::vector<ScriptElement>{
+                    signer.sign(sigHash).serialize(), signer.getPublicKey()
+                });
+            }
+            return conclaveTx;
+        }
+        
+        BOOST_AUTO_TEST_SUITE(SignatureVerifierTestSuite)
+            
+            BOOST_AUTO_TEST_CASE(SignatureVerifierValidTxTest)
+            {
+                SignatureVerifier signatureVerifier(4, 100);
+                const ConclaveTx conclaveTx = makeSignedTx(PRIVATE_KEY_1, 5000);
+                signatureVerifier.verifyTx(conclaveTx, makePrevOutputs(PRIVATE_KEY_1.getPublicKey()));
+            }
+            
+            BOOST_AUTO_TEST_CASE(SignatureVerifierSigHashIgnoresPredecessorsTest)
+            {
+                SignatureVerifier signatureVerifier(1, 100);
+                ConclaveTx conclaveTx = makeSignedTx(PRIVATE_KEY_1, 5000);
+                conclaveTx.conclaveInputs[0].predecessor = Inpoint(PREV_TX_ID, 1);
+                conclaveTx.conclaveOutputs[0].predecessor = Outpoint(PREV_TX_ID, 2);
+                signatureVerifier.verifyTx(conclaveTx, makePrevOutputs(PRIVATE_KEY_1.getPublicKey()));
+            }
+            
+            BOOST_AUTO_TEST_CASE(SignatureVerifierTamperedTxTest)
+            {
+                SignatureVerifier signatureVerifier(4, 100);
+                ConclaveTx conclaveTx = makeSignedTx(PRIVATE_KEY_1, 5000);
+                conclaveTx.conclaveOutputs[0].value = 6000;
+                BOOST_CHECK_THROW(signatureVerifier.verifyTx(conclaveTx, makePrevOutputs(PRIVATE_KEY_1.getPublicKey())),
+                                  std::runtime_error);
+            }
+            
+            BOOST_AUTO_TEST_CASE(SignatureVerifierWrongPrevValueTest)
+            {
+                SignatureVerifier signatureVerifier(4, 100);
+                const ConclaveTx conclaveTx = makeSignedTx(PRIVATE_KEY_1, 5000);
+                std::vector<ConclaveOutput> prevOutputs = makePrevOutputs(PRIVATE_KEY_1.getPublicKey());
+                prevOutputs[5].value = 2000;
+                BOOST_CHECK_THROW(signatureVerifier.verifyTx(conclaveTx, prevOutputs), std::runtime_error);
+            }
+            
+            BOOST_AUTO_TEST_CASE(SignatureVerifierWrongKeyTest)
+            {
+                SignatureVerifier signatureVerifier(4, 100);
+                const ConclaveTx conclaveTx = makeSignedTx(PRIVATE_KEY_2, 5000);
+                BOOST_CHECK_THROW(signatureVerifier.verifyTx(conclaveTx, makePrevOutputs(PRIVATE_KEY_1.getPublicKey())),
+                                  std::runtime_error);
+            }
+            
+            BOOST_AUTO_TEST_CASE(SignatureVerifierMalformedScriptSigTest)
+            {
+                SignatureVerifier signatureVerifier(4, 100);
+                ConclaveTx conclaveTx = makeSignedTx(PRIVATE_KEY_1, 5000);
+                conclaveTx.conclaveInputs[3].scriptSig = Script(std::vector<ScriptElement>{ScriptOp::dup});
+                BOOST_CHECK_THROW(signatureVerifier.verifyTx(conclaveTx, makePrevOutputs(PRIVATE_KEY_1.getPublicKey())),
+                                  std::runtime_error);
+            }
+            
+            BOOST_AUTO_TEST_CASE(SignatureVerifierBatchAndCacheTest)
+            {
+                SignatureVerifier signatureVerifier(4, 100);
+                const std::vector<ConclaveOutput> prevOutputs = makePrevOutputs(PRIVATE_KEY_1.getPublicKey());
+                std::vector<SignatureVerifier::SignatureCheck> signatureChecks =
+                    SignatureVerifier::makeSignatureChecks(makeSignedTx(PRIVATE_KEY_1, 5000), prevOutputs);
+                const std::vector<SignatureVerifier::SignatureCheck> moreSignatureChecks =
+                    SignatureVerifier::makeSignatureChecks(makeSignedTx(PRIVATE_KEY_1, 7000), prevOutputs);
+                signatureChecks.insert(signatureChecks.end(), moreSignatureChecks.begin(), moreSignatureChecks.end());
+                BOOST_TEST(signatureChecks.size() == 2 * NUM_INPUTS);
+                BOOST_TEST(signatureVerifier.verify(signatureChecks));
+                // Second pass is served from the cache
+                BOOST_TEST(signatureVerifier.verify(signatureChecks));
+                // A bad check fails the batch even when the rest are cached
+                signatureChecks.back().sigHash = PREV_TX_ID;
+                BOOST_TEST(!signatureVerifier.verify(signatureChecks));
+            }
+        
+            BOOST_AUTO_TEST_CASE(SignatureVerifierMultisigTest)
+            {
+                SignatureVerifier signatureVerifier(4, 100);
+                const std::vector<PublicKey> trustees{PRIVATE_KEY_1.getPublicKey(), PRIVATE_KEY_2.getPublicKey()};
+                const ConclaveTx claimTx(2, trustees, {});
+                const Script claimScript = claimTx.getClaimScript();
+                const std::vector<ConclaveOutput> prevOutputs{ConclaveOutput(Script::p2shScript(claimScript), 1000)};
+                ConclaveTx conclaveTx(0, 0, {ConclaveInput(Outpoint(PREV_TX_ID, 0), Script(), 0)}, {},
+                                      {ConclaveOutput(makeP2pkhScript(PRIVATE_KEY_2.getPublicKey()), 1000)});
+                const Hash256 sigHash = conclaveTx.getSigHash(0, claimScript, 1000);
+                const std::vector<BYTE> signature1 = PRIVATE_KEY_1.sign(sigHash).serialize();
+                const std::vector<BYTE> signature2 = PRIVATE_KEY_2.sign(sigHash).serialize();
+                const std::vector<BYTE> claimScriptBytes = static_cast<std::vector<BYTE>>(claimScript);
+                conclaveTx.conclaveInputs[0].scriptSig =
+                    Script(std::vector<ScriptElement>{signature1, signature2, claimScriptBytes});
+                signatureVerifier.verifyTx(conclaveTx, prevOutputs);
+                conclaveTx.conclaveInputs[0].scriptSig =
+                    Script(std::vector<ScriptElement>{signature2, signature1, claimScriptBytes});
+                BOOST_CHECK_THROW(signatureVerifier.verifyTx(conclaveTx, prevOutputs), std::runtime_error);
+                conclaveTx.conclaveInputs[0].scriptSig =
+                    Script(std::vector<ScriptElement>{signature1, claimScriptBytes});
+                BOOST_CHECK_THROW(signatureVerifier.verifyTx(conclaveTx, prevOutputs), std::runtime_error);
+            }
+            
+            BOOST_AUTO_TEST_CASE(SignatureVerifierManyMultisigInputsTest)
+            {
+                // Multisig inputs interleaved with single signature ones, verified with and without a pool
+                const std::vector<PublicKey> trustees{PRIVATE_KEY_1.getPublicKey(), PRIVATE_KEY_2.getPublicKey()};
+                const Script claimScript = ConclaveTx(2, trustees, {}).getClaimScript();
+                const std::vector<BYTE> claimScriptBytes = static_cast<std::vector<BYTE>>(claimScript);
+                std::vector<ConclaveOutput> prevOutputs;
+                std::vector<ConclaveInput> conclaveInputs;
+                for (uint32_t i = 0; i < NUM_INPUTS; i++) {
+                    prevOutputs.emplace_back(i % 2 ? makeP2pkhScript(PRIVATE_KEY_1.getPublicKey())
+                                                   : Script::p2shScript(claimScript), 1000 + i);
+                    conclaveInputs.emplace_back(Outpoint(PREV_TX_ID, i), Script(), 0);
+                }
+                ConclaveTx conclaveTx(0, 0, conclaveInputs, {},
+                                      {ConclaveOutput(makeP2pkhScript(PRIVATE_KEY_2.getPublicKey()), 5000)});
+                const SigHashContext sigHashContext(conclaveTx);
+                for (size_t i = 0; i < NUM_INPUTS; i++) {
+                    if (i % 2) {
+                        const Hash256 sigHash =
+                            sigHashContext.getSigHash(i, prevOutputs[i].scriptPubKey, prevOutputs[i].value);
+                        conclaveTx.conclaveInputs[i].scriptSig = Script(std::vector<ScriptElement>{
+                            PRIVATE_KEY_1.sign(sigHash).serialize(), PRIVATE_KEY_1.getPublicKey()
+                        });
+                    } else {
+                        const Hash256 sigHash = sigHashContext.getSigHash(i, claimScript, prevOutputs[i].value);
+                        conclaveTx.conclaveInputs[i].scriptSig = Script(std::vector<ScriptElement>{
+                            PRIVATE_KEY_1.sign(sigHash).serialize(), PRIVATE_KEY_2.sign(sigHash).serialize(),
+                            claimScriptBytes
+                        });
+                    }
+                }
+                for (const unsigned int numThreads: {1u, 4u}) {
+                    SignatureVerifier signatureVerifier(numThreads, 100);
+                    signatureVerifier.verifyTx(conclaveTx, prevOutputs);
+                    // Second pass is served from the cache
+                    signatureVerifier.verifyTx(conclaveTx, prevOutputs);
+                    // A bad multisig input fails the transaction even when the rest are cached
+                    ConclaveTx tamperedTx(conclaveTx);
+                    tamperedTx.conclaveInputs[4].scriptSig = conclaveTx.conclaveInputs[2].scriptSig;
+                    BOOST_CHECK_THROW(signatureVerifier.verifyTx(tamperedTx, prevOutputs), std::runtime_error);
+                }
+            }
+        
+        BOOST_AUTO_TEST_SUITE_END()
+    }
+}
@@ -0,0 +1,220 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE State_Tree_Test
+
+#include <boost/test/included/unit_test.hpp>
+#include "../../src/chain/state_tree.h"
+#include "../../src/chain/database/database_client.h"
+#include "../../src/util/filesystem.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace conclave
+{
+    namespace chain
+    {
+        const static std::string DB_ROOT = "/tmp/conclaveStateTreeDB.mdb";
+        const static std::string COLLECTION_NAME_1 = "stateTree1";
+        const static std::string COLLECTION_NAME_2 = "stateTree2";
+        const static size_t N_KEYS = 200;
+        
+        static const std::vector<Hash256> makeKeys(const std::string& seed)
+        {
+            std::vector<Hash256> keys;
+            for (size_t i = 0; i < N_KEYS; i++) {
+                keys.emplace_back(Hash256::digest(seed + std::to_string(i)));
+            }
+            return keys;
+        }
+        
+        static const Hash256 valueOf(const Hash256& key)
+        {
+            return Hash256::digest(static_cast<std::vector<BYTE>>(key));
+        }
+        
+        BOOST_AUTO_TEST_SUITE(StateTreeTestSuite)
+            
+            BOOST_AUTO_TEST_CASE(StateTreeEmptyTest)
+            {
+                fs::remove_all(DB_ROOT);
+                DatabaseClient databaseClient(DB_ROOT);
+                StateTree stateTree(databaseClient, COLLECTION_NAME_1);
+                BOOST_TEST(stateTree.getRoot() == StateTree::EMPTY_ROOT);
+                stateTree.erase(Hash256::digest("absent"));
+                BOOST_TEST(stateTree.getRoot() == StateTree::EMPTY_ROOT);
+                BOOST_TEST(!stateTree.getNode(0, StateTree::EMPTY_ROOT).has_value());
+                // Paths are 256 bits, so nothing lies deeper
+                BOOST_CHECK_THROW(stateTree.getNode(257, StateTree::EMPTY_ROOT), std::runtime_error);
+            }
+            
+            BOOST_AUTO_TEST_CASE(StateTreeSingleLeafTest)
+            {
+                // A lone leaf sits at the root and the root hash is the leaf hash
+                fs::remove_all(DB_ROOT);
+                DatabaseClient databaseClient(DB_ROOT);
+                StateTree stateTree(databaseClient, COLLECTION_NAME_1);
+                const Hash256 key = Hash256::digest("key");
+                stateTree.insert(key, valueOf(key));
+                BOOST_TEST(stateTree.getRoot() == StateTree::makeLeafHash(key, valueOf(key)));
+                stateTree.erase(key);
+                BOOST_TEST(stateTree.getRoot() == StateTree::EMPTY_ROOT);
+            }
+            
+            BOOST_AUTO_TEST_CASE(StateTreeOrderIndependenceTest)
+            {
+                // The root depends only on the key set, not on the order of updates
+                fs::remove_all(DB_ROOT);
+                DatabaseClient databaseClient(DB_ROOT);
+                StateTree stateTree1(databaseClient, COLLECTION_NAME_1);
+                StateTree stateTree2(databaseClient, COLLECTION_NAME_2);
+                std::vector<Hash256> keys = makeKeys("a");
+                const std::vector<Hash256> extraKeys = makeKeys("b");
+                for (const Hash256& key : keys) {
+                    stateTree1.insert(key, valueOf(key));
+                }
+                for (const Hash256& key : extraKeys) {
+                    stateTree2.insert(key, valueOf(key));
+                }
+                std::reverse(keys.begin(), keys.end());
+                for (const Hash256& key : keys) {
+                    stateTree2.insert(key, valueOf(key));
+                }
+                for (const Hash256& key : extraKeys) {
+                    stateTree2.erase(key);
+                }
+                BOOST_TEST(stateTree1.getRoot() != StateTree::EMPTY_ROOT);
+                BOOST_TEST(stateTree1.getRoot() == stateTree2.getRoot());
+                for (const Hash256& key : keys) {
+                    stateTree1.erase(key);
+                }
+                BOOST_TEST(stateTree1.getRoot() == StateTree::EMPTY_ROOT);
+            }
+            
+            BOOST_AUTO_TEST_CASE(StateTreeUpdateValueTest)
+            {
+                fs::remove_all(DB_ROOT);
+                DatabaseClient databaseClient(DB_ROOT);
+                StateTree stateTree(databaseClient, COLLECTION_NAME_1);
+                const std::vector<Hash256> keys = makeKeys("a");
+                for (const Hash256& key : keys) {
+                    stateTree.insert(key, valueOf(key));
+                }
+                const Hash256 root = stateTree.getRoot();
+                stateTree.insert(keys[7], Hash256::digest("other value"));
+                BOOST_TEST(stateTree.getRoot() != root);
+                stateTree.insert(keys[7], valueOf(keys[7]));
+                BOOST_TEST(stateTree.getRoot() == root);
+            }
+            
+            BOOST_AUTO_TEST_CASE(StateTreeCommitTest)
+            {
+                // Committed nodes are visible to a fresh tree over the same collection
+                fs::remove_all(DB_ROOT);
+                DatabaseClient databaseClient(DB_ROOT);
+                StateTree stateTree1(databaseClient, COLLECTION_NAME_1);
+                const std::vector<Hash256> keys = makeKeys("a");
+                for (const Hash256& key : keys) {
+                    stateTree1.insert(key, valueOf(key));
+                }
+                stateTree1.commit();
+                StateTree stateTree2(databaseClient, COLLECTION_NAME_1);
+                BOOST_TEST(stateTree2.getRoot() == stateTree1.getRoot());
+                for (size_t i = 0; i < keys.size(); i += 2) {
+                    stateTree2.erase(keys[i]);
+                }
+                stateTree2.commit();
+                StateTree stateTree3(databaseClient, COLLECTION_NAME_2);
+                for (size_t i = 1; i < keys.size(); i += 2) {
+                    stateTree3.insert(keys[i], valueOf(keys[i]));
+                }
+                BOOST_TEST(stateTree3.getRoot() == StateTree(databaseClient, COLLECTION_NAME_1).getRoot());
+            }
+            
+            BOOST_AUTO_TEST_CASE(StateTreeClearTest)
+            {
+                // Clearing one tree erases all of its nodes and none of another collection's
+                fs::remove_all(DB_ROOT);
+                DatabaseClient databaseClient(DB_ROOT);
+                const auto countEntries = [&databaseClient]() {
+                    size_t nEntries = 0;
+                    databaseClient.scan(StateTree::EMPTY_ROOT, std::nullopt,
+                                        [&nEntries](const Hash256&, const std::vector<BYTE>&) { nEntries++; });
+                    return nEntries;
+                };
+                StateTree stateTree2(databaseClient, COLLECTION_NAME_2);
+                for (const Hash256& key : makeKeys("b")) {
+                    stateTree2.insert(key, valueOf(key));
+                }
+                stateTree2.commit();
+                const size_t nEntries = countEntries();
+                const Hash256 root2 = stateTree2.getRoot();
+                StateTree stateTree1(databaseClient, COLLECTION_NAME_1);
+                for (const Hash256& key : makeKeys("a")) {
+                    stateTree1.insert(key, valueOf(key));
+                }
+                stateTree1.commit();
+                BOOST_TEST(countEntries() > nEntries);
+                stateTree1.clear();
+                BOOST_TEST(stateTree1.getRoot() == StateTree::EMPTY_ROOT);
+                BOOST_TEST(StateTree(databaseClient, COLLECTION_NAME_1).getRoot() == StateTree::EMPTY_ROOT);
+                BOOST_TEST(countEntries() == nEntries);
+                BOOST_TEST(StateTree(databaseClient, COLLECTION_NAME_2).getRoot() == root2);
+            }
+            
+            BOOST_AUTO_TEST_CASE(StateTreeBisectTest)
+            {
+                // Walking down the differing branches of two trees finds the one differing key
+                fs::remove_all(DB_ROOT);
+                DatabaseClient databaseClient(DB_ROOT);
+                StateTree stateTree1(databaseClient, COLLECTION_NAME_1);
+                StateTree stateTree2(databaseClient, COLLECTION_NAME_2);
+                const std::vector<Hash256> keys = makeKeys("a");
+                for (const Hash256& key : keys) {
+                    stateTree1.insert(key, valueOf(key));
+                    stateTree2.insert(key, valueOf(key));
+                }
+                const Hash256& changedKey = keys[42];
+                stateTree2.insert(changedKey, Hash256::digest("other value"));
+                uint16_t depth = 0;
+                Hash256 path = StateTree::EMPTY_ROOT;
+                std::optional<StateTree::Node> node1 = stateTree1.getNode(depth, path);
+                std::optional<StateTree::Node> node2 = stateTree2.getNode(depth, path);
+                while (!node1->isLeaf()) {
+                    BOOST_TEST(node1->hash != node2->hash);
+                    // Follow whichever child differs
+                    std::array<BYTE, LARGE_HASH_SIZE_BYTES> leftPath = static_cast<std::array<BYTE, LARGE_HASH_SIZE_BYTES>>(path);
+                    std::array<BYTE, LARGE_HASH_SIZE_BYTES> rightPath = leftPath;
+                    rightPath[depth / 8] |= (1 << (7 - (depth % 8)));
+                    depth++;
+                    const std::optional<StateTree::Node> left1 = stateTree1.getNode(depth, Hash256(leftPath));
+                    const std::optional<StateTree::Node> left2 = stateTree2.getNode(depth, Hash256(leftPath));
+                    const bool goLeft = left1.has_value() && (left1->hash != left2->hash);
+                    path = goLeft ? Hash256(leftPath) : Hash256(rightPath);
+                    node1 = stateTree1.getNode(depth, path);
+                    node2 = stateTree2.getNode(depth, path);
+                }
+                BOOST_TEST(node2->isLeaf());
+                BOOST_TEST(*node1->leafKey == changedKey);
+                BOOST_TEST(*node2->leafKey == changedKey);
+            }
+        
+        BOOST_AUTO_TEST_SUITE_END()
+    }
+}
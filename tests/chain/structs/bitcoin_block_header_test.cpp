@@ -141,6 +141,21 @@ namespace conclave
                 BOOST_TEST((bitcoinBlockHeader.getHash256() == BITCOIN_BLOCK_HEADER_1_HASH));
             }
             
+            BOOST_AUTO_TEST_CASE(BitcoinBlockHeaderGetHash256sTest)
+            {
+                std::vector<BitcoinBlockHeader> headers;
+                for (uint32_t nonce = 0; nonce < 10; nonce++) {
+                    headers.emplace_back(VERSION_1, HASH_PREV_BLOCK_1, HASH_MERKLE_ROOT_1, TIME_1, BITS_1, nonce);
+                }
+                headers.emplace_back(VERSION_1, HASH_PREV_BLOCK_1, HASH_MERKLE_ROOT_1, TIME_1, BITS_1, NONCE_1);
+                const std::vector<Hash256> hashes = BitcoinBlockHeader::getHash256s(headers);
+                BOOST_TEST(hashes.size() == headers.size());
+                for (size_t i = 0; i < headers.size(); i++) {
+                    BOOST_TEST((hashes[i] == headers[i].getHash256()));
+                }
+                BOOST_TEST((hashes.back() == BITCOIN_BLOCK_HEADER_1_HASH));
+            }
+            
             BOOST_AUTO_TEST_CASE(BitcoinBlockHeaderSerializeTest)
             {
                 BitcoinBlockHeader bitcoinBlockHeader(VERSION_1, HASH_PREV_BLOCK_1, HASH_MERKLE_ROOT_1,
@@ -148,6 +163,13 @@ namespace conclave
                 BOOST_TEST((bitcoinBlockHeader.serialize() == BITCOIN_BLOCK_HEADER_1_SERIALIZED));
             }
             
+            BOOST_AUTO_TEST_CASE(BitcoinBlockHeaderSerializedSizeTest)
+            {
+                BitcoinBlockHeader bitcoinBlockHeader(VERSION_1, HASH_PREV_BLOCK_1, HASH_MERKLE_ROOT_1,
+                                                      TIME_1, BITS_1, NONCE_1);
+                BOOST_TEST((bitcoinBlockHeader.serializedSize() == BITCOIN_BLOCK_HEADER_1_SERIALIZED.size()));
+            }
+            
             BOOST_AUTO_TEST_CASE(BitcoinBlockHeaderCastToPtreeTest)
             {
                 BitcoinBlockHeader bitcoinBlockHeader(VERSION_1, HASH_PREV_BLOCK_1, HASH_MERKLE_ROOT_1,
@@ -0,0 +1,52 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Ripemd160_Test
+
+#include <boost/test/included/unit_test.hpp>
+#include "../../src/crypto/ripemd160.h"
+#include "../../src/util/hex.h"
+#include <string>
+#include <vector>
+
+namespace conclave
+{
+    namespace crypto
+    {
+        static const std::string ripemd160Hex(const std::string& message)
+        {
+            std::vector<BYTE> digest(RIPEMD160_OUTPUT_SIZE_BYTES);
+            ripemd160(reinterpret_cast<const BYTE*>(message.data()), message.size(), digest.data());
+            return byteVectorToHexString(digest);
+        }
+        
+        BOOST_AUTO_TEST_SUITE(Ripemd160TestSuite)
+            
+            BOOST_AUTO_TEST_CASE(Ripemd160KnownAnswerTest)
+            {
+                // Test vectors from the RIPEMD-160 reference page
+                BOOST_TEST(ripemd160Hex("") == "9c1185a5c5e9fc54612808977ee8f548b2258d31");
+                BOOST_TEST(ripemd160Hex("abc") == "8eb208f7e05d987a9b044a8e98c6b087f15a0bfc");
+                BOOST_TEST(ripemd160Hex("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq") ==
+                           "12a053384a9c0c88e405a06c27dcf49ada62eb2b");
+                BOOST_TEST(ripemd160Hex(std::string(1000000, 'a')) == "52783243c1697bdbe16d37f97f68f08325dc1528");
+            }
+        
+        BOOST_AUTO_TEST_SUITE_END()
+    }
+}
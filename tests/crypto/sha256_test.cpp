@@ -0,0 +1,186 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Sha256_Test
+
+#include <boost/test/included/unit_test.hpp>
+#include "../../src/crypto/sha256.h"
+#include "../../src/util/hex.h"
+#include <string>
+#include <vector>
+
+namespace conclave
+{
+    namespace crypto
+    {
+        const static std::vector<Sha256Kernel> ALL_KERNELS{
+            Sha256Kernel::Scalar, Sha256Kernel::Sse41, Sha256Kernel::Avx2, Sha256Kernel::Avx512, Sha256Kernel::ShaNi
+        };
+        // NIST FIPS 180-2 examples
+        const static std::string ABC = "abc";
+        const static std::string ABC_DIGEST = "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad";
+        const static std::string TWO_BLOCK = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+        const static std::string TWO_BLOCK_DIGEST = "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1";
+        const static std::string EMPTY_DIGEST = "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855";
+        const static std::string EMPTY_DOUBLE_DIGEST = "5df6e0e2761359d30a8275058e299fcc0381534545f55cf43e41983f5d4c9456";
+        
+        static const std::string sha256Hex(const std::string& message, const bool doubleHash)
+        {
+            std::vector<BYTE> digest(SHA256_OUTPUT_SIZE_BYTES);
+            if (doubleHash) {
+                sha256d(reinterpret_cast<const BYTE*>(message.data()), message.size(), digest.data());
+            } else {
+                sha256(reinterpret_cast<const BYTE*>(message.data()), message.size(), digest.data());
+            }
+            return byteVectorToHexString(digest);
+        }
+        
+        static const std::vector<BYTE> sha256ManyBytes(const std::vector<std::vector<BYTE>>& messages,
+                                                       const bool doubleHash, const Sha256Kernel kernel)
+        {
+            std::vector<const BYTE*> data;
+            std::vector<size_t> sizes;
+            for (const std::vector<BYTE>& message : messages) {
+                data.push_back(message.data());
+                sizes.push_back(message.size());
+            }
+            std::vector<BYTE> digests(messages.size() * SHA256_OUTPUT_SIZE_BYTES);
+            sha256Many(data.data(), sizes.data(), messages.size(), digests.data(), doubleHash, kernel);
+            return digests;
+        }
+        
+        BOOST_AUTO_TEST_SUITE(Sha256TestSuite)
+            
+            BOOST_AUTO_TEST_CASE(Sha256KnownAnswerTest)
+            {
+                BOOST_TEST(sha256Hex("", false) == EMPTY_DIGEST);
+                BOOST_TEST(sha256Hex(ABC, false) == ABC_DIGEST);
+                BOOST_TEST(sha256Hex(TWO_BLOCK, false) == TWO_BLOCK_DIGEST);
+                BOOST_TEST(sha256Hex("", true) == EMPTY_DOUBLE_DIGEST);
+            }
+            
+            BOOST_AUTO_TEST_CASE(Sha256KernelSupportTest)
+            {
+                BOOST_TEST(sha256KernelSupported(Sha256Kernel::Scalar));
+                BOOST_TEST(sha256KernelSupported(getBestSha256Kernel()));
+                std::cout << "Best SHA-256 kernel: " << sha256KernelName(getBestSha256Kernel()) << std::endl;
+            }
+            
+            BOOST_AUTO_TEST_CASE(Sha256ManyKnownAnswerTest)
+            {
+                const std::vector<std::vector<BYTE>> messages{
+                    {}, std::vector<BYTE>(ABC.begin(), ABC.end()), std::vector<BYTE>(TWO_BLOCK.begin(), TWO_BLOCK.end())
+                };
+                for (const Sha256Kernel kernel : ALL_KERNELS) {
+                    if (!sha256KernelSupported(kernel)) {
+                        continue;
+                    }
+                    const std::vector<BYTE> digests = sha256ManyBytes(messages, false, kernel);
+                    BOOST_TEST(byteVectorToHexString(std::vector<BYTE>(digests.begin(), digests.begin() + 32)) ==
+                               EMPTY_DIGEST);
+                    BOOST_TEST(byteVectorToHexString(std::vector<BYTE>(digests.begin() + 32, digests.begin() + 64)) ==
+                               ABC_DIGEST);
+                    BOOST_TEST(byteVectorToHexString(std::vector<BYTE>(digests.begin() + 64, digests.end())) ==
+                               TWO_BLOCK_DIGEST);
+                }
+            }
+            
+            BOOST_AUTO_TEST_CASE(Sha256ManyKernelsAgreeTest)
+            {
+                // Lengths around the one/two padding block boundary (55/56 bytes) and multiples of
+                // the block size, in a count that leaves a partial group for every lane width
+                std::vector<std::vector<BYTE>> messages;
+                for (size_t i = 0; i < 53; i++) {
+                    const size_t size = (i * 37) % 200;
+                    std::vector<BYTE> message(size);
+                    for (size_t j = 0; j < size; j++) {
+                        message[j] = static_cast<BYTE>(i * 31 + j);
+                    }
+                    messages.push_back(message);
+                }
+                messages.emplace_back(55, 0xab);
+                messages.emplace_back(56, 0xab);
+                messages.emplace_back(64, 0xab);
+                messages.emplace_back(128, 0xab);
+                for (const bool doubleHash : {false, true}) {
+                    std::vector<BYTE> expected;
+                    for (const std::vector<BYTE>& message : messages) {
+                        std::vector<BYTE> digest(SHA256_OUTPUT_SIZE_BYTES);
+                        if (doubleHash) {
+                            sha256d(message.data(), message.size(), digest.data());
+                        } else {
+                            sha256(message.data(), message.size(), digest.data());
+                        }
+                        expected.insert(expected.end(), digest.begin(), digest.end());
+                    }
+                    for (const Sha256Kernel kernel : ALL_KERNELS) {
+                        if (sha256KernelSupported(kernel)) {
+                            BOOST_TEST((sha256ManyBytes(messages, doubleHash, kernel) == expected),
+                                       sha256KernelName(kernel));
+                        }
+                    }
+                }
+            }
+            
+            BOOST_AUTO_TEST_CASE(Sha256ManyReusesScratchTest)
+            {
+                // A batch too big for the buffers to be kept, then smaller ones reusing whatever is left
+                for (const size_t count : {2000, 3, 40, 1}) {
+                    std::vector<std::vector<BYTE>> messages;
+                    std::vector<BYTE> expected;
+                    for (size_t i = 0; i < count; i++) {
+                        messages.emplace_back((i * 13) % 100, static_cast<BYTE>(count + i));
+                        std::vector<BYTE> digest(SHA256_OUTPUT_SIZE_BYTES);
+                        sha256d(messages.back().data(), messages.back().size(), digest.data());
+                        expected.insert(expected.end(), digest.begin(), digest.end());
+                    }
+                    BOOST_TEST((sha256ManyBytes(messages, true, getBestSha256Kernel()) == expected));
+                }
+            }
+            
+            BOOST_AUTO_TEST_CASE(Sha256HasherTest)
+            {
+                Sha256Hasher hasher;
+                std::vector<BYTE> digest(SHA256_OUTPUT_SIZE_BYTES);
+                hasher.finalize(digest.data());
+                BOOST_TEST(byteVectorToHexString(digest) == EMPTY_DIGEST);
+                hasher.update(reinterpret_cast<const BYTE*>(TWO_BLOCK.data()), 10)
+                      .update(reinterpret_cast<const BYTE*>(TWO_BLOCK.data()) + 10, TWO_BLOCK.size() - 10);
+                hasher.finalize(digest.data());
+                BOOST_TEST(byteVectorToHexString(digest) == TWO_BLOCK_DIGEST);
+                hasher.finalizeDouble(digest.data());
+                BOOST_TEST(byteVectorToHexString(digest) == EMPTY_DOUBLE_DIGEST);
+                // Byte-at-a-time feeding has to cross every block and padding boundary
+                std::vector<BYTE> message(200);
+                for (size_t i = 0; i < message.size(); i++) {
+                    message[i] = static_cast<BYTE>(i * 7);
+                }
+                for (size_t size = 0; size <= message.size(); size++) {
+                    std::vector<BYTE> expected(SHA256_OUTPUT_SIZE_BYTES);
+                    sha256d(message.data(), size, expected.data());
+                    for (size_t i = 0; i < size; i++) {
+                        hasher.update(&message[i], 1);
+                    }
+                    hasher.finalizeDouble(digest.data());
+                    BOOST_TEST((digest == expected));
+                }
+            }
+        
+        BOOST_AUTO_TEST_SUITE_END()
+    }
+}
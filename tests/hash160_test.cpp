@@ -22,6 +22,7 @@
 #include "../src/hash160.h"
 #include "../src/conclave.h"
 #include <array>
+#include <unordered_set>
 
 namespace conclave
 {
@@ -83,11 +84,11 @@ namespace conclave
     const static char* ALL_ZEROS_CSTR_2 = "0000000000000000000000000000000000000000";
     const static char* ALL_ONES_CSTR_1 = "ffffffffffffffffffffffffffffffffffffffff";
     const static char* ALL_ONES_CSTR_2 = "ffffffffffffffffffffffffffffffffffffffff";
-    const static Hash160 RANDOM_HASH_1;
-    const static Hash160 RANDOM_HASH_2;
-    const static Hash160 ARBITRARY_HASH_1("97f6c464f25e32f444912fb4a9a53f3c62f2ef62");
-    const static Hash160 ARBITRARY_HASH_2("c6523779b9d753afcad2d77aa1a5771f39d0cdcf");
-    const static Hash160 ARBHASH1_XOR_ARBHASH2("51a4f31d4b89615b8e43f8ce080048235b2222ad");
+    const static Hash160 RANDOM_HASH_1 = Hash160::random();
+    const static Hash160 RANDOM_HASH_2 = Hash160::random();
+    constexpr static Hash160 ARBITRARY_HASH_1("97f6c464f25e32f444912fb4a9a53f3c62f2ef62");
+    constexpr static Hash160 ARBITRARY_HASH_2("c6523779b9d753afcad2d77aa1a5771f39d0cdcf");
+    constexpr static Hash160 ARBHASH1_XOR_ARBHASH2("51a4f31d4b89615b8e43f8ce080048235b2222ad");
     BOOST_AUTO_TEST_SUITE(Hash160TestSuite)
         
         BOOST_AUTO_TEST_CASE(Hash160DigestFactoryTest)
@@ -118,6 +119,23 @@ namespace conclave
             BOOST_TEST((threeLengthCStringDigest == THREE_LENGTH_STR_DIGEST));
         }
         
+        BOOST_AUTO_TEST_CASE(Hash160DigestManyFactoryTest)
+        {
+            std::vector<std::vector<BYTE>> messages;
+            for (size_t i = 0; i < 21; i++) {
+                messages.emplace_back(i * 11, static_cast<BYTE>(i));
+            }
+            messages.push_back(ZERO_LENGTH_BV);
+            messages.push_back(TWO_LENGTH_BV);
+            const std::vector<Hash160> digests = Hash160::digestMany(messages);
+            BOOST_TEST(digests.size() == messages.size());
+            for (size_t i = 0; i < messages.size(); i++) {
+                BOOST_TEST((digests[i] == Hash160::digest(messages[i])));
+            }
+            BOOST_TEST((digests[21] == ZERO_LENGTH_BV_DIGEST));
+            BOOST_TEST((digests[22] == TWO_LENGTH_BV_DIGEST));
+        }
+        
         BOOST_AUTO_TEST_CASE(Hash160DeserializeFactoryTest)
         {
             size_t pos = 0;
@@ -125,12 +143,17 @@ namespace conclave
             BOOST_TEST((pos == SMALL_HASH_SIZE_BYTES));
         }
         
-        BOOST_AUTO_TEST_CASE(Hash160DefaultConstructorTest)
+        BOOST_AUTO_TEST_CASE(Hash160RandomFactoryTest)
         {
-            // Default constructor should initialize with random data
             BOOST_TEST((RANDOM_HASH_1 != RANDOM_HASH_2));
         }
         
+        BOOST_AUTO_TEST_CASE(Hash160DefaultConstructorTest)
+        {
+            // Default constructor should initialize with zeros
+            BOOST_TEST((Hash160() == Hash160(ALL_ZEROS_CSTR_1)));
+        }
+        
         BOOST_AUTO_TEST_CASE(Hash160ByteArrayConstructorTest)
         {
             Hash160 zeros1(ALL_ZEROS_BA_1);
@@ -949,7 +972,7 @@ namespace conclave
         
         BOOST_AUTO_TEST_CASE(Hash160ReverseTest)
         {
-            Hash160 forward;
+            Hash160 forward = Hash160::random();
             Hash160 reverse = forward.reversed();
             BOOST_TEST((forward[0] == reverse[19]));
             BOOST_TEST((forward[1] == reverse[18]));
@@ -1080,9 +1103,28 @@ namespace conclave
             BOOST_TEST((ARBITRARY_HASH_1[19] == 0x62));
         }
         
+        BOOST_AUTO_TEST_CASE(Hash160LessThanOperatorTest)
+        {
+            // Orders by the bytes from first to last, like the underlying arrays
+            BOOST_TEST(!(ARBITRARY_HASH_1 < ARBITRARY_HASH_1));
+            BOOST_TEST(((ARBITRARY_HASH_1 < ARBITRARY_HASH_2) ==
+                        (static_cast<std::array<BYTE, 20>>(ARBITRARY_HASH_1) <
+                         static_cast<std::array<BYTE, 20>>(ARBITRARY_HASH_2))));
+            BOOST_TEST(((ARBITRARY_HASH_1 < ARBITRARY_HASH_2) != (ARBITRARY_HASH_2 < ARBITRARY_HASH_1)));
+            BOOST_TEST((Hash160(ALL_ZEROS_CSTR_1) < Hash160(ALL_ONES_CSTR_1)));
+        }
+        
+        BOOST_AUTO_TEST_CASE(Hash160StdHashTest)
+        {
+            std::unordered_set<Hash160> hashes{ARBITRARY_HASH_1, ARBITRARY_HASH_2, ARBITRARY_HASH_1};
+            BOOST_TEST(hashes.size() == 2);
+            BOOST_TEST(hashes.count(ARBITRARY_HASH_2) == 1);
+            BOOST_TEST(hashes.count(ARBHASH1_XOR_ARBHASH2) == 0);
+        }
+        
         BOOST_AUTO_TEST_CASE(Hash160AssignmentOperatorsTest)
         {
-            const Hash160 hash1;
+            const Hash160 hash1 = Hash160::random();
             Hash160 hash2, hash3;
             hash2 = hash1;
             hash3 = std::move(Hash160(hash1));
@@ -22,6 +22,7 @@
 #include "../src/hash256.h"
 #include "../src/conclave.h"
 #include <array>
+#include <unordered_set>
 
 namespace conclave
 {
@@ -102,11 +103,11 @@ namespace conclave
     const static char* ALL_ZEROS_CSTR_2 = "0000000000000000000000000000000000000000000000000000000000000000";
     const static char* ALL_ONES_CSTR_1 = "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff";
     const static char* ALL_ONES_CSTR_2 = "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff";
-    const static Hash256 RANDOM_HASH_1;
-    const static Hash256 RANDOM_HASH_2;
-    const static Hash256 ARBITRARY_HASH_1("5942bb725f27989943d672de52bd92843723546fa835af2eef0c8ce5921611f0");
-    const static Hash256 ARBITRARY_HASH_2("b861497ede04b280bd6a3d40f66095561174064c792d23b6629329d20127b385");
-    const static Hash256 ARBHASH1_XOR_ARBHASH2("e123f20c81232a19febc4f9ea4dd07d226575223d1188c988d9fa5379331a275");
+    const static Hash256 RANDOM_HASH_1 = Hash256::random();
+    const static Hash256 RANDOM_HASH_2 = Hash256::random();
+    constexpr static Hash256 ARBITRARY_HASH_1("5942bb725f27989943d672de52bd92843723546fa835af2eef0c8ce5921611f0");
+    constexpr static Hash256 ARBITRARY_HASH_2("b861497ede04b280bd6a3d40f66095561174064c792d23b6629329d20127b385");
+    constexpr static Hash256 ARBHASH1_XOR_ARBHASH2("e123f20c81232a19febc4f9ea4dd07d226575223d1188c988d9fa5379331a275");
     BOOST_AUTO_TEST_SUITE(Hash256TestSuite)
         
         BOOST_AUTO_TEST_CASE(Hash256DigestFactoryTest)
@@ -137,6 +138,52 @@ namespace conclave
             BOOST_TEST((threeLengthCStringDigest == THREE_LENGTH_STR_DIGEST));
         }
         
+        BOOST_AUTO_TEST_CASE(Hash256DigestManyFactoryTest)
+        {
+            // Enough messages of mixed length to fill several SIMD lane groups plus a remainder
+            std::vector<std::vector<BYTE>> messages;
+            for (size_t i = 0; i < 45; i++) {
+                messages.emplace_back(i * 7, static_cast<BYTE>(i));
+            }
+            messages.push_back(ZERO_LENGTH_BV);
+            messages.push_back(THREE_LENGTH_BV);
+            const std::vector<Hash256> digests = Hash256::digestMany(messages);
+            BOOST_TEST(digests.size() == messages.size());
+            for (size_t i = 0; i < messages.size(); i++) {
+                BOOST_TEST((digests[i] == Hash256::digest(messages[i])));
+            }
+            BOOST_TEST((digests[45] == ZERO_LENGTH_BV_DIGEST));
+            BOOST_TEST((digests[46] == THREE_LENGTH_BV_DIGEST));
+            BOOST_TEST(Hash256::digestMany({}).empty());
+        }
+        
+        BOOST_AUTO_TEST_CASE(Hash256WriterTest)
+        {
+            Hash256Writer writer;
+            BOOST_TEST((writer.getHash256() == ZERO_LENGTH_BV_DIGEST));
+            writer.write(THREE_LENGTH_BV.data(), THREE_LENGTH_BV.size());
+            BOOST_TEST((writer.getHash256() == THREE_LENGTH_BV_DIGEST));
+            // Split a few blocks' worth of bytes at every offset
+            std::vector<BYTE> message(150);
+            for (size_t i = 0; i < message.size(); i++) {
+                message[i] = static_cast<BYTE>(i * 13);
+            }
+            const Hash256 expected = Hash256::digest(message);
+            for (size_t split = 0; split <= message.size(); split++) {
+                writer.write(message.data(), split);
+                writer.write(message.data() + split, message.size() - split);
+                BOOST_TEST((writer.getHash256() == expected));
+            }
+        }
+        
+        BOOST_AUTO_TEST_CASE(Hash256SerializeToSinkTest)
+        {
+            std::vector<BYTE> serialized;
+            ByteVectorSink sink(serialized);
+            ARBITRARY_HASH_1.serialize(sink);
+            BOOST_TEST((serialized == ARBITRARY_HASH_1.serialize()));
+        }
+        
         BOOST_AUTO_TEST_CASE(Hash256DeserializeFactoryTest)
         {
             size_t pos = 0;
@@ -144,12 +191,17 @@ namespace conclave
             BOOST_TEST((pos == LARGE_HASH_SIZE_BYTES));
         }
         
-        BOOST_AUTO_TEST_CASE(Hash256DefaultConstructorTest)
+        BOOST_AUTO_TEST_CASE(Hash256RandomFactoryTest)
         {
-            // Default constructor should initialize with random data
             BOOST_TEST((RANDOM_HASH_1 != RANDOM_HASH_2));
         }
         
+        BOOST_AUTO_TEST_CASE(Hash256DefaultConstructorTest)
+        {
+            // Default constructor should initialize with zeros
+            BOOST_TEST((Hash256() == Hash256(ALL_ZEROS_CSTR_1)));
+        }
+        
         BOOST_AUTO_TEST_CASE(Hash256ByteArrayConstructorTest)
         {
             Hash256 zeros1(ALL_ZEROS_BA_1);
@@ -968,7 +1020,7 @@ namespace conclave
         
         BOOST_AUTO_TEST_CASE(Hash256ReverseTest)
         {
-            Hash256 forward;
+            Hash256 forward = Hash256::random();
             Hash256 reverse = forward.reversed();
             BOOST_TEST((forward[0] == reverse[31]));
             BOOST_TEST((forward[1] == reverse[30]));
@@ -1123,9 +1175,36 @@ namespace conclave
             BOOST_TEST((ARBITRARY_HASH_1[31] == 0xf0));
         }
         
+        BOOST_AUTO_TEST_CASE(Hash256LessThanOperatorTest)
+        {
+            // Orders by the bytes from first to last, like the underlying arrays
+            BOOST_TEST(!(ARBITRARY_HASH_1 < ARBITRARY_HASH_1));
+            BOOST_TEST(((ARBITRARY_HASH_1 < ARBITRARY_HASH_2) ==
+                        (static_cast<std::array<BYTE, 32>>(ARBITRARY_HASH_1) <
+                         static_cast<std::array<BYTE, 32>>(ARBITRARY_HASH_2))));
+            BOOST_TEST(((ARBITRARY_HASH_1 < ARBITRARY_HASH_2) != (ARBITRARY_HASH_2 < ARBITRARY_HASH_1)));
+            BOOST_TEST((Hash256(ALL_ZEROS_CSTR_1) < Hash256(ALL_ONES_CSTR_1)));
+        }
+        
+        BOOST_AUTO_TEST_CASE(Hash256StdHashTest)
+        {
+            std::unordered_set<Hash256> hashes{ARBITRARY_HASH_1, ARBITRARY_HASH_2, ARBITRARY_HASH_1};
+            BOOST_TEST(hashes.size() == 2);
+            BOOST_TEST(hashes.count(ARBITRARY_HASH_2) == 1);
+            BOOST_TEST(hashes.count(ARBHASH1_XOR_ARBHASH2) == 0);
+        }
+        
+        BOOST_AUTO_TEST_CASE(Hash256StdHashBlockHashTest)
+        {
+            // Block hashes share their leading zeros, which must not all land in the same bucket
+            const Hash256 blockHash1("00000000000000000002a7c4c1e48d76c5a37902165a270156b7a8d72728a054");
+            const Hash256 blockHash2("0000000000000000000590fc0f3eba193a278534220b2b37e9849e1a770ca959");
+            BOOST_TEST(std::hash<Hash256>()(blockHash1) != std::hash<Hash256>()(blockHash2));
+        }
+        
         BOOST_AUTO_TEST_CASE(Hash256AssignmentOperatorsTest)
         {
-            const Hash256 hash1;
+            const Hash256 hash1 = Hash256::random();
             Hash256 hash2, hash3;
             hash2 = hash1;
             hash3 = std::move(Hash256(hash1));
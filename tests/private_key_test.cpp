@@ -55,6 +55,14 @@ namespace conclave
             EcdsaSignature k1m1Sig = privateKey1.sign(MESSAGE_1);
             BOOST_TEST((k1m1Sig == K1_M1_SIG));
         }
+        
+        BOOST_AUTO_TEST_CASE(PublicKeyEcdsaVerifyTest)
+        {
+            PrivateKey privateKey1(KEY_DATA_1);
+            EcdsaSignature k1m1Sig = privateKey1.sign(MESSAGE_1);
+            BOOST_TEST(privateKey1.getPublicKey().verify(MESSAGE_1, k1m1Sig));
+            BOOST_TEST(!privateKey1.getPublicKey().verify(KEY_DATA_1, k1m1Sig));
+        }
     
     BOOST_AUTO_TEST_SUITE_END()
 }
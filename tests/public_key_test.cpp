@@ -73,6 +73,16 @@ namespace conclave
             BOOST_TEST((publicKeyFromXY == publicKeyFromXMoveYMove));
         }
         
+        BOOST_AUTO_TEST_CASE(PublicKeyCompressedHexConstructorsTest)
+        {
+            const PublicKey expected(X_1, !EVEN_1);
+            BOOST_TEST((PublicKey(HEX_LITERAL("0286f77ac51a93e9d65df4ab0d3a7f9dac2a0a282143e21352a94c2793898534a5")) ==
+                        expected));
+            BOOST_TEST((PublicKey("0286f77ac51a93e9d65df4ab0d3a7f9dac2a0a282143e21352a94c2793898534a5") == expected));
+            BOOST_CHECK_THROW(PublicKey("0586f77ac51a93e9d65df4ab0d3a7f9dac2a0a282143e21352a94c2793898534a5"),
+                              std::runtime_error);
+        }
+        
         BOOST_AUTO_TEST_CASE(PublicKeySerializeTest)
         {
             PublicKey publicKeyFromXY1(X_1, Y_1);
@@ -89,6 +99,21 @@ namespace conclave
             BOOST_TEST((publicKeyFromXY2.yIsEven() == EVEN_2));
         }
         
+        BOOST_AUTO_TEST_CASE(PublicKeyLazyDecompressionTest)
+        {
+            const PublicKey publicKeyFromX1(X_1, true);
+            const PublicKey publicKeyFromX2(X_2, false);
+            BOOST_TEST((publicKeyFromX1 == PublicKey(X_1, Y_1)));
+            BOOST_TEST((publicKeyFromX2 == PublicKey(X_2, Y_2)));
+            BOOST_TEST((publicKeyFromX1 != PublicKey(X_1, false)));
+            const PublicKey copyBeforeDecompression(publicKeyFromX1);
+            using UncompressedArray = std::array<BYTE, SECP256K1_PUBKEY_UNCOMPRESSED_SIZE_BYTES>;
+            BOOST_TEST((static_cast<UncompressedArray>(publicKeyFromX1) == UNCOMPRESSED_BA_1));
+            BOOST_TEST((static_cast<UncompressedArray>(copyBeforeDecompression) == UNCOMPRESSED_BA_1));
+            BOOST_TEST((static_cast<UncompressedArray>(publicKeyFromX2) == UNCOMPRESSED_BA_2));
+            BOOST_TEST((PublicKey::deserialize(UNCOMPRESSED_PUBKEY_SERIALIZED_1) == publicKeyFromX1));
+        }
+        
         BOOST_AUTO_TEST_CASE(PublicKeyAssignmentOperatorsTest)
         {
             const PublicKey publicKey1(X_1, Y_1);
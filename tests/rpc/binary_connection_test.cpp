@@ -0,0 +1,208 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Binary_Connection_Test
+
+#include <boost/test/included/unit_test.hpp>
+#include "../../src/rpc/binary_connection.h"
+#include "../../src/rpc/rpc_binary.h"
+#include "../../src/rpc/methods/error_response.h"
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace conclave
+{
+    namespace rpc
+    {
+        using namespace methods;
+        
+        // Counts how many responses have been deleted, to check that a closed connection still drops them
+        static int deletedResponses = 0;
+        
+        class CountedResponse final : public ErrorResponse
+        {
+            public:
+            explicit CountedResponse(const std::string& frame)
+                : ErrorResponse(frame)
+            {
+                binary = true;
+                setWrapped(frame);
+            }
+            
+            ~CountedResponse() override
+            {
+                deletedResponses++;
+            }
+        };
+        
+        class TestRequest final : public Request
+        {
+            public:
+            std::string_view getMethodName() const override
+            {
+                return "GetUtxos";
+            }
+            
+            Response* handle(ConclaveNode&) const override
+            {
+                return nullptr;
+            }
+        };
+        
+        /***
+         * A mongoose connection over one end of a socket pair, so that what it sends can be read off the other. It
+         * closes its BinaryConnection the way the acceptor does.
+         */
+        struct SocketPairFixture
+        {
+            SocketPairFixture()
+                : SocketPairFixture(RpcAcceptorConfig("127.0.0.1", 0))
+            {
+            }
+            
+            explicit SocketPairFixture(const RpcAcceptorConfig& rpcAcceptorConfig)
+            {
+                BOOST_REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+                mg_mgr_init(&mgr, nullptr);
+                conn = mg_add_sock(&mgr, fds[0], [](struct mg_connection* conn, int ev, void*) {
+                    if (ev == MG_EV_CLOSE) {
+                        ((BinaryConnection*) conn->user_data)->close();
+                    }
+                });
+                connection = new BinaryConnection(conn, rpcAcceptorConfig, requestQueue);
+                conn->user_data = connection;
+                deletedResponses = 0;
+            }
+            
+            ~SocketPairFixture()
+            {
+                mg_mgr_free(&mgr);
+                if (fds[1] != -1) {
+                    ::close(fds[1]);
+                }
+            }
+            
+            const std::string readSent()
+            {
+                // Connections only write when the manager is polled
+                mg_mgr_poll(&mgr, 0);
+                std::string sent;
+                char buffer[4096];
+                ssize_t n;
+                while ((n = recv(fds[1], buffer, sizeof(buffer), MSG_DONTWAIT)) > 0) {
+                    sent.append(buffer, n);
+                }
+                return sent;
+            }
+            
+            // Queues a request as the acceptor would and takes it straight back off, as a processor would
+            std::unique_ptr<Request> startRequest()
+            {
+                BOOST_REQUIRE(connection->startRequest());
+                connection->queue(std::make_unique<TestRequest>());
+                std::optional<Request*> request = requestQueue.popFromStart();
+                BOOST_REQUIRE(request.has_value());
+                return std::unique_ptr<Request>(*request);
+            }
+            
+            int fds[2];
+            struct mg_mgr mgr;
+            struct mg_connection* conn;
+            BinaryConnection* connection;
+            ConcurrentList<Request*> requestQueue;
+        };
+        
+        struct IdleFixture : public SocketPairFixture
+        {
+            IdleFixture()
+                : SocketPairFixture(RpcAcceptorConfig("127.0.0.1", 0, std::nullopt, std::chrono::milliseconds(0), 1000))
+            {
+            }
+        };
+        
+        struct RequestCapFixture : public SocketPairFixture
+        {
+            RequestCapFixture()
+                : SocketPairFixture(
+                    RpcAcceptorConfig("127.0.0.1", 0, std::nullopt, std::chrono::milliseconds(30000), 2))
+            {
+            }
+        };
+        
+        BOOST_FIXTURE_TEST_SUITE(BinaryConnectionTestSuite, SocketPairFixture)
+            
+            BOOST_AUTO_TEST_CASE(RespondTest)
+            {
+                const std::unique_ptr<Request> request = startRequest();
+                BOOST_TEST((request->tag == connection));
+                connection->respond(new CountedResponse("frame"));
+                BOOST_TEST(readSent() == "frame");
+                BOOST_TEST(deletedResponses == 1);
+            }
+            
+            BOOST_AUTO_TEST_CASE(RejectTest)
+            {
+                const Hash256 requestHash = Hash256::digest(std::vector<BYTE>{1, 2, 3});
+                connection->reject(requestHash, "bad");
+                BOOST_TEST((readSent() == std::string_view(makeBinaryErrorFrame(requestHash, "bad"))));
+            }
+            
+            BOOST_AUTO_TEST_CASE(CloseInFlightTest)
+            {
+                const std::unique_ptr<Request> first = startRequest();
+                const std::unique_ptr<Request> second = startRequest();
+                // The client hangs up before either is answered, and mongoose frees its connection
+                ::close(fds[1]);
+                fds[1] = -1;
+                for (int i = 0; i < 10 && mg_next(&mgr, nullptr) != nullptr; i++) {
+                    mg_mgr_poll(&mgr, 10);
+                }
+                BOOST_REQUIRE((mg_next(&mgr, nullptr) == nullptr));
+                // Neither response touches the freed connection, and the last one deletes the BinaryConnection
+                connection->respond(new CountedResponse("first"));
+                connection->respond(new CountedResponse("second"));
+                BOOST_TEST(deletedResponses == 2);
+            }
+            
+            BOOST_FIXTURE_TEST_CASE(IdleTest, IdleFixture)
+            {
+                const auto now = []() { return std::chrono::steady_clock::now(); };
+                BOOST_TEST(connection->isIdle(now()));
+                const std::unique_ptr<Request> request = startRequest();
+                // Never idle while a response is owed
+                BOOST_TEST(!connection->isIdle(now()));
+                connection->respond(new CountedResponse("done"));
+                BOOST_TEST(connection->isIdle(now()));
+            }
+            
+            BOOST_FIXTURE_TEST_CASE(RequestCapTest, RequestCapFixture)
+            {
+                const std::unique_ptr<Request> first = startRequest();
+                const std::unique_ptr<Request> second = startRequest();
+                // Anything sent after the last request is dropped
+                BOOST_TEST(!connection->startRequest());
+                connection->respond(new CountedResponse("first"));
+                BOOST_TEST(!(conn->flags & MG_F_SEND_AND_CLOSE));
+                connection->respond(new CountedResponse("second"));
+                BOOST_TEST((conn->flags & MG_F_SEND_AND_CLOSE));
+                BOOST_TEST(readSent() == "firstsecond");
+            }
+        
+        BOOST_AUTO_TEST_SUITE_END()
+    }
+}
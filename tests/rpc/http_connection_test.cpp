@@ -0,0 +1,186 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Http_Connection_Test
+
+#include <boost/test/included/unit_test.hpp>
+#include "../../src/rpc/http_connection.h"
+#include "../../src/rpc/methods/error_response.h"
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace conclave
+{
+    namespace rpc
+    {
+        using namespace methods;
+        
+        /***
+         * A mongoose connection over one end of a socket pair, so that what it sends can be read off the other
+         */
+        struct SocketPairFixture
+        {
+            SocketPairFixture()
+            {
+                BOOST_REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+                mg_mgr_init(&mgr, nullptr);
+                conn = mg_add_sock(&mgr, fds[0], [](struct mg_connection*, int, void*) {});
+            }
+            
+            ~SocketPairFixture()
+            {
+                mg_mgr_free(&mgr);
+                ::close(fds[1]);
+            }
+            
+            const std::string readSent()
+            {
+                // Connections only write when the manager is polled
+                mg_mgr_poll(&mgr, 0);
+                std::string sent;
+                char buffer[4096];
+                ssize_t n;
+                while ((n = recv(fds[1], buffer, sizeof(buffer), MSG_DONTWAIT)) > 0) {
+                    sent.append(buffer, n);
+                }
+                return sent;
+            }
+            
+            int fds[2];
+            struct mg_mgr mgr;
+            struct mg_connection* conn;
+            ConcurrentList<Request*> requestQueue;
+        };
+        
+        Response* makeResponse(const std::string& wrapped)
+        {
+            Response* response = new ErrorResponse(wrapped);
+            response->setWrapped(wrapped);
+            return response;
+        }
+        
+        size_t countOf(const std::string& haystack, const std::string& needle)
+        {
+            size_t count = 0;
+            for (size_t pos = haystack.find(needle); pos != std::string::npos; pos = haystack.find(needle, pos + 1)) {
+                count++;
+            }
+            return count;
+        }
+        
+        BOOST_FIXTURE_TEST_SUITE(HttpConnectionTestSuite, SocketPairFixture)
+            
+            BOOST_AUTO_TEST_CASE(ResponsesInOrderTest)
+            {
+                const RpcAcceptorConfig config("127.0.0.1", 0);
+                HttpConnection* connection = new HttpConnection(conn, config, requestQueue);
+                const uint64_t first = *connection->startRequest(true);
+                const uint64_t second = *connection->startRequest(true);
+                const uint64_t third = *connection->startRequest(true);
+                // Finished back to front, so nothing can go until the first is done
+                connection->respond(third, makeResponse("third"));
+                connection->respond(second, makeResponse("second"));
+                BOOST_TEST(readSent().empty());
+                connection->respond(first, makeResponse("first"));
+                const std::string sent = readSent();
+                const size_t firstPos = sent.find("first");
+                const size_t secondPos = sent.find("second");
+                const size_t thirdPos = sent.find("third");
+                BOOST_TEST(firstPos != std::string::npos);
+                BOOST_TEST(firstPos < secondPos);
+                BOOST_TEST(secondPos < thirdPos);
+                BOOST_TEST(thirdPos != std::string::npos);
+                BOOST_TEST(countOf(sent, "Connection: keep-alive") == 3);
+                BOOST_TEST(countOf(sent, "Connection: close") == 0);
+                connection->close();
+            }
+            
+            BOOST_AUTO_TEST_CASE(RejectInOrderTest)
+            {
+                const RpcAcceptorConfig config("127.0.0.1", 0);
+                HttpConnection* connection = new HttpConnection(conn, config, requestQueue);
+                const uint64_t first = *connection->startRequest(true);
+                const uint64_t second = *connection->startRequest(true);
+                connection->reject(second, "bad request");
+                BOOST_TEST(readSent().empty());
+                connection->respond(first, makeResponse("first"));
+                const std::string sent = readSent();
+                BOOST_TEST(sent.find("200 OK") < sent.find("500"));
+                BOOST_TEST(sent.find("first") < sent.find("bad request"));
+                connection->close();
+            }
+            
+            BOOST_AUTO_TEST_CASE(RequestCapTest)
+            {
+                const RpcAcceptorConfig config("127.0.0.1", 0, std::nullopt, std::chrono::milliseconds(30000), 2);
+                HttpConnection* connection = new HttpConnection(conn, config, requestQueue);
+                const std::optional<uint64_t> first = connection->startRequest(true);
+                const std::optional<uint64_t> second = connection->startRequest(true);
+                BOOST_REQUIRE(first.has_value());
+                BOOST_REQUIRE(second.has_value());
+                // Anything pipelined after the last request is dropped
+                BOOST_TEST(!connection->startRequest(true).has_value());
+                connection->respond(*first, makeResponse("first"));
+                BOOST_TEST(countOf(readSent(), "Connection: keep-alive") == 1);
+                connection->respond(*second, makeResponse("second"));
+                BOOST_TEST(countOf(readSent(), "Connection: close") == 1);
+                connection->close();
+            }
+            
+            BOOST_AUTO_TEST_CASE(NoKeepAliveTest)
+            {
+                const RpcAcceptorConfig config("127.0.0.1", 0);
+                HttpConnection* connection = new HttpConnection(conn, config, requestQueue);
+                const std::optional<uint64_t> only = connection->startRequest(false);
+                BOOST_REQUIRE(only.has_value());
+                BOOST_TEST(!connection->startRequest(true).has_value());
+                connection->respond(*only, makeResponse("only"));
+                BOOST_TEST(countOf(readSent(), "Connection: close") == 1);
+                connection->close();
+            }
+            
+            BOOST_AUTO_TEST_CASE(IdleTest)
+            {
+                const RpcAcceptorConfig config("127.0.0.1", 0, std::nullopt, std::chrono::milliseconds(0), 1000);
+                HttpConnection* connection = new HttpConnection(conn, config, requestQueue);
+                const auto now = []() { return std::chrono::steady_clock::now(); };
+                BOOST_TEST(connection->isIdle(now()));
+                const uint64_t sequence = *connection->startRequest(true);
+                // Never idle while a response is owed
+                BOOST_TEST(!connection->isIdle(now()));
+                connection->respond(sequence, makeResponse("done"));
+                BOOST_TEST(connection->isIdle(now()));
+                connection->close();
+            }
+            
+            BOOST_AUTO_TEST_CASE(CloseInFlightTest)
+            {
+                const RpcAcceptorConfig config("127.0.0.1", 0);
+                HttpConnection* connection = new HttpConnection(conn, config, requestQueue);
+                const uint64_t sequence = *connection->startRequest(true);
+                BOOST_REQUIRE(connection->startRequest(true).has_value());
+                // Closed with responses owed: they are thrown away, and the last one deletes the connection
+                connection->close();
+                connection->respond(sequence, makeResponse("late"));
+                connection->respond(sequence + 1, makeResponse("later"));
+                BOOST_TEST(readSent().empty());
+            }
+        
+        BOOST_AUTO_TEST_SUITE_END()
+    }
+}
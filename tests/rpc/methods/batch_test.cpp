@@ -0,0 +1,86 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Batch_Test
+
+#include <boost/test/included/unit_test.hpp>
+#include "../../../src/rpc/methods/batch.h"
+#include "../../../src/rpc/methods/error_response.h"
+
+namespace conclave
+{
+    namespace rpc
+    {
+        using namespace methods;
+        
+        const static Hash256 REQUEST_HASH("c48dc09b1e0495d33f6af7493fa10d050d5ffd5fc9a4f6bdaee0d1f1680f0feb");
+        
+        BOOST_AUTO_TEST_SUITE(BatchTestSuite)
+            
+            BOOST_AUTO_TEST_CASE(BatchCompleteTest)
+            {
+                int connection;
+                Batch batch(3, &connection, 7, REQUEST_HASH, std::make_unique<Arena>());
+                // Calls can finish in any order
+                BOOST_TEST(batch.complete(2, new ErrorResponse("third")) == nullptr);
+                BOOST_TEST(batch.complete(0, new ErrorResponse("first")) == nullptr);
+                const std::unique_ptr<Response> response(batch.complete(1, new ErrorResponse("second")));
+                BOOST_REQUIRE((response != nullptr));
+                BOOST_TEST((response->tag == &connection));
+                BOOST_TEST(response->sequence == 7);
+                BOOST_TEST(response->requestHash == REQUEST_HASH);
+                BOOST_TEST((response->arena != nullptr));
+                BOOST_TEST(response->methodName == "Batch");
+            }
+            
+            BOOST_AUTO_TEST_CASE(BatchResponseSerializeTest)
+            {
+                Batch batch(2, nullptr, 0, REQUEST_HASH, std::make_unique<Arena>());
+                BOOST_TEST(batch.complete(1, new ErrorResponse("second")) == nullptr);
+                const std::unique_ptr<Response> response(batch.complete(0, new ErrorResponse("first")));
+                BOOST_REQUIRE((response != nullptr));
+                const std::string json(response->getSerializedJson());
+                BOOST_TEST(json == R"([{"message":"first"},{"message":"second"}])");
+            }
+            
+            BOOST_AUTO_TEST_CASE(BatchSingleCallTest)
+            {
+                Batch batch(1, nullptr, 0, REQUEST_HASH, std::make_unique<Arena>());
+                const std::unique_ptr<Response> response(batch.complete(0, new ErrorResponse("only")));
+                BOOST_REQUIRE((response != nullptr));
+                const std::string json(response->getSerializedJson());
+                BOOST_TEST(json == R"([{"message":"only"}])");
+            }
+            
+            BOOST_AUTO_TEST_CASE(FailedCallTest)
+            {
+                // A malformed call keeps its place in the batch, and is answered with an error there
+                Batch batch(2, nullptr, 0, REQUEST_HASH, std::make_unique<Arena>());
+                const FailedCall call("Unknown RPC method: Foo");
+                BOOST_TEST(call.getMethodName() == "Invalid");
+                BOOST_TEST(batch.complete(1, new ErrorResponse("second")) == nullptr);
+                const std::unique_ptr<Response> response(
+                    batch.complete(0, new ErrorResponse("Unknown RPC method: Foo")));
+                BOOST_REQUIRE((response != nullptr));
+                const std::string json(response->getSerializedJson());
+                BOOST_TEST(json == R"([{"message":"Unknown RPC method: Foo"},{"message":"second"}])");
+            }
+        
+        BOOST_AUTO_TEST_SUITE_END()
+    }
+}
@@ -0,0 +1,128 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Methods_Test
+
+#include <boost/test/included/unit_test.hpp>
+#include "../../../src/rpc/methods/registry.h"
+
+namespace conclave
+{
+    namespace rpc
+    {
+        class JsonOnlyRequest;
+        class BinaryRequest;
+        
+        Response* testHandler(const JsonOnlyRequest&, ConclaveNode&)
+        {
+            return nullptr;
+        }
+        
+        Response* testBinaryHandler(const BinaryRequest&, ConclaveNode&)
+        {
+            return nullptr;
+        }
+        
+        class JsonOnlyRequest : public MethodRequest<JsonOnlyRequest, Response, testHandler>
+        {
+            public:
+            constexpr static std::string_view name = "JsonOnly";
+            
+            JsonOnlyRequest(const JsonValue&)
+            {
+            }
+        };
+        
+        class BinaryRequest : public MethodRequest<BinaryRequest, Response, testBinaryHandler>
+        {
+            public:
+            constexpr static std::string_view name = "Binary";
+            
+            BinaryRequest(const JsonValue&)
+                : value(0)
+            {
+            }
+            
+            BinaryRequest(ByteReader& reader)
+                : value(reader.readIntegral<uint8_t>())
+            {
+            }
+            
+            const uint8_t value;
+        };
+        
+        using TestMethods = MethodRegistry<JsonOnlyRequest, BinaryRequest>;
+        
+        BOOST_AUTO_TEST_SUITE(MethodsTestSuite)
+            
+            BOOST_AUTO_TEST_CASE(FindMethodTest)
+            {
+                // A method's position in the registry is its byte on the binary transport
+                BOOST_TEST((TestMethods::findMethod("JsonOnly") == std::optional<size_t>(0)));
+                BOOST_TEST((TestMethods::findMethod("Binary") == std::optional<size_t>(1)));
+                BOOST_TEST(TestMethods::NAMES[1] == "Binary");
+            }
+            
+            BOOST_AUTO_TEST_CASE(FindMethodUnknownTest)
+            {
+                BOOST_TEST(!TestMethods::findMethod("").has_value());
+                BOOST_TEST(!TestMethods::findMethod("jsononly").has_value());
+                BOOST_TEST(!TestMethods::findMethod("BinaryX").has_value());
+                BOOST_TEST(!TestMethods::findMethod("Binar").has_value());
+            }
+            
+            BOOST_AUTO_TEST_CASE(MakeRequestTest)
+            {
+                const std::unique_ptr<Request> request(TestMethods::makeRequest("JsonOnly", JsonValue()));
+                BOOST_TEST((dynamic_cast<JsonOnlyRequest*>(request.get()) != nullptr));
+                BOOST_TEST(request->getMethodName() == "JsonOnly");
+                BOOST_CHECK_THROW(TestMethods::makeRequest("Unknown", JsonValue()), std::runtime_error);
+            }
+            
+            BOOST_AUTO_TEST_CASE(MakeBinaryRequestTest)
+            {
+                const BYTE params[] = {42};
+                ByteReader reader(params, sizeof(params));
+                const std::unique_ptr<Request> request(TestMethods::makeRequest(1, reader));
+                const BinaryRequest* binaryRequest = dynamic_cast<BinaryRequest*>(request.get());
+                BOOST_REQUIRE((binaryRequest != nullptr));
+                BOOST_TEST(binaryRequest->value == 42);
+                // Not every method is served over the binary transport
+                ByteReader jsonOnlyReader(params, sizeof(params));
+                BOOST_CHECK_THROW(TestMethods::makeRequest(0, jsonOnlyReader), std::runtime_error);
+                ByteReader unknownReader(params, sizeof(params));
+                BOOST_CHECK_THROW(TestMethods::makeRequest(2, unknownReader), std::runtime_error);
+            }
+            
+            BOOST_AUTO_TEST_CASE(RpcMethodSlotsTest)
+            {
+                // Every name has a slot of its own
+                constexpr std::array<std::string_view, 6> names{
+                    "NodeInfo", "GetAddressBalance", "GetUtxos", "MakeEntryTx", "SubmitBitcoinTx", "SubmitConclaveTx"
+                };
+                constexpr uint32_t seed = findPerfectRpcMethodSeed(names);
+                size_t nUsed = 0;
+                for (const int16_t index : makeRpcMethodSlots(names, seed)) {
+                    nUsed += index >= 0;
+                }
+                BOOST_TEST(nUsed == names.size());
+            }
+        
+        BOOST_AUTO_TEST_SUITE_END()
+    }
+}
@@ -0,0 +1,86 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Rpc_Binary_Test
+
+#include <boost/test/included/unit_test.hpp>
+#include "../../src/rpc/rpc_binary.h"
+#include "../../src/rpc/methods/error_response.h"
+#include "../../src/rpc/methods/node_info/node_info_response.h"
+
+namespace conclave
+{
+    namespace rpc
+    {
+        using namespace methods;
+        using namespace methods::node_info;
+        
+        // The hash in serialized byte order, as it appears in frames
+        std::string serialized(const Hash256& hash)
+        {
+            std::pmr::string bytes;
+            ByteStringSink sink(bytes);
+            hash.serialize(sink);
+            return std::string(bytes);
+        }
+        
+        BOOST_AUTO_TEST_SUITE(RpcBinaryTestSuite)
+            
+            BOOST_AUTO_TEST_CASE(MakeBinaryFrameTest)
+            {
+                const Hash256 requestHash = Hash256::digest(std::vector<BYTE>{1, 2, 3});
+                const std::string hashBytes = serialized(requestHash);
+                const std::pmr::string frame = makeBinaryFrame(requestHash, std::string("\x00\x2a", 2), "sig");
+                // Length, then the request hash, then the body and the wrapper each behind their own length
+                BOOST_TEST((std::string_view(frame) ==
+                            std::string("\x27\x00\x00\x00", 4) + hashBytes +
+                            std::string("\x02\x00\x2a" "\x03" "sig", 7)));
+                const std::pmr::string unsignedFrame = makeBinaryFrame(requestHash, std::string_view("\x00", 1),
+                                                                       std::string_view());
+                BOOST_TEST((std::string_view(unsignedFrame) ==
+                            std::string("\x23\x00\x00\x00", 4) + hashBytes + std::string("\x01\x00" "\x00", 3)));
+            }
+            
+            BOOST_AUTO_TEST_CASE(MakeBinaryErrorFrameTest)
+            {
+                const Hash256 requestHash = Hash256::digest(std::vector<BYTE>{1, 2, 3});
+                const std::string hashBytes = serialized(requestHash);
+                // Unsigned, but still carrying the hash of the request it answers
+                const std::pmr::string frame = makeBinaryErrorFrame(requestHash, "bad");
+                BOOST_TEST((std::string_view(frame) ==
+                            std::string("\x26\x00\x00\x00", 4) + hashBytes + std::string("\x04\x01" "bad" "\x00", 6)));
+            }
+            
+            BOOST_AUTO_TEST_CASE(ErrorResponseBinaryTest)
+            {
+                ErrorResponse response("no such address");
+                BOOST_TEST(response.isError());
+                const std::pmr::string& body = response.getSerializedBinary();
+                BOOST_TEST((std::string_view(body) == std::string_view("\x01\x0f" "no such address", 17)));
+            }
+            
+            BOOST_AUTO_TEST_CASE(NoBinaryFormTest)
+            {
+                NodeInfoResponse response("Test Node", "key");
+                BOOST_TEST(!response.isError());
+                BOOST_CHECK_THROW(response.getSerializedBinary(), std::runtime_error);
+            }
+        
+        BOOST_AUTO_TEST_SUITE_END()
+    }
+}
@@ -0,0 +1,77 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Rpc_Signer_Test
+
+#include <boost/test/included/unit_test.hpp>
+#include "../../src/rpc/rpc_signer.h"
+#include "../../src/rpc/methods/node_info/node_info_response.h"
+#include "../../src/util/json.h"
+
+namespace conclave
+{
+    namespace rpc
+    {
+        using namespace methods::node_info;
+        
+        const static PrivateKey PRIVATE_KEY(Hash256("017b8511ce04f889d3ef08df1c4497794a2fce1c92a84562bbe5c6d572bfc67c"));
+        const static PublicKey PUBLIC_KEY("03f50ca6f27d1c1f461160ae4cc3588141dc048b262101b5faa8a22e9de4c99c08");
+        const static Hash256 REQUEST_HASH("c48dc09b1e0495d33f6af7493fa10d050d5ffd5fc9a4f6bdaee0d1f1680f0feb");
+        // Bitcoin genesis block
+        const static chain::BitcoinBlockHeader GENESIS_HEADER(
+            1, Hash256("0000000000000000000000000000000000000000000000000000000000000000"),
+            Hash256("4a5e1e4baab89f3a32518a88c31bc87f618f76673e2cc77ab2127b7afdeda33b"),
+            1231006505, 0x1d00ffff, 2083236893);
+        const static LatestBlock LATEST_BLOCK(GENESIS_HEADER, 0);
+        
+        BOOST_AUTO_TEST_SUITE(RpcSignerTestSuite)
+            
+            BOOST_AUTO_TEST_CASE(LatestBlockTest)
+            {
+                BOOST_TEST(static_cast<std::string>(LATEST_BLOCK.hash) ==
+                           "000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f");
+                const pt::ptree tree = static_cast<pt::ptree>(LATEST_BLOCK);
+                BOOST_TEST(tree.get<std::string>("time") == "1231006505");
+                BOOST_TEST(tree.get<uint64_t>("height") == 0);
+            }
+            
+            BOOST_AUTO_TEST_CASE(RpcSignerWrapTest)
+            {
+                NodeInfoResponse response("Test Node", static_cast<std::string>(PUBLIC_KEY));
+                response.requestHash = REQUEST_HASH;
+                const pt::ptree wrapped = stringToPtree(RpcSigner::wrap(response, PRIVATE_KEY, PUBLIC_KEY,
+                                                                        LATEST_BLOCK));
+                const std::string json = wrapped.get<std::string>("response");
+                BOOST_TEST((std::string_view(json) == response.getSerializedJson()));
+                BOOST_TEST(stringToPtree(json).get<std::string>("DisplayName") == "Test Node");
+                BOOST_TEST(PublicKey(wrapped.get<std::string>("responder")) == PUBLIC_KEY);
+                BOOST_TEST(Hash256(wrapped.get<std::string>("requestHash")) == REQUEST_HASH);
+                BOOST_TEST(wrapped.get<uint64_t>("latestBlock.height") == 0);
+                
+                // The signature must cover the embedded response and every other wrapper field
+                const EcdsaSignature signature(wrapped.get<std::string>("signature"));
+                const Hash256 sigHash = RpcSigner::getWrapperSigHash(json, PUBLIC_KEY, REQUEST_HASH, LATEST_BLOCK);
+                BOOST_TEST(PUBLIC_KEY.verify(sigHash, signature));
+                const Hash256 otherSigHash = RpcSigner::getWrapperSigHash(json, PUBLIC_KEY, Hash256::digest("x"),
+                                                                          LATEST_BLOCK);
+                BOOST_TEST(!PUBLIC_KEY.verify(otherSigHash, signature));
+            }
+        
+        BOOST_AUTO_TEST_SUITE_END()
+    }
+}
@@ -220,6 +220,103 @@ namespace conclave
             BOOST_TEST((Script(P2WSH_SCRIPT_BYTES).getP2wshHash() == Hash256(SCRIPT_HASH_BYTES)));
         }
         
+        BOOST_AUTO_TEST_CASE(ScriptIsP2pkhTest)
+        {
+            BOOST_TEST((Script(P2PKH_SCRIPT_BYTES).isP2pkh()));
+            BOOST_TEST((!Script(P2SH_SCRIPT_BYTES).isP2pkh()));
+            BOOST_TEST((!Script(P2WPKH_SCRIPT_BYTES).isP2pkh()));
+        }
+        
+        BOOST_AUTO_TEST_CASE(ScriptGetP2pkhHashTest)
+        {
+            BOOST_TEST((Script(P2SH_SCRIPT_BYTES).getP2pkhHash() == std::nullopt));
+            BOOST_TEST((Script(P2PKH_SCRIPT_BYTES).getP2pkhHash() == Hash160(ADDRESS_HASH_BYTES)));
+        }
+        
+        BOOST_AUTO_TEST_CASE(ScriptIsP2wpkhTest)
+        {
+            BOOST_TEST((Script(P2WPKH_SCRIPT_BYTES).isP2wpkh()));
+            BOOST_TEST((!Script(P2WSH_SCRIPT_BYTES).isP2wpkh()));
+            BOOST_TEST((!Script(P2PKH_SCRIPT_BYTES).isP2wpkh()));
+        }
+        
+        BOOST_AUTO_TEST_CASE(ScriptGetP2wpkhHashTest)
+        {
+            BOOST_TEST((Script(P2WSH_SCRIPT_BYTES).getP2wpkhHash() == std::nullopt));
+            BOOST_TEST((Script(P2WPKH_SCRIPT_BYTES).getP2wpkhHash() == Hash160(ADDRESS_HASH_BYTES)));
+        }
+        
+        BOOST_AUTO_TEST_CASE(ScriptIsP2shTest)
+        {
+            BOOST_TEST((Script(P2SH_SCRIPT_BYTES).isP2sh()));
+            BOOST_TEST((!Script(P2PKH_SCRIPT_BYTES).isP2sh()));
+            BOOST_TEST((Script(P2SH_SCRIPT_BYTES).getP2shHash() == Hash160(ADDRESS_HASH_BYTES)));
+            BOOST_TEST((Script(P2PKH_SCRIPT_BYTES).getP2shHash() == std::nullopt));
+        }
+        
+        BOOST_AUTO_TEST_CASE(ScriptGetMultisigParamsTest)
+        {
+            const PublicKey publicKey1("03f50ca6f27d1c1f461160ae4cc3588141dc048b262101b5faa8a22e9de4c99c08");
+            const PublicKey publicKey2("0286f77ac51a93e9d65df4ab0d3a7f9dac2a0a282143e21352a94c2793898534a5");
+            const Script multisigScript(std::vector<ScriptElement>{
+                1, publicKey1, publicKey2, 2, ScriptOp::checkmultisig
+            });
+            const Script claimScript(std::vector<ScriptElement>{
+                Hash256(SCRIPT_HASH_BYTES), ScriptOp::drop, 2, publicKey1, publicKey2, 2, ScriptOp::checkmultisig
+            });
+            const std::pair<uint32_t, std::vector<PublicKey>> oneOfTwo(1, {publicKey1, publicKey2});
+            const std::pair<uint32_t, std::vector<PublicKey>> twoOfTwo(2, {publicKey1, publicKey2});
+            BOOST_TEST((multisigScript.getMultisigParams() == oneOfTwo));
+            BOOST_TEST((claimScript.getMultisigParams() == twoOfTwo));
+            BOOST_TEST((Script(P2PKH_SCRIPT_BYTES).getMultisigParams() == std::nullopt));
+            const Script tooFewKeys(std::vector<ScriptElement>{1, publicKey1, 2, ScriptOp::checkmultisig});
+            BOOST_TEST((tooFewKeys.getMultisigParams() == std::nullopt));
+        }
+        
+        BOOST_AUTO_TEST_CASE(ScriptGetPushedDataTest)
+        {
+            const std::vector<std::vector<BYTE>> pushedData{ADDRESS_HASH_BYTES, SCRIPT_HASH_BYTES};
+            const Script pushOnlyScript(std::vector<ScriptElement>{ADDRESS_HASH_BYTES, SCRIPT_HASH_BYTES});
+            BOOST_TEST((pushOnlyScript.getPushedData() == pushedData));
+            BOOST_TEST((Script(EMPTY_SCRIPT_BYTES).getPushedData() == std::vector<std::vector<BYTE>>{}));
+            BOOST_TEST((Script(P2PKH_SCRIPT_BYTES).getPushedData() == std::nullopt));
+        }
+        
+        BOOST_AUTO_TEST_CASE(ScriptGetOperationsTest)
+        {
+            const Script p2pkhScript(P2PKH_SCRIPT_BYTES);
+            const std::optional<std::vector<ScriptOperation>> ops = p2pkhScript.getOperations();
+            BOOST_TEST((ops.has_value()));
+            BOOST_TEST((ops->size() == 5));
+            BOOST_TEST((ops->at(0).code == 0x76));
+            BOOST_TEST((ops->at(2).code == ADDRESS_HASH_BYTES.size()));
+            BOOST_TEST((std::vector<BYTE>(ops->at(2).data, ops->at(2).data + ops->at(2).dataSize) ==
+                        ADDRESS_HASH_BYTES));
+            BOOST_TEST((ops->at(4).code == 0xac));
+            const std::vector<BYTE> pushData1(76, 0x01);
+            std::vector<BYTE> pushData1Script{0x4c, 76};
+            pushData1Script.insert(pushData1Script.end(), pushData1.begin(), pushData1.end());
+            const std::optional<std::vector<ScriptOperation>> pushData1Ops = Script(pushData1Script).getOperations();
+            BOOST_TEST((pushData1Ops.has_value() && pushData1Ops->size() == 1));
+            BOOST_TEST((pushData1Ops->at(0).dataSize == pushData1.size()));
+            const Script truncatedScript(std::vector<BYTE>(P2PKH_SCRIPT_BYTES.begin(), P2PKH_SCRIPT_BYTES.end() - 5));
+            BOOST_TEST((truncatedScript.getOperations() == std::nullopt));
+            BOOST_TEST((truncatedScript.getPushedData() == std::nullopt));
+        }
+        
+        BOOST_AUTO_TEST_CASE(ScriptLongScriptTest)
+        {
+            std::vector<BYTE> longScriptBytes{0x4c, 100};
+            longScriptBytes.insert(longScriptBytes.end(), 100, 0x02);
+            const Script longScript(longScriptBytes);
+            BOOST_TEST((longScript.size() > Script::INLINE_SIZE_BYTES));
+            BOOST_TEST((static_cast<std::vector<BYTE>>(longScript) == longScriptBytes));
+            Script moved(std::move(Script(longScript)));
+            BOOST_TEST((moved == longScript));
+            moved = Script(P2PKH_SCRIPT_BYTES);
+            BOOST_TEST((moved.isP2pkh()));
+        }
+        
         BOOST_AUTO_TEST_CASE(ScriptGetHash160Test)
         {
             BOOST_TEST((Script(P2PKH_SCRIPT_BYTES).getHash160() == P2PKH_SCRIPT_HASH160));
@@ -0,0 +1,178 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Compact_Encoding_Test
+
+#include <boost/test/included/unit_test.hpp>
+#include "../../src/structs/compact_encoding.h"
+#include "../../src/util/byte_sink.h"
+#include "../../src/util/hex.h"
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace conclave
+{
+    namespace compact
+    {
+        const static std::string HASH160_HEX = "39a95df3c155a9c017c2099723a0a70ef85721b0";
+        const static std::string HASH256_HEX = "5db9ba8a8d0a6f3b7d2d3d8f7e35f3a3d6c04b4b2a9a6c1ad7c2b2b5b3e8f1a0";
+        const static Script P2PKH_SCRIPT(hexStringToByteVector("76a914" + HASH160_HEX + "88ac"));
+        const static Script P2SH_SCRIPT(hexStringToByteVector("a914" + HASH160_HEX + "87"));
+        const static Script P2WPKH_SCRIPT(hexStringToByteVector("0014" + HASH160_HEX));
+        const static Script P2WSH_SCRIPT(hexStringToByteVector("0020" + HASH256_HEX));
+        const static Script NONSTANDARD_SCRIPT(std::vector<BYTE>{0x51, 0x52, 0x93});
+        const static ConclaveTx CONCLAVE_TX(
+            1, 0, 2, Outpoint(Hash256::digest("fund"), 1),
+            std::vector<PublicKey>{PublicKey(Hash256::digest("trustee1"), true),
+                                   PublicKey(Hash256::digest("trustee2"), false)},
+            std::vector<ConclaveInput>{
+                ConclaveInput(Outpoint(Hash256::digest("spent1"), 0), NONSTANDARD_SCRIPT, 0xffffffff),
+                ConclaveInput(Outpoint(Hash256::digest("spent2"), 300), P2WPKH_SCRIPT, 0xfffffffe,
+                              Inpoint(Hash256::digest("pre"), 2))
+            },
+            std::vector<BitcoinOutput>{BitcoinOutput(5000, P2SH_SCRIPT)},
+            std::vector<ConclaveOutput>{
+                ConclaveOutput(P2PKH_SCRIPT, 7000),
+                ConclaveOutput(P2WSH_SCRIPT, 2100000000000000, Outpoint(Hash256::digest("prev"), 4)),
+                ConclaveOutput(NONSTANDARD_SCRIPT, 0)
+            }
+        );
+        
+        template<typename F>
+        static std::vector<BYTE> encode(F write)
+        {
+            std::vector<BYTE> encoded;
+            ByteVectorSink sink(encoded);
+            write(sink);
+            return encoded;
+        }
+        
+        BOOST_AUTO_TEST_CASE(CompactIntTest)
+        {
+            BOOST_TEST((encode([](ByteSink& sink) { writeCompactInt(sink, 0); }) == std::vector<BYTE>{0x00}));
+            BOOST_TEST((encode([](ByteSink& sink) { writeCompactInt(sink, 0x7f); }) == std::vector<BYTE>{0x7f}));
+            BOOST_TEST((encode([](ByteSink& sink) { writeCompactInt(sink, 0x80); }) == std::vector<BYTE>{0x80, 0x01}));
+            BOOST_TEST((encode([](ByteSink& sink) { writeCompactInt(sink, 300); }) == std::vector<BYTE>{0xac, 0x02}));
+            for (const uint64_t value : {uint64_t(0), uint64_t(1), uint64_t(0x3fff), uint64_t(0x4000),
+                                         uint64_t(2100000000000000), std::numeric_limits<uint64_t>::max()}) {
+                const std::vector<BYTE> encoded = encode([value](ByteSink& sink) { writeCompactInt(sink, value); });
+                ByteReader reader(encoded);
+                BOOST_TEST(readCompactInt(reader) == value);
+                BOOST_TEST(reader.getRemaining() == 0);
+            }
+            BOOST_TEST(encode([](ByteSink& sink) {
+                writeCompactInt(sink, std::numeric_limits<uint64_t>::max());
+            }).size() == 10);
+        }
+        
+        BOOST_AUTO_TEST_CASE(CompactIntInvalidTest)
+        {
+            // Overlong
+            const std::vector<BYTE> overlong{0x80, 0x00};
+            ByteReader overlongReader(overlong);
+            BOOST_CHECK_THROW(readCompactInt(overlongReader), std::runtime_error);
+            // Overflowing
+            std::vector<BYTE> overflowing(9, 0xff);
+            overflowing.push_back(0x02);
+            ByteReader overflowingReader(overflowing);
+            BOOST_CHECK_THROW(readCompactInt(overflowingReader), std::runtime_error);
+            // Truncated
+            const std::vector<BYTE> truncated{0x80};
+            ByteReader truncatedReader(truncated);
+            BOOST_CHECK_THROW(readCompactInt(truncatedReader), std::runtime_error);
+        }
+        
+        BOOST_AUTO_TEST_CASE(CompactScriptTest)
+        {
+            // Standard scripts are a one byte tag plus their hash, anything else is stored whole
+            const std::vector<std::pair<Script, size_t>> cases{
+                {P2PKH_SCRIPT, 1 + SMALL_HASH_SIZE_BYTES},
+                {P2SH_SCRIPT, 1 + SMALL_HASH_SIZE_BYTES},
+                {P2WPKH_SCRIPT, 1 + SMALL_HASH_SIZE_BYTES},
+                {P2WSH_SCRIPT, 1 + LARGE_HASH_SIZE_BYTES},
+                {NONSTANDARD_SCRIPT, 1 + 3},
+                {Script(), 1}
+            };
+            for (const std::pair<Script, size_t>& testCase : cases) {
+                const std::vector<BYTE> encoded = encode([&testCase](ByteSink& sink) {
+                    writeScript(sink, testCase.first);
+                });
+                BOOST_TEST(encoded.size() == testCase.second);
+                ByteReader reader(encoded);
+                BOOST_TEST((readScript(reader) == testCase.first));
+                BOOST_TEST(reader.getRemaining() == 0);
+                ByteReader skipReader(encoded);
+                skipScript(skipReader);
+                BOOST_TEST(skipReader.getRemaining() == 0);
+            }
+            BOOST_TEST(P2PKH_SCRIPT.isP2pkh());
+            BOOST_TEST(P2SH_SCRIPT.isP2sh());
+            BOOST_TEST(P2WPKH_SCRIPT.isP2wpkh());
+            BOOST_TEST(P2WSH_SCRIPT.isP2wsh());
+        }
+        
+        BOOST_AUTO_TEST_CASE(CompactConclaveTxRoundTripTest)
+        {
+            const std::vector<BYTE> encoded = serializeConclaveTx(CONCLAVE_TX);
+            BOOST_TEST(encoded.size() < CONCLAVE_TX.serializedSize());
+            const ConclaveTx decoded = deserializeConclaveTx(encoded);
+            BOOST_TEST((decoded == CONCLAVE_TX));
+            BOOST_TEST((decoded.serialize() == CONCLAVE_TX.serialize()));
+            BOOST_TEST((decoded.getHash256() == CONCLAVE_TX.getHash256()));
+            BOOST_TEST((serializeConclaveTx(decoded) == encoded));
+        }
+        
+        BOOST_AUTO_TEST_CASE(CompactConclaveTxSkipTest)
+        {
+            // Skipping an input or output lands exactly where reading it would
+            for (const ConclaveInput& conclaveInput : CONCLAVE_TX.conclaveInputs) {
+                const std::vector<BYTE> encoded = encode([&conclaveInput](ByteSink& sink) {
+                    writeConclaveInput(sink, conclaveInput);
+                });
+                ByteReader reader(encoded);
+                skipConclaveInput(reader);
+                BOOST_TEST(reader.getRemaining() == 0);
+            }
+            for (const ConclaveOutput& conclaveOutput : CONCLAVE_TX.conclaveOutputs) {
+                const std::vector<BYTE> encoded = encode([&conclaveOutput](ByteSink& sink) {
+                    writeConclaveOutput(sink, conclaveOutput);
+                });
+                ByteReader reader(encoded);
+                skipConclaveOutput(reader);
+                BOOST_TEST(reader.getRemaining() == 0);
+            }
+        }
+        
+        BOOST_AUTO_TEST_CASE(CompactConclaveTxInvalidTest)
+        {
+            std::vector<BYTE> trailing = serializeConclaveTx(CONCLAVE_TX);
+            trailing.push_back(0x00);
+            BOOST_CHECK_THROW(deserializeConclaveTx(trailing), std::runtime_error);
+            std::vector<BYTE> truncated = serializeConclaveTx(CONCLAVE_TX);
+            truncated.pop_back();
+            BOOST_CHECK_THROW(deserializeConclaveTx(truncated), std::runtime_error);
+            // version, lockTime and minSigs are one byte each, followed by the fund point's presence flag
+            std::vector<BYTE> badFlag = serializeConclaveTx(CONCLAVE_TX);
+            badFlag[3] = 0x02;
+            BOOST_CHECK_THROW(deserializeConclaveTx(badFlag), std::runtime_error);
+        }
+    }
+}
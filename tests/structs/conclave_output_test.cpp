@@ -425,6 +425,14 @@ namespace conclave
             BOOST_TEST((conclaveOutput7.serialize() == CONCLAVE_OUTPUT_7_SERIALIZED));
             BOOST_TEST((conclaveOutput8.serialize() == CONCLAVE_OUTPUT_8_SERIALIZED));
         }
+        
+        BOOST_AUTO_TEST_CASE(ConclaveOutputSerializedSizeTest)
+        {
+            ConclaveOutput conclaveOutput1(SCRIPTPUBKEY_1, VALUE_1);
+            ConclaveOutput conclaveOutput2(SCRIPTPUBKEY_2, VALUE_2, PREDECESSOR_1);
+            BOOST_TEST((conclaveOutput1.serializedSize() == CONCLAVE_OUTPUT_1_SERIALIZED.size()));
+            BOOST_TEST((conclaveOutput2.serializedSize() == CONCLAVE_OUTPUT_8_SERIALIZED.size()));
+        }
     
     BOOST_AUTO_TEST_SUITE_END()
 }
@@ -26,6 +26,44 @@ namespace conclave
 {
     BOOST_AUTO_TEST_CASE(ConclaveTxConstructorsTest)
     {
-        BOOST_TEST(true);
+        // Binding from a parsed JsonDocument gives the same transaction as going through a property tree
+        const Script script(std::vector<BYTE>{0x51, 0x52, 0x87});
+        const ConclaveTx conclaveTx(1, 0, 1, Outpoint(Hash256::digest("fund"), 1),
+                                    {PublicKey(Hash256::digest("trustee"), true)},
+                                    {ConclaveInput(Outpoint(Hash256::digest("spent"), 0), script, 0xffffffff,
+                                                   Inpoint(Hash256::digest("pre"), 2))},
+                                    {BitcoinOutput(5000, script)}, {ConclaveOutput(script, 7000)});
+        const std::string json = ptreeToString(static_cast<pt::ptree>(conclaveTx));
+        const JsonDocument document(json);
+        BOOST_TEST((ConclaveTx(document.getRoot()) == conclaveTx));
+        BOOST_TEST((ConclaveTx(stringToPtree(json)) == conclaveTx));
+        // And writing it out directly reads back the same way
+        std::pmr::string written;
+        JsonWriter writer(written);
+        conclaveTx.writeJson(writer);
+        const JsonDocument writtenDocument(written);
+        BOOST_TEST((ConclaveTx(writtenDocument.getRoot()) == conclaveTx));
+        BOOST_TEST((ConclaveTx(stringToPtree(written)) == conclaveTx));
+    }
+    
+    BOOST_AUTO_TEST_CASE(ConclaveTxGetHash256Test)
+    {
+        // getHash256() streams the serialization into the hasher, so check it against hashing the bytes
+        const Outpoint fundPoint(Hash256::digest("fund"), 1);
+        const std::vector<PublicKey> trustees{PublicKey(Hash256::digest("trustee"), true)};
+        const Script script(std::vector<BYTE>{0x51, 0x52, 0x93});
+        const std::vector<ConclaveInput> conclaveInputs{
+            ConclaveInput(Outpoint(Hash256::digest("spent"), 0), script, 0xffffffff, Inpoint(Hash256::digest("pre"), 2))
+        };
+        const std::vector<BitcoinOutput> bitcoinOutputs{BitcoinOutput(5000, script)};
+        const std::vector<ConclaveOutput> conclaveOutputs{ConclaveOutput(script, 7000)};
+        const ConclaveTx conclaveTx(1, 0, 1, fundPoint, trustees, conclaveInputs, bitcoinOutputs, conclaveOutputs);
+        for (const bool preFund : {false, true}) {
+            const std::vector<BYTE> serialized = conclaveTx.serialize(preFund);
+            BOOST_TEST((conclaveTx.getHash256(preFund) == Hash256::digest(serialized)));
+            BOOST_TEST((conclaveTx.serializedSize(preFund) == serialized.size()));
+            BOOST_TEST((ConclaveTx(serialized).serialize(preFund) == serialized));
+        }
+        BOOST_TEST((conclaveTx.getHash256(true) != conclaveTx.getHash256(false)));
     }
 }
@@ -0,0 +1,98 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Conclave_Tx_View_Test
+
+#include <boost/test/included/unit_test.hpp>
+#include "../../src/structs/conclave_tx_view.h"
+#include "../../src/structs/compact_encoding.h"
+#include <cstdint>
+#include <stdexcept>
+
+namespace conclave
+{
+    const static Script SCRIPT_1(std::vector<BYTE>{0x51, 0x52, 0x93});
+    const static Script SCRIPT_2(std::vector<BYTE>{0x00, 0x14, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09,
+                                                   0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12, 0x13, 0x14});
+    const static ConclaveTx CONCLAVE_TX(
+        1, 0, 2, Outpoint(Hash256::digest("fund"), 1),
+        std::vector<PublicKey>{PublicKey(Hash256::digest("trustee1"), true),
+                               PublicKey(Hash256::digest("trustee2"), false)},
+        std::vector<ConclaveInput>{
+            ConclaveInput(Outpoint(Hash256::digest("spent1"), 0), SCRIPT_1, 0xffffffff),
+            ConclaveInput(Outpoint(Hash256::digest("spent2"), 3), SCRIPT_2, 0xfffffffe,
+                          Inpoint(Hash256::digest("pre"), 2))
+        },
+        std::vector<BitcoinOutput>{BitcoinOutput(5000, SCRIPT_2)},
+        std::vector<ConclaveOutput>{
+            ConclaveOutput(SCRIPT_1, 7000),
+            ConclaveOutput(SCRIPT_2, 8000, Outpoint(Hash256::digest("prev"), 4)),
+            ConclaveOutput(SCRIPT_2, 9000)
+        }
+    );
+    
+    BOOST_AUTO_TEST_CASE(ConclaveTxViewHeaderTest)
+    {
+        const ConclaveTxView view(compact::serializeConclaveTx(CONCLAVE_TX));
+        BOOST_TEST((view.getHash256() == CONCLAVE_TX.getHash256()));
+        BOOST_TEST((view.getVersion() == CONCLAVE_TX.version));
+        BOOST_TEST((view.getLockTime() == CONCLAVE_TX.lockTime));
+        BOOST_TEST((view.getMinSigs() == CONCLAVE_TX.minSigs));
+        BOOST_TEST((view.getFundPoint() == CONCLAVE_TX.fundPoint));
+        BOOST_TEST((view.toConclaveTx() == CONCLAVE_TX));
+    }
+    
+    BOOST_AUTO_TEST_CASE(ConclaveTxViewInputsTest)
+    {
+        const ConclaveTxView view(compact::serializeConclaveTx(CONCLAVE_TX));
+        BOOST_TEST((view.getNumConclaveInputs() == CONCLAVE_TX.conclaveInputs.size()));
+        for (size_t i = 0; i < CONCLAVE_TX.conclaveInputs.size(); i++) {
+            const ConclaveInput& conclaveInput = CONCLAVE_TX.conclaveInputs[i];
+            BOOST_TEST((view.getConclaveInput(i) == conclaveInput));
+            BOOST_TEST((view.getConclaveInputOutpoint(i) == conclaveInput.outpoint));
+            BOOST_TEST((view.getConclaveInputPredecessor(i) == conclaveInput.predecessor));
+        }
+        BOOST_CHECK_THROW(view.getConclaveInput(CONCLAVE_TX.conclaveInputs.size()), std::runtime_error);
+    }
+    
+    BOOST_AUTO_TEST_CASE(ConclaveTxViewOutputsTest)
+    {
+        const ConclaveTxView view(compact::serializeConclaveTx(CONCLAVE_TX));
+        BOOST_TEST((view.getNumBitcoinOutputs() == CONCLAVE_TX.bitcoinOutputs.size()));
+        BOOST_TEST((view.getBitcoinOutput(0) == CONCLAVE_TX.bitcoinOutputs[0]));
+        BOOST_TEST((view.getNumConclaveOutputs() == CONCLAVE_TX.conclaveOutputs.size()));
+        // Out of order, to check nothing depends on having read the previous output
+        for (const size_t i : {2, 0, 1}) {
+            const ConclaveOutput& conclaveOutput = CONCLAVE_TX.conclaveOutputs[i];
+            BOOST_TEST((view.getConclaveOutput(i) == conclaveOutput));
+            BOOST_TEST((view.getConclaveOutputValue(i) == conclaveOutput.value));
+            BOOST_TEST((view.getConclaveOutputPredecessor(i) == conclaveOutput.predecessor));
+        }
+        BOOST_CHECK_THROW(view.getConclaveOutputValue(CONCLAVE_TX.conclaveOutputs.size()), std::runtime_error);
+    }
+    
+    BOOST_AUTO_TEST_CASE(ConclaveTxViewTruncatedTest)
+    {
+        std::vector<BYTE> truncated = compact::serializeConclaveTx(CONCLAVE_TX);
+        truncated.pop_back();
+        const ConclaveTxView view(truncated);
+        // The header is still readable, but indexing runs off the end
+        BOOST_TEST((view.getVersion() == CONCLAVE_TX.version));
+        BOOST_CHECK_THROW(view.getNumConclaveOutputs(), std::runtime_error);
+    }
+}
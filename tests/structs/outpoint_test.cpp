@@ -22,6 +22,7 @@
 #include "../../src/structs/outpoint.h"
 #include "../../src/util/json.h"
 #include <boost/property_tree/json_parser.hpp>
+#include <array>
 #include <sstream>
 
 namespace pt = boost::property_tree;
@@ -70,12 +71,16 @@ namespace conclave
             Outpoint outpointFromProps(TXID_1, INDEX_1);
             Outpoint outpointFromPtree(OUTPOINT_1_PTREE);
             Outpoint outpointFromByteVector(OUTPOINT_1_SERIALIZED);
+            const JsonDocument document(OUTPOINT_1_STR);
+            Outpoint outpointFromJsonValue(document.getRoot());
             BOOST_TEST((outpointFromProps.txId == TXID_1));
             BOOST_TEST((outpointFromProps.index == INDEX_1));
             BOOST_TEST((outpointFromPtree.txId == TXID_1));
             BOOST_TEST((outpointFromPtree.index == INDEX_1));
             BOOST_TEST((outpointFromByteVector.txId == TXID_1));
             BOOST_TEST((outpointFromByteVector.index == INDEX_1));
+            BOOST_TEST((outpointFromJsonValue.txId == TXID_1));
+            BOOST_TEST((outpointFromJsonValue.index == INDEX_1));
         }
         
         BOOST_AUTO_TEST_CASE(OutpointCastToStringTest)
@@ -129,6 +134,18 @@ namespace conclave
             BOOST_TEST((Outpoint(TXID_2, INDEX_1).serialize() == OUTPOINT_3_SERIALIZED));
             BOOST_TEST((Outpoint(TXID_2, INDEX_2).serialize() == OUTPOINT_4_SERIALIZED));
         }
+        
+        BOOST_AUTO_TEST_CASE(OutpointDeserializeFromReaderTest)
+        {
+            // Decodes in place from a buffer which isn't a std::vector, and refuses to run past its end
+            std::array<BYTE, Outpoint::SERIALIZED_SIZE_BYTES> buffer;
+            std::copy(OUTPOINT_3_SERIALIZED.begin(), OUTPOINT_3_SERIALIZED.end(), buffer.begin());
+            ByteReader reader(buffer.data(), buffer.size());
+            BOOST_TEST((Outpoint::deserialize(reader) == Outpoint(TXID_2, INDEX_1)));
+            BOOST_TEST((reader.getRemaining() == 0));
+            ByteReader truncatedReader(buffer.data(), buffer.size() - 1);
+            BOOST_CHECK_THROW(Outpoint::deserialize(truncatedReader), std::runtime_error);
+        }
     
     BOOST_AUTO_TEST_SUITE_END()
 };
@@ -0,0 +1,92 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Sig_Hash_Context_Test
+
+#include <boost/test/included/unit_test.hpp>
+#include "../../src/structs/sig_hash_context.h"
+
+namespace conclave
+{
+    const static Hash256 PREV_TX_ID("b5c1e7f9d3a2c4e6f8a0b2c4d6e8f0a1b3c5d7e9f1a3b5c7d9e1f3a5b7c9d1e3");
+    const static Script SCRIPT_CODE("dup hash160 [39a95df3c155a9c017c2099723a0a70ef85721b0] equalverify checksig");
+    const static Script OTHER_SCRIPT("hash160 [39a95df3c155a9c017c2099723a0a70ef85721b0] equal");
+    
+    inline static ConclaveTx makeTx()
+    {
+        return ConclaveTx(0, 0, {
+            ConclaveInput(Outpoint(PREV_TX_ID, 0), Script(), 0),
+            ConclaveInput(Outpoint(PREV_TX_ID, 1), Script(), 0),
+            ConclaveInput(Outpoint(PREV_TX_ID, 2), Script(), 0)
+        }, {}, {
+            ConclaveOutput(SCRIPT_CODE, 3000),
+            ConclaveOutput(OTHER_SCRIPT, 500)
+        });
+    }
+    
+    BOOST_AUTO_TEST_SUITE(SigHashContextTestSuite)
+        
+        BOOST_AUTO_TEST_CASE(SigHashContextMatchesConclaveTxTest)
+        {
+            const ConclaveTx conclaveTx = makeTx();
+            const SigHashContext sigHashContext(conclaveTx);
+            for (size_t i = 0; i < conclaveTx.conclaveInputs.size(); i++) {
+                BOOST_TEST((sigHashContext.getSigHash(i, SCRIPT_CODE, 1000) ==
+                            conclaveTx.getSigHash(i, SCRIPT_CODE, 1000)));
+            }
+        }
+        
+        BOOST_AUTO_TEST_CASE(SigHashContextCommitsToInputTest)
+        {
+            const ConclaveTx conclaveTx = makeTx();
+            const SigHashContext sigHashContext(conclaveTx);
+            const Hash256 sigHash = sigHashContext.getSigHash(0, SCRIPT_CODE, 1000);
+            BOOST_TEST((sigHash != sigHashContext.getSigHash(1, SCRIPT_CODE, 1000)));
+            BOOST_TEST((sigHash != sigHashContext.getSigHash(0, OTHER_SCRIPT, 1000)));
+            BOOST_TEST((sigHash != sigHashContext.getSigHash(0, SCRIPT_CODE, 1001)));
+            BOOST_CHECK_THROW(sigHashContext.getSigHash(3, SCRIPT_CODE, 1000), std::runtime_error);
+        }
+        
+        BOOST_AUTO_TEST_CASE(SigHashContextCommitsToTxTest)
+        {
+            const ConclaveTx conclaveTx = makeTx();
+            const Hash256 sigHash = conclaveTx.getSigHash(0, SCRIPT_CODE, 1000);
+            ConclaveTx otherTx = makeTx();
+            otherTx.conclaveOutputs[1].value = 600;
+            BOOST_TEST((sigHash != otherTx.getSigHash(0, SCRIPT_CODE, 1000)));
+            otherTx = makeTx();
+            otherTx.conclaveInputs[2].sequence = 1;
+            BOOST_TEST((sigHash != otherTx.getSigHash(0, SCRIPT_CODE, 1000)));
+            otherTx = makeTx();
+            otherTx.conclaveInputs[1].outpoint.index = 7;
+            BOOST_TEST((sigHash != otherTx.getSigHash(0, SCRIPT_CODE, 1000)));
+        }
+        
+        BOOST_AUTO_TEST_CASE(SigHashContextIgnoresScriptSigsAndPredecessorsTest)
+        {
+            const ConclaveTx conclaveTx = makeTx();
+            const Hash256 sigHash = conclaveTx.getSigHash(0, SCRIPT_CODE, 1000);
+            ConclaveTx signedTx = makeTx();
+            signedTx.conclaveInputs[0].scriptSig = OTHER_SCRIPT;
+            signedTx.conclaveInputs[1].predecessor = Inpoint(PREV_TX_ID, 4);
+            signedTx.conclaveOutputs[0].predecessor = Outpoint(PREV_TX_ID, 5);
+            BOOST_TEST((sigHash == signedTx.getSigHash(0, SCRIPT_CODE, 1000)));
+        }
+    
+    BOOST_AUTO_TEST_SUITE_END()
+}
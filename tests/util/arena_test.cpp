@@ -0,0 +1,72 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Arena_Test
+
+#include <boost/test/included/unit_test.hpp>
+#include "../../src/util/arena.h"
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace conclave
+{
+    BOOST_AUTO_TEST_CASE(ArenaScopeTest)
+    {
+        // Scopes nest, and the default resource is current outside of any
+        Arena outer;
+        Arena inner;
+        BOOST_TEST(Arena::getCurrentResource() == std::pmr::get_default_resource());
+        {
+            const Arena::Scope outerScope(&outer);
+            BOOST_TEST(Arena::getCurrentResource() == outer.getResource());
+            {
+                const Arena::Scope innerScope(&inner);
+                BOOST_TEST(Arena::getCurrentResource() == inner.getResource());
+                const Arena::Scope noScope(nullptr);
+                BOOST_TEST(Arena::getCurrentResource() == std::pmr::get_default_resource());
+            }
+            BOOST_TEST(Arena::getCurrentResource() == outer.getResource());
+        }
+        BOOST_TEST(Arena::getCurrentResource() == std::pmr::get_default_resource());
+    }
+    
+    BOOST_AUTO_TEST_CASE(ArenaAllocateTest)
+    {
+        // Containers work the same whether they fit in the arena's buffer or overflow it
+        Arena arena;
+        std::pmr::string small("a string too long for the small string optimization", arena.getResource());
+        std::pmr::vector<BYTE> large(4 * Arena::BUFFER_SIZE_BYTES, 0xab, arena.getResource());
+        small += small;
+        BOOST_TEST(small.size() == 102);
+        BOOST_TEST(large.size() == 4 * Arena::BUFFER_SIZE_BYTES);
+        BOOST_TEST(large.back() == 0xab);
+    }
+    
+    BOOST_AUTO_TEST_CASE(ArenaRecycleTest)
+    {
+        // A released buffer is handed to the next arena
+        void* first;
+        {
+            Arena arena;
+            first = arena.getResource()->allocate(1);
+        }
+        Arena arena;
+        BOOST_TEST(arena.getResource()->allocate(1) == first);
+    }
+}
@@ -72,3 +72,18 @@ BOOST_AUTO_TEST_CASE(HexTest)
     BOOST_TEST(threeByteHexStringFromByteVector == THREE_BYTE_HEX_STRING);
     BOOST_TEST(threeByteHexStringFromByteArray == THREE_BYTE_HEX_STRING);
 }
+
+BOOST_AUTO_TEST_CASE(HexLiteralTest)
+{
+    // Parsed at compile time
+    constexpr std::array<BYTE, 3> threeByteArray = hexLiteralToByteArray("ff0080");
+    static_assert(threeByteArray[0] == 0xff && threeByteArray[1] == 0x00 && threeByteArray[2] == 0x80);
+    static_assert(hexLiteralToByteArray("02E7")[1] == 0xe7);
+    static_assert(hexLiteralToByteArray("").empty());
+    BOOST_TEST((HEX_LITERAL("ff0080") == THREE_BYTE_ARRAY));
+    // The same parser throws when it is only reached at runtime
+    BOOST_TEST((hexCStringToByteArray<2>(TWO_BYTE_HEX_STRING.c_str()) == TWO_BYTE_ARRAY));
+    BOOST_CHECK_THROW(hexCStringToByteArray<2>("02e"), std::runtime_error);
+    BOOST_CHECK_THROW(hexCStringToByteArray<2>("02e7ff"), std::runtime_error);
+    BOOST_CHECK_THROW(hexCStringToByteArray<2>("02g7"), std::runtime_error);
+}
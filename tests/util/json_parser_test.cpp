@@ -0,0 +1,97 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Json_Parser_Test
+
+#include <boost/test/included/unit_test.hpp>
+#include "../../src/util/json_parser.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace conclave
+{
+    BOOST_AUTO_TEST_CASE(JsonParserValuesTest)
+    {
+        const std::string json =
+            "{\"method\": \"getUtxos\", \"id\": 7, \"flag\": true, \"none\": null,\n"
+            " \"params\": {\"address\": \"mfWxJ45yp2SFn7UciZyNpvDKrzbhyfKrY8\", \"index\": \"4294967294\"},\n"
+            " \"list\": [1, -2, 3.5e2, [], {}]}";
+        const JsonDocument document(json);
+        const JsonValue root = document.getRoot();
+        BOOST_TEST(root.isObject());
+        BOOST_TEST(root.size() == 6);
+        BOOST_TEST(root.get("method").getValue<std::string>() == "getUtxos");
+        BOOST_TEST(root.get("id").getValue<uint32_t>() == 7);
+        BOOST_TEST(root.get("id").getValue<std::string>() == "7");
+        BOOST_TEST(root.get("flag").getValue<bool>());
+        BOOST_TEST(root.get("none").isNull());
+        // Numbers may arrive as strings, as they do from the property tree writer
+        BOOST_TEST(root.get("params").get("index").getValue<uint32_t>() == 0xfffffffe);
+        BOOST_TEST(!root.find("missing").has_value());
+        BOOST_CHECK_THROW(root.get("missing"), std::runtime_error);
+        BOOST_CHECK_THROW(root.get("method").getValue<uint32_t>(), std::runtime_error);
+        BOOST_CHECK_THROW(root.get("list").get("anything"), std::runtime_error);
+        std::vector<std::string> texts;
+        for (const JsonValue item : root.get("list")) {
+            texts.emplace_back(item.getText());
+        }
+        BOOST_TEST((texts == std::vector<std::string>{"1", "-2", "3.5e2", "", ""}));
+    }
+    
+    BOOST_AUTO_TEST_CASE(JsonParserStringsTest)
+    {
+        // Plain strings are views into the text; escaped ones are unescaped into the document
+        const std::string json = "[\"plain\", \"a\\\"b\\\\c\\/d\\n\", \"\\u00e9\\u20ac\\ud83d\\ude00\"]";
+        const JsonDocument document(json);
+        std::vector<JsonValue> items(document.getRoot().begin(), document.getRoot().end());
+        BOOST_TEST(items.size() == 3);
+        BOOST_TEST(items[0].getText() == "plain");
+        BOOST_TEST((items[0].getText().data() >= json.data() &&
+                    items[0].getText().data() < json.data() + json.size()));
+        BOOST_TEST(items[1].getText() == "a\"b\\c/d\n");
+        BOOST_TEST(items[2].getText() == "\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80");
+    }
+    
+    BOOST_AUTO_TEST_CASE(JsonParserMalformedTest)
+    {
+        const std::vector<std::string> malformed{
+            "", "{", "{\"a\" 1}", "{\"a\": 1,}", "[1 2]", "[01]", "[1.]", "[-]", "\"unterminated",
+            "\"bad \\x escape\"", "\"\\ud83d alone\"", "[tru]", "{} {}", "{\"a\": \"tab\there\"}",
+            std::string(JsonDocument::MAX_DEPTH + 2, '[') + std::string(JsonDocument::MAX_DEPTH + 2, ']')
+        };
+        for (const std::string& json : malformed) {
+            BOOST_CHECK_THROW(JsonDocument document(json), std::runtime_error);
+        }
+        const std::string deepest = std::string(JsonDocument::MAX_DEPTH + 1, '[') +
+                                    std::string(JsonDocument::MAX_DEPTH + 1, ']');
+        BOOST_CHECK_NO_THROW(JsonDocument document(deepest));
+    }
+    
+    BOOST_AUTO_TEST_CASE(JsonParserArenaTest)
+    {
+        // The tape comes from the current arena, which must outlive the document
+        Arena arena;
+        const Arena::Scope scope(&arena);
+        const std::string json = "{\"a\": [\"\\u0041\", {\"b\": false}]}";
+        const JsonDocument document(json);
+        BOOST_TEST(document.getRoot().get("a").size() == 2);
+        BOOST_TEST((*document.getRoot().get("a").begin()).getText() == "A");
+    }
+}
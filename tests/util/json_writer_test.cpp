@@ -0,0 +1,73 @@
+/*
+ * CONCLAVE - Scaling Bitcoin Simply.
+ * Copyright (C) 2019-2021 Conclave development team
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE Json_Writer_Test
+
+#include <boost/test/included/unit_test.hpp>
+#include "../../src/util/json_parser.h"
+#include "../../src/util/json_writer.h"
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace conclave
+{
+    BOOST_AUTO_TEST_CASE(JsonWriterStructureTest)
+    {
+        std::pmr::string json;
+        JsonWriter writer(json);
+        writer.startObject();
+        writer.key("a").number(1);
+        writer.key("b").startArray().number(-2).boolean(true).null().startObject().endObject().endArray();
+        writer.key("c").startArray().endArray();
+        writer.key("d").strings(std::vector<std::string>{"x", "y"});
+        writer.endObject();
+        BOOST_TEST(json == "{\"a\":1,\"b\":[-2,true,null,{}],\"c\":[],\"d\":[\"x\",\"y\"]}");
+    }
+    
+    BOOST_AUTO_TEST_CASE(JsonWriterValuesTest)
+    {
+        std::pmr::string json;
+        JsonWriter writer(json);
+        const std::vector<BYTE> bytes{0x00, 0x1f, 0xab, 0xff};
+        writer.startArray();
+        writer.number(std::numeric_limits<uint64_t>::max());
+        writer.number(std::numeric_limits<int64_t>::min());
+        writer.hex(bytes.data(), bytes.size());
+        writer.string("quote\" backslash\\ newline\n tab\t bell\x07 \xc3\xa9");
+        writer.endArray();
+        BOOST_TEST(json == "[18446744073709551615,-9223372036854775808,\"001fabff\","
+                           "\"quote\\\" backslash\\\\ newline\\n tab\\t bell\\u0007 \xc3\xa9\"]");
+    }
+    
+    BOOST_AUTO_TEST_CASE(JsonWriterRoundTripTest)
+    {
+        // Whatever is written parses back to the same values
+        const std::string original = "control \x01\x1f, unicode \xe2\x82\xac, escapes \"\\/";
+        std::pmr::string json;
+        JsonWriter writer(json);
+        writer.startObject().key(original).string(original).key("n").number(uint32_t(4294967294)).endObject();
+        const JsonDocument document(json);
+        const JsonValue root = document.getRoot();
+        BOOST_TEST(root.size() == 2);
+        BOOST_TEST(root.get(original).getValue<std::string>() == original);
+        BOOST_TEST(root.get("n").getValue<uint32_t>() == 4294967294);
+    }
+}
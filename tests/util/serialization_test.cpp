@@ -20,6 +20,7 @@
 
 #include <boost/test/included/unit_test.hpp>
 #include "../../src/util/serialization.h"
+#include <array>
 #include <cstdint>
 #include <optional>
 
@@ -36,6 +37,13 @@ namespace conclave
             return Thingy(size);
         }
         
+        static Thingy deserialize(ByteReader& reader)
+        {
+            const uint8_t size = reader.readIntegral<uint8_t>();
+            reader.skip(size - 1);
+            return Thingy(size);
+        }
+        
         static Thingy deserialize(const std::vector<BYTE>& data)
         {
             size_t pos = 0;
@@ -65,6 +73,16 @@ namespace conclave
             return serialization;
         }
         
+        void serialize(ByteSink& sink) const
+        {
+            writeBytes(sink, serialize());
+        }
+        
+        const size_t serializedSize() const
+        {
+            return size;
+        }
+        
         bool operator==(const Thingy& other) const
         {
             return (size == other.size);
@@ -200,6 +218,70 @@ namespace conclave
             BOOST_TEST((serializeVectorOfObjects(THINGIES) == THINGIES_SERIALIZED));
         }
         
+        BOOST_AUTO_TEST_CASE(VarIntSizeTest)
+        {
+            for (const uint64_t value: {0x00ULL, 0xfcULL, 0xfdULL, 0xffffULL, 0x10000ULL, 0xffffffffULL,
+                                        0x100000000ULL, 0xffffffffffffffffULL}) {
+                BOOST_TEST((varIntSize(value) == serializeVarInt(value).size()));
+            }
+            static_assert(varIntSize(0xfd) == 3, "varIntSize() should be usable at compile time");
+        }
+        
+        BOOST_AUTO_TEST_CASE(SerializedSizeTest)
+        {
+            BOOST_TEST((optionalObjectSerializedSize(OPTIONAL_PRESENT) == OPTIONAL_PRESENT_SERIALIZED.size()));
+            BOOST_TEST((optionalObjectSerializedSize(OPTIONAL_ABSENT) == OPTIONAL_ABSENT_SERIALIZED.size()));
+            BOOST_TEST((vectorOfObjectsSerializedSize(THINGIES) == THINGIES_SERIALIZED.size()));
+        }
+        
+        BOOST_AUTO_TEST_CASE(WriteToSinkTest)
+        {
+            std::vector<BYTE> serialized;
+            ByteVectorSink sink(serialized);
+            writeOptionalObject(sink, OPTIONAL_PRESENT);
+            writeOptionalObject(sink, OPTIONAL_ABSENT);
+            writeVectorOfObjects(sink, THINGIES);
+            std::vector<BYTE> expected(OPTIONAL_PRESENT_SERIALIZED);
+            expected.insert(expected.end(), OPTIONAL_ABSENT_SERIALIZED.begin(), OPTIONAL_ABSENT_SERIALIZED.end());
+            expected.insert(expected.end(), THINGIES_SERIALIZED.begin(), THINGIES_SERIALIZED.end());
+            BOOST_TEST((serialized == expected));
+        }
+        
+        BOOST_AUTO_TEST_CASE(SerializeToByteVectorTest)
+        {
+            BOOST_TEST((serializeToByteVector(Thingy(3)) == std::vector<BYTE>{0x03, 0x03, 0x03}));
+            BOOST_TEST((serializeToByteVector(Thingy(0)).empty()));
+        }
+        
+        BOOST_AUTO_TEST_CASE(ByteBufferSinkTest)
+        {
+            std::array<BYTE, 4> buffer{};
+            ByteBufferSink sink(buffer.data(), buffer.size());
+            writeIntegral<uint16_t>(sink, 0x0201);
+            writeIntegral<uint8_t>(sink, 0x03);
+            BOOST_TEST((sink.getPosition() == 3));
+            BOOST_CHECK_THROW(writeIntegral<uint16_t>(sink, 0x0504), std::runtime_error);
+            writeIntegral<uint8_t>(sink, 0x04);
+            BOOST_TEST((buffer == std::array<BYTE, 4>{0x01, 0x02, 0x03, 0x04}));
+        }
+        
+        BOOST_AUTO_TEST_CASE(VarStringTest)
+        {
+            std::pmr::string serialized;
+            ByteStringSink sink(serialized);
+            writeVarString(sink, "abc");
+            writeVarString(sink, "");
+            BOOST_TEST((std::string_view(serialized) == std::string_view("\x03" "abc" "\x00", 5)));
+            ByteReader reader(reinterpret_cast<const BYTE*>(serialized.data()), serialized.size());
+            BOOST_TEST(readVarString(reader) == "abc");
+            BOOST_TEST(readVarString(reader) == "");
+            BOOST_TEST(reader.getRemaining() == 0);
+            // A length running past the end of the data
+            const std::vector<BYTE> truncated{0x05, 'a', 'b'};
+            ByteReader truncatedReader(truncated);
+            BOOST_CHECK_THROW(readVarString(truncatedReader), std::runtime_error);
+        }
+        
         BOOST_AUTO_TEST_CASE(DeserializeIntegralTest)
         {
             std::vector<BYTE> data{
@@ -288,6 +370,51 @@ namespace conclave
             BOOST_TEST((deserializeVectorOfObjects<Thingy>(THINGIES_SERIALIZED, pos) == THINGIES));
             BOOST_TEST((pos == THINGIES_SERIALIZED.size()));
         }
+        
+        BOOST_AUTO_TEST_CASE(ByteReaderTest)
+        {
+            const BYTE data[]{0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0xfd, 0x00, 0x01, 0xff};
+            ByteReader reader(data, sizeof(data));
+            BOOST_TEST((reader.readIntegral<uint8_t>() == 0x01));
+            BOOST_TEST((reader.readIntegral<uint16_t>() == 0x0302));
+            BOOST_TEST((reader.readIntegral<int32_t>() == 0x07060504));
+            BOOST_TEST((reader.readVarInt() == 0x100));
+            BOOST_TEST((reader.getPosition() == 10));
+            BOOST_TEST((reader.getRemaining() == 1));
+            // A varint prefix promising more bytes than are left
+            BOOST_CHECK_THROW(reader.readVarInt(), std::runtime_error);
+            BOOST_CHECK_THROW(reader.read(1), std::runtime_error);
+            BOOST_CHECK_THROW(ByteReader(THINGIES_SERIALIZED, THINGIES_SERIALIZED.size() + 1), std::runtime_error);
+        }
+        
+        BOOST_AUTO_TEST_CASE(ReadObjectsTest)
+        {
+            ByteReader vectorReader(THINGIES_SERIALIZED);
+            BOOST_TEST((readVectorOfObjects<Thingy>(vectorReader) == THINGIES));
+            BOOST_TEST((vectorReader.getRemaining() == 0));
+            ByteReader presentReader(OPTIONAL_PRESENT_SERIALIZED);
+            BOOST_TEST((readOptionalObject<Thingy>(presentReader) == OPTIONAL_PRESENT));
+            ByteReader absentReader(OPTIONAL_ABSENT_SERIALIZED);
+            BOOST_TEST((readOptionalObject<Thingy>(absentReader) == OPTIONAL_ABSENT));
+            // Size prefix disagrees with the object
+            const std::vector<BYTE> mismatched{0x02, 0x03, 0x03, 0x03};
+            ByteReader mismatchedReader(mismatched);
+            BOOST_CHECK_THROW(readOptionalObject<Thingy>(mismatchedReader), std::runtime_error);
+            // Truncated vector
+            const std::vector<BYTE> truncated(THINGIES_SERIALIZED.begin(), THINGIES_SERIALIZED.end() - 1);
+            ByteReader truncatedReader(truncated);
+            BOOST_CHECK_THROW(readVectorOfObjects<Thingy>(truncatedReader), std::runtime_error);
+        }
+        
+        BOOST_AUTO_TEST_CASE(DeserializeOutOfBoundsTest)
+        {
+            size_t pos = 1;
+            BOOST_CHECK_THROW(deserializeIntegral<uint32_t>(std::vector<BYTE>{0x00, 0x01, 0x02, 0x03}, pos),
+                              std::runtime_error);
+            BOOST_TEST((pos == 1));
+            pos = 0;
+            BOOST_CHECK_THROW(deserializeVarInt(std::vector<BYTE>{0xfe, 0x00}, pos), std::runtime_error);
+        }
     
     BOOST_AUTO_TEST_SUITE_END()
 }